@@ -0,0 +1,67 @@
+#ifndef _INC_ASTRA_ACCUMULATOR
+#define _INC_ASTRA_ACCUMULATOR
+
+#include "Globals.h"
+
+#include <cmath>
+
+
+/**
+	* Accumulators for sums of float32 products, used by the accumulating policies.
+	*
+	* All three share the same interface: reset(), add(a, b) adds a * b, and
+	* result() returns the sum rounded to float. Storage stays float32 in every case;
+	* only the running sum differs.
+	*/
+
+//----------------------------------------------------------------------------------------
+/** Plain float32 sum. Same rounding behaviour as accumulating directly into the data.
+	*/
+struct SFloatAccumulator
+{
+	float m_fSum;
+
+	FORCEINLINE void reset() { m_fSum = 0.0f; }
+	FORCEINLINE void add(float _fA, float _fB) { m_fSum += _fA * _fB; }
+	FORCEINLINE float result() const { return m_fSum; }
+};
+
+//----------------------------------------------------------------------------------------
+/** float64 sum. Products are formed exactly in double, so the only rounding is that of the
+	* double additions, about 2^-29 relative to the float32 result.
+	*/
+struct SDoubleAccumulator
+{
+	double m_dSum;
+
+	FORCEINLINE void reset() { m_dSum = 0.0; }
+	FORCEINLINE void add(float _fA, float _fB) { m_dSum += (double)_fA * (double)_fB; }
+	FORCEINLINE float result() const { return (float)m_dSum; }
+};
+
+//----------------------------------------------------------------------------------------
+/** Compensated float32 sum (Kahan-Babuska/Neumaier). The error of the sum does not grow
+	* with the ray length; the products themselves are still rounded to float.
+	* Must not be compiled with value-unsafe floating point optimizations (-ffast-math, /fp:fast),
+	* which are allowed to remove the compensation.
+	*/
+struct SKahanAccumulator
+{
+	float m_fSum;
+	float m_fCompensation;
+
+	FORCEINLINE void reset() { m_fSum = 0.0f; m_fCompensation = 0.0f; }
+	FORCEINLINE void add(float _fA, float _fB)
+	{
+		float fValue = _fA * _fB;
+		float fSum = m_fSum + fValue;
+		if (fabs(m_fSum) >= fabs(fValue))
+			m_fCompensation += (m_fSum - fSum) + fValue;
+		else
+			m_fCompensation += (fValue - fSum) + m_fSum;
+		m_fSum = fSum;
+	}
+	FORCEINLINE float result() const { return m_fSum + m_fCompensation; }
+};
+
+#endif // _INC_ASTRA_ACCUMULATOR
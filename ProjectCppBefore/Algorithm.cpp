@@ -1,4 +1,7 @@
 #include "Algorithm.h"
+#include "ThreadPool.h"
+
+#include <chrono>
 
 
 
@@ -14,3 +17,125 @@ CAlgorithm::~CAlgorithm() {
 
 }
 
+//----------------------------------------------------------------------------------------
+// Progress callback
+void CAlgorithm::setProgressCallback(const CProjectionControl::ProgressCallback& _callback)
+{
+	m_control.setProgressCallback(_callback);
+}
+
+//----------------------------------------------------------------------------------------
+// Run asynchronously
+std::shared_ptr<CAlgorithmJob> CAlgorithm::runAsync(int _iNrIterations)
+{
+	std::shared_ptr<CAlgorithmJob> pJob(new CAlgorithmJob(this, _iNrIterations));
+	CThreadPool::getSingleton().submit([pJob]() { pJob->_execute(); });
+	return pJob;
+}
+
+
+//----------------------------------------------------------------------------------------
+// Job constructor
+CAlgorithmJob::CAlgorithmJob(CAlgorithm* _pAlgorithm, int _iNrIterations)
+{
+	m_pAlgorithm = _pAlgorithm;
+	m_iNrIterations = _iNrIterations;
+	m_eState = JOB_QUEUED;
+}
+
+//----------------------------------------------------------------------------------------
+// Execute
+void CAlgorithmJob::_execute()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_eState == JOB_CANCELLED)
+			return;
+		m_eState = JOB_RUNNING;
+	}
+
+	std::exception_ptr exception;
+	try {
+		m_pAlgorithm->run(m_iNrIterations);
+	}
+	catch (...) {
+		exception = std::current_exception();
+	}
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_exception = exception;
+	m_eState = m_pAlgorithm->stoppedEarly() ? JOB_CANCELLED : JOB_DONE;
+	// a cancel that came too late to stop the run must not stop the next one
+	m_pAlgorithm->m_control.clearAbort();
+	m_done.notify_all();
+}
+
+//----------------------------------------------------------------------------------------
+// State
+CAlgorithmJob::EState CAlgorithmJob::getState() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_eState;
+}
+
+//----------------------------------------------------------------------------------------
+// Done?
+bool CAlgorithmJob::isDone() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_eState == JOB_DONE || m_eState == JOB_CANCELLED;
+}
+
+//----------------------------------------------------------------------------------------
+// Wait
+void CAlgorithmJob::wait()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_done.wait(lock, [this]() { return m_eState == JOB_DONE || m_eState == JOB_CANCELLED; });
+	if (m_exception)
+		std::rethrow_exception(m_exception);
+}
+
+//----------------------------------------------------------------------------------------
+// Wait with timeout
+bool CAlgorithmJob::waitFor(int _iMilliseconds)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	return m_done.wait_for(lock, std::chrono::milliseconds(_iMilliseconds), [this]() { return m_eState == JOB_DONE || m_eState == JOB_CANCELLED; });
+}
+
+//----------------------------------------------------------------------------------------
+// Cancel
+bool CAlgorithmJob::cancel()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (m_eState == JOB_RUNNING) {
+		// run() may not have started yet, and clears a plain abort when it does
+		m_pAlgorithm->m_control.signalAbortIncludingNextRun();
+		return true;
+	}
+	if (m_eState != JOB_QUEUED)
+		return false;
+	m_eState = JOB_CANCELLED;
+	m_done.notify_all();
+	return true;
+}
+
+//----------------------------------------------------------------------------------------
+// Progress
+float CAlgorithmJob::getProgress() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (m_eState == JOB_QUEUED)
+		return 0.0f;
+	if (m_eState == JOB_DONE)
+		return 1.0f;
+	return m_pAlgorithm->getProgress();
+}
+
+//----------------------------------------------------------------------------------------
+// Algorithm
+CAlgorithm* CAlgorithmJob::getAlgorithm() const
+{
+	return m_pAlgorithm;
+}
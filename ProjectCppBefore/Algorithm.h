@@ -2,6 +2,15 @@
 #define _INC_ASTRA_ALGORITHM
 
 #include "Globals.h"
+#include "ProjectionControl.h"
+#include "Instrumentation.h"
+
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+
+class CAlgorithmJob;
 
 
 /**
@@ -25,6 +34,47 @@ public:
 		*/
 	virtual void run(int _iNrIterations = 0) = 0;
 
+	/** Perform a number of iterations asynchronously, on the shared CThreadPool.
+		* The algorithm must stay alive until the job is done, and must not be run
+		* again (synchronously or asynchronously) before that.
+		*
+		* @param _iNrIterations amount of iterations to perform.
+		* @return handle to wait for or cancel the job
+		*/
+	std::shared_ptr<CAlgorithmJob> runAsync(int _iNrIterations = 0);
+
+	/** Ask a running run() to stop. It is checked once per block of angles, so run()
+		* returns shortly after, leaving the output partially computed. Every run() clears
+		* the flag when it starts.
+		*/
+	void signalAbort();
+
+	/** Clear the abort flag.
+		*/
+	void clearAbort();
+
+	/** Has an abort been signalled?
+		*/
+	bool shouldAbort() const;
+
+	/** Did the current (or last) run() stop early because of an abort?
+		*/
+	bool stoppedEarly() const;
+
+	/** Get the fraction of the current (or last) run that is done, in [0, 1].
+		*/
+	float getProgress() const;
+
+	/** Set a callback that receives the number of angles done and the total after every
+		* block of angles. It is called from worker threads.
+		*/
+	void setProgressCallback(const CProjectionControl::ProgressCallback& _callback);
+
+	/** Get the stage timers and counters of the last run(). All zero unless the library
+		* is built with ASTRA_ENABLE_INSTRUMENTATION, see Instrumentation.h.
+		*/
+	const SInstrumentationReport& getInstrumentation() const { return m_instrumentation; }
+
 	/** Has this class been initialized?
 		*
 		* @return initialized
@@ -47,7 +97,16 @@ protected:
 	//< Has this class been initialized?
 	bool m_bIsInitialized;
 
+	//< Abort flag and progress, passed on to the data projectors
+	CProjectionControl m_control;
+
+	//< Instrumentation of the last run, see ASTRA_RECORD
+	SInstrumentationReport m_instrumentation;
+
 private:
+
+	friend class CAlgorithmJob;
+
 	/**
 		* Private copy constructor to prevent CAlgorithms from being copied.
 		*/
@@ -60,9 +119,80 @@ private:
 
 };
 
+
+/**
+	* Handle to an asynchronous run of a CAlgorithm, see CAlgorithm::runAsync().
+	*/
+class CAlgorithmJob {
+
+public:
+
+	enum EState { JOB_QUEUED, JOB_RUNNING, JOB_DONE, JOB_CANCELLED };
+
+	/** Get the current state.
+		*/
+	EState getState() const;
+
+	/** Has the job finished or been cancelled?
+		*/
+	bool isDone() const;
+
+	/** Wait until the job has finished or been cancelled. If run() threw an exception,
+		* it is rethrown here.
+		*/
+	void wait();
+
+	/** Wait at most _iMilliseconds for the job.
+		*
+		* @return true if the job is done
+		*/
+	bool waitFor(int _iMilliseconds);
+
+	/** Cancel the job. A job that has not started yet will not run, a running job is
+		* signalled to abort after its current blocks of angles (see CAlgorithm::signalAbort()).
+		* The job ends as JOB_CANCELLED only if the run actually stopped early.
+		*
+		* @return false if the job had already finished
+		*/
+	bool cancel();
+
+	/** Get the fraction of the job that is done, in [0, 1].
+		*/
+	float getProgress() const;
+
+	/** Get the algorithm that is being run.
+		*/
+	CAlgorithm* getAlgorithm() const;
+
+private:
+
+	friend class CAlgorithm;
+
+	CAlgorithmJob(CAlgorithm* _pAlgorithm, int _iNrIterations);
+
+	/** Run the algorithm, called on a worker thread.
+		*/
+	void _execute();
+
+	CAlgorithm* m_pAlgorithm;
+	int m_iNrIterations;
+	EState m_eState;
+	std::exception_ptr m_exception;
+	mutable std::mutex m_mutex;
+	std::condition_variable m_done;
+
+	CAlgorithmJob(const CAlgorithmJob&);
+	CAlgorithmJob& operator=(const CAlgorithmJob&);
+};
+
 // inline functions
 inline std::string CAlgorithm::description() const { return "Algorithm"; };
 inline bool CAlgorithm::isInitialized() const { return m_bIsInitialized; }
+inline void CAlgorithm::signalAbort() { m_control.signalAbort(); }
+inline void CAlgorithm::clearAbort() { m_control.clearAbort(); }
+inline bool CAlgorithm::shouldAbort() const { return m_control.shouldAbort(); }
+inline bool CAlgorithm::stoppedEarly() const { return m_control.stoppedEarly(); }
+inline float CAlgorithm::getProgress() const { return m_control.getProgress(); }
 
 
 #endif
@@ -1,11 +1,12 @@
 #ifndef _INC_ASTRA_ASTRAOBJECTMANAGER
 #define _INC_ASTRA_ASTRAOBJECTMANAGER
 
-#include <map>
 #include <sstream>
+#include <vector>
 
 #include "Globals.h"
 #include "Singleton.h"
+#include "HandleTable.h"
 #include "Projector2D.h"
 #include "Float32Data2D.h"
 #include "SparseMatrix.h"
@@ -28,36 +29,48 @@ public:
 };
 
 
+/**
+	* Hands out the indices of all object managers, so that indices are unique among them.
+	* The indices are handles into one concurrent CHandleTable that stores both the manager
+	* and the object: get() does not take a lock, store() and remove() are lock-free.
+	*/
 class CAstraIndexManager : public Singleton<CAstraIndexManager> {
 public:
-	CAstraIndexManager() : m_iLastIndex(0) { }
+	CAstraIndexManager() { }
 
-	int store(CAstraObjectManagerBase* m) {
-		m_table[++m_iLastIndex] = m;
-		return m_iLastIndex;
+	/** Store an object of manager m, returns its index or 0 if the table is full.
+		*/
+	int store(CAstraObjectManagerBase* m, void* _pObject) {
+		return m_table.store(m, _pObject);
 	}
 
+	/** Get the manager of an index, 0 if the index is not in use.
+		*/
 	CAstraObjectManagerBase* get(int index) const {
-		std::map<int, CAstraObjectManagerBase*>::const_iterator i;
-		i = m_table.find(index);
-		if (i != m_table.end())
-			return i->second;
-		else
-			return 0;
+		return (CAstraObjectManagerBase*)m_table.getOwner(index);
 	}
 
-	void remove(int index) {
-		std::map<int, CAstraObjectManagerBase*>::iterator i;
-		i = m_table.find(index);
-		if (i != m_table.end())
-			m_table.erase(i);
+	/** Get the object of an index if it belongs to manager m, 0 otherwise.
+		*/
+	void* getObject(int index, const CAstraObjectManagerBase* m) const {
+		return m_table.get(index, m);
 	}
 
-private:
-	/** The index last handed out
+	/** Remove an index if it belongs to manager m. Returns the object, 0 if the index
+		* was not in use (also when another thread removed it first).
 		*/
-	int m_iLastIndex;
-	std::map<int, CAstraObjectManagerBase*> m_table;
+	void* remove(int index, const CAstraObjectManagerBase* m) {
+		return m_table.remove(index, m);
+	}
+
+	/** Access to the table, for iterating over all objects.
+		*/
+	const CHandleTable& getTable() const {
+		return m_table;
+	}
+
+private:
+	CHandleTable m_table;
 };
 
 
@@ -77,7 +90,7 @@ public:
 	/** Store the object in the manager and assign a unique index handle to it.
 		*
 		* @param _pObject A pointer to the object that should be stored.
-		* @return The index of the stored data object.  If the index in negative, an error occurred
+		* @return The index of the stored data object.  If the index is 0, the table is full
 		* and the object was NOT stored.
 		*/
 	int store(T* _pObject);
@@ -125,11 +138,13 @@ public:
 		*/
 	std::string info();
 
-protected:
-
-	/** Map each data object to a unique index.
+	/** Get the indices of all managed objects.
 		*/
-	std::map<int, T*> m_mIndexToObject;
+	std::vector<int> getIndices() const;
+
+	// store, get, hasIndex and remove are safe to call from several threads at once.
+	// The objects are owned by the manager: a pointer returned by get() stays valid
+	// until the object is removed.
 
 };
 
@@ -153,9 +168,7 @@ CAstraObjectManager<T>::~CAstraObjectManager()
 template <typename T>
 int CAstraObjectManager<T>::store(T* _pDataObject)
 {
-	int iIndex = CAstraIndexManager::getSingleton().store(this);
-	m_mIndexToObject[iIndex] = _pDataObject;
-	return iIndex;
+	return CAstraIndexManager::getSingleton().store(this, _pDataObject);
 }
 
 //----------------------------------------------------------------------------------------
@@ -163,8 +176,7 @@ int CAstraObjectManager<T>::store(T* _pDataObject)
 template <typename T>
 bool CAstraObjectManager<T>::hasIndex(int _iIndex) const
 {
-	typename std::map<int, T*>::const_iterator it = m_mIndexToObject.find(_iIndex);
-	return it != m_mIndexToObject.end();
+	return CAstraIndexManager::getSingleton().getObject(_iIndex, this) != 0;
 }
 
 //----------------------------------------------------------------------------------------
@@ -172,11 +184,7 @@ bool CAstraObjectManager<T>::hasIndex(int _iIndex) const
 template <typename T>
 T* CAstraObjectManager<T>::get(int _iIndex) const
 {
-	typename std::map<int, T*>::const_iterator it = m_mIndexToObject.find(_iIndex);
-	if (it != m_mIndexToObject.end())
-		return it->second;
-	else
-		return 0;
+	return (T*)CAstraIndexManager::getSingleton().getObject(_iIndex, this);
 }
 
 //----------------------------------------------------------------------------------------
@@ -184,16 +192,27 @@ T* CAstraObjectManager<T>::get(int _iIndex) const
 template <typename T>
 void CAstraObjectManager<T>::remove(int _iIndex)
 {
-	// find data
-	typename std::map<int, T*>::iterator it = m_mIndexToObject.find(_iIndex);
-	if (it == m_mIndexToObject.end())
-		return;
-	// delete data
-	delete (*it).second;
-	// delete from map
-	m_mIndexToObject.erase(it);
-
-	CAstraIndexManager::getSingleton().remove(_iIndex);
+	// only the thread that actually removed the index deletes the object
+	T* pObject = (T*)CAstraIndexManager::getSingleton().remove(_iIndex, this);
+	delete pObject;
+}
+
+//----------------------------------------------------------------------------------------
+// Get indices
+template <typename T>
+std::vector<int> CAstraObjectManager<T>::getIndices() const
+{
+	std::vector<int> indices;
+	const CHandleTable& table = CAstraIndexManager::getSingleton().getTable();
+	int iSlotCount = table.getSlotCount();
+	for (int i = 0; i < iSlotCount; ++i) {
+		int iIndex;
+		const void* pOwner;
+		void* pObject;
+		if (table.getSlot(i, iIndex, pOwner, pObject) && pOwner == this)
+			indices.push_back(iIndex);
+	}
+	return indices;
 }
 
 //----------------------------------------------------------------------------------------
@@ -201,8 +220,14 @@ void CAstraObjectManager<T>::remove(int _iIndex)
 template <typename T>
 int CAstraObjectManager<T>::getIndex(const T* _pObject) const
 {
-	for (typename std::map<int, T*>::const_iterator it = m_mIndexToObject.begin(); it != m_mIndexToObject.end(); it++) {
-		if ((*it).second == _pObject) return (*it).first;
+	const CHandleTable& table = CAstraIndexManager::getSingleton().getTable();
+	int iSlotCount = table.getSlotCount();
+	for (int i = 0; i < iSlotCount; ++i) {
+		int iIndex;
+		const void* pOwner;
+		void* pObject;
+		if (table.getSlot(i, iIndex, pOwner, pObject) && pOwner == this && pObject == _pObject)
+			return iIndex;
 	}
 	return 0;
 }
@@ -213,23 +238,18 @@ int CAstraObjectManager<T>::getIndex(const T* _pObject) const
 template <typename T>
 void CAstraObjectManager<T>::clear()
 {
-	for (typename std::map<int, T*>::iterator it = m_mIndexToObject.begin(); it != m_mIndexToObject.end(); it++) {
-		// delete data
-		delete (*it).second;
-		(*it).second = 0;
-	}
-
-	m_mIndexToObject.clear();
+	std::vector<int> indices = getIndices();
+	for (size_t i = 0; i < indices.size(); ++i)
+		remove(indices[i]);
 }
 
 //----------------------------------------------------------------------------------------
 // Print info to string
 template <typename T>
 std::string CAstraObjectManager<T>::getInfo(int index) const {
-	typename std::map<int, T*>::const_iterator it = m_mIndexToObject.find(index);
-	if (it == m_mIndexToObject.end())
+	const T* pObject = get(index);
+	if (!pObject)
 		return "";
-	const T* pObject = it->second;
 	std::stringstream res;
 	res << index << " \t";
 	if (pObject->isInitialized()) {
@@ -247,8 +267,9 @@ std::string CAstraObjectManager<T>::info() {
 	std::stringstream res;
 	res << "id  init  description" << std::endl;
 	res << "-----------------------------------------" << std::endl;
-	for (typename std::map<int, T*>::const_iterator it = m_mIndexToObject.begin(); it != m_mIndexToObject.end(); it++) {
-		res << getInfo(it->first) << std::endl;
+	std::vector<int> indices = getIndices();
+	for (size_t i = 0; i < indices.size(); ++i) {
+		res << getInfo(indices[i]) << std::endl;
 	}
 	res << "-----------------------------------------" << std::endl;
 	return res.str();
@@ -0,0 +1,179 @@
+/**
+	* Benchmark of the projection vector generators on large (10^5 angle) geometries.
+	*
+	* Compares, for fan and parallel beam geometries:
+	*   legacy   the previous loop, libm cos() and sin() twice per vector and angle
+	*   aos      genFanProjections() / genParProjections(), array of structures
+	*   batch    genFanProjectionsBatch() / genParProjectionsBatch(), structure of arrays
+	* and reports the largest deviation of sincosBatch() and of the generated vectors
+	* from libm.
+	*
+	* Usage: GeometryBenchmark [angles] [repetitions]
+	*/
+
+#include "../GeometryUtil2D.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace std;
+
+static const unsigned int DETECTORS = 768;
+static const double DETECTOR_SIZE = 1.0;
+static const double ORIGIN_SOURCE = 1000.0;
+static const double ORIGIN_DETECTOR = 500.0;
+
+
+//----------------------------------------------------------------------------------------
+// Previous generators, for reference
+static SFanProjection* legacyFanProjections(unsigned int _iAngles, const float* _pfAngles)
+{
+	SFanProjection* pProjs = new SFanProjection[_iAngles];
+	float fSrcX0 = 0.0f;
+	float fSrcY0 = -ORIGIN_SOURCE;
+	float fDetUX0 = DETECTOR_SIZE;
+	float fDetUY0 = 0.0f;
+	float fDetSX0 = DETECTORS * fDetUX0 / -2.0f;
+	float fDetSY0 = ORIGIN_DETECTOR;
+
+#define ROTATE0(name,i,alpha) do { pProjs[i].f##name##X = f##name##X0 * ::cos(alpha) - f##name##Y0 * ::sin(alpha); pProjs[i].f##name##Y = f##name##X0 * ::sin(alpha) + f##name##Y0 * ::cos(alpha); } while(0)
+	for (unsigned int i = 0; i < _iAngles; ++i) {
+		ROTATE0(Src, i, _pfAngles[i]);
+		ROTATE0(DetS, i, _pfAngles[i]);
+		ROTATE0(DetU, i, _pfAngles[i]);
+	}
+#undef ROTATE0
+	return pProjs;
+}
+
+static SParProjection* legacyParProjections(unsigned int _iAngles, const float* _pfAngles)
+{
+	SParProjection base;
+	base.fRayX = 0.0f;
+	base.fRayY = 1.0f;
+	base.fDetSX = DETECTORS * DETECTOR_SIZE * -0.5f;
+	base.fDetSY = 0.0f;
+	base.fDetUX = DETECTOR_SIZE;
+	base.fDetUY = 0.0f;
+
+	SParProjection* p = new SParProjection[_iAngles];
+#define ROTATE0(name,i,alpha) do { p[i].f##name##X = base.f##name##X * ::cos(alpha) - base.f##name##Y * ::sin(alpha); p[i].f##name##Y = base.f##name##X * ::sin(alpha) + base.f##name##Y * ::cos(alpha); } while(0)
+	for (unsigned int i = 0; i < _iAngles; ++i) {
+		ROTATE0(Ray, i, _pfAngles[i]);
+		ROTATE0(DetS, i, _pfAngles[i]);
+		ROTATE0(DetU, i, _pfAngles[i]);
+	}
+#undef ROTATE0
+	return p;
+}
+
+//----------------------------------------------------------------------------------------
+// Best of _iRepetitions runs, in milliseconds
+template <typename TFunction>
+double time(int _iRepetitions, TFunction _function)
+{
+	double dBest = 1e30;
+	for (int r = 0; r < _iRepetitions; ++r) {
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		_function();
+		dBest = min(dBest, chrono::duration<double, milli>(chrono::steady_clock::now() - start).count());
+	}
+	return dBest;
+}
+
+static float maxDifference(const float* _pfA, const float* _pfB, size_t _iCount, size_t _iStride)
+{
+	float fMax = 0.0f;
+	for (size_t i = 0; i < _iCount; ++i)
+		fMax = max(fMax, fabs(_pfA[i * _iStride] - _pfB[i]));
+	return fMax;
+}
+
+//----------------------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+	unsigned int iAngles = argc > 1 ? atoi(argv[1]) : 100000;
+	int iRepetitions = argc > 2 ? atoi(argv[2]) : 20;
+
+	vector<float> angles(iAngles);
+	for (unsigned int i = 0; i < iAngles; ++i)
+		angles[i] = (float)(2.0 * M_PI * i / iAngles);
+
+	printf("angles %u, detectors %u, best of %d\n\n", iAngles, DETECTORS, iRepetitions);
+
+	// accuracy
+	vector<double> sines(iAngles), cosines(iAngles);
+	sincosBatch(&angles[0], iAngles, &sines[0], &cosines[0]);
+	double dMaxSin = 0.0, dMaxCos = 0.0;
+	for (unsigned int i = 0; i < iAngles; ++i) {
+		dMaxSin = max(dMaxSin, fabs(sines[i] - sin((double)angles[i])));
+		dMaxCos = max(dMaxCos, fabs(cosines[i] - cos((double)angles[i])));
+	}
+	printf("sincosBatch vs libm: max |dsin| %.3g, max |dcos| %.3g\n", dMaxSin, dMaxCos);
+
+	// fan beam
+	SFanProjection* pLegacyFan = legacyFanProjections(iAngles, &angles[0]);
+	SFanProjectionBatch fanBatch;
+	genFanProjectionsBatch(iAngles, DETECTORS, ORIGIN_SOURCE, ORIGIN_DETECTOR, DETECTOR_SIZE, &angles[0], fanBatch);
+	const size_t iFanStride = sizeof(SFanProjection) / sizeof(float);
+	float fFanDiff = 0.0f;
+	fFanDiff = max(fFanDiff, maxDifference(&pLegacyFan[0].fSrcX, fanBatch.pfSrcX, iAngles, iFanStride));
+	fFanDiff = max(fFanDiff, maxDifference(&pLegacyFan[0].fSrcY, fanBatch.pfSrcY, iAngles, iFanStride));
+	fFanDiff = max(fFanDiff, maxDifference(&pLegacyFan[0].fDetSX, fanBatch.pfDetSX, iAngles, iFanStride));
+	fFanDiff = max(fFanDiff, maxDifference(&pLegacyFan[0].fDetSY, fanBatch.pfDetSY, iAngles, iFanStride));
+	fFanDiff = max(fFanDiff, maxDifference(&pLegacyFan[0].fDetUX, fanBatch.pfDetUX, iAngles, iFanStride));
+	fFanDiff = max(fFanDiff, maxDifference(&pLegacyFan[0].fDetUY, fanBatch.pfDetUY, iAngles, iFanStride));
+	delete[] pLegacyFan;
+	printf("fan vectors vs legacy: max difference %.3g\n", fFanDiff);
+
+	// parallel beam
+	SParProjection* pLegacyPar = legacyParProjections(iAngles, &angles[0]);
+	SParProjectionBatch parBatch;
+	genParProjectionsBatch(iAngles, DETECTORS, DETECTOR_SIZE, &angles[0], NULL, parBatch);
+	const size_t iParStride = sizeof(SParProjection) / sizeof(float);
+	float fParDiff = 0.0f;
+	fParDiff = max(fParDiff, maxDifference(&pLegacyPar[0].fRayX, parBatch.pfRayX, iAngles, iParStride));
+	fParDiff = max(fParDiff, maxDifference(&pLegacyPar[0].fRayY, parBatch.pfRayY, iAngles, iParStride));
+	fParDiff = max(fParDiff, maxDifference(&pLegacyPar[0].fDetSX, parBatch.pfDetSX, iAngles, iParStride));
+	fParDiff = max(fParDiff, maxDifference(&pLegacyPar[0].fDetSY, parBatch.pfDetSY, iAngles, iParStride));
+	fParDiff = max(fParDiff, maxDifference(&pLegacyPar[0].fDetUX, parBatch.pfDetUX, iAngles, iParStride));
+	fParDiff = max(fParDiff, maxDifference(&pLegacyPar[0].fDetUY, parBatch.pfDetUY, iAngles, iParStride));
+	delete[] pLegacyPar;
+	printf("par vectors vs legacy: max difference %.3g\n\n", fParDiff);
+
+	// timings
+	double dSinCos = time(iRepetitions, [&]() { sincosBatch(&angles[0], iAngles, &sines[0], &cosines[0]); });
+	double dLibm = time(iRepetitions, [&]() {
+		for (unsigned int i = 0; i < iAngles; ++i) {
+			sines[i] = sin((double)angles[i]);
+			cosines[i] = cos((double)angles[i]);
+		}
+	});
+	printf("sincos   libm %8.3f ms   batch %8.3f ms   speedup %6.2fx\n", dLibm, dSinCos, dLibm / dSinCos);
+
+	double dFanLegacy = time(iRepetitions, [&]() { delete[] legacyFanProjections(iAngles, &angles[0]); });
+	double dFanAoS = time(iRepetitions, [&]() {
+		delete[] genFanProjections(iAngles, DETECTORS, ORIGIN_SOURCE, ORIGIN_DETECTOR, DETECTOR_SIZE, &angles[0]);
+	});
+	double dFanBatch = time(iRepetitions, [&]() {
+		genFanProjectionsBatch(iAngles, DETECTORS, ORIGIN_SOURCE, ORIGIN_DETECTOR, DETECTOR_SIZE, &angles[0], fanBatch);
+	});
+	printf("fan      legacy %8.3f ms   aos %8.3f ms   batch %8.3f ms   speedup %6.2fx\n",
+		dFanLegacy, dFanAoS, dFanBatch, dFanLegacy / dFanBatch);
+
+	double dParLegacy = time(iRepetitions, [&]() { delete[] legacyParProjections(iAngles, &angles[0]); });
+	double dParAoS = time(iRepetitions, [&]() {
+		delete[] genParProjections(iAngles, DETECTORS, DETECTOR_SIZE, &angles[0], NULL);
+	});
+	double dParBatch = time(iRepetitions, [&]() {
+		genParProjectionsBatch(iAngles, DETECTORS, DETECTOR_SIZE, &angles[0], NULL, parBatch);
+	});
+	printf("par      legacy %8.3f ms   aos %8.3f ms   batch %8.3f ms   speedup %6.2fx\n",
+		dParLegacy, dParAoS, dParBatch, dParLegacy / dParBatch);
+
+	return 0;
+}
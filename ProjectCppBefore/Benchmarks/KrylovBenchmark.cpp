@@ -0,0 +1,132 @@
+/**
+	* Time to tolerance of CGLS against SIRT on the bundled Shepp-Logan phantom
+	* (modified_shepp_logan_512.bin, 512 x 512 doubles, subsampled to the volume size).
+	*
+	*   cgls   CCglsAlgorithm
+	*   sirt   COrderedSubsetsAlgorithm with a single subset
+	*
+	* Both solve for the sinogram of the phantom (line projector) from a zero start, one
+	* iteration at a time. After every iteration the relative residual ||b - A x|| / ||b||
+	* is measured outside the timed part, and the time and iteration count at which each
+	* tolerance is first reached are reported as a markdown table. A method gives up after
+	* [max_seconds] of iterations.
+	*
+	* Usage: KrylovBenchmark [phantom] [size] [angles] [max_seconds]
+	*/
+
+#include "../FanFlatProjectionGeometry2D.h"
+#include "../FanFlatBeamLineKernelProjector2D.h"
+#include "../VolumeGeometry2D.h"
+#include "../Float32VolumeData2D.h"
+#include "../Float32ProjectionData2D.h"
+#include "../ForwardProjectionAlgorithm.h"
+#include "../CglsAlgorithm.h"
+#include "../OrderedSubsetsAlgorithm.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <vector>
+
+using namespace std;
+
+static const int PHANTOM_SIZE = 512;
+static const double TOLERANCES[] = { 1e-1, 3e-2, 1e-2, 3e-3, 1e-3 };
+static const int TOLERANCE_COUNT = sizeof(TOLERANCES) / sizeof(TOLERANCES[0]);
+
+
+struct SReached {
+	int iIterations;
+	double dSeconds;
+};
+
+//----------------------------------------------------------------------------------------
+// Iterate _pAlgorithm until all tolerances are reached or _dMaxSeconds have passed
+static vector<SReached> timeToTolerance(CAlgorithm* _pAlgorithm, CFloat32VolumeData2D* _pReconstruction,
+	CFloat32ProjectionData2D* _pSinogram, CProjector2D* _pProjector, double _dMaxSeconds)
+{
+	vector<SReached> reached(TOLERANCE_COUNT, SReached{ -1, 0.0 });
+
+	CFloat32ProjectionData2D residual(_pSinogram->getGeometry(), 0.0f);
+	CForwardProjectionAlgorithm forwardProjection(_pProjector, _pReconstruction, &residual);
+	double dSinogramNorm = sqrt(_pSinogram->squaredNorm());
+
+	double dSeconds = 0.0;
+	int iReached = 0;
+	for (int iIteration = 1; iReached < TOLERANCE_COUNT && dSeconds < _dMaxSeconds; ++iIteration) {
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		_pAlgorithm->run(1);
+		dSeconds += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+		// ||b - A x|| / ||b||, not timed
+		forwardProjection.run();
+		residual -= *_pSinogram;
+		double dResidual = sqrt(residual.squaredNorm()) / dSinogramNorm;
+
+		while (iReached < TOLERANCE_COUNT && dResidual <= TOLERANCES[iReached]) {
+			reached[iReached].iIterations = iIteration;
+			reached[iReached].dSeconds = dSeconds;
+			++iReached;
+		}
+	}
+	return reached;
+}
+
+//----------------------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+	const char* pcPhantom = argc > 1 ? argv[1] : "../modified_shepp_logan_512.bin";
+	int iSize = argc > 2 ? atoi(argv[2]) : 256;
+	int iAngles = argc > 3 ? atoi(argv[3]) : 180;
+	double dMaxSeconds = argc > 4 ? atof(argv[4]) : 60.0;
+	int iDetectors = iSize * 3 / 2;
+
+	vector<double> phantom(PHANTOM_SIZE * PHANTOM_SIZE);
+	ifstream fileIn(pcPhantom, ios::binary);
+	if (!fileIn.read(reinterpret_cast<char*>(&phantom[0]), sizeof(double) * phantom.size())) {
+		fprintf(stderr, "cannot read %d x %d phantom from %s\n", PHANTOM_SIZE, PHANTOM_SIZE, pcPhantom);
+		return 1;
+	}
+	vector<float> phantomf(iSize * iSize);
+	for (int y = 0; y < iSize; ++y)
+		for (int x = 0; x < iSize; ++x)
+			phantomf[y * iSize + x] = (float)phantom[(y * PHANTOM_SIZE / iSize) * PHANTOM_SIZE + x * PHANTOM_SIZE / iSize];
+
+	vector<float> angles(iAngles);
+	for (int i = 0; i < iAngles; ++i)
+		angles[i] = (float)(2.0 * M_PI * i / iAngles);
+
+	// source and detector far enough out for the volume, detector covers the fan
+	CFanFlatProjectionGeometry2D projectionGeometry(iAngles, iDetectors, 2.0f * iSize / iDetectors, &angles[0], 2.0f * iSize, 2.0f * iSize);
+	CVolumeGeometry2D volumeGeometry(iSize, iSize);
+	CFanFlatBeamLineKernelProjector2D projector(&projectionGeometry, &volumeGeometry);
+
+	CFloat32VolumeData2D volume(&volumeGeometry, &phantomf[0]);
+	CFloat32ProjectionData2D sinogram(&projectionGeometry, 0.0f);
+	CForwardProjectionAlgorithm(&projector, &volume, &sinogram).run();
+
+	CFloat32VolumeData2D cglsReconstruction(&volumeGeometry, 0.0f);
+	CCglsAlgorithm cgls(&projector, &sinogram, &cglsReconstruction);
+	vector<SReached> cglsReached = timeToTolerance(&cgls, &cglsReconstruction, &sinogram, &projector, dMaxSeconds);
+
+	CFloat32VolumeData2D sirtReconstruction(&volumeGeometry, 0.0f);
+	COrderedSubsetsAlgorithm sirt(&projector, &sinogram, &sirtReconstruction, 1);
+	sirt.run(0);	// normalization, not part of the iterations
+	vector<SReached> sirtReached = timeToTolerance(&sirt, &sirtReconstruction, &sinogram, &projector, dMaxSeconds);
+
+	printf("Shepp-Logan %d x %d, %d angles, %d detectors, at most %.0f s per method\n\n", iSize, iSize, iAngles, iDetectors, dMaxSeconds);
+	printf("| rel. residual | CGLS it | CGLS time (s) | SIRT it | SIRT time (s) | speedup |\n");
+	printf("|--------------:|--------:|--------------:|--------:|--------------:|--------:|\n");
+	for (int t = 0; t < TOLERANCE_COUNT; ++t) {
+		const SReached& c = cglsReached[t];
+		const SReached& s = sirtReached[t];
+		printf("| %13.0e |", TOLERANCES[t]);
+		if (c.iIterations > 0) printf(" %7d | %13.2f |", c.iIterations, c.dSeconds); else printf(" %7s | %13s |", "-", "-");
+		if (s.iIterations > 0) printf(" %7d | %13.2f |", s.iIterations, s.dSeconds); else printf(" %7s | %13s |", "-", "-");
+		if (c.iIterations > 0 && s.iIterations > 0) printf(" %6.1fx |\n", s.dSeconds / c.dSeconds); else printf(" %7s |\n", "-");
+	}
+
+	return 0;
+}
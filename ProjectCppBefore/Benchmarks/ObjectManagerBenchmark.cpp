@@ -0,0 +1,139 @@
+/**
+	* Contention benchmark for the object manager handle table.
+	*
+	* A number of threads (64 by default) hammer one manager with a request-like mix:
+	* every thread keeps a few objects of its own alive, looks up random live indices of
+	* all threads and now and then replaces one of its objects (remove + store).
+	* The same workload is run against a std::map guarded by a std::mutex, which is what
+	* making the previous map-based manager thread-safe would have cost.
+	*
+	* Usage: ObjectManagerBenchmark [threads] [operations per thread] [lookups per update]
+	*/
+
+#include "../AstraObjectManager.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// objects every thread keeps alive
+static const int OBJECTS_PER_THREAD = 16;
+
+
+//----------------------------------------------------------------------------------------
+// Baseline: the previous map, guarded by a mutex
+class CLockedMap {
+public:
+	CLockedMap() : m_iLastIndex(0) { }
+
+	int store(CSparseMatrix* _pObject) {
+		lock_guard<mutex> lock(m_mutex);
+		m_table[++m_iLastIndex] = _pObject;
+		return m_iLastIndex;
+	}
+	CSparseMatrix* get(int _iIndex) const {
+		lock_guard<mutex> lock(m_mutex);
+		map<int, CSparseMatrix*>::const_iterator it = m_table.find(_iIndex);
+		return it != m_table.end() ? it->second : 0;
+	}
+	void remove(int _iIndex) {
+		CSparseMatrix* pObject = 0;
+		{
+			lock_guard<mutex> lock(m_mutex);
+			map<int, CSparseMatrix*>::iterator it = m_table.find(_iIndex);
+			if (it == m_table.end())
+				return;
+			pObject = it->second;
+			m_table.erase(it);
+		}
+		delete pObject;
+	}
+
+private:
+	mutable mutex m_mutex;
+	int m_iLastIndex;
+	map<int, CSparseMatrix*> m_table;
+};
+
+//----------------------------------------------------------------------------------------
+// Adapter for the handle table based manager
+class CManagerAdapter {
+public:
+	int store(CSparseMatrix* _pObject) { return CMatrixManager::getSingleton().store(_pObject); }
+	CSparseMatrix* get(int _iIndex) const { return CMatrixManager::getSingleton().get(_iIndex); }
+	void remove(int _iIndex) { CMatrixManager::getSingleton().remove(_iIndex); }
+};
+
+//----------------------------------------------------------------------------------------
+// Run the workload, returns million operations per second
+template <typename TManager>
+double run(TManager& _manager, int _iThreads, int _iOperations, int _iLookupsPerUpdate)
+{
+	// published indices; slots are overwritten by their owning thread only
+	vector<atomic<int> > indices(_iThreads * OBJECTS_PER_THREAD);
+	for (size_t i = 0; i < indices.size(); ++i)
+		indices[i].store(_manager.store(new CSparseMatrix()));
+
+	atomic<long> found(0);
+	vector<thread> threads;
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	for (int t = 0; t < _iThreads; ++t) {
+		threads.push_back(thread([&, t]() {
+			unsigned int iSeed = 2463534242u + t;
+			long iFound = 0;
+			for (int i = 0; i < _iOperations; ++i) {
+				iSeed ^= iSeed << 13; iSeed ^= iSeed >> 17; iSeed ^= iSeed << 5;
+				if (i % (_iLookupsPerUpdate + 1) == 0) {
+					atomic<int>& slot = indices[t * OBJECTS_PER_THREAD + iSeed % OBJECTS_PER_THREAD];
+					int iOld = slot.load();
+					slot.store(_manager.store(new CSparseMatrix()));
+					_manager.remove(iOld);
+				}
+				else {
+					// objects of other threads may be gone by the time they are looked up
+					if (_manager.get(indices[iSeed % indices.size()].load()))
+						++iFound;
+				}
+			}
+			found += iFound;
+		}));
+	}
+	for (size_t i = 0; i < threads.size(); ++i)
+		threads[i].join();
+	double dSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+	for (size_t i = 0; i < indices.size(); ++i)
+		_manager.remove(indices[i].load());
+
+	if (found.load() == 0)
+		printf("warning: no lookup succeeded\n");
+	return (double)_iThreads * _iOperations / dSeconds / 1e6;
+}
+
+//----------------------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+	int iThreads = argc > 1 ? atoi(argv[1]) : 64;
+	int iOperations = argc > 2 ? atoi(argv[2]) : 200000;
+	int iLookupsPerUpdate = argc > 3 ? atoi(argv[3]) : 9;
+
+	printf("threads %d, operations per thread %d, lookups per update %d\n", iThreads, iOperations, iLookupsPerUpdate);
+
+	CLockedMap lockedMap;
+	double dLocked = run(lockedMap, iThreads, iOperations, iLookupsPerUpdate);
+	printf("mutex + std::map    %8.2f Mops/s\n", dLocked);
+
+	CManagerAdapter manager;
+	double dTable = run(manager, iThreads, iOperations, iLookupsPerUpdate);
+	printf("handle table        %8.2f Mops/s\n", dTable);
+
+	printf("speedup             %8.2fx\n", dTable / dLocked);
+	return 0;
+}
@@ -0,0 +1,416 @@
+/**
+	* Benchmark suite for the projector, the policies and the data operations.
+	*
+	* For every volume size, angle count, detector count and thread count of the sweep the
+	* benchmarks below are run once to warm up and then a fixed number of repetitions. Per
+	* benchmark the mean, median, standard deviation and minimum wall time are reported,
+	* together with rays/s (projections only) and GB/s, as JSON in the layout of Google
+	* Benchmark's --benchmark_format=json so existing tooling can compare two runs.
+	*
+	*   FP            forward projection, CForwardProjectionAlgorithm::run()
+	*   FPRayTable    FP with the projector's ray table enabled
+	*   BP            back projection, DefaultBPPolicy
+	*   GetMatrix     CProjector2D::getMatrix()
+	*   SpMV          sinogram = matrix * volume on the getMatrix() result
+	*   UpdateStats   CFloat32Data2D::updateStatistics() on the volume
+	*   AddData       volume += volume
+	*   MulScalar     volume *= scalar
+	*   ClampMin      volume.clampMin()
+	*
+	* GB/s counts the bytes a benchmark has to move at least: for the projections that is
+	* one float per matrix entry (getProjectionWeightsCount() bound) plus the sinogram, for
+	* SpMV the CSR arrays plus the gathered and written vectors, for the data operations the
+	* arrays read and written. Benchmarks that do not use the thread pool are only run for
+	* the first thread count. Benchmarks that need a system matrix or a ray table larger than
+	* --matrix_limit_mb are skipped.
+	*
+	* Usage: ProjectorBenchmark [--sizes=128,256,512] [--angles=180,720] [--detectors=0]
+	*                           [--threads=1,2,4] [--repetitions=5] [--filter=FP]
+	*                           [--matrix_limit_mb=1024] [--out=results.json]
+	* A detector count of 0 means 1.5 times the volume size; by default the thread counts are
+	* the powers of two up to the hardware thread count, and that count itself.
+	*/
+
+#include "../FanFlatProjectionGeometry2D.h"
+#include "../FanFlatBeamLineKernelProjector2D.h"
+#include "../VolumeGeometry2D.h"
+#include "../Float32VolumeData2D.h"
+#include "../Float32ProjectionData2D.h"
+#include "../ForwardProjectionAlgorithm.h"
+#include "../DataProjector.h"
+#include "../DataProjectorPolicies.h"
+#include "../SparseMatrix.h"
+#include "../ThreadPool.h"
+
+#include "../Projector2DImpl.inl"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+
+//----------------------------------------------------------------------------------------
+// Options
+struct SOptions
+{
+	vector<int> sizes;
+	vector<int> angles;
+	vector<int> detectors;
+	vector<int> threads;
+	int iRepetitions;
+	string filter;
+	int iMatrixLimitMB;
+	string out;
+};
+
+//----------------------------------------------------------------------------------------
+// Result of one benchmark run
+struct SResult
+{
+	string name;
+	string family;
+	int iSize, iAngles, iDetectors, iThreads;
+	int iRepetitions;
+	double dMean, dMedian, dStdDev, dMin;	// seconds
+	double dRays;							// rays per iteration, 0 if not a projection
+	double dBytes;							// bytes per iteration
+};
+
+//----------------------------------------------------------------------------------------
+// Parse "1,2,4"
+static vector<int> parseList(const char* _pcValue)
+{
+	vector<int> values;
+	const char* p = _pcValue;
+	while (*p) {
+		values.push_back(atoi(p));
+		while (*p && *p != ',')
+			++p;
+		if (*p == ',')
+			++p;
+	}
+	return values;
+}
+
+//----------------------------------------------------------------------------------------
+// Time _function: one warmup call, then _iRepetitions timed calls
+static void measure(const function<void()>& _function, int _iRepetitions, SResult& _result)
+{
+	_function();
+
+	vector<double> times;
+	for (int i = 0; i < _iRepetitions; ++i) {
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		_function();
+		times.push_back(chrono::duration<double>(chrono::steady_clock::now() - start).count());
+	}
+
+	sort(times.begin(), times.end());
+	double dSum = 0.0;
+	for (size_t i = 0; i < times.size(); ++i)
+		dSum += times[i];
+	double dMean = dSum / times.size();
+	double dVar = 0.0;
+	for (size_t i = 0; i < times.size(); ++i)
+		dVar += (times[i] - dMean) * (times[i] - dMean);
+	size_t n = times.size();
+
+	_result.iRepetitions = _iRepetitions;
+	_result.dMean = dMean;
+	_result.dMedian = (n % 2) ? times[n / 2] : 0.5 * (times[n / 2 - 1] + times[n / 2]);
+	_result.dStdDev = n > 1 ? sqrt(dVar / (n - 1)) : 0.0;
+	_result.dMin = times[0];
+}
+
+//----------------------------------------------------------------------------------------
+// Sparse matrix times vector, rows split over the thread pool
+static void multiply(const CSparseMatrix& _matrix, const float* _pfIn, float* _pfOut)
+{
+	parallelFor(0, (int)_matrix.m_iHeight, 256, [&](int _iFrom, int _iTo) {
+		for (int iRow = _iFrom; iRow < _iTo; ++iRow) {
+			unsigned int iSize;
+			const float* pfValues;
+			const unsigned int* piColIndices;
+			_matrix.getRowData(iRow, iSize, pfValues, piColIndices);
+			float fSum = 0.0f;
+			for (unsigned int i = 0; i < iSize; ++i)
+				fSum += pfValues[i] * _pfIn[piColIndices[i]];
+			_pfOut[iRow] = fSum;
+		}
+	});
+}
+
+//----------------------------------------------------------------------------------------
+// Simple phantom: a disc of ones with a smaller disc of twos
+static void fillPhantom(CFloat32VolumeData2D& _volume, int _iSize)
+{
+	float* pfData = _volume.getData();
+	for (int iRow = 0; iRow < _iSize; ++iRow) {
+		for (int iCol = 0; iCol < _iSize; ++iCol) {
+			float x = (iCol + 0.5f) / _iSize - 0.5f;
+			float y = (iRow + 0.5f) / _iSize - 0.5f;
+			float r2 = x * x + y * y;
+			pfData[iRow * _iSize + iCol] = r2 < 0.04f ? 2.0f : (r2 < 0.16f ? 1.0f : 0.0f);
+		}
+	}
+	_volume.updateStatistics();
+}
+
+//----------------------------------------------------------------------------------------
+// All benchmarks of one geometry
+class CGeometryBenchmarks {
+public:
+	CGeometryBenchmarks(const SOptions& _options, int _iSize, int _iAngles, int _iDetectors)
+		: m_options(_options), m_iSize(_iSize), m_iAngles(_iAngles), m_iDetectors(_iDetectors), m_pMatrix(0)
+	{
+		vector<float> angles(_iAngles);
+		for (int i = 0; i < _iAngles; ++i)
+			angles[i] = (float)(PI * i / _iAngles);
+
+		// source and detector far enough out for the volume, detector covers the fan
+		float fDistance = 2.0f * _iSize;
+		float fDetectorWidth = 2.0f * _iSize / _iDetectors;
+		m_pProjectionGeometry = new CFanFlatProjectionGeometry2D(_iAngles, _iDetectors, fDetectorWidth, &angles[0], fDistance, fDistance);
+		m_pVolumeGeometry = new CVolumeGeometry2D(_iSize, _iSize);
+		m_pProjector = new CFanFlatBeamLineKernelProjector2D(m_pProjectionGeometry, m_pVolumeGeometry);
+		m_pVolume = new CFloat32VolumeData2D(m_pVolumeGeometry, 0.0f);
+		m_pSinogram = new CFloat32ProjectionData2D(m_pProjectionGeometry, 0.0f);
+		m_pOther = new CFloat32VolumeData2D(m_pVolumeGeometry, 1.0f);
+		fillPhantom(*m_pVolume, _iSize);
+
+		m_dWeights = 0.0;
+		for (int i = 0; i < _iAngles; ++i)
+			m_dWeights += (double)m_pProjector->getProjectionWeightsCount(i) * _iDetectors;
+	}
+
+	~CGeometryBenchmarks()
+	{
+		delete m_pMatrix;
+		delete m_pOther;
+		delete m_pSinogram;
+		delete m_pVolume;
+		delete m_pProjector;
+		delete m_pVolumeGeometry;
+		delete m_pProjectionGeometry;
+	}
+
+	void run(int _iThreads, bool _bFirstThreadCount, vector<SResult>& _results)
+	{
+		double dRays = (double)m_iAngles * m_iDetectors;
+		double dVolumeBytes = 4.0 * m_iSize * m_iSize;
+		double dSinogramBytes = 4.0 * dRays;
+		double dMatrixBytes = 8.0 * m_dWeights + 8.0 * (dRays + 1);
+		bool bMatrixAllowed = dMatrixBytes <= m_options.iMatrixLimitMB * 1048576.0;
+
+		CForwardProjectionAlgorithm forwardProjection(m_pProjector, m_pVolume, m_pSinogram);
+		_bench(_results, "FP", _iThreads, dRays, 4.0 * m_dWeights + dSinogramBytes, [&]() {
+			forwardProjection.run();
+		});
+
+		if (CFanFlatRayTable::getMemorySize(m_iAngles, m_iDetectors) <= m_options.iMatrixLimitMB * 1048576.0) {
+			m_pProjector->setRayTableEnabled(true);
+			if (_bFirstThreadCount)
+				fprintf(stderr, "ray table: %.1f MB\n", m_pProjector->getRayTableMemorySize() / 1048576.0);
+			_bench(_results, "FPRayTable", _iThreads, dRays, 4.0 * m_dWeights + dSinogramBytes, [&]() {
+				forwardProjection.run();
+			});
+			m_pProjector->setRayTableEnabled(false);
+		}
+
+		if (_bFirstThreadCount) {
+			CDataProjectorInterface* pBackProjector = dispatchDataProjector(m_pProjector, DefaultBPPolicy(m_pOther, m_pSinogram));
+			_bench(_results, "BP", 1, dRays, 4.0 * m_dWeights + dSinogramBytes, [&]() {
+				pBackProjector->project();
+			});
+			delete pBackProjector;
+
+			if (bMatrixAllowed) {
+				_bench(_results, "GetMatrix", 1, dRays, dMatrixBytes, [&]() {
+					delete m_pMatrix;
+					m_pMatrix = m_pProjector->getMatrix();
+				});
+			}
+
+			_bench(_results, "UpdateStats", 1, 0.0, dVolumeBytes, [&]() {
+				m_pOther->updateStatistics();
+			});
+			_bench(_results, "AddData", 1, 0.0, 3.0 * dVolumeBytes, [&]() {
+				*m_pOther += *m_pVolume;
+			});
+			_bench(_results, "MulScalar", 1, 0.0, 2.0 * dVolumeBytes, [&]() {
+				*m_pOther *= 0.5f;
+			});
+			_bench(_results, "ClampMin", 1, 0.0, 2.0 * dVolumeBytes, [&]() {
+				float fMin = 0.25f;
+				m_pOther->clampMin(fMin);
+			});
+		}
+
+		if (bMatrixAllowed) {
+			if (!m_pMatrix)
+				m_pMatrix = m_pProjector->getMatrix();
+			if (m_pMatrix) {
+				double dBytes = 8.0 * m_pMatrix->m_plRowStarts[m_pMatrix->m_iHeight] + 8.0 * (dRays + 1) + dVolumeBytes + dSinogramBytes;
+				_bench(_results, "SpMV", _iThreads, dRays, dBytes, [&]() {
+					multiply(*m_pMatrix, m_pVolume->getDataConst(), m_pSinogram->getData());
+				});
+			}
+		}
+	}
+
+private:
+
+	void _bench(vector<SResult>& _results, const char* _pcFamily, int _iThreads,
+		double _dRays, double _dBytes, const function<void()>& _function)
+	{
+		if (!m_options.filter.empty() && m_options.filter != _pcFamily)
+			return;
+
+		char name[256];
+		snprintf(name, sizeof(name), "%s/size:%d/angles:%d/detectors:%d/threads:%d",
+			_pcFamily, m_iSize, m_iAngles, m_iDetectors, _iThreads);
+
+		SResult result;
+		result.name = name;
+		result.family = _pcFamily;
+		result.iSize = m_iSize;
+		result.iAngles = m_iAngles;
+		result.iDetectors = m_iDetectors;
+		result.iThreads = _iThreads;
+		result.dRays = _dRays;
+		result.dBytes = _dBytes;
+		measure(_function, m_options.iRepetitions, result);
+
+		fprintf(stderr, "%-60s %10.3f ms %8.2f GB/s\n", name, result.dMedian * 1e3, result.dBytes / result.dMedian / 1e9);
+		_results.push_back(result);
+	}
+
+	const SOptions& m_options;
+	int m_iSize, m_iAngles, m_iDetectors;
+	double m_dWeights;
+
+	CFanFlatProjectionGeometry2D* m_pProjectionGeometry;
+	CVolumeGeometry2D* m_pVolumeGeometry;
+	CFanFlatBeamLineKernelProjector2D* m_pProjector;
+	CFloat32VolumeData2D* m_pVolume;
+	CFloat32VolumeData2D* m_pOther;
+	CFloat32ProjectionData2D* m_pSinogram;
+	CSparseMatrix* m_pMatrix;
+};
+
+//----------------------------------------------------------------------------------------
+// Write the results as JSON
+static void writeJson(FILE* _pFile, const vector<SResult>& _results, const SOptions& _options)
+{
+	char date[64];
+	time_t now = time(0);
+	strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", localtime(&now));
+
+	fprintf(_pFile, "{\n  \"context\": {\n");
+	fprintf(_pFile, "    \"date\": \"%s\",\n", date);
+	fprintf(_pFile, "    \"num_cpus\": %u,\n", thread::hardware_concurrency());
+#ifdef NDEBUG
+	fprintf(_pFile, "    \"library_build_type\": \"release\",\n");
+#else
+	fprintf(_pFile, "    \"library_build_type\": \"debug\",\n");
+#endif
+	fprintf(_pFile, "    \"repetitions\": %d\n", _options.iRepetitions);
+	fprintf(_pFile, "  },\n  \"benchmarks\": [\n");
+
+	for (size_t i = 0; i < _results.size(); ++i) {
+		const SResult& r = _results[i];
+		fprintf(_pFile, "    {\n");
+		fprintf(_pFile, "      \"name\": \"%s\",\n", r.name.c_str());
+		fprintf(_pFile, "      \"run_name\": \"%s\",\n", r.name.c_str());
+		fprintf(_pFile, "      \"family\": \"%s\",\n", r.family.c_str());
+		fprintf(_pFile, "      \"size\": %d,\n", r.iSize);
+		fprintf(_pFile, "      \"angles\": %d,\n", r.iAngles);
+		fprintf(_pFile, "      \"detectors\": %d,\n", r.iDetectors);
+		fprintf(_pFile, "      \"threads\": %d,\n", r.iThreads);
+		fprintf(_pFile, "      \"repetitions\": %d,\n", r.iRepetitions);
+		fprintf(_pFile, "      \"real_time\": %.6f,\n", r.dMedian * 1e3);
+		fprintf(_pFile, "      \"real_time_mean\": %.6f,\n", r.dMean * 1e3);
+		fprintf(_pFile, "      \"real_time_stddev\": %.6f,\n", r.dStdDev * 1e3);
+		fprintf(_pFile, "      \"real_time_min\": %.6f,\n", r.dMin * 1e3);
+		fprintf(_pFile, "      \"time_unit\": \"ms\",\n");
+		fprintf(_pFile, "      \"rays_per_second\": %.6e,\n", r.dRays / r.dMedian);
+		fprintf(_pFile, "      \"bytes_per_second\": %.6e,\n", r.dBytes / r.dMedian);
+		fprintf(_pFile, "      \"gb_per_second\": %.4f\n", r.dBytes / r.dMedian / 1e9);
+		fprintf(_pFile, "    }%s\n", i + 1 < _results.size() ? "," : "");
+	}
+	fprintf(_pFile, "  ]\n}\n");
+}
+
+//----------------------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+	SOptions options;
+	options.sizes = parseList("128,256,512");
+	options.angles = parseList("180,720");
+	options.detectors = parseList("0");
+	options.iRepetitions = 5;
+	options.iMatrixLimitMB = 1024;
+
+	int iHardwareThreads = max(1u, thread::hardware_concurrency());
+	for (int i = 1; i < iHardwareThreads; i *= 2)
+		options.threads.push_back(i);
+	options.threads.push_back(iHardwareThreads);
+
+	for (int i = 1; i < argc; ++i) {
+		const char* pcArg = argv[i];
+		const char* pcValue = strchr(pcArg, '=');
+		if (strncmp(pcArg, "--", 2) != 0 || !pcValue) {
+			fprintf(stderr, "unknown argument %s\n", pcArg);
+			return 1;
+		}
+		string key(pcArg + 2, pcValue - pcArg - 2);
+		++pcValue;
+		if (key == "sizes") options.sizes = parseList(pcValue);
+		else if (key == "angles") options.angles = parseList(pcValue);
+		else if (key == "detectors") options.detectors = parseList(pcValue);
+		else if (key == "threads") options.threads = parseList(pcValue);
+		else if (key == "repetitions") options.iRepetitions = max(1, atoi(pcValue));
+		else if (key == "filter") options.filter = pcValue;
+		else if (key == "matrix_limit_mb") options.iMatrixLimitMB = atoi(pcValue);
+		else if (key == "out") options.out = pcValue;
+		else {
+			fprintf(stderr, "unknown argument %s\n", pcArg);
+			return 1;
+		}
+	}
+
+	vector<SResult> results;
+	for (size_t s = 0; s < options.sizes.size(); ++s) {
+		for (size_t a = 0; a < options.angles.size(); ++a) {
+			for (size_t d = 0; d < options.detectors.size(); ++d) {
+				int iSize = options.sizes[s];
+				int iDetectors = options.detectors[d] > 0 ? options.detectors[d] : (3 * iSize + 1) / 2;
+				CGeometryBenchmarks benchmarks(options, iSize, options.angles[a], iDetectors);
+				for (size_t t = 0; t < options.threads.size(); ++t) {
+					CThreadPool::getSingleton().setThreadCount(options.threads[t]);
+					benchmarks.run(options.threads[t], t == 0, results);
+				}
+			}
+		}
+	}
+
+	FILE* pFile = options.out.empty() ? stdout : fopen(options.out.c_str(), "w");
+	if (!pFile) {
+		fprintf(stderr, "cannot open %s\n", options.out.c_str());
+		return 1;
+	}
+	writeJson(pFile, results, options);
+	if (pFile != stdout)
+		fclose(pFile);
+	return 0;
+}
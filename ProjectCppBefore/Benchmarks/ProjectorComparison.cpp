@@ -0,0 +1,143 @@
+/**
+	* Throughput and accuracy of the fan beam projector kernels on the bundled Shepp-Logan
+	* phantom (modified_shepp_logan_512.bin, 512 x 512 doubles).
+	*
+	*   line     CFanFlatBeamLineKernelProjector2D
+	*   siddon   CFanFlatBeamSiddonKernelProjector2D, exact intersection lengths
+	*   joseph   CFanFlatBeamJosephKernelProjector2D
+	*   dd       CFanFlatBeamDistanceDrivenProjector2D, averaged over the detector pixel
+	*   strip    CFanFlatBeamStripKernelProjector2D, area integral over the detector pixel
+	*   blob     CFanFlatBeamBlobKernelProjector2D, the phantom as blob coefficients (smoother)
+	*
+	* Every kernel forward projects the phantom with CForwardProjectionAlgorithm::run(). The
+	* Siddon sinogram is the exact line integral of the pixelated phantom, so the error of the
+	* others is reported against it, as relative L2 norm and largest absolute difference.
+	* The result is printed as a markdown table.
+	*
+	* Usage: ProjectorComparison [phantom] [angles] [detectors] [repetitions]
+	*/
+
+#include "../FanFlatProjectionGeometry2D.h"
+#include "../FanFlatBeamLineKernelProjector2D.h"
+#include "../FanFlatBeamSiddonKernelProjector2D.h"
+#include "../FanFlatBeamJosephKernelProjector2D.h"
+#include "../FanFlatBeamDistanceDrivenProjector2D.h"
+#include "../FanFlatBeamStripKernelProjector2D.h"
+#include "../FanFlatBeamBlobKernelProjector2D.h"
+#include "../VolumeGeometry2D.h"
+#include "../Float32VolumeData2D.h"
+#include "../Float32ProjectionData2D.h"
+#include "../ForwardProjectionAlgorithm.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <vector>
+
+using namespace std;
+
+static const int SIZE = 512;
+
+
+//----------------------------------------------------------------------------------------
+// Best of _iRepetitions runs, in milliseconds
+template <typename TFunction>
+double time(int _iRepetitions, TFunction _function)
+{
+	double dBest = 1e30;
+	for (int r = 0; r < _iRepetitions; ++r) {
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		_function();
+		dBest = min(dBest, chrono::duration<double, milli>(chrono::steady_clock::now() - start).count());
+	}
+	return dBest;
+}
+
+struct SKernelResult {
+	const char* pcName;
+	double dMilliseconds;
+	vector<float> sinogram;
+};
+
+static SKernelResult runKernel(const char* _pcName, CProjector2D* _pProjector, CFloat32VolumeData2D* _pVolume,
+	CFanFlatProjectionGeometry2D* _pGeometry, int _iRepetitions)
+{
+	CFloat32ProjectionData2D sinogram(_pGeometry, 0.0f);
+	CForwardProjectionAlgorithm forwardProjection(_pProjector, _pVolume, &sinogram);
+
+	// warm up
+	forwardProjection.run();
+
+	SKernelResult result;
+	result.pcName = _pcName;
+	result.dMilliseconds = time(_iRepetitions, [&]() { forwardProjection.run(); });
+	result.sinogram.assign(sinogram.getDataConst(), sinogram.getDataConst() + sinogram.getSize());
+	return result;
+}
+
+//----------------------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+	const char* pcPhantom = argc > 1 ? argv[1] : "../modified_shepp_logan_512.bin";
+	int iAngles = argc > 2 ? atoi(argv[2]) : 720;
+	int iDetectors = argc > 3 ? atoi(argv[3]) : 768;
+	int iRepetitions = argc > 4 ? atoi(argv[4]) : 5;
+
+	vector<double> phantom(SIZE * SIZE);
+	ifstream fileIn(pcPhantom, ios::binary);
+	if (!fileIn.read(reinterpret_cast<char*>(&phantom[0]), sizeof(double) * phantom.size())) {
+		fprintf(stderr, "cannot read %d x %d phantom from %s\n", SIZE, SIZE, pcPhantom);
+		return 1;
+	}
+	vector<float> phantomf(phantom.begin(), phantom.end());
+
+	vector<float> angles(iAngles);
+	for (int i = 0; i < iAngles; ++i)
+		angles[i] = (float)(2.0 * M_PI * i / iAngles);
+
+	// source and detector far enough out for the volume, detector covers the fan
+	CFanFlatProjectionGeometry2D projectionGeometry(iAngles, iDetectors, 2.0f * SIZE / iDetectors, &angles[0], 2.0f * SIZE, 2.0f * SIZE);
+	CVolumeGeometry2D volumeGeometry(SIZE, SIZE);
+	CFloat32VolumeData2D volume(&volumeGeometry, &phantomf[0]);
+
+	CFanFlatBeamLineKernelProjector2D line(&projectionGeometry, &volumeGeometry);
+	CFanFlatBeamSiddonKernelProjector2D siddon(&projectionGeometry, &volumeGeometry);
+	CFanFlatBeamJosephKernelProjector2D joseph(&projectionGeometry, &volumeGeometry);
+	CFanFlatBeamDistanceDrivenProjector2D distanceDriven(&projectionGeometry, &volumeGeometry);
+	CFanFlatBeamStripKernelProjector2D strip(&projectionGeometry, &volumeGeometry);
+	CFanFlatBeamBlobKernelProjector2D blob(&projectionGeometry, &volumeGeometry);
+
+	vector<SKernelResult> results;
+	results.push_back(runKernel("siddon", &siddon, &volume, &projectionGeometry, iRepetitions));
+	results.push_back(runKernel("line", &line, &volume, &projectionGeometry, iRepetitions));
+	results.push_back(runKernel("joseph", &joseph, &volume, &projectionGeometry, iRepetitions));
+	results.push_back(runKernel("dd", &distanceDriven, &volume, &projectionGeometry, iRepetitions));
+	results.push_back(runKernel("strip", &strip, &volume, &projectionGeometry, iRepetitions));
+	results.push_back(runKernel("blob", &blob, &volume, &projectionGeometry, iRepetitions));
+
+	const vector<float>& reference = results[0].sinogram;
+	double dReferenceNorm = 0.0;
+	for (size_t i = 0; i < reference.size(); ++i)
+		dReferenceNorm += (double)reference[i] * reference[i];
+	dReferenceNorm = sqrt(dReferenceNorm);
+
+	printf("Shepp-Logan %d x %d, %d angles, %d detectors, best of %d\n\n", SIZE, SIZE, iAngles, iDetectors, iRepetitions);
+	printf("| kernel | FP time (ms) | Mrays/s | rel. L2 error vs siddon | max abs error vs siddon |\n");
+	printf("|--------|-------------:|--------:|------------------------:|------------------------:|\n");
+	for (size_t k = 0; k < results.size(); ++k) {
+		const SKernelResult& result = results[k];
+		double dError = 0.0, dMax = 0.0;
+		for (size_t i = 0; i < reference.size(); ++i) {
+			double d = (double)result.sinogram[i] - reference[i];
+			dError += d * d;
+			dMax = max(dMax, fabs(d));
+		}
+		printf("| %-6s | %12.1f | %7.2f | %23.3e | %23.3e |\n", result.pcName, result.dMilliseconds,
+			(double)iAngles * iDetectors / (result.dMilliseconds * 1e3), sqrt(dError) / dReferenceNorm, dMax);
+	}
+
+	return 0;
+}
@@ -0,0 +1,204 @@
+#include "CglsAlgorithm.h"
+
+#include "DataProjectorPolicies.h"
+#include "Float32VolumeData2DView.h"
+
+#include <cmath>
+
+#include "Projector2DImpl.inl"
+
+// type of the algorithm, needed to register with CAlgorithmFactory
+std::string CCglsAlgorithm::type = "CGLS";
+
+//----------------------------------------------------------------------------------------
+// Constructor - Default
+CCglsAlgorithm::CCglsAlgorithm()
+{
+	_clear();
+}
+
+//----------------------------------------------------------------------------------------
+// Constructor
+CCglsAlgorithm::CCglsAlgorithm(CProjector2D* _pProjector,
+	CFloat32ProjectionData2D* _pSinogram,
+	CFloat32VolumeData2D* _pReconstruction)
+{
+	_clear();
+	initialize(_pProjector, _pSinogram, _pReconstruction);
+}
+
+//----------------------------------------------------------------------------------------
+// Destructor
+CCglsAlgorithm::~CCglsAlgorithm()
+{
+	clear();
+}
+
+//---------------------------------------------------------------------------------------
+// Clear - Constructors
+void CCglsAlgorithm::_clear()
+{
+	m_pProjector = NULL;
+	m_pSinogram = NULL;
+	m_pReconstruction = NULL;
+	m_pR = NULL;
+	m_pQ = NULL;
+	m_pP = NULL;
+	m_pS = NULL;
+	m_pForwardProjectorX = NULL;
+	m_pForwardProjectorP = NULL;
+	m_pBackProjector = NULL;
+	m_dGamma = 0.0;
+	m_dSinogramNorm = 0.0;
+	m_dResidualNorm = 0.0;
+	m_fTolerance = 0.0f;
+	m_bStarted = false;
+	m_iIteration = 0;
+	m_bIsInitialized = false;
+}
+
+//---------------------------------------------------------------------------------------
+// Clear - Public
+void CCglsAlgorithm::clear()
+{
+	delete m_pForwardProjectorX;
+	delete m_pForwardProjectorP;
+	delete m_pBackProjector;
+	delete m_pR;
+	delete m_pQ;
+	delete m_pP;
+	delete m_pS;
+	float fTolerance = m_fTolerance;
+	_clear();
+	m_fTolerance = fTolerance;
+}
+
+//----------------------------------------------------------------------------------------
+// Check
+bool CCglsAlgorithm::_check()
+{
+	// check pointers
+	ASTRA_CONFIG_CHECK(m_pProjector, "CGLS", "Invalid Projector Object.");
+	ASTRA_CONFIG_CHECK(m_pSinogram, "CGLS", "Invalid Projection Data Object.");
+	ASTRA_CONFIG_CHECK(m_pReconstruction, "CGLS", "Invalid Reconstruction Data Object.");
+
+	// check initializations
+	ASTRA_CONFIG_CHECK(m_pProjector->isInitialized(), "CGLS", "Projector Object Not Initialized.");
+	ASTRA_CONFIG_CHECK(m_pSinogram->isInitialized(), "CGLS", "Projection Data Object Not Initialized.");
+	ASTRA_CONFIG_CHECK(m_pReconstruction->isInitialized(), "CGLS", "Reconstruction Data Object Not Initialized.");
+
+	// check compatibility between projector and data classes
+	ASTRA_CONFIG_CHECK(m_pSinogram->getGeometry()->isEqual(m_pProjector->getProjectionGeometry()), "CGLS", "Projection Data not compatible with the specified Projector.");
+	ASTRA_CONFIG_CHECK(m_pReconstruction->getGeometry()->isEqual(m_pProjector->getVolumeGeometry()), "CGLS", "Reconstruction Data not compatible with the specified Projector.");
+	ASTRA_CONFIG_CHECK(m_pReconstruction->getStride() == m_pProjector->getVolumeStride(), "CGLS", "Reconstruction Data row stride does not match the Projector, see CProjector2D::setVolumeStride.");
+
+	ASTRA_CONFIG_CHECK(m_pForwardProjectorX && m_pForwardProjectorP && m_pBackProjector, "CGLS", "Invalid FP/BP Policy");
+	ASTRA_CONFIG_CHECK(m_pP->getStride() == m_pProjector->getVolumeStride(), "CGLS", "Work volume row stride does not match the Projector, see CProjector2D::setVolumeStride.");
+
+	// success
+	return true;
+}
+
+//----------------------------------------------------------------------------------------
+// Initialize
+bool CCglsAlgorithm::initialize(CProjector2D* _pProjector,
+	CFloat32ProjectionData2D* _pSinogram,
+	CFloat32VolumeData2D* _pReconstruction)
+{
+	clear();
+
+	// store classes
+	m_pProjector = _pProjector;
+	m_pSinogram = _pSinogram;
+	m_pReconstruction = _pReconstruction;
+
+	if (m_pProjector && m_pSinogram && m_pReconstruction && m_pSinogram->isInitialized() && m_pReconstruction->isInitialized()) {
+		// work vectors, with the row stride of the projector
+		m_pR = new CFloat32ProjectionData2D(m_pSinogram->getGeometry(), 0.0f);
+		m_pQ = new CFloat32ProjectionData2D(m_pSinogram->getGeometry(), 0.0f);
+		m_pP = new CFloat32VolumeData2DView(m_pReconstruction->getGeometry(), m_pProjector->getVolumeStride(), 0.0f);
+		m_pS = new CFloat32VolumeData2DView(m_pReconstruction->getGeometry(), m_pProjector->getVolumeStride(), 0.0f);
+
+		m_pForwardProjectorX = dispatchDataProjector(m_pProjector, DefaultFPPolicy(m_pReconstruction, m_pR));
+		m_pForwardProjectorP = dispatchDataProjector(m_pProjector, DefaultFPPolicy(m_pP, m_pQ));
+		m_pBackProjector = dispatchDataProjector(m_pProjector, DefaultBPPolicy(m_pS, m_pR));
+	}
+
+	// return success
+	m_bIsInitialized = _check();
+	return m_bIsInitialized;
+}
+
+//----------------------------------------------------------------------------------------
+// Start
+void CCglsAlgorithm::_start()
+{
+	// r = b - A x
+	m_pForwardProjectorX->projectParallel();
+	*m_pR *= -1.0f;
+	*m_pR += *m_pSinogram;
+
+	// p = s = A^T r
+	m_pS->setData(0.0f);
+	m_pBackProjector->project();
+	*m_pP = *m_pS;
+
+	m_dGamma = m_pS->squaredNorm();
+	m_dSinogramNorm = sqrt(m_pSinogram->squaredNorm());
+	m_dResidualNorm = sqrt(m_pR->squaredNorm());
+	m_iIteration = 0;
+	m_bStarted = true;
+}
+
+//----------------------------------------------------------------------------------------
+// Iterate
+void CCglsAlgorithm::run(int _iNrIterations)
+{
+	// check initialized
+	ASTRA_ASSERT(m_bIsInitialized);
+
+	ASTRA_RECORD(m_instrumentation);
+
+	m_control.beginRun();
+	m_control.addTotal(_iNrIterations);
+
+	if (!m_bStarted)
+		_start();
+
+	for (int iIteration = 0; iIteration < _iNrIterations; ++iIteration) {
+		if (m_control.checkAbort())
+			return;
+
+		// converged, or nothing left to do (A^T r == 0)
+		if (m_dResidualNorm <= m_fTolerance * m_dSinogramNorm || m_dGamma <= 0.0)
+			return;
+
+		// q = A p
+		m_pForwardProjectorP->projectParallel();
+
+		// alpha = ||A^T r||^2 / ||A p||^2
+		double dQNorm = m_pQ->squaredNorm();
+		if (dQNorm <= 0.0)
+			return;
+		float fAlpha = (float)(m_dGamma / dQNorm);
+
+		// x += alpha p, r -= alpha q
+		m_pReconstruction->addScaled(fAlpha, *m_pP);
+		m_pR->addScaled(-fAlpha, *m_pQ);
+		m_dResidualNorm = sqrt(m_pR->squaredNorm());
+
+		// s = A^T r
+		m_pS->setData(0.0f);
+		m_pBackProjector->project();
+
+		// p = s + beta p
+		double dGamma = m_pS->squaredNorm();
+		float fBeta = (float)(dGamma / m_dGamma);
+		m_pP->scaleAndAdd(fBeta, *m_pS);
+		m_dGamma = dGamma;
+
+		++m_iIteration;
+		m_control.advance(1);
+	}
+}
+//----------------------------------------------------------------------------------------
@@ -0,0 +1,167 @@
+#ifndef _INC_ASTRA_CGLSALGORITHM
+#define _INC_ASTRA_CGLSALGORITHM
+
+#include "Algorithm.h"
+
+#include "Globals.h"
+
+#include "Projector2D.h"
+#include "Float32ProjectionData2D.h"
+#include "Float32VolumeData2D.h"
+
+#include "DataProjector.h"
+
+/**
+	* \brief
+	* This class contains the implementation of the CGLS algorithm, conjugate gradients on the
+	* normal equations A^T A x = A^T b, with A the forward projection of the projector and A^T
+	* its backprojection.
+	*
+	* Every iteration takes one forward projection (angle-parallel on the thread pool), one
+	* backprojection and a few fused vector updates. The Krylov state is kept between calls
+	* of run(), so run(10) twice is the same as run(20). The initial content of the
+	* reconstruction is the starting point (warm start); call restart() after changing the
+	* reconstruction between runs.
+	*
+	* run() stops early when the residual norm ||b - A x|| drops below the tolerance times
+	* ||b||, see setTolerance().
+	*
+	* The reconstruction may be a view, with the projector set up for its stride; the volume
+	* work vectors then get the same stride.
+	*/
+class CCglsAlgorithm : public CAlgorithm {
+
+protected:
+
+	/** Initial clearing. Only to be used by constructors.
+		*/
+	virtual void _clear();
+
+	/** Check the values of this object.  If everything is ok, the object can be set to the initialized state.
+		* The following statements are then guaranteed to hold:
+		* - valid projector
+		* - valid data objects
+		*/
+	virtual bool _check();
+
+	/** Set up the Krylov state from the current reconstruction: r = b - A x, p = A^T r.
+		*/
+	void _start();
+
+	//< Projector object.
+	CProjector2D* m_pProjector;
+	//< ProjectionData2D object containing the sinogram.
+	CFloat32ProjectionData2D* m_pSinogram;
+	//< VolumeData2D object for storing the reconstruction.
+	CFloat32VolumeData2D* m_pReconstruction;
+
+	//< Residual b - A x
+	CFloat32ProjectionData2D* m_pR;
+	//< A p
+	CFloat32ProjectionData2D* m_pQ;
+	//< Search direction
+	CFloat32VolumeData2D* m_pP;
+	//< A^T r
+	CFloat32VolumeData2D* m_pS;
+
+	//< Data projectors: x -> A x, p -> q, r -> s
+	CDataProjectorInterface* m_pForwardProjectorX;
+	CDataProjectorInterface* m_pForwardProjectorP;
+	CDataProjectorInterface* m_pBackProjector;
+
+	//< ||A^T r||^2 of the current residual
+	double m_dGamma;
+	//< ||b||, ||r|| of the current residual
+	double m_dSinogramNorm;
+	double m_dResidualNorm;
+	//< Relative residual norm to stop at, 0 for none
+	float m_fTolerance;
+	//< Is the Krylov state set up?
+	bool m_bStarted;
+	//< Iterations done since the last (re)start
+	int m_iIteration;
+
+public:
+
+	// type of the algorithm, needed to register with CAlgorithmFactory
+	static std::string type;
+
+	/** Default constructor, containing no code.
+		*/
+	CCglsAlgorithm();
+
+	/** Initializing constructor.
+		*
+		* @param _pProjector		Projector to use.
+		* @param _pSinogram		ProjectionData2D object containing the sinogram to reconstruct.
+		* @param _pReconstruction	VolumeData2D object containing the starting point, updated in place.
+		*/
+	CCglsAlgorithm(CProjector2D* _pProjector,
+		CFloat32ProjectionData2D* _pSinogram,
+		CFloat32VolumeData2D* _pReconstruction);
+
+	/** Destructor.
+		*/
+	virtual ~CCglsAlgorithm();
+
+	/** Clear this class.
+		*/
+	virtual void clear();
+
+	/** Initialize class.
+		*
+		* @param _pProjector		Projector to use.
+		* @param _pSinogram		ProjectionData2D object containing the sinogram to reconstruct.
+		* @param _pReconstruction	VolumeData2D object containing the starting point, updated in place.
+		* @return success
+		*/
+	bool initialize(CProjector2D* _pProjector,
+		CFloat32ProjectionData2D* _pSinogram,
+		CFloat32VolumeData2D* _pReconstruction);
+
+	/** Set the stopping tolerance: run() returns once ||b - A x|| <= _fTolerance * ||b||.
+		*
+		* @param _fTolerance relative residual norm, 0 (default) to always do all iterations
+		*/
+	void setTolerance(float _fTolerance);
+
+	/** Get the stopping tolerance.
+		*/
+	float getTolerance() const;
+
+	/** Restart from the current content of the reconstruction on the next run().
+		*/
+	void restart();
+
+	/** Get the relative residual norm ||b - A x|| / ||b|| after the last iteration.
+		*/
+	double getRelativeResidualNorm() const;
+
+	/** Get the number of iterations done since the last (re)start.
+		*/
+	int getIterationCount() const;
+
+	/** Perform a number of iterations, fewer if the tolerance is reached.
+		*
+		* @param _iNrIterations amount of iterations to perform.
+		*/
+	virtual void run(int _iNrIterations = 0);
+
+	/** Get a description of the class.
+		*
+		* @return description string
+		*/
+	virtual std::string description() const;
+
+};
+
+// inline functions
+inline std::string CCglsAlgorithm::description() const { return CCglsAlgorithm::type; };
+inline void CCglsAlgorithm::setTolerance(float _fTolerance) { m_fTolerance = _fTolerance; }
+inline float CCglsAlgorithm::getTolerance() const { return m_fTolerance; }
+inline void CCglsAlgorithm::restart() { m_bStarted = false; }
+inline double CCglsAlgorithm::getRelativeResidualNorm() const { return m_dSinogramNorm > 0.0 ? m_dResidualNorm / m_dSinogramNorm : 0.0; }
+inline int CCglsAlgorithm::getIterationCount() const { return m_iIteration; }
+
+
+#endif
@@ -1 +1,45 @@
 #include "DataProjector.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+
+//----------------------------------------------------------------------------------------
+// Project in parallel angle blocks
+bool CDataProjectorInterface::projectParallel(int _iAngleBlockSize)
+{
+	int iAngleCount = getAngleCount();
+	int iBlockSize = std::max(1, _iAngleBlockSize);
+	CProjectionControl* pControl = m_pControl;
+
+	if (!pControl && !isAngleParallel()) {
+		project();
+		return true;
+	}
+
+	if (pControl)
+		pControl->addTotal(iAngleCount);
+
+	if (!isAngleParallel()) {
+		for (int iFrom = 0; iFrom < iAngleCount; iFrom += iBlockSize) {
+			if (pControl->checkAbort())
+				return false;
+			int iTo = std::min(iFrom + iBlockSize, iAngleCount);
+			projectAngleRange(iFrom, iTo);
+			pControl->advance(iTo - iFrom);
+		}
+		return true;
+	}
+
+	std::atomic<bool> bAborted(false);
+	parallelFor(0, iAngleCount, iBlockSize, [this, pControl, &bAborted](int _iFrom, int _iTo) {
+		if (pControl && pControl->checkAbort()) {
+			bAborted.store(true, std::memory_order_relaxed);
+			return;
+		}
+		projectAngleRange(_iFrom, _iTo);
+		if (pControl)
+			pControl->advance(_iTo - _iFrom);
+	});
+	return !bAborted.load();
+}
@@ -9,18 +9,60 @@
 
 #include "DataProjectorPolicies.h"
 
+#include "ProjectionControl.h"
+
+#include "RayWeightCache.h"
+
+#include <type_traits>
+
 /**
 	* Interface class for the Data Projector. The sole purpose of this class is to force child classes to implement a series of methods
 	*/
 class CDataProjectorInterface {
 public:
-	CDataProjectorInterface() { }
+	CDataProjectorInterface() : m_pControl(NULL) { }
 	virtual ~CDataProjectorInterface() { }
 	virtual void project() = 0;
 	virtual void projectSingleProjection(int _iProjection) = 0;
 	virtual void projectSingleRay(int _iProjection, int _iDetector) = 0;
 	//	virtual void projectSingleVoxel(int _iRow, int _iCol) = 0;
 	//	virtual void projectAllVoxels() = 0;
+
+	/** Number of projection angles of the projector.
+		*/
+	virtual int getAngleCount() = 0;
+
+	/** Project the angles _iFrom (inclusive) to _iTo (exclusive), all detectors.
+		*/
+	virtual void projectAngleRange(int _iFrom, int _iTo) = 0;
+
+	/** Can disjoint angle ranges be projected at the same time? See PolicyAngleParallel.
+		*/
+	virtual bool isAngleParallel() const = 0;
+
+	/** Default number of angles per task of projectParallel().
+		*/
+	static const int DEFAULT_ANGLE_BLOCK_SIZE = 8;
+
+	/** Project all angles. If the policy allows it, blocks of _iAngleBlockSize angles are
+		* scheduled as tasks on the shared CThreadPool; otherwise they run one after the other
+		* on the calling thread. The result is identical in both cases.
+		*
+		* If a CProjectionControl is set, its abort flag is checked before every block and its
+		* progress is advanced after every block.
+		*
+		* @return false if the projection was aborted before all blocks were done
+		*/
+	bool projectParallel(int _iAngleBlockSize = DEFAULT_ANGLE_BLOCK_SIZE);
+
+	/** Set the cancellation and progress state to use in projectParallel(), NULL for none.
+		* Not owned.
+		*/
+	void setControl(CProjectionControl* _pControl) { m_pControl = _pControl; }
+
+protected:
+
+	CProjectionControl* m_pControl;
 };
 
 /**
@@ -50,6 +92,23 @@ public:
 	//	virtual void projectSingleVoxel(int _iRow, int _iCol);
 
 	//	virtual void projectAllVoxels();
+
+	virtual int getAngleCount();
+
+	virtual void projectAngleRange(int _iFrom, int _iTo);
+
+	virtual bool isAngleParallel() const;
+
+private:
+
+	/** Ray weight cache of the projector, if it has one and the policy steps in float (the
+		* weights of double stepping differ from the cached ones). NULL otherwise.
+		*/
+	CRayWeightCache* _getRayWeightCache() const;
+
+	/** Project a range of angles with the weights from the cache.
+		*/
+	void _projectCached(CRayWeightCache* _pCache, int _iFrom, int _iTo, Policy& _policy);
 };
 
 //----------------------------------------------------------------------------------------
@@ -80,7 +139,10 @@ CDataProjector<Projector, Policy>::~CDataProjector()
 template <typename Projector, typename Policy>
 void CDataProjector<Projector, Policy>::project()
 {
-	m_pProjector->project(m_pPolicy);
+	if (CRayWeightCache* pCache = _getRayWeightCache())
+		_projectCached(pCache, 0, getAngleCount(), m_pPolicy);
+	else
+		m_pProjector->project(m_pPolicy);
 }
 
 //----------------------------------------------------------------------------------------
@@ -90,7 +152,10 @@ void CDataProjector<Projector, Policy>::project()
 template <typename Projector, typename Policy>
 void CDataProjector<Projector, Policy>::projectSingleProjection(int _iProjection)
 {
-	m_pProjector->projectSingleProjection(_iProjection, m_pPolicy);
+	if (CRayWeightCache* pCache = _getRayWeightCache())
+		_projectCached(pCache, _iProjection, _iProjection + 1, m_pPolicy);
+	else
+		m_pProjector->projectSingleProjection(_iProjection, m_pPolicy);
 }
 
 //----------------------------------------------------------------------------------------
@@ -103,6 +168,75 @@ void CDataProjector<Projector, Policy>::projectSingleRay(int _iProjection, int _
 	m_pProjector->projectSingleRay(_iProjection, _iDetector, m_pPolicy);
 }
 
+//----------------------------------------------------------------------------------------
+/**
+	* Number of projection angles
+*/
+template <typename Projector, typename Policy>
+int CDataProjector<Projector, Policy>::getAngleCount()
+{
+	return m_pProjector->getProjectionGeometry()->getProjectionAngleCount();
+}
+
+//----------------------------------------------------------------------------------------
+/**
+	* Compute a range of projections. Angle-parallel policies are copied, so that concurrent
+	* ranges do not share policy state.
+*/
+template <typename Projector, typename Policy>
+void CDataProjector<Projector, Policy>::projectAngleRange(int _iFrom, int _iTo)
+{
+	CRayWeightCache* pCache = _getRayWeightCache();
+	if (PolicyAngleParallel<Policy>::value) {
+		Policy policy = m_pPolicy;
+		if (pCache)
+			_projectCached(pCache, _iFrom, _iTo, policy);
+		else
+			m_pProjector->projectAngleRange(_iFrom, _iTo, policy);
+	}
+	else {
+		if (pCache)
+			_projectCached(pCache, _iFrom, _iTo, m_pPolicy);
+		else
+			m_pProjector->projectAngleRange(_iFrom, _iTo, m_pPolicy);
+	}
+}
+
+//----------------------------------------------------------------------------------------
+/**
+	* Can angle ranges be projected concurrently?
+*/
+template <typename Projector, typename Policy>
+bool CDataProjector<Projector, Policy>::isAngleParallel() const
+{
+	return PolicyAngleParallel<Policy>::value;
+}
+
+//----------------------------------------------------------------------------------------
+/**
+	* Ray weight cache to use, if any
+*/
+template <typename Projector, typename Policy>
+CRayWeightCache* CDataProjector<Projector, Policy>::_getRayWeightCache() const
+{
+	if (!std::is_same<typename PolicyStepType<Policy>::type, float>::value)
+		return NULL;
+	return m_pProjector->getRayWeightCache();
+}
+
+//----------------------------------------------------------------------------------------
+/**
+	* Project a range of angles with cached weights
+*/
+template <typename Projector, typename Policy>
+void CDataProjector<Projector, Policy>::_projectCached(CRayWeightCache* _pCache, int _iFrom, int _iTo, Policy& _policy)
+{
+	for (int iProjection = _iFrom; iProjection < _iTo; ++iProjection) {
+		std::shared_ptr<const SProjectionWeights> pWeights = _pCache->getProjectionWeights(iProjection);
+		projectCachedWeights(*pWeights, iProjection, _policy);
+	}
+}
+
 //----------------------------------------------------------------------------------------
 //template <typename Projector, typename Policy>
 //void CDataProjector<Projector,Policy>::projectSingleVoxel(int _iRow, int _iCol) 
@@ -213,7 +347,6 @@ static CDataProjectorInterface* dispatchDataProjector(CProjector2D* _pProjector,
 		return dispatchDataProjector(_pProjector, _policy1, _policy2, _bUsePolicy1, _bUsePolicy2);
 	}
 	else {
-		std::cout << "combined" << std::endl;
 		return dispatchDataProjector(_pProjector, Combine3Policy<Policy1, Policy2, Policy3>(_policy1, _policy2, _policy3));
 	}
 }
@@ -7,11 +7,52 @@
 
 #include "Float32ProjectionData2D.h"
 #include "Float32VolumeData2D.h"
+#include "HalfData2D.h"
+#include "Accumulator.h"
 
 
 //enum {PixelDrivenPolicy, RayDrivenPolicy, AllPolicy} PolicyType;
 
 
+//----------------------------------------------------------------------------------------
+/** Step type of a policy: the floating point type the projector uses for its incremental
+	* ray stepping. A policy selects double stepping with "typedef double StepType;",
+	* all other policies step in float.
+	*/
+template<typename P>
+struct PolicyStepType {
+	template<typename U> static char test(typename U::StepType*);
+	template<typename U> static long test(...);
+
+	template<bool bHasStepType, typename U> struct select { typedef float type; };
+	template<typename U> struct select<true, U> { typedef typename U::StepType type; };
+
+	typedef typename select<sizeof(test<P>(0)) == sizeof(char), P>::type type;
+};
+
+/** The wider of two step types.
+	*/
+template<typename A, typename B> struct WiderStepType { typedef double type; };
+template<> struct WiderStepType<float, float> { typedef float type; };
+
+/** Can disjoint ranges of angles be projected concurrently with copies of a policy?
+	* This holds for policies that only write to data of the ray they are called for
+	* (or write nothing), and keep no state across rays. Such a policy declares
+	* "enum { AngleParallel = 1 };"; all other policies are projected on one thread.
+	*/
+template<typename P>
+struct PolicyAngleParallel {
+	template<typename U, int> struct probe { };
+	template<typename U> static char test(probe<U, U::AngleParallel>*);
+	template<typename U> static long test(...);
+
+	template<bool bHasFlag, typename U> struct select { enum { value = 0 }; };
+	template<typename U> struct select<true, U> { enum { value = U::AngleParallel }; };
+
+	enum { value = select<sizeof(test<P>(0)) == sizeof(char), P>::value };
+};
+
+
 //----------------------------------------------------------------------------------------
 /** Policy for Default Forward Projection (Ray Driven)
 	*/
@@ -23,6 +64,8 @@ class DefaultFPPolicy {
 	CFloat32VolumeData2D* m_pVolumeData;
 
 public:
+
+	enum { AngleParallel = 1 };
 	FORCEINLINE DefaultFPPolicy();
 	FORCEINLINE DefaultFPPolicy(CFloat32VolumeData2D* _pVolumeData, CFloat32ProjectionData2D* _pProjectionData);
 	FORCEINLINE ~DefaultFPPolicy();
@@ -70,6 +113,8 @@ class DiffFPPolicy {
 	CFloat32VolumeData2D* m_pVolumeData;
 public:
 
+	enum { AngleParallel = 1 };
+
 	FORCEINLINE DiffFPPolicy();
 	FORCEINLINE DiffFPPolicy(CFloat32VolumeData2D* _vol_data, CFloat32ProjectionData2D* _proj_data, CFloat32ProjectionData2D* _proj_data_base);
 	FORCEINLINE ~DiffFPPolicy();
@@ -106,6 +151,33 @@ public:
 };
 
 
+//----------------------------------------------------------------------------------------
+/** Store Pixel Weights (Ray+Pixel Driven), with the volume indices and the weights in
+	* separate arrays, such as the column indices and values of a CSparseMatrix.
+	*/
+class StoreSplitPixelWeightsPolicy {
+
+	int* m_piIndices;
+	float* m_pfWeights;
+	int m_iMaxPixelCount;
+	int m_iStoredPixelCount;
+
+public:
+
+	FORCEINLINE StoreSplitPixelWeightsPolicy();
+	FORCEINLINE StoreSplitPixelWeightsPolicy(int* _piIndices, float* _pfWeights, int _iMaxPixelCount);
+	FORCEINLINE ~StoreSplitPixelWeightsPolicy();
+
+	FORCEINLINE bool rayPrior(int _iRayIndex);
+	FORCEINLINE bool pixelPrior(int _iVolumeIndex);
+	FORCEINLINE void addWeight(int _iRayIndex, int _iVolumeIndex, float _fWeight);
+	FORCEINLINE void rayPosterior(int _iRayIndex);
+	FORCEINLINE void pixelPosterior(int _iVolumeIndex);
+
+	FORCEINLINE int getStoredPixelCount();
+};
+
+
 //----------------------------------------------------------------------------------------
 /** Policy For Calculating the Total Pixel Weight Multiplied by Sinogram
 	*/
@@ -156,6 +228,8 @@ class TotalRayLengthPolicy {
 
 public:
 
+	enum { AngleParallel = 1 };
+
 	FORCEINLINE TotalRayLengthPolicy();
 	FORCEINLINE TotalRayLengthPolicy(CFloat32ProjectionData2D* _pRayLength);
 	FORCEINLINE ~TotalRayLengthPolicy();
@@ -179,6 +253,9 @@ class CombinePolicy {
 
 public:
 
+	typedef typename WiderStepType<typename PolicyStepType<P1>::type, typename PolicyStepType<P2>::type>::type StepType;
+	enum { AngleParallel = PolicyAngleParallel<P1>::value && PolicyAngleParallel<P2>::value };
+
 	FORCEINLINE CombinePolicy();
 	FORCEINLINE CombinePolicy(P1 _policy1, P2 _policy2);
 	FORCEINLINE ~CombinePolicy();
@@ -202,6 +279,9 @@ class Combine3Policy {
 
 public:
 
+	typedef typename WiderStepType<typename PolicyStepType<P1>::type, typename WiderStepType<typename PolicyStepType<P2>::type, typename PolicyStepType<P3>::type>::type>::type StepType;
+	enum { AngleParallel = PolicyAngleParallel<P1>::value && PolicyAngleParallel<P2>::value && PolicyAngleParallel<P3>::value };
+
 	FORCEINLINE Combine3Policy();
 	FORCEINLINE Combine3Policy(P1 _policy1, P2 _policy2, P3 _policy3);
 	FORCEINLINE ~Combine3Policy();
@@ -226,6 +306,9 @@ class Combine4Policy {
 
 public:
 
+	typedef typename WiderStepType<typename PolicyStepType<P1>::type, typename WiderStepType<typename PolicyStepType<P2>::type, typename WiderStepType<typename PolicyStepType<P3>::type, typename PolicyStepType<P4>::type>::type>::type>::type StepType;
+	enum { AngleParallel = PolicyAngleParallel<P1>::value && PolicyAngleParallel<P2>::value && PolicyAngleParallel<P3>::value && PolicyAngleParallel<P4>::value };
+
 	FORCEINLINE Combine4Policy();
 	FORCEINLINE Combine4Policy(P1 _policy1, P2 _policy2, P3 _policy3, P4 _policy4);
 	FORCEINLINE ~Combine4Policy();
@@ -248,6 +331,9 @@ class CombineListPolicy {
 
 public:
 
+	typedef typename PolicyStepType<P>::type StepType;
+	enum { AngleParallel = PolicyAngleParallel<P>::value };
+
 	FORCEINLINE CombineListPolicy();
 	FORCEINLINE CombineListPolicy(std::vector<P> _policyList);
 	FORCEINLINE ~CombineListPolicy();
@@ -268,6 +354,8 @@ class EmptyPolicy {
 
 public:
 
+	enum { AngleParallel = 1 };
+
 	FORCEINLINE EmptyPolicy();
 	FORCEINLINE ~EmptyPolicy();
 
@@ -314,6 +402,8 @@ class SinogramMaskPolicy {
 
 public:
 
+	enum { AngleParallel = 1 };
+
 	FORCEINLINE SinogramMaskPolicy();
 	FORCEINLINE SinogramMaskPolicy(CFloat32ProjectionData2D* _pSinogramMask);
 	FORCEINLINE ~SinogramMaskPolicy();
@@ -334,6 +424,8 @@ class ReconstructionMaskPolicy {
 
 public:
 
+	enum { AngleParallel = 1 };
+
 	FORCEINLINE ReconstructionMaskPolicy();
 	FORCEINLINE ReconstructionMaskPolicy(CFloat32VolumeData2D* _pReconstructionMask);
 	FORCEINLINE ~ReconstructionMaskPolicy();
@@ -345,6 +437,158 @@ public:
 	FORCEINLINE void pixelPosterior(int _iVolumeIndex);
 };
 
+//----------------------------------------------------------------------------------------
+/** Policy for Forward Projection from/to 16-bit storage (Ray Driven)
+	*
+	* Reads the volume from a CFloat16Data2D or CBFloat16Data2D, accumulates each ray
+	* in a float32 register and rounds once when the ray is stored in the 16-bit sinogram.
+	*/
+template<typename T>
+class HalfFPPolicy {
+
+	//< Projection Data
+	CHalfData2D<T>* m_pProjectionData;
+	//< Volume Data
+	CHalfData2D<T>* m_pVolumeData;
+	//< Sum of the current ray
+	float m_fRaySum;
+
+public:
+
+	enum { AngleParallel = 1 };
+
+	FORCEINLINE HalfFPPolicy();
+	FORCEINLINE HalfFPPolicy(CHalfData2D<T>* _pVolumeData, CHalfData2D<T>* _pProjectionData);
+	FORCEINLINE ~HalfFPPolicy();
+
+	FORCEINLINE bool rayPrior(int _iRayIndex);
+	FORCEINLINE bool pixelPrior(int _iVolumeIndex);
+	FORCEINLINE void addWeight(int _iRayIndex, int _iVolumeIndex, float weight);
+	FORCEINLINE void rayPosterior(int _iRayIndex);
+	FORCEINLINE void pixelPosterior(int _iVolumeIndex);
+};
+
+//----------------------------------------------------------------------------------------
+/** Policy for Back Projection from 16-bit storage (Ray+Pixel Driven)
+	*
+	* Reads the sinogram from a CFloat16Data2D or CBFloat16Data2D and accumulates into a
+	* float32 volume. Accumulating into 16-bit storage would round after every ray, so the
+	* result stays float32; convert it with CHalfData2D::initialize() when done.
+	*/
+template<typename T>
+class HalfBPPolicy {
+
+	//< Projection Data
+	CHalfData2D<T>* m_pProjectionData;
+	//< Volume Data
+	CFloat32VolumeData2D* m_pVolumeData;
+
+public:
+
+	FORCEINLINE HalfBPPolicy();
+	FORCEINLINE HalfBPPolicy(CFloat32VolumeData2D* _pVolumeData, CHalfData2D<T>* _pProjectionData);
+	FORCEINLINE ~HalfBPPolicy();
+
+	FORCEINLINE bool rayPrior(int _iRayIndex);
+	FORCEINLINE bool pixelPrior(int _iVolumeIndex);
+	FORCEINLINE void addWeight(int _iRayIndex, int _iVolumeIndex, float weight);
+	FORCEINLINE void rayPosterior(int _iRayIndex);
+	FORCEINLINE void pixelPosterior(int _iVolumeIndex);
+};
+
+//----------------------------------------------------------------------------------------
+/** Policy for Forward Projection with a wider ray accumulator (Ray Driven)
+	*
+	* Same result as DefaultFPPolicy, but each ray is summed in a TAccumulator (see Accumulator.h)
+	* and added to the sinogram once in rayPosterior. TStep is the type the projector uses for
+	* its incremental ray stepping. Storage stays float32. Use it for long rays through large
+	* volumes, where float32 summation and stepping error grows with the number of pixels crossed.
+	*/
+template<typename TAccumulator, typename TStep = float>
+class AccumulatingFPPolicy {
+
+	//< Projection Data
+	CFloat32ProjectionData2D* m_pProjectionData;
+	//< Volume Data
+	CFloat32VolumeData2D* m_pVolumeData;
+	//< Sum of the current ray
+	TAccumulator m_accumulator;
+
+public:
+
+	enum { AngleParallel = 1 };
+
+	typedef TStep StepType;
+
+	FORCEINLINE AccumulatingFPPolicy();
+	FORCEINLINE AccumulatingFPPolicy(CFloat32VolumeData2D* _pVolumeData, CFloat32ProjectionData2D* _pProjectionData);
+	FORCEINLINE ~AccumulatingFPPolicy();
+
+	FORCEINLINE bool rayPrior(int _iRayIndex);
+	FORCEINLINE bool pixelPrior(int _iVolumeIndex);
+	FORCEINLINE void addWeight(int _iRayIndex, int _iVolumeIndex, float weight);
+	FORCEINLINE void rayPosterior(int _iRayIndex);
+	FORCEINLINE void pixelPosterior(int _iVolumeIndex);
+};
+
+/** Forward projection with float64 accumulation and float64 ray stepping.
+	*/
+typedef AccumulatingFPPolicy<SDoubleAccumulator, double> DoubleFPPolicy;
+
+/** Forward projection with compensated float32 accumulation and float32 ray stepping.
+	*/
+typedef AccumulatingFPPolicy<SKahanAccumulator, float> KahanFPPolicy;
+
+//----------------------------------------------------------------------------------------
+/** Policy for Forward Projection of a block of slices at once (Ray Driven)
+	*
+	* The volume holds SLICE_LANES slices interleaved, the values of volume index i at
+	* [i * SLICE_LANES, (i + 1) * SLICE_LANES), so every weight the projector computes is
+	* applied to all slices of the block with one vector multiply-add. Each ray is summed
+	* per slice and stored in rayPosterior into the [slice][ray] sinograms of the block.
+	*
+	* The block is read through a pointer, so the caller can move a data projector on to
+	* the next block of slices by changing the SBlock it was made with.
+	*/
+class SliceStackFPPolicy {
+
+public:
+
+	enum { SLICE_LANES = 8 };
+
+	struct SBlock {
+		//< Interleaved volume, SLICE_LANES values per volume index
+		const float* m_pVolume;
+		//< Sinogram of the first slice of the block, the others follow
+		float* m_pSinograms;
+		//< Number of slices in the block, at most SLICE_LANES
+		int m_iSliceCount;
+		//< Number of rays of one sinogram
+		int m_iRayCount;
+	};
+
+private:
+
+	//< Current block
+	const SBlock* m_pBlock;
+	//< Sums of the current ray, one per slice
+	float m_fRaySums[SLICE_LANES];
+
+public:
+
+	enum { AngleParallel = 1 };
+
+	FORCEINLINE SliceStackFPPolicy();
+	FORCEINLINE SliceStackFPPolicy(const SBlock* _pBlock);
+	FORCEINLINE ~SliceStackFPPolicy();
+
+	FORCEINLINE bool rayPrior(int _iRayIndex);
+	FORCEINLINE bool pixelPrior(int _iVolumeIndex);
+	FORCEINLINE void addWeight(int _iRayIndex, int _iVolumeIndex, float weight);
+	FORCEINLINE void rayPosterior(int _iRayIndex);
+	FORCEINLINE void pixelPosterior(int _iVolumeIndex);
+};
+
 //----------------------------------------------------------------------------------------
 
 #include "DataProjectorPolicies.inl"
@@ -1,9 +1,6 @@
 #ifndef _INC_ASTRA_DATAPROJECTORPOLICIES_INLINE
 #define _INC_ASTRA_DATAPROJECTORPOLICIES_INLINE
 
-#include <iostream>
-
-
 
 //----------------------------------------------------------------------------------------
 // DEFAULT FORWARD PROJECTION (Ray Driven)
@@ -18,8 +15,6 @@ DefaultFPPolicy::DefaultFPPolicy(CFloat32VolumeData2D* _pVolumeData,
 {
 	m_pProjectionData = _pProjectionData;
 	m_pVolumeData = _pVolumeData;
-	std::cout << "DefaultFPPolicy used" << std::endl;
-
 }
 //----------------------------------------------------------------------------------------
 DefaultFPPolicy::~DefaultFPPolicy()
@@ -70,8 +65,6 @@ DefaultBPPolicy::DefaultBPPolicy(CFloat32VolumeData2D* _pVolumeData,
 {
 	m_pProjectionData = _pProjectionData;
 	m_pVolumeData = _pVolumeData;
-	std::cout << "DefaultBPPolicy used" << std::endl;
-
 }
 //----------------------------------------------------------------------------------------
 DefaultBPPolicy::~DefaultBPPolicy()
@@ -125,9 +118,6 @@ DiffFPPolicy::DiffFPPolicy(CFloat32VolumeData2D* _pVolumeData,
 	m_pDiffProjectionData = _pDiffProjectionData;
 	m_pBaseProjectionData = _pBaseProjectionData;
 	m_pVolumeData = _pVolumeData;
-
-	std::cout << "DiffFPPolicy used" << std::endl;
-
 }
 //----------------------------------------------------------------------------------------
 DiffFPPolicy::~DiffFPPolicy()
@@ -177,7 +167,6 @@ StorePixelWeightsPolicy::StorePixelWeightsPolicy(SPixelWeight* _pPixelWeights, i
 	m_iStoredPixelCount = 0;
 	m_pPixelWeights = _pPixelWeights;
 	m_iMaxPixelCount = _iMaxPixelCount;
-	std::cout << "store pixel weight used" << std::endl;
 
 }
 //----------------------------------------------------------------------------------------	
@@ -221,6 +210,62 @@ int StorePixelWeightsPolicy::getStoredPixelCount()
 
 
 
+//----------------------------------------------------------------------------------------
+// STORE PIXEL WEIGHT, INDICES AND WEIGHTS APART (Ray+Pixel Driven)
+//----------------------------------------------------------------------------------------
+StoreSplitPixelWeightsPolicy::StoreSplitPixelWeightsPolicy()
+{
+
+}
+//----------------------------------------------------------------------------------------
+StoreSplitPixelWeightsPolicy::StoreSplitPixelWeightsPolicy(int* _piIndices, float* _pfWeights, int _iMaxPixelCount)
+{
+	m_iStoredPixelCount = 0;
+	m_piIndices = _piIndices;
+	m_pfWeights = _pfWeights;
+	m_iMaxPixelCount = _iMaxPixelCount;
+}
+//----------------------------------------------------------------------------------------
+StoreSplitPixelWeightsPolicy::~StoreSplitPixelWeightsPolicy()
+{
+
+}
+//----------------------------------------------------------------------------------------
+bool StoreSplitPixelWeightsPolicy::rayPrior(int _iRayIndex)
+{
+	return (m_iStoredPixelCount < m_iMaxPixelCount);
+}
+//----------------------------------------------------------------------------------------
+bool StoreSplitPixelWeightsPolicy::pixelPrior(int _iVolumeIndex)
+{
+	return (m_iStoredPixelCount < m_iMaxPixelCount);
+}
+//----------------------------------------------------------------------------------------
+void StoreSplitPixelWeightsPolicy::addWeight(int _iRayIndex, int _iVolumeIndex, float _fWeight)
+{
+	m_piIndices[m_iStoredPixelCount] = _iVolumeIndex;
+	m_pfWeights[m_iStoredPixelCount] = _fWeight;
+	++m_iStoredPixelCount;
+}
+//----------------------------------------------------------------------------------------
+void StoreSplitPixelWeightsPolicy::rayPosterior(int _iRayIndex)
+{
+	// nothing
+}
+//----------------------------------------------------------------------------------------
+void StoreSplitPixelWeightsPolicy::pixelPosterior(int _iVolumeIndex)
+{
+	// nothing
+}
+//----------------------------------------------------------------------------------------
+int StoreSplitPixelWeightsPolicy::getStoredPixelCount()
+{
+	return m_iStoredPixelCount;
+}
+//----------------------------------------------------------------------------------------
+
+
+
 //----------------------------------------------------------------------------------------
 // TOTAL PIXEL WEIGHT MULTIPLIED BY SINOGRAM (Ray+Pixel Driven)
 //----------------------------------------------------------------------------------------
@@ -234,9 +279,6 @@ TotalPixelWeightBySinogramPolicy::TotalPixelWeightBySinogramPolicy(CFloat32Proje
 {
 	m_pPixelWeight = _pPixelWeight;
 	m_pSinogram = _pSinogram;
-
-	std::cout << "TotalPixelWeightBySinogramPolicy used" << std::endl;
-
 }
 //----------------------------------------------------------------------------------------	
 TotalPixelWeightBySinogramPolicy::~TotalPixelWeightBySinogramPolicy()
@@ -285,8 +327,6 @@ TotalPixelWeightPolicy::TotalPixelWeightPolicy()
 TotalPixelWeightPolicy::TotalPixelWeightPolicy(CFloat32VolumeData2D* _pPixelWeight)
 {
 	m_pPixelWeight = _pPixelWeight;
-	std::cout << "TotalPixelWeightPolicy used" << std::endl;
-
 }
 //----------------------------------------------------------------------------------------	
 TotalPixelWeightPolicy::~TotalPixelWeightPolicy()
@@ -334,8 +374,6 @@ TotalRayLengthPolicy::TotalRayLengthPolicy()
 TotalRayLengthPolicy::TotalRayLengthPolicy(CFloat32ProjectionData2D* _pRayLength)
 {
 	m_pRayLength = _pRayLength;
-	std::cout << "TotalRayLengthPolicy used" << std::endl;
-
 }
 //----------------------------------------------------------------------------------------	
 TotalRayLengthPolicy::~TotalRayLengthPolicy()
@@ -845,4 +883,227 @@ void ReconstructionMaskPolicy::pixelPosterior(int _iVolumeIndex)
 
 
 
+//----------------------------------------------------------------------------------------
+// 16-BIT FORWARD PROJECTION (Ray Driven)
+//----------------------------------------------------------------------------------------
+template<typename T>
+HalfFPPolicy<T>::HalfFPPolicy()
+{
+
+}
+//----------------------------------------------------------------------------------------
+template<typename T>
+HalfFPPolicy<T>::HalfFPPolicy(CHalfData2D<T>* _pVolumeData, CHalfData2D<T>* _pProjectionData)
+{
+	m_pProjectionData = _pProjectionData;
+	m_pVolumeData = _pVolumeData;
+	m_fRaySum = 0.0f;
+}
+//----------------------------------------------------------------------------------------
+template<typename T>
+HalfFPPolicy<T>::~HalfFPPolicy()
+{
+
+}
+//----------------------------------------------------------------------------------------
+template<typename T>
+bool HalfFPPolicy<T>::rayPrior(int _iRayIndex)
+{
+	m_fRaySum = 0.0f;
+	return true;
+}
+//----------------------------------------------------------------------------------------
+template<typename T>
+bool HalfFPPolicy<T>::pixelPrior(int _iVolumeIndex)
+{
+	// do nothing
+	return true;
+}
+//----------------------------------------------------------------------------------------
+template<typename T>
+void HalfFPPolicy<T>::addWeight(int _iRayIndex, int _iVolumeIndex, float _fWeight)
+{
+	m_fRaySum += toFloat(m_pVolumeData->getData()[_iVolumeIndex]) * _fWeight;
+}
+//----------------------------------------------------------------------------------------
+template<typename T>
+void HalfFPPolicy<T>::rayPosterior(int _iRayIndex)
+{
+	m_pProjectionData->getData()[_iRayIndex] = fromFloat<T>(m_fRaySum);
+}
+//----------------------------------------------------------------------------------------
+template<typename T>
+void HalfFPPolicy<T>::pixelPosterior(int _iVolumeIndex)
+{
+	// nothing
+}
+//----------------------------------------------------------------------------------------
+
+
+//----------------------------------------------------------------------------------------
+// 16-BIT BACK PROJECTION (Ray+Pixel Driven)
+//----------------------------------------------------------------------------------------
+template<typename T>
+HalfBPPolicy<T>::HalfBPPolicy()
+{
+
+}
+//----------------------------------------------------------------------------------------
+template<typename T>
+HalfBPPolicy<T>::HalfBPPolicy(CFloat32VolumeData2D* _pVolumeData, CHalfData2D<T>* _pProjectionData)
+{
+	m_pProjectionData = _pProjectionData;
+	m_pVolumeData = _pVolumeData;
+}
+//----------------------------------------------------------------------------------------
+template<typename T>
+HalfBPPolicy<T>::~HalfBPPolicy()
+{
+
+}
+//----------------------------------------------------------------------------------------
+template<typename T>
+bool HalfBPPolicy<T>::rayPrior(int _iRayIndex)
+{
+	// do nothing
+	return true;
+}
+//----------------------------------------------------------------------------------------
+template<typename T>
+bool HalfBPPolicy<T>::pixelPrior(int _iVolumeIndex)
+{
+	// do nothing
+	return true;
+}
+//----------------------------------------------------------------------------------------
+template<typename T>
+void HalfBPPolicy<T>::addWeight(int _iRayIndex, int _iVolumeIndex, float _fWeight)
+{
+	m_pVolumeData->getData()[_iVolumeIndex] += toFloat(m_pProjectionData->getData()[_iRayIndex]) * _fWeight;
+}
+//----------------------------------------------------------------------------------------
+template<typename T>
+void HalfBPPolicy<T>::rayPosterior(int _iRayIndex)
+{
+	// nothing
+}
+//----------------------------------------------------------------------------------------
+template<typename T>
+void HalfBPPolicy<T>::pixelPosterior(int _iVolumeIndex)
+{
+	// nothing
+}
+//----------------------------------------------------------------------------------------
+
+
+
+//----------------------------------------------------------------------------------------
+// ACCUMULATING FORWARD PROJECTION (Ray Driven)
+//----------------------------------------------------------------------------------------
+template<typename TAccumulator, typename TStep>
+AccumulatingFPPolicy<TAccumulator, TStep>::AccumulatingFPPolicy()
+{
+
+}
+//----------------------------------------------------------------------------------------
+template<typename TAccumulator, typename TStep>
+AccumulatingFPPolicy<TAccumulator, TStep>::AccumulatingFPPolicy(CFloat32VolumeData2D* _pVolumeData, CFloat32ProjectionData2D* _pProjectionData)
+{
+	m_pProjectionData = _pProjectionData;
+	m_pVolumeData = _pVolumeData;
+	m_accumulator.reset();
+}
+//----------------------------------------------------------------------------------------
+template<typename TAccumulator, typename TStep>
+AccumulatingFPPolicy<TAccumulator, TStep>::~AccumulatingFPPolicy()
+{
+
+}
+//----------------------------------------------------------------------------------------
+template<typename TAccumulator, typename TStep>
+bool AccumulatingFPPolicy<TAccumulator, TStep>::rayPrior(int _iRayIndex)
+{
+	m_accumulator.reset();
+	return true;
+}
+//----------------------------------------------------------------------------------------
+template<typename TAccumulator, typename TStep>
+bool AccumulatingFPPolicy<TAccumulator, TStep>::pixelPrior(int _iVolumeIndex)
+{
+	// do nothing
+	return true;
+}
+//----------------------------------------------------------------------------------------
+template<typename TAccumulator, typename TStep>
+void AccumulatingFPPolicy<TAccumulator, TStep>::addWeight(int _iRayIndex, int _iVolumeIndex, float _fWeight)
+{
+	m_accumulator.add(m_pVolumeData->getData()[_iVolumeIndex], _fWeight);
+}
+//----------------------------------------------------------------------------------------
+template<typename TAccumulator, typename TStep>
+void AccumulatingFPPolicy<TAccumulator, TStep>::rayPosterior(int _iRayIndex)
+{
+	m_pProjectionData->getData()[_iRayIndex] += m_accumulator.result();
+}
+//----------------------------------------------------------------------------------------
+template<typename TAccumulator, typename TStep>
+void AccumulatingFPPolicy<TAccumulator, TStep>::pixelPosterior(int _iVolumeIndex)
+{
+	// nothing
+}
+//----------------------------------------------------------------------------------------
+
+
+//----------------------------------------------------------------------------------------
+// SLICE STACK FORWARD PROJECTION (Ray Driven)
+//----------------------------------------------------------------------------------------
+SliceStackFPPolicy::SliceStackFPPolicy()
+{
+
+}
+//----------------------------------------------------------------------------------------
+SliceStackFPPolicy::SliceStackFPPolicy(const SBlock* _pBlock)
+{
+	m_pBlock = _pBlock;
+}
+//----------------------------------------------------------------------------------------
+SliceStackFPPolicy::~SliceStackFPPolicy()
+{
+
+}
+//----------------------------------------------------------------------------------------
+bool SliceStackFPPolicy::rayPrior(int _iRayIndex)
+{
+	for (int k = 0; k < SLICE_LANES; ++k)
+		m_fRaySums[k] = 0.0f;
+	return true;
+}
+//----------------------------------------------------------------------------------------
+bool SliceStackFPPolicy::pixelPrior(int _iVolumeIndex)
+{
+	// do nothing
+	return true;
+}
+//----------------------------------------------------------------------------------------
+void SliceStackFPPolicy::addWeight(int _iRayIndex, int _iVolumeIndex, float _fWeight)
+{
+	const float* pValues = m_pBlock->m_pVolume + (size_t)_iVolumeIndex * SLICE_LANES;
+	for (int k = 0; k < SLICE_LANES; ++k)
+		m_fRaySums[k] += pValues[k] * _fWeight;
+}
+//----------------------------------------------------------------------------------------
+void SliceStackFPPolicy::rayPosterior(int _iRayIndex)
+{
+	float* pSinogram = m_pBlock->m_pSinograms + _iRayIndex;
+	for (int k = 0; k < m_pBlock->m_iSliceCount; ++k)
+		pSinogram[(size_t)k * m_pBlock->m_iRayCount] = m_fRaySums[k];
+}
+//----------------------------------------------------------------------------------------
+void SliceStackFPPolicy::pixelPosterior(int _iVolumeIndex)
+{
+	// nothing
+}
+//----------------------------------------------------------------------------------------
+
+
 #endif
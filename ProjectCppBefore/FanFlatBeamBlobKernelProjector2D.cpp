@@ -0,0 +1,151 @@
+#include "FanFlatBeamBlobKernelProjector2D.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "DataProjectorPolicies.h"
+#include "RayWeightCache.h"
+#include "FanFlatBeamBlobKernelProjector2D.inl"
+
+// type of the projector, needed to register with CProjectorFactory
+std::string CFanFlatBeamBlobKernelProjector2D::type = "blob_fanflat";
+
+
+//----------------------------------------------------------------------------------------
+// default constructor
+CFanFlatBeamBlobKernelProjector2D::CFanFlatBeamBlobKernelProjector2D()
+{
+	_clear();
+}
+
+//----------------------------------------------------------------------------------------
+// constructor
+CFanFlatBeamBlobKernelProjector2D::CFanFlatBeamBlobKernelProjector2D(CFanFlatProjectionGeometry2D* _pProjectionGeometry,
+	CVolumeGeometry2D* _pReconstructionGeometry)
+{
+	_clear();
+	initialize(_pProjectionGeometry, _pReconstructionGeometry);
+}
+
+//----------------------------------------------------------------------------------------
+// destructor
+CFanFlatBeamBlobKernelProjector2D::~CFanFlatBeamBlobKernelProjector2D()
+{
+	clear();
+}
+
+//---------------------------------------------------------------------------------------
+// Clear - Constructors
+void CFanFlatBeamBlobKernelProjector2D::_clear()
+{
+	CFanFlatRayProjector2D::_clear();
+	std::atomic_store(&m_pBlob, _buildBlob(2.0f, 10.4f, 2));
+	m_bIsInitialized = false;
+}
+
+//---------------------------------------------------------------------------------------
+// Check
+bool CFanFlatBeamBlobKernelProjector2D::_check()
+{
+	// check base class
+	ASTRA_CONFIG_CHECK(CFanFlatRayProjector2D::_check(), "FanFlatBeamBlobKernelProjector2D", "Error in FanFlatRayProjector2D initialization");
+
+	ASTRA_CONFIG_CHECK(std::fabs(m_pVolumeGeometry->getPixelLengthX() / m_pVolumeGeometry->getPixelLengthY() - 1) < eps, "FanFlatBeamBlobKernelProjector2D", "Pixel height must equal pixel width.");
+
+	// success
+	return true;
+}
+
+//----------------------------------------------------------------------------------------
+// Blob
+bool CFanFlatBeamBlobKernelProjector2D::setBlobParameters(float _fRadius, float _fAlpha, int _iOrder)
+{
+	ASTRA_CONFIG_CHECK(_fRadius > 0.0f, "FanFlatBeamBlobKernelProjector2D", "Blob radius must be positive.");
+	ASTRA_CONFIG_CHECK(_fAlpha >= 0.0f, "FanFlatBeamBlobKernelProjector2D", "Blob alpha must not be negative.");
+	ASTRA_CONFIG_CHECK(_iOrder >= 0, "FanFlatBeamBlobKernelProjector2D", "Blob order must not be negative.");
+
+	// build the new blob completely before publishing it
+	std::atomic_store(&m_pBlob, _buildBlob(_fRadius, _fAlpha, _iOrder));
+
+	// cached weights belong to the old blob
+	if (m_pRayWeightCache)
+		m_pRayWeightCache->clear();
+	return true;
+}
+
+std::shared_ptr<const CFanFlatBeamBlobKernelProjector2D::SBlob> CFanFlatBeamBlobKernelProjector2D::_buildBlob(float _fRadius, float _fAlpha, int _iOrder)
+{
+	// The line integral of the blob (1 - (r/a)^2)^(m/2) I_m(alpha sqrt(1 - (r/a)^2)) at
+	// distance s from its centre is, up to a constant (Lewitt 1990),
+	//   z^(m + 1/2) I_(m + 1/2)(alpha z),  z = sqrt(1 - (s/a)^2)
+	// and with the power series of I_nu, without its constant factor (alpha / 2)^nu,
+	//   z^(2 nu) sum_k (alpha z / 2)^(2k) / (k! Gamma(k + nu + 1)),  nu = m + 1/2
+	// which has positive terms only, and is also valid for alpha = 0.
+	const double dRadius = _fRadius;
+	const double dNu = _iOrder + 0.5;
+	const double dHalfAlpha = 0.5 * _fAlpha;
+	const int iSampleCount = int(std::ceil(dRadius * BLOB_TABLE_SAMPLES_PER_PIXEL));
+
+	std::vector<double> profile(iSampleCount + 1, 0.0);
+	for (int i = 0; i < iSampleCount; ++i) {
+		double s = double(i) / BLOB_TABLE_SAMPLES_PER_PIXEL;
+		double z2 = 1.0 - (s / dRadius) * (s / dRadius);
+		if (z2 <= 0.0)
+			continue;
+		double x2 = dHalfAlpha * dHalfAlpha * z2;
+		double dTerm = 1.0 / std::tgamma(dNu + 1.0);
+		double dSum = dTerm;
+		for (int k = 1; k < 200 && dTerm > 1e-17 * dSum; ++k) {
+			dTerm *= x2 / (k * (k + dNu));
+			dSum += dTerm;
+		}
+		profile[i] = std::pow(z2, dNu) * dSum;
+	}
+
+	// normalize to the area of a pixel, for the profile as it is interpolated
+	double dIntegral = profile[0];
+	for (int i = 1; i <= iSampleCount; ++i)
+		dIntegral += 2.0 * profile[i];
+	dIntegral /= BLOB_TABLE_SAMPLES_PER_PIXEL;
+
+	std::shared_ptr<SBlob> pBlob(new SBlob());
+	pBlob->m_fRadius = _fRadius;
+	pBlob->m_fAlpha = _fAlpha;
+	pBlob->m_iOrder = _iOrder;
+
+	// zeros from the radius on, and one past the end for the interpolation
+	pBlob->m_table.assign(iSampleCount + 2, 0.0f);
+	for (int i = 0; i <= iSampleCount; ++i)
+		pBlob->m_table[i] = float(profile[i] / dIntegral);
+	return pBlob;
+}
+
+//----------------------------------------------------------------------------------------
+// Get maximum amount of weights on a single ray
+int CFanFlatBeamBlobKernelProjector2D::getProjectionWeightsCount(int _iProjectionIndex)
+{
+	// per row (or column) the pixels within the blob radius of the ray, which cuts the row
+	// at 45 degrees at most: fewer than 2 sqrt(2) radius + 1
+	const int iRowCount = m_pVolumeGeometry->getGridRowCount();
+	const int iColCount = m_pVolumeGeometry->getGridColCount();
+	const int iWidth = int(2.0 * std::sqrt(2.0) * getBlobRadius()) + 2;
+	return std::max(iRowCount * std::min(iColCount, iWidth), iColCount * std::min(iRowCount, iWidth));
+}
+
+//----------------------------------------------------------------------------------------
+// Single Ray Weights
+void CFanFlatBeamBlobKernelProjector2D::computeSingleRayWeights(int _iProjectionIndex,
+	int _iDetectorIndex,
+	SPixelWeight* _pWeightedPixels,
+	int _iMaxPixelCount,
+	int& _iStoredPixelCount)
+{
+	ASTRA_ASSERT(m_bIsInitialized);
+	StorePixelWeightsPolicy p(_pWeightedPixels, _iMaxPixelCount);
+	projectSingleRay(_iProjectionIndex, _iDetectorIndex, p);
+	_iStoredPixelCount = p.getStoredPixelCount();
+}
+
+//----------------------------------------------------------------------------------------
+// kernel-independent members
+template class CFanFlatKernelProjector2D<CFanFlatBeamBlobKernelProjector2D>;
@@ -0,0 +1,228 @@
+#ifndef _INC_ASTRA_FANFLATBEAMBLOBKERNELPROJECTOR
+#define _INC_ASTRA_FANFLATBEAMBLOBKERNELPROJECTOR
+
+#include "FanFlatRayProjector2D.h"
+#include "FanFlatRayTable.h"
+#include "Float32Data2D.h"
+
+#include <memory>
+#include <vector>
+
+
+/** This class implements a two-dimensional projector with a Kaiser-Bessel blob basis
+	* with a fan flat projection geometry.
+	*
+	* The volume holds the coefficients of blobs centred on the pixels, and the weight of a
+	* pixel is the line integral of its blob along the ray, which only depends on the
+	* distance from the pixel centre to the ray. These projected profiles are sampled once
+	* into a lookup table (getBlobTable()), in closed form, and the kernel interpolates the
+	* table linearly for the pixels of a row (or column) within the blob radius. No Bessel
+	* function is evaluated during projection.
+	*
+	* The profile is normalized to the area of a pixel, so that a constant volume projects
+	* to about the ray length, as with the line kernels. Pixels must be square, the blob
+	* radius is in pixel lengths.
+	*/
+class CFanFlatBeamBlobKernelProjector2D : public CFanFlatKernelProjector2D<CFanFlatBeamBlobKernelProjector2D> {
+
+public:
+
+	/** Table samples per pixel length of distance to the ray.
+		*/
+	static const int BLOB_TABLE_SAMPLES_PER_PIXEL = 256;
+
+protected:
+
+	/** Initial clearing. Only to be used by constructors.
+		*/
+	virtual void _clear();
+
+	/** Check the values of this object.  If everything is ok, the object can be set to the initialized state.
+		* The following statements are then guaranteed to hold:
+		* - no NULL pointers
+		* - all sub-objects are initialized properly
+		* - square pixels
+		*/
+	virtual bool _check();
+
+	/** A blob and its sampled profile. Never changed once built, see m_pBlob.
+		*/
+	struct SBlob {
+		//< Blob radius, in pixel lengths
+		float m_fRadius;
+		//< Blob taper
+		float m_fAlpha;
+		//< Blob order
+		int m_iOrder;
+		//< Projected profile at distances i / BLOB_TABLE_SAMPLES_PER_PIXEL, up to the radius, then zeros
+		std::vector<float> m_table;
+	};
+
+	/** Build a blob, sampling its projected profile into the lookup table.
+		*/
+	static std::shared_ptr<const SBlob> _buildBlob(float _fRadius, float _fAlpha, int _iOrder);
+
+	/** The current blob. Only accessed through std::atomic_load/atomic_store: a projection
+		* holds its own reference for as long as it runs, so setBlobParameters() never frees or
+		* changes the table under a projection in progress.
+		*/
+	std::shared_ptr<const SBlob> m_pBlob;
+
+public:
+
+	// type of the projector, needed to register with CProjectorFactory
+	static std::string type;
+
+	/** Default constructor.
+		*/
+	CFanFlatBeamBlobKernelProjector2D();
+
+	/** Constructor.
+		*
+		* @param _pProjectionGeometry		Information class about the geometry of the projection.  Will be HARDCOPIED.
+		* @param _pReconstructionGeometry	Information class about the geometry of the reconstruction volume. Will be HARDCOPIED.
+		*/
+	CFanFlatBeamBlobKernelProjector2D(CFanFlatProjectionGeometry2D* _pProjectionGeometry,
+		CVolumeGeometry2D* _pReconstructionGeometry);
+
+	/** Destructor, is virtual to show that we are aware subclass destructor are called.
+		*/
+	~CFanFlatBeamBlobKernelProjector2D();
+
+	/** Set the Kaiser-Bessel blob, and rebuild the lookup table. The default is the blob
+		* recommended for a square grid by Matej and Lewitt: radius 2, alpha 10.4, order 2.
+		*
+		* @param _fRadius	Radius of the blob, in pixel lengths (> 0).
+		* @param _fAlpha	Taper of the blob (>= 0), 0 is a flat disc for order 0.
+		* @param _iOrder	Order of the blob (>= 0), the blob has _iOrder - 1 continuous derivatives at its edge.
+		*
+		* Safe to call while other threads project with this projector: projections already
+		* running finish with the blob they started with, later ones use the new blob.
+		*
+		* @return parameters valid? If not, the blob is left unchanged.
+		*/
+	bool setBlobParameters(float _fRadius, float _fAlpha, int _iOrder);
+
+	/** Get the blob radius, in pixel lengths.
+		*/
+	float getBlobRadius() const;
+
+	/** Get the blob taper.
+		*/
+	float getBlobAlpha() const;
+
+	/** Get the blob order.
+		*/
+	int getBlobOrder() const;
+
+	/** Get the lookup table of the projected blob profile: entry i is the line integral of a
+		* blob of unit coefficient at distance i / BLOB_TABLE_SAMPLES_PER_PIXEL pixel lengths
+		* from its centre, for a pixel length of 1. Returns a copy, as the table is replaced
+		* by setBlobParameters().
+		*/
+	std::vector<float> getBlobTable() const;
+
+	/** Returns the number of weights required for storage of all weights of one projection.
+		*
+		* @param _iProjectionIndex Index of the projection (zero-based).
+		* @return Size of buffer (given in SPixelWeight elements) needed to store weighted pixels.
+		*/
+	virtual int getProjectionWeightsCount(int _iProjectionIndex);
+
+	/** Compute the pixel weights for a single ray, from the source to a detector pixel.
+		*
+		* @param _iProjectionIndex	Index of the projection
+		* @param _iDetectorIndex	Index of the detector pixel
+		* @param _pWeightedPixels	Pointer to a pre-allocated array, consisting of _iMaxPixelCount elements
+		*							of type SPixelWeight. On return, this array contains a list of the index
+		*							and weight for all pixels on the ray.
+		* @param _iMaxPixelCount	Maximum number of pixels (and corresponding weights) that can be stored in _pWeightedPixels.
+		*							This number MUST be greater than the total number of pixels on the ray.
+		* @param _iStoredPixelCount On return, this variable contains the total number of pixels on the
+		*                           ray (that have been stored in the list _pWeightedPixels).
+		*/
+	virtual void computeSingleRayWeights(int _iProjectionIndex,
+		int _iDetectorIndex,
+		SPixelWeight* _pWeightedPixels,
+		int _iMaxPixelCount,
+		int& _iStoredPixelCount);
+
+	/** Policy-based projection of all rays.  This function will calculate each non-zero projection
+		* weight and use this value for a task provided by the policy object.
+		*
+		* @param _policy Policy object.  Should contain prior, addWeight and posterior function.
+		*/
+	template <typename Policy>
+	void project(Policy& _policy);
+
+	/** Policy-based projection of all rays of a single projection.  This function will calculate
+		* each non-zero projection weight and use this value for a task provided by the policy object.
+		*
+		* @param _iProjection Which projection should be projected?
+		* @param _policy Policy object.  Should contain prior, addWeight and posterior function.
+		*/
+	template <typename Policy>
+	void projectSingleProjection(int _iProjection, Policy& _policy);
+
+	/** Policy-based projection of a single ray.  This function will calculate each non-zero
+		* projection  weight and use this value for a task provided by the policy object.
+		*
+		* @param _iProjection Which projection should be projected?
+		* @param _iDetector Which detector should be projected?
+		* @param _policy Policy object.  Should contain prior, addWeight and posterior function.
+		*/
+	template <typename Policy>
+	void projectSingleRay(int _iProjection, int _iDetector, Policy& _policy);
+
+	/** Policy-based projection of all rays of a range of projections.
+		*
+		* @param _iProjFrom First projection (inclusive)
+		* @param _iProjTo Last projection (exclusive)
+		* @param _policy Policy object.  Should contain prior, addWeight and posterior function.
+		*/
+	template <typename Policy>
+	void projectAngleRange(int _iProjFrom, int _iProjTo, Policy& _policy);
+
+	/** Return the type of this projector.
+		*
+		* @return identification type of this projector
+		*/
+	virtual std::string getType();
+
+protected:
+	/** Internal policy-based projection of a range of angles and range.
+		* (_i*From is inclusive, _i*To exclusive) */
+	template <typename Policy>
+	void projectBlock_internal(int _iProjFrom, int _iProjTo,
+		int _iDetFrom, int _iDetTo, Policy& _policy);
+
+};
+
+//----------------------------------------------------------------------------------------
+
+inline std::string CFanFlatBeamBlobKernelProjector2D::getType()
+{
+	return type;
+}
+
+inline float CFanFlatBeamBlobKernelProjector2D::getBlobRadius() const
+{
+	return std::atomic_load(&m_pBlob)->m_fRadius;
+}
+
+inline float CFanFlatBeamBlobKernelProjector2D::getBlobAlpha() const
+{
+	return std::atomic_load(&m_pBlob)->m_fAlpha;
+}
+
+inline int CFanFlatBeamBlobKernelProjector2D::getBlobOrder() const
+{
+	return std::atomic_load(&m_pBlob)->m_iOrder;
+}
+
+inline std::vector<float> CFanFlatBeamBlobKernelProjector2D::getBlobTable() const
+{
+	return std::atomic_load(&m_pBlob)->m_table;
+}
+
+#endif
@@ -0,0 +1,116 @@
+#include "FanFlatRayProjector2D.inl"
+
+template <typename Policy>
+void CFanFlatBeamBlobKernelProjector2D::project(Policy& p)
+{
+	projectBlock_internal(0, m_pProjectionGeometry->getProjectionAngleCount(),
+		0, m_pProjectionGeometry->getDetectorCount(), p);
+}
+
+template <typename Policy>
+void CFanFlatBeamBlobKernelProjector2D::projectSingleProjection(int _iProjection, Policy& p)
+{
+	projectBlock_internal(_iProjection, _iProjection + 1,
+		0, m_pProjectionGeometry->getDetectorCount(), p);
+}
+
+template <typename Policy>
+void CFanFlatBeamBlobKernelProjector2D::projectAngleRange(int _iProjFrom, int _iProjTo, Policy& p)
+{
+	projectBlock_internal(_iProjFrom, _iProjTo,
+		0, m_pProjectionGeometry->getDetectorCount(), p);
+}
+
+template <typename Policy>
+void CFanFlatBeamBlobKernelProjector2D::projectSingleRay(int _iProjection, int _iDetector, Policy& p)
+{
+	projectBlock_internal(_iProjection, _iProjection + 1,
+		_iDetector, _iDetector + 1, p);
+}
+
+//----------------------------------------------------------------------------------------
+// KERNEL - blob kernel: per row (or column) the pixels within the blob radius of the ray,
+// weighted with the projected blob profile at their distance to the ray, interpolated
+// from the lookup table
+template <typename Real>
+struct SFanFlatBlobKernel {
+	const SLineKernelGrid<Real> grid;
+	const int colCount;
+	const int rowCount;
+	const int rowStride;
+	const float* table;
+	const Real tableEnd;		///< last table entry, the first at or beyond the radius
+	const Real radius;			///< in pixel lengths
+	ASTRA_INSTRUMENT(uint64_t iPixelsVisited;)
+
+	SFanFlatBlobKernel(const CVolumeGeometry2D* _pVolumeGeometry, int _iRowStride, const std::vector<float>& _table, Real _radius)
+		: grid(_pVolumeGeometry),
+		  colCount(_pVolumeGeometry->getGridColCount()),
+		  rowCount(_pVolumeGeometry->getGridRowCount()),
+		  rowStride(_iRowStride),
+		  table(&_table[0]),
+		  tableEnd(Real(_table.size() - 2)),
+		  radius(_radius)
+	{
+		ASTRA_INSTRUMENT(iPixelsVisited = 0;)
+	}
+
+	template <typename Policy>
+	FORCEINLINE void traceRay(const SFanProjection& _proj, int _iDetector, int iRayIndex, Policy& p)
+	{
+		SLineKernelRay<Real> ray;
+		setupFanFlatRay(_proj, _iDetector, grid, ray);
+
+		// vertical: steps are rows, the axis runs over the columns of a row
+		const int stepCount = ray.vertical ? rowCount : colCount;
+		const int axisCount = ray.vertical ? colCount : rowCount;
+		const int stepStride = ray.vertical ? rowStride : 1;
+		const int axisStride = ray.vertical ? 1 : rowStride;
+
+		// distance to the ray per pixel along the axis, in pixel lengths, is the cosine
+		// pixelLength / length of the angle between the ray and the steps; the weight is the
+		// table value times the pixel length
+		const Real pixelLength = ray.vertical ? grid.pixelLengthX : grid.pixelLengthY;
+		const Real cosine = pixelLength / ray.length;
+		const Real halfWidth = radius / cosine;
+		const Real tableScale = cosine * Real(CFanFlatBeamBlobKernelProjector2D::BLOB_TABLE_SAMPLES_PER_PIXEL);
+
+		Real c = ray.start;
+		bool isin = false;
+
+		for (int step = 0; step < stepCount; ++step, c += ray.delta) {
+
+			const Real lo = c - halfWidth;
+			const Real hi = c + halfWidth;
+			if (hi < Real(0) || lo > Real(axisCount - 1)) { if (!isin) continue; else break; }
+			isin = true;
+
+			// pixels strictly within the radius (hi >= 0, and the truncation is its floor)
+			int i = lo < Real(0) ? 0 : int(lo) + 1;
+			const int iLast = std::min(axisCount - 1, int(hi));
+			int iVolumeIndex = step * stepStride + i * axisStride;
+			for (; i <= iLast; ++i, iVolumeIndex += axisStride) {
+				Real t = std::min(std::fabs(c - Real(i)) * tableScale, tableEnd);
+				int j = int(t);
+				Real f = t - Real(j);
+				Real weight = (Real(table[j]) + f * (Real(table[j + 1]) - Real(table[j]))) * pixelLength;
+				if (weight > Real(0)) { policy_weight(p, iRayIndex, iVolumeIndex, weight); }
+			}
+		}
+	}
+};
+
+//----------------------------------------------------------------------------------------
+// PROJECT BLOCK - vector projection geometry
+template <typename Policy>
+void CFanFlatBeamBlobKernelProjector2D::projectBlock_internal(int _iProjFrom, int _iProjTo, int _iDetFrom, int _iDetTo, Policy& p)
+{
+	// stepping type, float unless the policy asks for double (see PolicyStepType)
+	typedef typename PolicyStepType<Policy>::type Real;
+
+	// the local reference keeps the blob alive until this block is done (see setBlobParameters)
+	std::shared_ptr<const SBlob> pBlob = std::atomic_load(&m_pBlob);
+
+	SFanFlatBlobKernel<Real> kernel(m_pVolumeGeometry, getVolumeStride(), pBlob->m_table, Real(pBlob->m_fRadius));
+	projectRays(kernel, _iProjFrom, _iProjTo, _iDetFrom, _iDetTo, p);
+}
@@ -0,0 +1,76 @@
+#include "FanFlatBeamDistanceDrivenProjector2D.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "DataProjectorPolicies.h"
+#include "FanFlatBeamDistanceDrivenProjector2D.inl"
+
+// type of the projector, needed to register with CProjectorFactory
+std::string CFanFlatBeamDistanceDrivenProjector2D::type = "distance_driven_fanflat";
+
+
+//----------------------------------------------------------------------------------------
+// default constructor
+CFanFlatBeamDistanceDrivenProjector2D::CFanFlatBeamDistanceDrivenProjector2D()
+{
+	_clear();
+}
+
+//----------------------------------------------------------------------------------------
+// constructor
+CFanFlatBeamDistanceDrivenProjector2D::CFanFlatBeamDistanceDrivenProjector2D(CFanFlatProjectionGeometry2D* _pProjectionGeometry,
+	CVolumeGeometry2D* _pReconstructionGeometry)
+{
+	_clear();
+	initialize(_pProjectionGeometry, _pReconstructionGeometry);
+}
+
+//----------------------------------------------------------------------------------------
+// destructor
+CFanFlatBeamDistanceDrivenProjector2D::~CFanFlatBeamDistanceDrivenProjector2D()
+{
+	clear();
+}
+
+//----------------------------------------------------------------------------------------
+// Get maximum amount of weights on a single ray
+int CFanFlatBeamDistanceDrivenProjector2D::getProjectionWeightsCount(int _iProjectionIndex)
+{
+	// per row (or column) at most the widest footprint plus the two partial pixels at its ends,
+	// and the footprints are widest at the first or the last row
+	const SFanProjection& proj = m_pVecProjectionGeometry->getProjectionVectors()[_iProjectionIndex];
+	const int iDetectorCount = m_pVecProjectionGeometry->getDetectorCount();
+	const bool bVertical = isFanFlatFootprintVertical(proj, iDetectorCount);
+	const int iStepCount = bVertical ? m_pVolumeGeometry->getGridRowCount() : m_pVolumeGeometry->getGridColCount();
+	const int iAxisCount = bVertical ? m_pVolumeGeometry->getGridColCount() : m_pVolumeGeometry->getGridRowCount();
+
+	SLineKernelGrid<double> grid(m_pVolumeGeometry);
+	double dMaxWidth = 0.0;
+	for (int iDetector = 0; iDetector < iDetectorCount; ++iDetector) {
+		SFanFlatFootprint<double> ray;
+		setupFanFlatFootprint(proj, iDetector, bVertical, grid, ray);
+		double dLast = double(iStepCount - 1);
+		dMaxWidth = std::max(dMaxWidth, std::fabs(ray.start1 - ray.start0));
+		dMaxWidth = std::max(dMaxWidth, std::fabs(ray.start1 + dLast * ray.delta1 - ray.start0 - dLast * ray.delta0));
+	}
+	return iStepCount * std::min(iAxisCount, int(std::ceil(std::min(dMaxWidth, double(iAxisCount)))) + 2);
+}
+
+//----------------------------------------------------------------------------------------
+// Single Ray Weights
+void CFanFlatBeamDistanceDrivenProjector2D::computeSingleRayWeights(int _iProjectionIndex,
+	int _iDetectorIndex,
+	SPixelWeight* _pWeightedPixels,
+	int _iMaxPixelCount,
+	int& _iStoredPixelCount)
+{
+	ASTRA_ASSERT(m_bIsInitialized);
+	StorePixelWeightsPolicy p(_pWeightedPixels, _iMaxPixelCount);
+	projectSingleRay(_iProjectionIndex, _iDetectorIndex, p);
+	_iStoredPixelCount = p.getStoredPixelCount();
+}
+
+//----------------------------------------------------------------------------------------
+// kernel-independent members
+template class CFanFlatKernelProjector2D<CFanFlatBeamDistanceDrivenProjector2D>;
@@ -0,0 +1,112 @@
+#include "FanFlatRayProjector2D.inl"
+
+template <typename Policy>
+void CFanFlatBeamDistanceDrivenProjector2D::project(Policy& p)
+{
+	projectBlock_internal(0, m_pProjectionGeometry->getProjectionAngleCount(),
+		0, m_pProjectionGeometry->getDetectorCount(), p);
+}
+
+template <typename Policy>
+void CFanFlatBeamDistanceDrivenProjector2D::projectSingleProjection(int _iProjection, Policy& p)
+{
+	projectBlock_internal(_iProjection, _iProjection + 1,
+		0, m_pProjectionGeometry->getDetectorCount(), p);
+}
+
+template <typename Policy>
+void CFanFlatBeamDistanceDrivenProjector2D::projectAngleRange(int _iProjFrom, int _iProjTo, Policy& p)
+{
+	projectBlock_internal(_iProjFrom, _iProjTo,
+		0, m_pProjectionGeometry->getDetectorCount(), p);
+}
+
+template <typename Policy>
+void CFanFlatBeamDistanceDrivenProjector2D::projectSingleRay(int _iProjection, int _iDetector, Policy& p)
+{
+	projectBlock_internal(_iProjection, _iProjection + 1,
+		_iDetector, _iDetector + 1, p);
+}
+
+//----------------------------------------------------------------------------------------
+// KERNEL - distance-driven kernel: per row (or column) the footprint of the detector
+// pixel on the common axis is overlapped with the pixels, and the length of the ray
+// within the row is split in proportion to the overlaps
+template <typename Real>
+struct SFanFlatDistanceDrivenKernel {
+	const SLineKernelGrid<Real> grid;
+	const int colCount;
+	const int rowCount;
+	const int rowStride;
+	const int detCount;
+	ASTRA_INSTRUMENT(uint64_t iPixelsVisited;)
+
+	SFanFlatDistanceDrivenKernel(const CVolumeGeometry2D* _pVolumeGeometry, int _iRowStride, int _iDetectorCount)
+		: grid(_pVolumeGeometry),
+		  colCount(_pVolumeGeometry->getGridColCount()),
+		  rowCount(_pVolumeGeometry->getGridRowCount()),
+		  rowStride(_iRowStride),
+		  detCount(_iDetectorCount)
+	{
+		ASTRA_INSTRUMENT(iPixelsVisited = 0;)
+	}
+
+	template <typename Policy>
+	FORCEINLINE void traceRay(const SFanProjection& _proj, int _iDetector, int iRayIndex, Policy& p)
+	{
+		const bool vertical = isFanFlatFootprintVertical(_proj, detCount);
+		SFanFlatFootprint<Real> ray;
+		setupFanFlatFootprint(_proj, _iDetector, vertical, grid, ray);
+
+		// vertical: steps are rows, the axis runs over the columns of a row
+		const int stepCount = vertical ? rowCount : colCount;
+		const int axisCount = vertical ? colCount : rowCount;
+		const int stepStride = vertical ? rowStride : 1;
+		const int axisStride = vertical ? 1 : rowStride;
+
+		Real e0 = ray.start0;
+		Real e1 = ray.start1;
+		bool isin = false;
+
+		for (int step = 0; step < stepCount; ++step, e0 += ray.delta0, e1 += ray.delta1) {
+
+			Real lo = std::min(e0, e1);
+			Real hi = std::max(e0, e1);
+			if (hi <= Real(0) || lo >= Real(axisCount)) { if (!isin) continue; else break; }
+			isin = true;
+
+			// footprint narrower than rounding: all of the row to the pixel it is in
+			if (!(hi - lo > Real(1e-6))) {
+				int i = int(lo);
+				if (i >= 0 && i < axisCount) { policy_weight(p, iRayIndex, step * stepStride + i * axisStride, ray.length); }
+				continue;
+			}
+
+			// merge the footprint [lo, hi) with the pixel boundaries i, i + 1, ...
+			const Real scale = ray.length / (hi - lo);
+			// (hi > 0, and the truncation of max(lo, 0) is its floor)
+			int i = int(std::max(lo, Real(0)));
+			const int iLast = std::min(axisCount - 1, int(hi));
+			Real left = std::max(lo, Real(i));
+			int iVolumeIndex = step * stepStride + i * axisStride;
+			for (; i <= iLast; ++i, iVolumeIndex += axisStride) {
+				Real right = std::min(hi, Real(i + 1));
+				Real overlap = right - left;
+				if (overlap > Real(0)) { policy_weight(p, iRayIndex, iVolumeIndex, overlap * scale); }
+				left = right;
+			}
+		}
+	}
+};
+
+//----------------------------------------------------------------------------------------
+// PROJECT BLOCK - vector projection geometry
+template <typename Policy>
+void CFanFlatBeamDistanceDrivenProjector2D::projectBlock_internal(int _iProjFrom, int _iProjTo, int _iDetFrom, int _iDetTo, Policy& p)
+{
+	// stepping type, float unless the policy asks for double (see PolicyStepType)
+	typedef typename PolicyStepType<Policy>::type Real;
+
+	SFanFlatDistanceDrivenKernel<Real> kernel(m_pVolumeGeometry, getVolumeStride(), m_pVecProjectionGeometry->getDetectorCount());
+	projectRays(kernel, _iProjFrom, _iProjTo, _iDetFrom, _iDetTo, p);
+}
@@ -0,0 +1,59 @@
+#include "FanFlatBeamJosephKernelProjector2D.h"
+
+#include <algorithm>
+
+#include "DataProjectorPolicies.h"
+#include "FanFlatBeamJosephKernelProjector2D.inl"
+
+// type of the projector, needed to register with CProjectorFactory
+std::string CFanFlatBeamJosephKernelProjector2D::type = "joseph_fanflat";
+
+
+//----------------------------------------------------------------------------------------
+// default constructor
+CFanFlatBeamJosephKernelProjector2D::CFanFlatBeamJosephKernelProjector2D()
+{
+	_clear();
+}
+
+//----------------------------------------------------------------------------------------
+// constructor
+CFanFlatBeamJosephKernelProjector2D::CFanFlatBeamJosephKernelProjector2D(CFanFlatProjectionGeometry2D* _pProjectionGeometry,
+	CVolumeGeometry2D* _pReconstructionGeometry)
+{
+	_clear();
+	initialize(_pProjectionGeometry, _pReconstructionGeometry);
+}
+
+//----------------------------------------------------------------------------------------
+// destructor
+CFanFlatBeamJosephKernelProjector2D::~CFanFlatBeamJosephKernelProjector2D()
+{
+	clear();
+}
+
+//----------------------------------------------------------------------------------------
+// Get maximum amount of weights on a single ray
+int CFanFlatBeamJosephKernelProjector2D::getProjectionWeightsCount(int _iProjectionIndex)
+{
+	int maxDim = std::max(m_pVolumeGeometry->getGridRowCount(), m_pVolumeGeometry->getGridColCount());
+	return maxDim * 2;
+}
+
+//----------------------------------------------------------------------------------------
+// Single Ray Weights
+void CFanFlatBeamJosephKernelProjector2D::computeSingleRayWeights(int _iProjectionIndex,
+	int _iDetectorIndex,
+	SPixelWeight* _pWeightedPixels,
+	int _iMaxPixelCount,
+	int& _iStoredPixelCount)
+{
+	ASTRA_ASSERT(m_bIsInitialized);
+	StorePixelWeightsPolicy p(_pWeightedPixels, _iMaxPixelCount);
+	projectSingleRay(_iProjectionIndex, _iDetectorIndex, p);
+	_iStoredPixelCount = p.getStoredPixelCount();
+}
+
+//----------------------------------------------------------------------------------------
+// kernel-independent members
+template class CFanFlatKernelProjector2D<CFanFlatBeamJosephKernelProjector2D>;
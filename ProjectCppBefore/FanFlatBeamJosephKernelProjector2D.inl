@@ -0,0 +1,130 @@
+#include "FanFlatRayProjector2D.inl"
+
+template <typename Policy>
+void CFanFlatBeamJosephKernelProjector2D::project(Policy& p)
+{
+	projectBlock_internal(0, m_pProjectionGeometry->getProjectionAngleCount(),
+		0, m_pProjectionGeometry->getDetectorCount(), p);
+}
+
+template <typename Policy>
+void CFanFlatBeamJosephKernelProjector2D::projectSingleProjection(int _iProjection, Policy& p)
+{
+	projectBlock_internal(_iProjection, _iProjection + 1,
+		0, m_pProjectionGeometry->getDetectorCount(), p);
+}
+
+template <typename Policy>
+void CFanFlatBeamJosephKernelProjector2D::projectAngleRange(int _iProjFrom, int _iProjTo, Policy& p)
+{
+	projectBlock_internal(_iProjFrom, _iProjTo,
+		0, m_pProjectionGeometry->getDetectorCount(), p);
+}
+
+template <typename Policy>
+void CFanFlatBeamJosephKernelProjector2D::projectSingleRay(int _iProjection, int _iDetector, Policy& p)
+{
+	projectBlock_internal(_iProjection, _iProjection + 1,
+		_iDetector, _iDetector + 1, p);
+}
+
+//----------------------------------------------------------------------------------------
+// KERNEL - Joseph kernel, the ray is sampled where it crosses the centre line of each
+// row (vertical rays) or column (horizontal rays), and the length of the ray within the
+// row is split linearly between the two pixels around the sample
+template <typename Real>
+struct SFanFlatJosephKernel {
+	const SLineKernelGrid<Real> grid;
+	const int colCount;
+	const int rowCount;
+	const int rowStride;
+	// setupFanFlatRay takes the length from the pixel width across the steps, which is the
+	// line kernel's; within a row (column) it is the pixel height (width) along them
+	const Real verticalLengthScale;
+	const Real horizontalLengthScale;
+	ASTRA_INSTRUMENT(uint64_t iPixelsVisited;)
+
+	SFanFlatJosephKernel(const CVolumeGeometry2D* _pVolumeGeometry, int _iRowStride)
+		: grid(_pVolumeGeometry),
+		  colCount(_pVolumeGeometry->getGridColCount()),
+		  rowCount(_pVolumeGeometry->getGridRowCount()),
+		  rowStride(_iRowStride),
+		  verticalLengthScale(Real(_pVolumeGeometry->getPixelLengthY()) / Real(_pVolumeGeometry->getPixelLengthX())),
+		  horizontalLengthScale(Real(_pVolumeGeometry->getPixelLengthX()) / Real(_pVolumeGeometry->getPixelLengthY()))
+	{
+		ASTRA_INSTRUMENT(iPixelsVisited = 0;)
+	}
+
+	template <typename Policy>
+	FORCEINLINE void traceRay(const SFanProjection& _proj, int _iDetector, int iRayIndex, Policy& p)
+	{
+		// variables
+		Real weight, c, r, offset;
+		int iVolumeIndex, row, col;
+		SLineKernelRay<Real> ray;
+
+		setupFanFlatRay(_proj, _iDetector, grid, ray);
+		ray.length *= ray.vertical ? verticalLengthScale : horizontalLengthScale;
+		bool isin = false;
+
+		// vertically
+		if (ray.vertical) {
+
+			// c for row 0
+			c = ray.start;
+
+			// for each row
+			for (row = 0; row < rowCount; ++row, c += ray.delta) {
+
+				col = int(floor(c));
+				if (col < -1 || col >= colCount) { if (!isin) continue; else break; }
+				offset = c - Real(col);
+				weight = offset * ray.length;
+
+				iVolumeIndex = row * rowStride + col;
+				if (col >= 0) { policy_weight(p, iRayIndex, iVolumeIndex, ray.length - weight); }
+
+				iVolumeIndex++;
+				if (col + 1 < colCount) { policy_weight(p, iRayIndex, iVolumeIndex, weight); }
+
+				isin = true;
+			}
+		}
+
+		// horizontally
+		else {
+
+			// r for col 0
+			r = ray.start;
+
+			// for each col
+			for (col = 0; col < colCount; ++col, r += ray.delta) {
+
+				row = int(floor(r));
+				if (row < -1 || row >= rowCount) { if (!isin) continue; else break; }
+				offset = r - Real(row);
+				weight = offset * ray.length;
+
+				iVolumeIndex = row * rowStride + col;
+				if (row >= 0) { policy_weight(p, iRayIndex, iVolumeIndex, ray.length - weight); }
+
+				iVolumeIndex += rowStride;
+				if (row + 1 < rowCount) { policy_weight(p, iRayIndex, iVolumeIndex, weight); }
+
+				isin = true;
+			}
+		}
+	}
+};
+
+//----------------------------------------------------------------------------------------
+// PROJECT BLOCK - vector projection geometry
+template <typename Policy>
+void CFanFlatBeamJosephKernelProjector2D::projectBlock_internal(int _iProjFrom, int _iProjTo, int _iDetFrom, int _iDetTo, Policy& p)
+{
+	// stepping type, float unless the policy asks for double (see PolicyStepType)
+	typedef typename PolicyStepType<Policy>::type Real;
+
+	SFanFlatJosephKernel<Real> kernel(m_pVolumeGeometry, getVolumeStride());
+	projectRays(kernel, _iProjFrom, _iProjTo, _iDetFrom, _iDetTo, p);
+}
@@ -39,7 +39,9 @@ CFanFlatBeamLineKernelProjector2D::~CFanFlatBeamLineKernelProjector2D()
 // Clear - Constructors
 void CFanFlatBeamLineKernelProjector2D::_clear()
 {
-	CProjector2D::_clear();
+	CFanFlatRayProjector2D::_clear();
+	std::atomic_store(&m_pRayTable, std::shared_ptr<const CFanFlatRayTable>());
+	m_bRayTableEnabled = false;
 	m_bIsInitialized = false;
 }
 
@@ -47,7 +49,8 @@ void CFanFlatBeamLineKernelProjector2D::_clear()
 // Clear - Public
 void CFanFlatBeamLineKernelProjector2D::clear()
 {
-	CProjector2D::clear();
+	CFanFlatRayProjector2D::clear();
+	std::atomic_store(&m_pRayTable, std::shared_ptr<const CFanFlatRayTable>());
 	m_bIsInitialized = false;
 }
 
@@ -56,9 +59,7 @@ void CFanFlatBeamLineKernelProjector2D::clear()
 bool CFanFlatBeamLineKernelProjector2D::_check()
 {
 	// check base class
-	ASTRA_CONFIG_CHECK(CProjector2D::_check(), "FanFlatBeamLineKernelProjector2D", "Error in Projector2D initialization");
-
-	ASTRA_CONFIG_CHECK(dynamic_cast<CFanFlatProjectionGeometry2D*>(m_pProjectionGeometry) || dynamic_cast<CFanFlatVecProjectionGeometry2D*>(m_pProjectionGeometry), "FanFlatBeamLineKernelProjector2D", "Unsupported projection geometry");
+	ASTRA_CONFIG_CHECK(CFanFlatRayProjector2D::_check(), "FanFlatBeamLineKernelProjector2D", "Error in FanFlatRayProjector2D initialization");
 
 	ASTRA_CONFIG_CHECK(abs(m_pVolumeGeometry->getPixelLengthX() / m_pVolumeGeometry->getPixelLengthY()) - 1 < eps, "FanFlatBeamLineKernelProjector2D", "Pixel height must equal pixel width.");
 
@@ -67,22 +68,33 @@ bool CFanFlatBeamLineKernelProjector2D::_check()
 }
 
 //---------------------------------------------------------------------------------------
-// Initialize
-bool CFanFlatBeamLineKernelProjector2D::initialize(CFanFlatProjectionGeometry2D* _pProjectionGeometry,
-	CVolumeGeometry2D* _pVolumeGeometry)
+// Geometry changed
+void CFanFlatBeamLineKernelProjector2D::_geometryChanged()
 {
-	// if already initialized, clear first
-	if (m_bIsInitialized) {
-		clear();
-	}
+	std::atomic_store(&m_pRayTable, std::shared_ptr<const CFanFlatRayTable>());
+	_updateRayTable();
+}
 
-	// hardcopy geometries
-	m_pProjectionGeometry = _pProjectionGeometry->clone();
-	m_pVolumeGeometry = _pVolumeGeometry->clone();
+//----------------------------------------------------------------------------------------
+// Ray table
+void CFanFlatBeamLineKernelProjector2D::setRayTableEnabled(bool _bEnabled)
+{
+	m_bRayTableEnabled = _bEnabled;
+	_updateRayTable();
+}
 
-	// success
-	m_bIsInitialized = _check();
-	return m_bIsInitialized;
+void CFanFlatBeamLineKernelProjector2D::_updateRayTable()
+{
+	if (!m_bRayTableEnabled || !m_bIsInitialized) {
+		std::atomic_store(&m_pRayTable, std::shared_ptr<const CFanFlatRayTable>());
+		return;
+	}
+	if (!std::atomic_load(&m_pRayTable)) {
+		// build the table completely before publishing it
+		std::shared_ptr<CFanFlatRayTable> pRayTable(new CFanFlatRayTable());
+		pRayTable->initialize(m_pVecProjectionGeometry, m_pVolumeGeometry);
+		std::atomic_store(&m_pRayTable, std::shared_ptr<const CFanFlatRayTable>(pRayTable));
+	}
 }
 
 //----------------------------------------------------------------------------------------
@@ -116,3 +128,5 @@ float CFanFlatBeamLineKernelProjector2D::angleBetweenVectors(float _fAX, float _
 }
 
 //----------------------------------------------------------------------------------------
+// kernel-independent members
+template class CFanFlatKernelProjector2D<CFanFlatBeamLineKernelProjector2D>;
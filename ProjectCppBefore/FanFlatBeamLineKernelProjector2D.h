@@ -1,16 +1,18 @@
 #ifndef _INC_ASTRA_FANFLATBEAMLINEKERNELPROJECTOR
 #define _INC_ASTRA_FANFLATBEAMLINEKERNELPROJECTOR
 
-#include "FanFlatProjectionGeometry2D.h"
-#include "FanFlatVecProjectionGeometry2D.h"
+#include "FanFlatRayProjector2D.h"
+#include "FanFlatRayTable.h"
 #include "Float32Data2D.h"
-#include "Projector2D.h"
+
+#include <atomic>
+#include <memory>
 
 
 /** This class implements a two-dimensional projector based on a line based kernel
 	* with a fan flat projection geometry.
 	*/
-class CFanFlatBeamLineKernelProjector2D : public CProjector2D {
+class CFanFlatBeamLineKernelProjector2D : public CFanFlatKernelProjector2D<CFanFlatBeamLineKernelProjector2D> {
 
 protected:
 
@@ -26,6 +28,24 @@ protected:
 		*/
 	virtual bool _check();
 
+	/** Drop the ray table, it depends on both geometries.
+		*/
+	virtual void _geometryChanged();
+
+	/** Precomputed ray parameters, NULL unless the ray table is enabled. Only accessed through
+		* std::atomic_load/atomic_store: a projection holds its own reference for as long as it runs,
+		* so replacing or dropping the table never frees it under a projection in progress.
+		*/
+	std::shared_ptr<const CFanFlatRayTable> m_pRayTable;
+
+	/** Should a ray table be kept?
+		*/
+	std::atomic<bool> m_bRayTableEnabled;
+
+	/** Build or drop the ray table to match m_bRayTableEnabled and the current geometries.
+		*/
+	void _updateRayTable();
+
 public:
 
 	// type of the projector, needed to register with CProjectorFactory
@@ -47,15 +67,6 @@ public:
 		*/
 	~CFanFlatBeamLineKernelProjector2D();
 
-	/** Initialize the projector.
-		*
-		* @param _pProjectionGeometry		Information class about the geometry of the projection. Will be HARDCOPIED.
-		* @param _pReconstructionGeometry	Information class about the geometry of the reconstruction volume. Will be HARDCOPIED.
-		* @return initialization successful?
-		*/
-	virtual bool initialize(CFanFlatProjectionGeometry2D* _pProjectionGeometry,
-		CVolumeGeometry2D* _pReconstructionGeometry);
-
 	/** Clear this class.
 		*/
 	virtual void clear();
@@ -112,6 +123,15 @@ public:
 	template <typename Policy>
 	void projectSingleRay(int _iProjection, int _iDetector, Policy& _policy);
 
+	/** Policy-based projection of all rays of a range of projections.
+		*
+		* @param _iProjFrom First projection (inclusive)
+		* @param _iProjTo Last projection (exclusive)
+		* @param _policy Policy object.  Should contain prior, addWeight and posterior function.
+		*/
+	template <typename Policy>
+	void projectAngleRange(int _iProjFrom, int _iProjTo, Policy& _policy);
+
 	/** Return the type of this projector.
 		*
 		* @return identification type of this projector
@@ -120,6 +140,27 @@ public:
 
 	float angleBetweenVectors(float _fAX, float _fAY, float _fBX, float _fBY);
 
+	/** Keep a table of precomputed ray parameters (see CFanFlatRayTable), so that
+		* projections skip the per-ray setup. Off by default, as the table takes
+		* getRayTableMemorySize() bytes, about 25 bytes per ray. Float projections use it,
+		* policies stepping in double precision still set up every ray.
+		*
+		* Safe to call while other threads project with this projector (e.g. a projector shared
+		* through CProjectorCache): projections already running finish with the table they
+		* started with, later ones pick up the new setting. Results are the same either way.
+		*
+		* @param _bEnabled build (true) or release (false) the table
+		*/
+	void setRayTableEnabled(bool _bEnabled);
+
+	/** Is the ray table enabled?
+		*/
+	bool isRayTableEnabled() const;
+
+	/** Memory taken by the ray table, in bytes. 0 if it is disabled.
+		*/
+	size_t getRayTableMemorySize() const;
+
 protected:
 	/** Internal policy-based projection of a range of angles and range.
 		* (_i*From is inclusive, _i*To exclusive) */
@@ -136,6 +177,17 @@ inline std::string CFanFlatBeamLineKernelProjector2D::getType()
 	return type;
 }
 
+inline bool CFanFlatBeamLineKernelProjector2D::isRayTableEnabled() const
+{
+	return m_bRayTableEnabled;
+}
+
+inline size_t CFanFlatBeamLineKernelProjector2D::getRayTableMemorySize() const
+{
+	std::shared_ptr<const CFanFlatRayTable> pRayTable = std::atomic_load(&m_pRayTable);
+	return pRayTable ? pRayTable->getMemorySize() : 0;
+}
+
 
 
 #endif 
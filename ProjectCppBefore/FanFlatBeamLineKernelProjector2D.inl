@@ -1,17 +1,6 @@
-/*
-policy_weight(p, rayindex, volindex, weight) {
-	do {
-		if (p.pixelPrior(volindex)) {
-			p.addWeight(rayindex, volindex, weight);
-			p.pixelPosterior(volindex);
-		}
-	}
-	while (false)
-}
-*/
-#include <iostream>
+#include <type_traits>
 
-#define policy_weight(p,rayindex,volindex,weight) do { if (p.pixelPrior(volindex)) { p.addWeight(rayindex, volindex, weight); p.pixelPosterior(volindex); } } while (false)
+#include "FanFlatRayProjector2D.inl"
 
 template <typename Policy>
 void CFanFlatBeamLineKernelProjector2D::project(Policy& p)
@@ -27,6 +16,13 @@ void CFanFlatBeamLineKernelProjector2D::projectSingleProjection(int _iProjection
 		0, m_pProjectionGeometry->getDetectorCount(), p);
 }
 
+template <typename Policy>
+void CFanFlatBeamLineKernelProjector2D::projectAngleRange(int _iProjFrom, int _iProjTo, Policy& p)
+{
+	projectBlock_internal(_iProjFrom, _iProjTo,
+		0, m_pProjectionGeometry->getDetectorCount(), p);
+}
+
 template <typename Policy>
 void CFanFlatBeamLineKernelProjector2D::projectSingleRay(int _iProjection, int _iDetector, Policy& p)
 {
@@ -35,174 +31,156 @@ void CFanFlatBeamLineKernelProjector2D::projectSingleRay(int _iProjection, int _
 }
 
 //----------------------------------------------------------------------------------------
-// PROJECT BLOCK - vector projection geometry
-template <typename Policy>
-void CFanFlatBeamLineKernelProjector2D::projectBlock_internal(int _iProjFrom, int _iProjTo, int _iDetFrom, int _iDetTo, Policy& p)
-{
-	// get vector geometry
-	const CFanFlatVecProjectionGeometry2D* pVecProjectionGeometry;
-	if (dynamic_cast<CFanFlatProjectionGeometry2D*>(m_pProjectionGeometry)) {
-		pVecProjectionGeometry = dynamic_cast<CFanFlatProjectionGeometry2D*>(m_pProjectionGeometry)->toVectorGeometry();
+// KERNEL - line kernel, the weight of a pixel is the length of the ray within its row
+// (vertical rays) or column (horizontal rays), split over the two nearest pixels
+template <typename Real>
+struct SFanFlatLineKernel {
+	const SLineKernelGrid<Real> grid;
+	const int colCount;
+	const int rowCount;
+	const int rowStride;
+	const CFanFlatRayTable* pRayTable;	///< precomputed rays or NULL
+	ASTRA_INSTRUMENT(uint64_t iPixelsVisited;)
+
+	SFanFlatLineKernel(const CVolumeGeometry2D* _pVolumeGeometry, int _iRowStride, const CFanFlatRayTable* _pRayTable)
+		: grid(_pVolumeGeometry),
+		  colCount(_pVolumeGeometry->getGridColCount()),
+		  rowCount(_pVolumeGeometry->getGridRowCount()),
+		  rowStride(_iRowStride),
+		  pRayTable(_pRayTable)
+	{
+		ASTRA_INSTRUMENT(iPixelsVisited = 0;)
 	}
-	else {
-		pVecProjectionGeometry = dynamic_cast<CFanFlatVecProjectionGeometry2D*>(m_pProjectionGeometry);
-	}
-
-	// precomputations
-	const float pixelLengthX = m_pVolumeGeometry->getPixelLengthX();
-	const float pixelLengthY = m_pVolumeGeometry->getPixelLengthY();
-	const float inv_pixelLengthX = 1.0f / pixelLengthX;
-	const float inv_pixelLengthY = 1.0f / pixelLengthY;
-	const int colCount = m_pVolumeGeometry->getGridColCount();
-	const int rowCount = m_pVolumeGeometry->getGridRowCount();
-	const int detCount = pVecProjectionGeometry->getDetectorCount();
-	const float Ex = m_pVolumeGeometry->getWindowMinX() + pixelLengthX * 0.5f;
-	const float Ey = m_pVolumeGeometry->getWindowMaxY() - pixelLengthY * 0.5f;
-
-	// loop angles
-	for (int iAngle = _iProjFrom; iAngle < _iProjTo; ++iAngle) {
 
+	template <typename Policy>
+	FORCEINLINE void traceRay(const SFanProjection& _proj, int _iDetector, int iRayIndex, Policy& p)
+	{
 		// variables
-		float Dx, Dy, Rx, Ry, S, T, weight, c, r, deltac, deltar, offset, RxOverRy, RyOverRx;
-		float lengthPerRow, lengthPerCol, invTminSTimesLengthPerRow, invTminSTimesLengthPerCol;
-		int iVolumeIndex, iRayIndex, row, col, iDetector;
+		Real S, T, weight, c, r, deltac, deltar, offset;
+		Real lengthPerRow, lengthPerCol, invTminSTimesLengthPerRow, invTminSTimesLengthPerCol;
+		int iVolumeIndex, row, col;
+		SLineKernelRay<Real> ray;
 
-		const SFanProjection* proj = &pVecProjectionGeometry->getProjectionVectors()[iAngle];
+		if (pRayTable)
+			pRayTable->getRay(iRayIndex, ray);
+		else
+			setupFanFlatRay(_proj, _iDetector, grid, ray);
 
-		// loop detectors
-		for (iDetector = _iDetFrom; iDetector < _iDetTo; ++iDetector) {
+		S = ray.S;
+		T = ray.T;
+		bool isin = false;
 
-			iRayIndex = iAngle * detCount + iDetector;
+		// vertically
+		if (ray.vertical) {
+			lengthPerRow = ray.length;
+			deltac = ray.delta;
+			invTminSTimesLengthPerRow = ray.invTminSTimesLength;
 
-			// POLICY: RAY PRIOR
-			if (!p.rayPrior(iRayIndex)) continue;
+			// c for row 0
+			c = ray.start;
 
-			Dx = proj->fDetSX + (iDetector + 0.5f) * proj->fDetUX;
-			Dy = proj->fDetSY + (iDetector + 0.5f) * proj->fDetUY;
+			// for each row
+			for (row = 0; row < rowCount; ++row, c += deltac) {
 
-			Rx = proj->fSrcX - Dx;
-			Ry = proj->fSrcY - Dy;
+				col = int(floor(c + Real(0.5)));
+				if (col < -1 || col > colCount) { if (!isin) continue; else break; }
+				offset = c - Real(col);
 
-			bool vertical = fabs(Rx) < fabs(Ry);
-			bool isin = false;
+				// left
+				if (offset < -S) {
+					weight = (offset + T) * invTminSTimesLengthPerRow;
 
-			// vertically
-			if (vertical) {
-				RxOverRy = Rx / Ry;
-				lengthPerRow = pixelLengthX * sqrt(Rx * Rx + Ry * Ry) / abs(Ry);
-				deltac = -pixelLengthY * RxOverRy * inv_pixelLengthX;
-				S = 0.5f - 0.5f * fabs(RxOverRy);
-				T = 0.5f + 0.5f * fabs(RxOverRy);
-				invTminSTimesLengthPerRow = lengthPerRow / (T - S);
+					iVolumeIndex = row * rowStride + col - 1;
+					if (col > 0) { policy_weight(p, iRayIndex, iVolumeIndex, lengthPerRow - weight); }
 
-				// calculate c for row 0
-				c = (Dx + (Ey - Dy) * RxOverRy - Ex) * inv_pixelLengthX;
+					iVolumeIndex++;
+					if (col >= 0 && col < colCount) { policy_weight(p, iRayIndex, iVolumeIndex, weight); }
+				}
 
-				// for each row
-				for (row = 0; row < rowCount; ++row, c += deltac) {
+				// right
+				else if (S < offset) {
+					weight = (offset - S) * invTminSTimesLengthPerRow;
 
-					col = int(floor(c + 0.5f));
-					if (col < -1 || col > colCount) { if (!isin) continue; else break; }
-					offset = c - float(col);
+					iVolumeIndex = row * rowStride + col;
+					if (col >= 0 && col < colCount) { policy_weight(p, iRayIndex, iVolumeIndex, lengthPerRow - weight); }
 
-					// left
-					if (offset < -S) {
-						weight = (offset + T) * invTminSTimesLengthPerRow;
+					iVolumeIndex++;
+					if (col + 1 < colCount) { policy_weight(p, iRayIndex, iVolumeIndex, weight); }
+				}
 
-						iVolumeIndex = row * colCount + col - 1;
-						if (col > 0) { policy_weight(p, iRayIndex, iVolumeIndex, lengthPerRow - weight); }
+				// centre
+				else if (col >= 0 && col < colCount) {
+					iVolumeIndex = row * rowStride + col;
+					policy_weight(p, iRayIndex, iVolumeIndex, lengthPerRow);
+				}
+				isin = true;
+			}
+		}
 
-						iVolumeIndex++;
-						if (col >= 0 && col < colCount) { policy_weight(p, iRayIndex, iVolumeIndex, weight); }
-					}
+		// horizontally
+		else {
+			lengthPerCol = ray.length;
+			deltar = ray.delta;
+			invTminSTimesLengthPerCol = ray.invTminSTimesLength;
 
-					// right
-					else if (S < offset) {
-						weight = (offset - S) * invTminSTimesLengthPerRow;
+			// r for col 0
+			r = ray.start;
 
-						iVolumeIndex = row * colCount + col;
-						if (col >= 0 && col < colCount) { policy_weight(p, iRayIndex, iVolumeIndex, lengthPerRow - weight); }
+			// for each col
+			for (col = 0; col < colCount; ++col, r += deltar) {
 
-						iVolumeIndex++;
-						if (col + 1 < colCount) { policy_weight(p, iRayIndex, iVolumeIndex, weight); }
-					}
+				row = int(floor(r + Real(0.5)));
+				if (row < -1 || row > rowCount) { if (!isin) continue; else break; }
+				offset = r - Real(row);
 
-					// centre
-					else if (col >= 0 && col < colCount) {
-						iVolumeIndex = row * colCount + col;
-						policy_weight(p, iRayIndex, iVolumeIndex, lengthPerRow);
-					}
-					isin = true;
-				}
-			}
+				// up
+				if (offset < -S) {
+					weight = (offset + T) * invTminSTimesLengthPerCol;
+
+					iVolumeIndex = (row - 1) * rowStride + col;
+					if (row > 0) { policy_weight(p, iRayIndex, iVolumeIndex, lengthPerCol - weight); }
 
-			// horizontally
-			else {
-				RyOverRx = Ry / Rx;
-				lengthPerCol = pixelLengthY * sqrt(Rx * Rx + Ry * Ry) / abs(Rx);
-				deltar = -pixelLengthX * RyOverRx * inv_pixelLengthY;
-				S = 0.5f - 0.5f * fabs(RyOverRx);
-				T = 0.5f + 0.5f * fabs(RyOverRx);
-				invTminSTimesLengthPerCol = lengthPerCol / (T - S);
-
-				// calculate r for col 0
-				r = -(Dy + (Ex - Dx) * RyOverRx - Ey) * inv_pixelLengthY;
-
-				// for each col
-				for (col = 0; col < colCount; ++col, r += deltar) {
-
-					row = int(floor(r + 0.5f));
-					if (row < -1 || row > rowCount) { if (!isin) continue; else break; }
-					offset = r - float(row);
-
-					// up
-					if (offset < -S) {
-						weight = (offset + T) * invTminSTimesLengthPerCol;
-
-						iVolumeIndex = (row - 1) * colCount + col;
-						if (row > 0) { policy_weight(p, iRayIndex, iVolumeIndex, lengthPerCol - weight); }
-
-						iVolumeIndex += colCount;
-						if (row >= 0 && row < rowCount) { policy_weight(p, iRayIndex, iVolumeIndex, weight); }
-					}
-
-					// down
-					else if (S < offset) {
-						weight = (offset - S) * invTminSTimesLengthPerCol;
-
-						iVolumeIndex = row * colCount + col;
-						if (row >= 0 && row < rowCount) { policy_weight(p, iRayIndex, iVolumeIndex, lengthPerCol - weight); }
-
-						iVolumeIndex += colCount;
-						if (row + 1 < rowCount) { policy_weight(p, iRayIndex, iVolumeIndex, weight); }
-					}
-
-					// centre
-					else if (row >= 0 && row < rowCount) {
-						iVolumeIndex = row * colCount + col;
-						policy_weight(p, iRayIndex, iVolumeIndex, lengthPerCol);
-					}
-					isin = true;
+					iVolumeIndex += rowStride;
+					if (row >= 0 && row < rowCount) { policy_weight(p, iRayIndex, iVolumeIndex, weight); }
 				}
-			}
 
-			// POLICY: RAY POSTERIOR
-			p.rayPosterior(iRayIndex);
-			//std::cout << p->policy1.m_pVolumeData.getData()[iRayIndex] << std::endl;
+				// down
+				else if (S < offset) {
+					weight = (offset - S) * invTminSTimesLengthPerCol;
 
-		} // end loop detector
+					iVolumeIndex = row * rowStride + col;
+					if (row >= 0 && row < rowCount) { policy_weight(p, iRayIndex, iVolumeIndex, lengthPerCol - weight); }
 
-		std::cout << Dx << ",";
-		std::cout << Dy << ",";
-		std::cout << Rx << ",";
-		std::cout << Ry << ",";
-		std::cout << S << ",";
-		std::cout << T << std::endl;
+					iVolumeIndex += rowStride;
+					if (row + 1 < rowCount) { policy_weight(p, iRayIndex, iVolumeIndex, weight); }
+				}
 
-	} // end loop angles
+				// centre
+				else if (row >= 0 && row < rowCount) {
+					iVolumeIndex = row * rowStride + col;
+					policy_weight(p, iRayIndex, iVolumeIndex, lengthPerCol);
+				}
+				isin = true;
+			}
+		}
+	}
+};
 
-	// Delete created vec geometry if required
-	if (dynamic_cast<CFanFlatProjectionGeometry2D*>(m_pProjectionGeometry))
-		delete pVecProjectionGeometry;
+//----------------------------------------------------------------------------------------
+// PROJECT BLOCK - vector projection geometry
+template <typename Policy>
+void CFanFlatBeamLineKernelProjector2D::projectBlock_internal(int _iProjFrom, int _iProjTo, int _iDetFrom, int _iDetTo, Policy& p)
+{
+	// stepping type, float unless the policy asks for double (see PolicyStepType)
+	typedef typename PolicyStepType<Policy>::type Real;
+
+	// precomputed rays, only for float stepping (see setRayTableEnabled); the local reference
+	// keeps the table alive until this block is done, even if it is replaced meanwhile
+	std::shared_ptr<const CFanFlatRayTable> pRayTable;
+	if (std::is_same<Real, float>::value) {
+		pRayTable = std::atomic_load(&m_pRayTable);
+	}
 
+	SFanFlatLineKernel<Real> kernel(m_pVolumeGeometry, getVolumeStride(), pRayTable.get());
+	projectRays(kernel, _iProjFrom, _iProjTo, _iDetFrom, _iDetTo, p);
 }
@@ -0,0 +1,59 @@
+#include "FanFlatBeamSiddonKernelProjector2D.h"
+
+#include <algorithm>
+
+#include "DataProjectorPolicies.h"
+#include "FanFlatBeamSiddonKernelProjector2D.inl"
+
+// type of the projector, needed to register with CProjectorFactory
+std::string CFanFlatBeamSiddonKernelProjector2D::type = "siddon_fanflat";
+
+
+//----------------------------------------------------------------------------------------
+// default constructor
+CFanFlatBeamSiddonKernelProjector2D::CFanFlatBeamSiddonKernelProjector2D()
+{
+	_clear();
+}
+
+//----------------------------------------------------------------------------------------
+// constructor
+CFanFlatBeamSiddonKernelProjector2D::CFanFlatBeamSiddonKernelProjector2D(CFanFlatProjectionGeometry2D* _pProjectionGeometry,
+	CVolumeGeometry2D* _pReconstructionGeometry)
+{
+	_clear();
+	initialize(_pProjectionGeometry, _pReconstructionGeometry);
+}
+
+//----------------------------------------------------------------------------------------
+// destructor
+CFanFlatBeamSiddonKernelProjector2D::~CFanFlatBeamSiddonKernelProjector2D()
+{
+	clear();
+}
+
+//----------------------------------------------------------------------------------------
+// Get maximum amount of weights on a single ray
+int CFanFlatBeamSiddonKernelProjector2D::getProjectionWeightsCount(int _iProjectionIndex)
+{
+	// a line crosses at most one pixel more than it crosses grid lines
+	return m_pVolumeGeometry->getGridRowCount() + m_pVolumeGeometry->getGridColCount();
+}
+
+//----------------------------------------------------------------------------------------
+// Single Ray Weights
+void CFanFlatBeamSiddonKernelProjector2D::computeSingleRayWeights(int _iProjectionIndex,
+	int _iDetectorIndex,
+	SPixelWeight* _pWeightedPixels,
+	int _iMaxPixelCount,
+	int& _iStoredPixelCount)
+{
+	ASTRA_ASSERT(m_bIsInitialized);
+	StorePixelWeightsPolicy p(_pWeightedPixels, _iMaxPixelCount);
+	projectSingleRay(_iProjectionIndex, _iDetectorIndex, p);
+	_iStoredPixelCount = p.getStoredPixelCount();
+}
+
+//----------------------------------------------------------------------------------------
+// kernel-independent members
+template class CFanFlatKernelProjector2D<CFanFlatBeamSiddonKernelProjector2D>;
@@ -0,0 +1,146 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "FanFlatRayProjector2D.inl"
+
+template <typename Policy>
+void CFanFlatBeamSiddonKernelProjector2D::project(Policy& p)
+{
+	projectBlock_internal(0, m_pProjectionGeometry->getProjectionAngleCount(),
+		0, m_pProjectionGeometry->getDetectorCount(), p);
+}
+
+template <typename Policy>
+void CFanFlatBeamSiddonKernelProjector2D::projectSingleProjection(int _iProjection, Policy& p)
+{
+	projectBlock_internal(_iProjection, _iProjection + 1,
+		0, m_pProjectionGeometry->getDetectorCount(), p);
+}
+
+template <typename Policy>
+void CFanFlatBeamSiddonKernelProjector2D::projectAngleRange(int _iProjFrom, int _iProjTo, Policy& p)
+{
+	projectBlock_internal(_iProjFrom, _iProjTo,
+		0, m_pProjectionGeometry->getDetectorCount(), p);
+}
+
+template <typename Policy>
+void CFanFlatBeamSiddonKernelProjector2D::projectSingleRay(int _iProjection, int _iDetector, Policy& p)
+{
+	projectBlock_internal(_iProjection, _iProjection + 1,
+		_iDetector, _iDetector + 1, p);
+}
+
+//----------------------------------------------------------------------------------------
+// KERNEL - Siddon kernel, the weight of a pixel is the length of the ray inside it.
+// The ray is the line from the source through the centre of the detector pixel, traced
+// over the grid lines it crosses (in the incremental form of Jacobs et al.), in double
+// so that it can serve as the reference for the other kernels.
+template <typename Real>
+struct SFanFlatSiddonKernel {
+	const double minX;
+	const double maxY;
+	const double inv_pixelLengthX;
+	const double inv_pixelLengthY;
+	const int colCount;
+	const int rowCount;
+	const int rowStride;
+	ASTRA_INSTRUMENT(uint64_t iPixelsVisited;)
+
+	SFanFlatSiddonKernel(const CVolumeGeometry2D* _pVolumeGeometry, int _iRowStride)
+		: minX(_pVolumeGeometry->getWindowMinX()),
+		  maxY(_pVolumeGeometry->getWindowMaxY()),
+		  inv_pixelLengthX(1.0 / _pVolumeGeometry->getPixelLengthX()),
+		  inv_pixelLengthY(1.0 / _pVolumeGeometry->getPixelLengthY()),
+		  colCount(_pVolumeGeometry->getGridColCount()),
+		  rowCount(_pVolumeGeometry->getGridRowCount()),
+		  rowStride(_iRowStride)
+	{
+		ASTRA_INSTRUMENT(iPixelsVisited = 0;)
+	}
+
+	// clip the parameter range [_aMin, _aMax] of u0 + a * du to [0, _iCount]
+	static FORCEINLINE bool clip(double u0, double du, int _iCount, double& _aMin, double& _aMax)
+	{
+		if (du == 0.0)
+			return u0 >= 0.0 && u0 <= _iCount;
+		double a0 = -u0 / du;
+		double a1 = (_iCount - u0) / du;
+		_aMin = std::max(_aMin, std::min(a0, a1));
+		_aMax = std::min(_aMax, std::max(a0, a1));
+		return true;
+	}
+
+	// first cell of u0 + a * du at entry parameter _a, and the parameter of its next boundary
+	static FORCEINLINE int enter(double u0, double du, int _iCount, double _a, double& _aNext, double& _aStep)
+	{
+		double u = u0 + _a * du;
+		int cell = (du >= 0.0) ? int(floor(u)) : int(ceil(u)) - 1;
+		cell = std::min(std::max(cell, 0), _iCount - 1);
+		if (du == 0.0) {
+			_aNext = _aStep = std::numeric_limits<double>::infinity();
+		} else {
+			_aStep = 1.0 / std::fabs(du);
+			_aNext = ((du > 0.0 ? cell + 1 : cell) - u0) / du;
+		}
+		return cell;
+	}
+
+	template <typename Policy>
+	FORCEINLINE void traceRay(const SFanProjection& _proj, int _iDetector, int iRayIndex, Policy& p)
+	{
+		// ray S + a * (D - S) in grid coordinates u (columns, left to right) and v (rows, top to bottom)
+		double Dx = _proj.fDetSX + (_iDetector + 0.5) * _proj.fDetUX;
+		double Dy = _proj.fDetSY + (_iDetector + 0.5) * _proj.fDetUY;
+		double Rx = Dx - _proj.fSrcX;
+		double Ry = Dy - _proj.fSrcY;
+		double length = sqrt(Rx * Rx + Ry * Ry);
+
+		double u0 = (_proj.fSrcX - minX) * inv_pixelLengthX;
+		double v0 = (maxY - _proj.fSrcY) * inv_pixelLengthY;
+		double du = Rx * inv_pixelLengthX;
+		double dv = -Ry * inv_pixelLengthY;
+
+		// part of the line inside the volume
+		double aMin = -std::numeric_limits<double>::infinity();
+		double aMax = std::numeric_limits<double>::infinity();
+		if (!clip(u0, du, colCount, aMin, aMax) || !clip(v0, dv, rowCount, aMin, aMax) || !(aMin < aMax))
+			return;
+
+		double aU, aV, stepU, stepV;
+		int col = enter(u0, du, colCount, aMin, aU, stepU);
+		int row = enter(v0, dv, rowCount, aMin, aV, stepV);
+		const int dcol = (du > 0.0) ? 1 : -1;
+		const int drow = (dv > 0.0) ? 1 : -1;
+
+		// walk the cells, from one grid line crossing to the next
+		double a = aMin;
+		while (a < aMax) {
+			double aNext = std::min(std::min(aU, aV), aMax);
+
+			double weight = (aNext - a) * length;
+			if (weight > 0.0) {
+				int iVolumeIndex = row * rowStride + col;
+				policy_weight(p, iRayIndex, iVolumeIndex, Real(weight));
+			}
+
+			if (aNext == aU) { col += dcol; aU += stepU; }
+			if (aNext == aV) { row += drow; aV += stepV; }
+			if (col < 0 || col >= colCount || row < 0 || row >= rowCount) break;
+			a = aNext;
+		}
+	}
+};
+
+//----------------------------------------------------------------------------------------
+// PROJECT BLOCK - vector projection geometry
+template <typename Policy>
+void CFanFlatBeamSiddonKernelProjector2D::projectBlock_internal(int _iProjFrom, int _iProjTo, int _iDetFrom, int _iDetTo, Policy& p)
+{
+	// the ray is traced in double, weights are handed out in the stepping type of the policy
+	typedef typename PolicyStepType<Policy>::type Real;
+
+	SFanFlatSiddonKernel<Real> kernel(m_pVolumeGeometry, getVolumeStride());
+	projectRays(kernel, _iProjFrom, _iProjTo, _iDetFrom, _iDetTo, p);
+}
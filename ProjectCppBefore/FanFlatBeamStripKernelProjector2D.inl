@@ -0,0 +1,143 @@
+#include "FanFlatRayProjector2D.inl"
+
+template <typename Policy>
+void CFanFlatBeamStripKernelProjector2D::project(Policy& p)
+{
+	projectBlock_internal(0, m_pProjectionGeometry->getProjectionAngleCount(),
+		0, m_pProjectionGeometry->getDetectorCount(), p);
+}
+
+template <typename Policy>
+void CFanFlatBeamStripKernelProjector2D::projectSingleProjection(int _iProjection, Policy& p)
+{
+	projectBlock_internal(_iProjection, _iProjection + 1,
+		0, m_pProjectionGeometry->getDetectorCount(), p);
+}
+
+template <typename Policy>
+void CFanFlatBeamStripKernelProjector2D::projectAngleRange(int _iProjFrom, int _iProjTo, Policy& p)
+{
+	projectBlock_internal(_iProjFrom, _iProjTo,
+		0, m_pProjectionGeometry->getDetectorCount(), p);
+}
+
+template <typename Policy>
+void CFanFlatBeamStripKernelProjector2D::projectSingleRay(int _iProjection, int _iDetector, Policy& p)
+{
+	projectBlock_internal(_iProjection, _iProjection + 1,
+		_iDetector, _iDetector + 1, p);
+}
+
+//----------------------------------------------------------------------------------------
+// RAMP AREA - the area of the part of a row (of height 1) that is left of axis coordinate
+// _u + a but right of an edge that runs from a to a + _width over the height of the row,
+// _invWidth = 1 / _width: the row clipped by a vertical line and the edge, in closed
+// form. The area of the strip between edges L and R left of x is then
+// rampArea(x - aL) - rampArea(x - aR), and that of a pixel the difference at its two
+// boundaries.
+template <typename Real>
+FORCEINLINE Real stripRampArea(Real _u, Real _width, Real _invWidth)
+{
+	Real t = std::min(_width, std::max(Real(0), _u));
+	return t * t * Real(0.5) * _invWidth + std::max(Real(0), _u - _width);
+}
+
+//----------------------------------------------------------------------------------------
+// KERNEL - strip kernel: the weight of a pixel is the area of its intersection with the
+// strip between the two edges of the detector pixel, computed per row (or column) from
+// the strip area left of each pixel boundary, and scaled by the length of the ray within
+// the row over the width of the strip at the row
+template <typename Real>
+struct SFanFlatStripKernel {
+	const SLineKernelGrid<Real> grid;
+	const int colCount;
+	const int rowCount;
+	const int rowStride;
+	const int detCount;
+	ASTRA_INSTRUMENT(uint64_t iPixelsVisited;)
+
+	SFanFlatStripKernel(const CVolumeGeometry2D* _pVolumeGeometry, int _iRowStride, int _iDetectorCount)
+		: grid(_pVolumeGeometry),
+		  colCount(_pVolumeGeometry->getGridColCount()),
+		  rowCount(_pVolumeGeometry->getGridRowCount()),
+		  rowStride(_iRowStride),
+		  detCount(_iDetectorCount)
+	{
+		ASTRA_INSTRUMENT(iPixelsVisited = 0;)
+	}
+
+	template <typename Policy>
+	FORCEINLINE void traceRay(const SFanProjection& _proj, int _iDetector, int iRayIndex, Policy& p)
+	{
+		const bool vertical = isFanFlatFootprintVertical(_proj, detCount);
+		SFanFlatFootprint<Real> ray;
+		setupFanFlatFootprint(_proj, _iDetector, vertical, grid, ray);
+
+		// vertical: steps are rows, the axis runs over the columns of a row
+		const int stepCount = vertical ? rowCount : colCount;
+		const int axisCount = vertical ? colCount : rowCount;
+		const int stepStride = vertical ? rowStride : 1;
+		const int axisStride = vertical ? 1 : rowStride;
+
+		// edge L left of edge R on the axis, in the middle of the volume
+		const bool swap = ray.start1 + Real(0.5 * stepCount) * ray.delta1 < ray.start0 + Real(0.5 * stepCount) * ray.delta0;
+		const Real deltaL = swap ? ray.delta1 : ray.delta0;
+		const Real deltaR = swap ? ray.delta0 : ray.delta1;
+		const Real widthL = std::fabs(deltaL);
+		const Real widthR = std::fabs(deltaR);
+		// (finite for edges along the steps, where t is 0)
+		const Real invWidthL = Real(1) / std::max(widthL, Real(1e-20));
+		const Real invWidthR = Real(1) / std::max(widthR, Real(1e-20));
+
+		// the lower end (a) of each edge within step 0, the upper end is a + width
+		Real aL = (swap ? ray.start1 : ray.start0) - Real(0.5) * widthL;
+		Real aR = (swap ? ray.start0 : ray.start1) - Real(0.5) * widthR;
+		bool isin = false;
+
+		for (int step = 0; step < stepCount; ++step, aL += deltaL, aR += deltaR) {
+
+			const Real bL = aL + widthL;
+			const Real bR = aR + widthR;
+			if (bR <= Real(0) || aL >= Real(axisCount)) { if (!isin) continue; else break; }
+			isin = true;
+
+			// width of the strip at the centre of the row
+			const Real width = Real(0.5) * (aR + bR - aL - bL);
+
+			// strip narrower than rounding: all of the row to the pixel it is in
+			if (!(width > Real(1e-6))) {
+				int i = int(Real(0.5) * (aL + bL));
+				if (i >= 0 && i < axisCount) { policy_weight(p, iRayIndex, step * stepStride + i * axisStride, ray.length); }
+				continue;
+			}
+
+			// the area of every pixel the strip touches, from the area left of its boundaries
+			// (bR > 0, and the truncation of max(aL, 0) is its floor)
+			const Real scale = ray.length / width;
+			int i = int(std::max(aL, Real(0)));
+			const int iLast = std::min(axisCount - 1, int(bR));
+			int iVolumeIndex = step * stepStride + i * axisStride;
+			Real x = Real(i);
+			Real areaLeft = stripRampArea(x - aL, widthL, invWidthL) - stripRampArea(x - aR, widthR, invWidthR);
+			for (; i <= iLast; ++i, iVolumeIndex += axisStride) {
+				x += Real(1);
+				Real areaRight = stripRampArea(x - aL, widthL, invWidthL) - stripRampArea(x - aR, widthR, invWidthR);
+				Real area = areaRight - areaLeft;
+				if (area > Real(0)) { policy_weight(p, iRayIndex, iVolumeIndex, area * scale); }
+				areaLeft = areaRight;
+			}
+		}
+	}
+};
+
+//----------------------------------------------------------------------------------------
+// PROJECT BLOCK - vector projection geometry
+template <typename Policy>
+void CFanFlatBeamStripKernelProjector2D::projectBlock_internal(int _iProjFrom, int _iProjTo, int _iDetFrom, int _iDetTo, Policy& p)
+{
+	// stepping type, float unless the policy asks for double (see PolicyStepType)
+	typedef typename PolicyStepType<Policy>::type Real;
+
+	SFanFlatStripKernel<Real> kernel(m_pVolumeGeometry, getVolumeStride(), m_pVecProjectionGeometry->getDetectorCount());
+	projectRays(kernel, _iProjFrom, _iProjTo, _iDetFrom, _iDetTo, p);
+}
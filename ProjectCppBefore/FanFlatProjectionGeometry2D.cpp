@@ -1,5 +1,6 @@
 #include "FanFlatProjectionGeometry2D.h"
 #include "GeometryUtil2D.h"
+#include "Instrumentation.h"
 
 #include <cstring>
 #include <sstream>
@@ -24,6 +25,7 @@ CFanFlatProjectionGeometry2D::CFanFlatProjectionGeometry2D(int _iProjectionAngle
 	float _fOriginSourceDistance,
 	float _fOriginDetectorDistance)
 {
+	_clear();
 	this->initialize(_iProjectionAngleCount,
 		_iDetectorCount,
 		_fDetectorWidth,
@@ -51,6 +53,7 @@ CFanFlatProjectionGeometry2D& CFanFlatProjectionGeometry2D::operator=(const CFan
 {
 	if (m_bInitialized)
 		delete[] m_pfProjectionAngles;
+	_resetFingerprint();
 	m_bInitialized = _other.m_bInitialized;
 	if (m_bInitialized) {
 		m_iProjectionAngleCount = _other.m_iProjectionAngleCount;
@@ -63,6 +66,29 @@ CFanFlatProjectionGeometry2D& CFanFlatProjectionGeometry2D::operator=(const CFan
 	}
 	return *this;
 }
+
+//----------------------------------------------------------------------------------------
+// Move Constructor
+CFanFlatProjectionGeometry2D::CFanFlatProjectionGeometry2D(CFanFlatProjectionGeometry2D&& _projGeom)
+{
+	_clear();
+	_takeProjectionGeometry(_projGeom);
+	m_fOriginSourceDistance = _projGeom.m_fOriginSourceDistance;
+	m_fOriginDetectorDistance = _projGeom.m_fOriginDetectorDistance;
+}
+
+//----------------------------------------------------------------------------------------
+// Move assignment operator.
+CFanFlatProjectionGeometry2D& CFanFlatProjectionGeometry2D::operator=(CFanFlatProjectionGeometry2D&& _other)
+{
+	if (this != &_other) {
+		_takeProjectionGeometry(_other);
+		m_fOriginSourceDistance = _other.m_fOriginSourceDistance;
+		m_fOriginDetectorDistance = _other.m_fOriginDetectorDistance;
+	}
+	return *this;
+}
+
 //----------------------------------------------------------------------------------------
 // Destructor.
 CFanFlatProjectionGeometry2D::~CFanFlatProjectionGeometry2D()
@@ -111,6 +137,7 @@ bool CFanFlatProjectionGeometry2D::isEqual(CProjectionGeometry2D* _pGeom2) const
 
 	// both objects must be initialized
 	if (!m_bInitialized || !pGeom2->m_bInitialized) return false;
+	if (_isKnownEqual(pGeom2)) return true;
 
 	// check all values
 	if (m_iProjectionAngleCount != pGeom2->m_iProjectionAngleCount) return false;
@@ -119,13 +146,26 @@ bool CFanFlatProjectionGeometry2D::isEqual(CProjectionGeometry2D* _pGeom2) const
 	if (m_fOriginSourceDistance != pGeom2->m_fOriginSourceDistance) return false;
 	if (m_fOriginDetectorDistance != pGeom2->m_fOriginDetectorDistance) return false;
 
+	// fast reject, then the angles themselves, as different geometries may share a fingerprint
+	if (getFingerprint() != pGeom2->getFingerprint()) return false;
 	for (int i = 0; i < m_iProjectionAngleCount; ++i) {
 		if (m_pfProjectionAngles[i] != pGeom2->m_pfProjectionAngles[i]) return false;
 	}
 
+	_setKnownEqual(pGeom2);
 	return true;
 }
 
+//----------------------------------------------------------------------------------------
+// Fingerprint
+void CFanFlatProjectionGeometry2D::_fingerprint(CFingerprint& _fingerprint) const
+{
+	_fingerprint.add("fanflat");
+	CProjectionGeometry2D::_fingerprint(_fingerprint);
+	_fingerprint.add(m_fOriginSourceDistance);
+	_fingerprint.add(m_fOriginDetectorDistance);
+}
+
 //----------------------------------------------------------------------------------------
 // Is of type
 bool CFanFlatProjectionGeometry2D::isOfType(const std::string& _sType)
@@ -137,6 +177,8 @@ bool CFanFlatProjectionGeometry2D::isOfType(const std::string& _sType)
 //----------------------------------------------------------------------------------------
 CFanFlatVecProjectionGeometry2D* CFanFlatProjectionGeometry2D::toVectorGeometry()
 {
+	ASTRA_TIMER(STAGE_GEOMETRY_SETUP);
+
 	SFanProjection* vectors = genFanProjections(m_iProjectionAngleCount,
 		m_iDetectorCount,
 		m_fOriginSourceDistance,
@@ -19,6 +19,12 @@ class CFanFlatProjectionGeometry2D : public CProjectionGeometry2D
 		*/
 	float m_fOriginDetectorDistance;
 
+protected:
+
+	/** Add the type, the common values and both distances to _fingerprint.
+		*/
+	virtual void _fingerprint(CFingerprint& _fingerprint) const;
+
 public:
 
 	/** Default constructor. Sets all variables to zero. Note that this constructor leaves the object in an unusable state and must
@@ -51,6 +57,14 @@ public:
 		*/
 	CFanFlatProjectionGeometry2D& operator=(const CFanFlatProjectionGeometry2D& _other);
 
+	/** Move constructor. Takes over the projection angles of _projGeom, which is left cleared.
+		*/
+	CFanFlatProjectionGeometry2D(CFanFlatProjectionGeometry2D&& _projGeom);
+
+	/** Move assignment operator. Takes over the projection angles of _other, which is left cleared.
+		*/
+	CFanFlatProjectionGeometry2D& operator=(CFanFlatProjectionGeometry2D&& _other);
+
 	/** Destructor.
 		*/
 	virtual ~CFanFlatProjectionGeometry2D();
@@ -0,0 +1,90 @@
+#include "FanFlatRayProjector2D.h"
+
+#include "RayWeightCache.h"
+
+
+//----------------------------------------------------------------------------------------
+// default constructor
+CFanFlatRayProjector2D::CFanFlatRayProjector2D()
+{
+	m_pVecProjectionGeometry = NULL;
+}
+
+//----------------------------------------------------------------------------------------
+// destructor
+CFanFlatRayProjector2D::~CFanFlatRayProjector2D()
+{
+	delete m_pVecProjectionGeometry;
+	m_pVecProjectionGeometry = NULL;
+}
+
+//---------------------------------------------------------------------------------------
+// Clear - Constructors
+void CFanFlatRayProjector2D::_clear()
+{
+	CProjector2D::_clear();
+	m_pVecProjectionGeometry = NULL;
+	m_bIsInitialized = false;
+}
+
+//---------------------------------------------------------------------------------------
+// Clear - Public
+void CFanFlatRayProjector2D::clear()
+{
+	CProjector2D::clear();
+	delete m_pVecProjectionGeometry;
+	m_pVecProjectionGeometry = NULL;
+	m_bIsInitialized = false;
+}
+
+//---------------------------------------------------------------------------------------
+// Check
+bool CFanFlatRayProjector2D::_check()
+{
+	// check base class
+	ASTRA_CONFIG_CHECK(CProjector2D::_check(), "FanFlatRayProjector2D", "Error in Projector2D initialization");
+
+	ASTRA_CONFIG_CHECK(dynamic_cast<CFanFlatProjectionGeometry2D*>(m_pProjectionGeometry) || dynamic_cast<CFanFlatVecProjectionGeometry2D*>(m_pProjectionGeometry), "FanFlatRayProjector2D", "Unsupported projection geometry");
+	ASTRA_CONFIG_CHECK(m_pVecProjectionGeometry && m_pVecProjectionGeometry->isInitialized(), "FanFlatRayProjector2D", "Invalid vector projection geometry");
+
+	// success
+	return true;
+}
+
+//---------------------------------------------------------------------------------------
+// Initialize
+bool CFanFlatRayProjector2D::initialize(CFanFlatProjectionGeometry2D* _pProjectionGeometry,
+	CVolumeGeometry2D* _pVolumeGeometry)
+{
+	// if already initialized with the same geometries, keep the current copies
+	if (m_bIsInitialized && m_pProjectionGeometry->isEqual(_pProjectionGeometry) && m_pVolumeGeometry->isEqual(_pVolumeGeometry)) {
+		return true;
+	}
+
+	// hardcopy geometries, only replacing the ones that changed
+	CProjectionGeometry2D* pProjectionGeometry = m_pProjectionGeometry;
+	CVolumeGeometry2D* pVolumeGeometry = m_pVolumeGeometry;
+	if (!m_bIsInitialized || !pProjectionGeometry->isEqual(_pProjectionGeometry)) {
+		pProjectionGeometry = _pProjectionGeometry->clone();
+		delete m_pProjectionGeometry;
+
+		// the vector form only depends on the projection geometry
+		delete m_pVecProjectionGeometry;
+		m_pVecProjectionGeometry = _pProjectionGeometry->toVectorGeometry();
+	}
+	if (!m_bIsInitialized || !pVolumeGeometry->isEqual(_pVolumeGeometry)) {
+		pVolumeGeometry = _pVolumeGeometry->clone();
+		delete m_pVolumeGeometry;
+	}
+	m_pProjectionGeometry = pProjectionGeometry;
+	m_pVolumeGeometry = pVolumeGeometry;
+
+	// cached weights belong to the previous geometries
+	if (m_pRayWeightCache)
+		m_pRayWeightCache->clear();
+
+	// success
+	m_bIsInitialized = _check();
+	_geometryChanged();
+	return m_bIsInitialized;
+}
@@ -0,0 +1,130 @@
+#ifndef _INC_ASTRA_FANFLATRAYPROJECTOR
+#define _INC_ASTRA_FANFLATRAYPROJECTOR
+
+#include "FanFlatProjectionGeometry2D.h"
+#include "FanFlatVecProjectionGeometry2D.h"
+#include "Projector2D.h"
+
+
+/** Base class of the ray-driven projectors with a fan flat projection geometry.
+	*
+	* It owns the geometries and their vector form, and provides the traversal skeleton
+	* projectRays(): the loops over angles and detectors, the ray policy callbacks and the
+	* instrumentation. A projector only supplies a kernel that computes the pixel weights
+	* of one ray. Everything built on the skeleton (angle-parallel projection, ISA variants,
+	* cancellation) therefore applies to every kernel alike.
+	*
+	* A kernel is a class with
+	* \code
+	*   template <typename Policy>
+	*   void traceRay(const SFanProjection& _proj, int _iDetector, int _iRayIndex, Policy& _policy);
+	* \endcode
+	* that reports the weights of the ray with policy_weight(), and, when instrumentation is
+	* enabled, a member iPixelsVisited (see FanFlatRayProjector2D.inl).
+	*/
+class CFanFlatRayProjector2D : public CProjector2D {
+
+protected:
+
+	/** Initial clearing. Only to be used by constructors.
+		*/
+	virtual void _clear();
+
+	/** Check the values of this object.  If everything is ok, the object can be set to the initialized state.
+		* The following statements are then guaranteed to hold:
+		* - no NULL pointers
+		* - all sub-objects are initialized properly
+		*/
+	virtual bool _check();
+
+	/** Called by initialize() after the geometries have been replaced, to rebuild whatever
+		* a projector derives from them.
+		*/
+	virtual void _geometryChanged() { }
+
+	/** Project the rays of a block of angles and detectors with a kernel.
+		* (_i*From is inclusive, _i*To exclusive)
+		*/
+	template <typename Kernel, typename Policy>
+	ASTRA_ISA_VARIANTS void projectRays(Kernel& _kernel, int _iProjFrom, int _iProjTo,
+		int _iDetFrom, int _iDetTo, Policy& _policy);
+
+	/** Vector form of the projection geometry, built once per projection geometry. Owned by the projector.
+		*/
+	CFanFlatVecProjectionGeometry2D* m_pVecProjectionGeometry;
+
+	/** Default constructor.
+		*/
+	CFanFlatRayProjector2D();
+
+public:
+
+	/** Destructor.
+		*/
+	virtual ~CFanFlatRayProjector2D();
+
+	/** Initialize the projector.
+		*
+		* Calling this again with geometries equal to the current ones keeps the existing copies.
+		*
+		* @param _pProjectionGeometry		Information class about the geometry of the projection. Will be HARDCOPIED.
+		* @param _pReconstructionGeometry	Information class about the geometry of the reconstruction volume. Will be HARDCOPIED.
+		* @return initialization successful?
+		*/
+	virtual bool initialize(CFanFlatProjectionGeometry2D* _pProjectionGeometry,
+		CVolumeGeometry2D* _pReconstructionGeometry);
+
+	/** Clear this class.
+		*/
+	virtual void clear();
+
+	/** Get the vector form of the projection geometry used for projection.
+		*
+		* @return vector projection geometry, owned by the projector
+		*/
+	const CFanFlatVecProjectionGeometry2D* getVecProjectionGeometry() const;
+
+};
+
+//----------------------------------------------------------------------------------------
+
+inline const CFanFlatVecProjectionGeometry2D* CFanFlatRayProjector2D::getVecProjectionGeometry() const
+{
+	return m_pVecProjectionGeometry;
+}
+
+
+//----------------------------------------------------------------------------------------
+
+/** Base class of the fan flat ray projector Projector, for the members that are the same
+	* for every kernel but have to call the projector's own policy-based projection. Projector
+	* derives from CFanFlatKernelProjector2D<Projector>, and its .cpp file instantiates it
+	* (see FanFlatRayProjector2D.inl).
+	*/
+template <typename Projector>
+class CFanFlatKernelProjector2D : public CFanFlatRayProjector2D {
+
+public:
+
+
+	/** Compute the pixel weights for a single ray, with the volume indices and the weights
+		* stored in separate arrays.
+		*
+		* @param _iProjectionIndex	Index of the projection
+		* @param _iDetectorIndex	Index of the detector pixel
+		* @param _piIndices			Pointer to a pre-allocated array of _iMaxPixelCount volume indices.
+		* @param _pfWeights			Pointer to a pre-allocated array of _iMaxPixelCount weights.
+		* @param _iMaxPixelCount	Maximum number of pixels (and corresponding weights) that can be stored.
+		*							This number MUST be greater than the total number of pixels on the ray.
+		* @param _iStoredPixelCount On return, this variable contains the total number of pixels on the ray.
+		*/
+	virtual void computeSingleRaySplitWeights(int _iProjectionIndex,
+		int _iDetectorIndex,
+		int* _piIndices,
+		float* _pfWeights,
+		int _iMaxPixelCount,
+		int& _iStoredPixelCount);
+
+};
+
+#endif // _INC_ASTRA_FANFLATRAYPROJECTOR
@@ -0,0 +1,74 @@
+#ifndef _INC_ASTRA_FANFLATRAYPROJECTOR_INL
+#define _INC_ASTRA_FANFLATRAYPROJECTOR_INL
+
+/*
+policy_weight(p, rayindex, volindex, weight) {
+	do {
+		if (p.pixelPrior(volindex)) {
+			p.addWeight(rayindex, volindex, weight);
+			p.pixelPosterior(volindex);
+		}
+	}
+	while (false)
+}
+*/
+
+#include "DataProjectorPolicies.h"
+#include "Instrumentation.h"
+
+#define policy_weight(p,rayindex,volindex,weight) do { ASTRA_INSTRUMENT(++iPixelsVisited;) if (p.pixelPrior(volindex)) { p.addWeight(rayindex, volindex, weight); p.pixelPosterior(volindex); } } while (false)
+
+//----------------------------------------------------------------------------------------
+// PROJECT RAYS - traversal skeleton shared by all kernels
+template <typename Kernel, typename Policy>
+void CFanFlatRayProjector2D::projectRays(Kernel& _kernel, int _iProjFrom, int _iProjTo, int _iDetFrom, int _iDetTo, Policy& p)
+{
+	ASTRA_TIMER(STAGE_PROJECTION);
+	ASTRA_COUNT(COUNTER_RAYS, (uint64_t)(_iProjTo - _iProjFrom) * (_iDetTo - _iDetFrom));
+
+	// vector geometry, built in initialize()
+	const SFanProjection* pProjections = m_pVecProjectionGeometry->getProjectionVectors();
+	const int detCount = m_pVecProjectionGeometry->getDetectorCount();
+
+	// loop angles
+	for (int iAngle = _iProjFrom; iAngle < _iProjTo; ++iAngle) {
+
+		const SFanProjection& proj = pProjections[iAngle];
+
+		// loop detectors
+		for (int iDetector = _iDetFrom; iDetector < _iDetTo; ++iDetector) {
+
+			int iRayIndex = iAngle * detCount + iDetector;
+
+			// POLICY: RAY PRIOR
+			if (!p.rayPrior(iRayIndex)) continue;
+
+			_kernel.traceRay(proj, iDetector, iRayIndex, p);
+
+			// POLICY: RAY POSTERIOR
+			p.rayPosterior(iRayIndex);
+
+		} // end loop detector
+
+	} // end loop angles
+
+	ASTRA_COUNT(COUNTER_PIXELS, _kernel.iPixelsVisited);
+}
+
+//----------------------------------------------------------------------------------------
+// Single Ray Weights, indices and weights apart
+template <typename Projector>
+void CFanFlatKernelProjector2D<Projector>::computeSingleRaySplitWeights(int _iProjectionIndex,
+	int _iDetectorIndex,
+	int* _piIndices,
+	float* _pfWeights,
+	int _iMaxPixelCount,
+	int& _iStoredPixelCount)
+{
+	ASTRA_ASSERT(m_bIsInitialized);
+	StoreSplitPixelWeightsPolicy p(_piIndices, _pfWeights, _iMaxPixelCount);
+	static_cast<Projector*>(this)->projectSingleRay(_iProjectionIndex, _iDetectorIndex, p);
+	_iStoredPixelCount = p.getStoredPixelCount();
+}
+
+#endif // _INC_ASTRA_FANFLATRAYPROJECTOR_INL
@@ -0,0 +1,210 @@
+#include "FanFlatRayTable.h"
+
+#include "Float32MemoryPool.h"
+#include "Instrumentation.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define RAYTABLE_SIMD_TARGET(x) __attribute__((target(x)))
+#define RAYTABLE_HAS_AVX2() __builtin_cpu_supports("avx2")
+#define RAYTABLE_SIMD
+#elif defined(_MSC_VER) && defined(__AVX2__)
+#include <immintrin.h>
+#define RAYTABLE_SIMD_TARGET(x)
+#define RAYTABLE_HAS_AVX2() true
+#define RAYTABLE_SIMD
+#endif
+
+
+// destination of the rays of one angle
+struct SRayTableRow {
+	float* pfStart;
+	float* pfDelta;
+	float* pfLength;
+	float* pfS;
+	float* pfT;
+	float* pfInvTminSTimesLength;
+	unsigned char* pbVertical;
+};
+
+//----------------------------------------------------------------------------------------
+// Scalar
+static void _setupRowScalar(const SFanProjection& _proj, const SLineKernelGrid<float>& _grid,
+	int _iDetFrom, int _iDetTo, const SRayTableRow& _row)
+{
+	for (int iDetector = _iDetFrom; iDetector < _iDetTo; ++iDetector) {
+		SLineKernelRay<float> ray;
+		setupFanFlatRay(_proj, iDetector, _grid, ray);
+		_row.pfStart[iDetector] = ray.start;
+		_row.pfDelta[iDetector] = ray.delta;
+		_row.pfLength[iDetector] = ray.length;
+		_row.pfS[iDetector] = ray.S;
+		_row.pfT[iDetector] = ray.T;
+		_row.pfInvTminSTimesLength[iDetector] = ray.invTminSTimesLength;
+		_row.pbVertical[iDetector] = ray.vertical;
+	}
+}
+
+#ifdef RAYTABLE_SIMD
+
+//----------------------------------------------------------------------------------------
+// AVX2, 8 detectors at a time. Same operations in the same order as setupFanFlatRay(),
+// so the table matches the rays the projector sets up itself.
+RAYTABLE_SIMD_TARGET("avx2")
+static void _setupRowAVX2(const SFanProjection& _proj, const SLineKernelGrid<float>& _grid,
+	int _iDetCount, const SRayTableRow& _row)
+{
+	const __m256 signMask = _mm256_set1_ps(-0.0f);
+	const __m256 half = _mm256_set1_ps(0.5f);
+	const __m256 srcX = _mm256_set1_ps(_proj.fSrcX);
+	const __m256 srcY = _mm256_set1_ps(_proj.fSrcY);
+	const __m256 detSX = _mm256_set1_ps(_proj.fDetSX);
+	const __m256 detSY = _mm256_set1_ps(_proj.fDetSY);
+	const __m256 detUX = _mm256_set1_ps(_proj.fDetUX);
+	const __m256 detUY = _mm256_set1_ps(_proj.fDetUY);
+	const __m256 pixelLengthX = _mm256_set1_ps(_grid.pixelLengthX);
+	const __m256 pixelLengthY = _mm256_set1_ps(_grid.pixelLengthY);
+	const __m256 inv_pixelLengthX = _mm256_set1_ps(_grid.inv_pixelLengthX);
+	const __m256 inv_pixelLengthY = _mm256_set1_ps(_grid.inv_pixelLengthY);
+	const __m256 Ex = _mm256_set1_ps(_grid.Ex);
+	const __m256 Ey = _mm256_set1_ps(_grid.Ey);
+
+	int iDetector = 0;
+	for (; iDetector + 8 <= _iDetCount; iDetector += 8) {
+		__m256 det = _mm256_add_ps(_mm256_cvtepi32_ps(_mm256_add_epi32(_mm256_set1_epi32(iDetector),
+			_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7))), half);
+		__m256 Dx = _mm256_add_ps(detSX, _mm256_mul_ps(det, detUX));
+		__m256 Dy = _mm256_add_ps(detSY, _mm256_mul_ps(det, detUY));
+		__m256 Rx = _mm256_sub_ps(srcX, Dx);
+		__m256 Ry = _mm256_sub_ps(srcY, Dy);
+
+		__m256 vertical = _mm256_cmp_ps(_mm256_andnot_ps(signMask, Rx), _mm256_andnot_ps(signMask, Ry), _CMP_LT_OQ);
+
+		__m256 along = _mm256_blendv_ps(Rx, Ry, vertical);
+		__m256 ratio = _mm256_div_ps(_mm256_blendv_ps(Ry, Rx, vertical), along);
+		__m256 pixelLength = _mm256_blendv_ps(pixelLengthY, pixelLengthX, vertical);
+		__m256 pixelLengthStep = _mm256_blendv_ps(pixelLengthX, pixelLengthY, vertical);
+		__m256 inv_pixelLength = _mm256_blendv_ps(inv_pixelLengthY, inv_pixelLengthX, vertical);
+
+		__m256 length = _mm256_div_ps(
+			_mm256_mul_ps(pixelLength, _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(Rx, Rx), _mm256_mul_ps(Ry, Ry)))),
+			_mm256_andnot_ps(signMask, along));
+		__m256 delta = _mm256_mul_ps(_mm256_mul_ps(_mm256_xor_ps(pixelLengthStep, signMask), ratio), inv_pixelLength);
+		__m256 halfRatio = _mm256_mul_ps(half, _mm256_andnot_ps(signMask, ratio));
+		__m256 S = _mm256_sub_ps(half, halfRatio);
+		__m256 T = _mm256_add_ps(half, halfRatio);
+		__m256 invTminSTimesLength = _mm256_div_ps(length, _mm256_sub_ps(T, S));
+
+		__m256 start = _mm256_sub_ps(_mm256_add_ps(_mm256_blendv_ps(Dy, Dx, vertical),
+			_mm256_mul_ps(_mm256_sub_ps(_mm256_blendv_ps(Ex, Ey, vertical), _mm256_blendv_ps(Dx, Dy, vertical)), ratio)),
+			_mm256_blendv_ps(Ey, Ex, vertical));
+		start = _mm256_mul_ps(start, inv_pixelLength);
+		start = _mm256_blendv_ps(_mm256_xor_ps(start, signMask), start, vertical);
+
+		_mm256_storeu_ps(_row.pfStart + iDetector, start);
+		_mm256_storeu_ps(_row.pfDelta + iDetector, delta);
+		_mm256_storeu_ps(_row.pfLength + iDetector, length);
+		_mm256_storeu_ps(_row.pfS + iDetector, S);
+		_mm256_storeu_ps(_row.pfT + iDetector, T);
+		_mm256_storeu_ps(_row.pfInvTminSTimesLength + iDetector, invTminSTimesLength);
+		int iMask = _mm256_movemask_ps(vertical);
+		for (int k = 0; k < 8; ++k)
+			_row.pbVertical[iDetector + k] = (iMask >> k) & 1;
+	}
+
+	_setupRowScalar(_proj, _grid, iDetector, _iDetCount, _row);
+}
+
+#endif // RAYTABLE_SIMD
+
+
+// bytes of one array of _iCount elements of _iSize bytes, padded to the pool alignment
+static size_t _arrayBytes(size_t _iCount, size_t _iSize)
+{
+	return (_iCount * _iSize + CFloat32MemoryPool::ALIGNMENT - 1) & ~(CFloat32MemoryPool::ALIGNMENT - 1);
+}
+
+//----------------------------------------------------------------------------------------
+// Constructor
+CFanFlatRayTable::CFanFlatRayTable()
+	: m_pfStart(NULL), m_pfDelta(NULL), m_pfLength(NULL), m_pfS(NULL), m_pfT(NULL),
+	  m_pfInvTminSTimesLength(NULL), m_pbVertical(NULL), m_iRayCount(0), m_pBlock(NULL)
+{
+}
+
+//----------------------------------------------------------------------------------------
+// Destructor
+CFanFlatRayTable::~CFanFlatRayTable()
+{
+	_release();
+}
+
+void CFanFlatRayTable::_release()
+{
+	if (m_pBlock)
+		CFloat32MemoryPool::getSingleton().release(m_pBlock);
+	m_pBlock = NULL;
+	m_iRayCount = 0;
+}
+
+//----------------------------------------------------------------------------------------
+// Memory size
+size_t CFanFlatRayTable::getMemorySize(int _iAngleCount, int _iDetectorCount)
+{
+	size_t iRays = (size_t)_iAngleCount * _iDetectorCount;
+	return 6 * _arrayBytes(iRays, sizeof(float)) + _arrayBytes(iRays, sizeof(unsigned char));
+}
+
+//----------------------------------------------------------------------------------------
+// Initialize
+void CFanFlatRayTable::initialize(const CFanFlatVecProjectionGeometry2D* _pProjectionGeometry,
+	const CVolumeGeometry2D* _pVolumeGeometry)
+{
+	ASTRA_TIMER(STAGE_GEOMETRY_SETUP);
+
+	const int iAngleCount = _pProjectionGeometry->getProjectionAngleCount();
+	const int iDetCount = _pProjectionGeometry->getDetectorCount();
+
+	_release();
+	m_iRayCount = iAngleCount * iDetCount;
+	m_pBlock = CFloat32MemoryPool::getSingleton().allocate(getMemorySize(iAngleCount, iDetCount));
+	ASTRA_COUNT(COUNTER_BYTES_ALLOCATED, getMemorySize());
+	ASTRA_COUNT(COUNTER_ALLOCATIONS, 1);
+
+	const size_t iStride = _arrayBytes(m_iRayCount, sizeof(float));
+	char* pBlock = (char*)m_pBlock;
+	m_pfStart = (float*)pBlock;
+	m_pfDelta = (float*)(pBlock + iStride);
+	m_pfLength = (float*)(pBlock + 2 * iStride);
+	m_pfS = (float*)(pBlock + 3 * iStride);
+	m_pfT = (float*)(pBlock + 4 * iStride);
+	m_pfInvTminSTimesLength = (float*)(pBlock + 5 * iStride);
+	m_pbVertical = (unsigned char*)(pBlock + 6 * iStride);
+
+	const SLineKernelGrid<float> grid(_pVolumeGeometry);
+	const SFanProjection* pProjections = _pProjectionGeometry->getProjectionVectors();
+
+#ifdef RAYTABLE_SIMD
+	const bool bAVX2 = RAYTABLE_HAS_AVX2();
+#endif
+
+	for (int iAngle = 0; iAngle < iAngleCount; ++iAngle) {
+		const int iOffset = iAngle * iDetCount;
+		SRayTableRow row;
+		row.pfStart = m_pfStart + iOffset;
+		row.pfDelta = m_pfDelta + iOffset;
+		row.pfLength = m_pfLength + iOffset;
+		row.pfS = m_pfS + iOffset;
+		row.pfT = m_pfT + iOffset;
+		row.pfInvTminSTimesLength = m_pfInvTminSTimesLength + iOffset;
+		row.pbVertical = m_pbVertical + iOffset;
+
+#ifdef RAYTABLE_SIMD
+		if (bAVX2) {
+			_setupRowAVX2(pProjections[iAngle], grid, iDetCount, row);
+			continue;
+		}
+#endif
+		_setupRowScalar(pProjections[iAngle], grid, 0, iDetCount, row);
+	}
+}
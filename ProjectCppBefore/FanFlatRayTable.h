@@ -0,0 +1,243 @@
+#ifndef _INC_ASTRA_FANFLATRAYTABLE
+#define _INC_ASTRA_FANFLATRAYTABLE
+
+#include "Globals.h"
+#include "FanFlatVecProjectionGeometry2D.h"
+#include "VolumeGeometry2D.h"
+
+#include <cmath>
+#include <cstddef>
+
+
+/**
+	* Constants of the volume grid used by the line kernel ray setup.
+	*/
+template <typename Real>
+struct SLineKernelGrid {
+	Real pixelLengthX;
+	Real pixelLengthY;
+	Real inv_pixelLengthX;
+	Real inv_pixelLengthY;
+	Real Ex;		///< x of the centre of the first column
+	Real Ey;		///< y of the centre of the first row
+
+	explicit SLineKernelGrid(const CVolumeGeometry2D* _pVolumeGeometry)
+	{
+		pixelLengthX = _pVolumeGeometry->getPixelLengthX();
+		pixelLengthY = _pVolumeGeometry->getPixelLengthY();
+		inv_pixelLengthX = Real(1) / pixelLengthX;
+		inv_pixelLengthY = Real(1) / pixelLengthY;
+		Ex = _pVolumeGeometry->getWindowMinX() + pixelLengthX * Real(0.5);
+		Ey = _pVolumeGeometry->getWindowMaxY() - pixelLengthY * Real(0.5);
+	}
+};
+
+
+/**
+	* Parameters of one ray for the line kernel traversal. A vertical ray steps over the
+	* rows, with start the column coordinate at row 0; a horizontal one over the columns,
+	* with start the row coordinate at column 0.
+	*/
+template <typename Real>
+struct SLineKernelRay {
+	bool vertical;
+	Real start;					///< c at row 0 or r at column 0
+	Real delta;					///< deltac per row or deltar per column
+	Real length;				///< lengthPerRow or lengthPerCol
+	Real S;
+	Real T;
+	Real invTminSTimesLength;	///< length / (T - S)
+};
+
+
+/**
+	* Set up the ray from the source to detector _iDetector of a fan beam projection.
+	*
+	* Both orientations are computed with the same operations on selected operands, so
+	* the function has no branches and vectorizes over detectors, and the result is
+	* identical whether it is computed on the fly or taken from a CFanFlatRayTable.
+	*/
+template <typename Real>
+inline void setupFanFlatRay(const SFanProjection& _proj, int _iDetector, const SLineKernelGrid<Real>& _grid,
+	SLineKernelRay<Real>& _ray)
+{
+	Real Dx = _proj.fDetSX + (_iDetector + Real(0.5)) * _proj.fDetUX;
+	Real Dy = _proj.fDetSY + (_iDetector + Real(0.5)) * _proj.fDetUY;
+	Real Rx = _proj.fSrcX - Dx;
+	Real Ry = _proj.fSrcY - Dy;
+
+	bool vertical = std::fabs(Rx) < std::fabs(Ry);
+
+	// vertical: RxOverRy, steps in y; horizontal: RyOverRx, steps in x
+	Real along = vertical ? Ry : Rx;
+	Real ratio = (vertical ? Rx : Ry) / along;
+	Real pixelLength = vertical ? _grid.pixelLengthX : _grid.pixelLengthY;
+	Real pixelLengthStep = vertical ? _grid.pixelLengthY : _grid.pixelLengthX;
+	Real inv_pixelLength = vertical ? _grid.inv_pixelLengthX : _grid.inv_pixelLengthY;
+
+	_ray.vertical = vertical;
+	_ray.length = pixelLength * std::sqrt(Rx * Rx + Ry * Ry) / std::fabs(along);
+	_ray.delta = -pixelLengthStep * ratio * inv_pixelLength;
+	_ray.S = Real(0.5) - Real(0.5) * std::fabs(ratio);
+	_ray.T = Real(0.5) + Real(0.5) * std::fabs(ratio);
+	_ray.invTminSTimesLength = _ray.length / (_ray.T - _ray.S);
+
+	// c = (Dx + (Ey - Dy) * RxOverRy - Ex) / pixelLengthX
+	// r = -(Dy + (Ex - Dx) * RyOverRx - Ey) / pixelLengthY
+	Real start = ((vertical ? Dx : Dy) + ((vertical ? _grid.Ey : _grid.Ex) - (vertical ? Dy : Dx)) * ratio
+		- (vertical ? _grid.Ex : _grid.Ey)) * inv_pixelLength;
+	_ray.start = vertical ? start : -start;
+}
+
+
+/**
+	* Footprint of the detector pixel of one ray for the area-based kernels (distance-driven,
+	* strip). Its two edges are mapped onto a common axis: a vertical footprint steps over
+	* the rows and the axis is the column coordinate where an edge crosses the centre line
+	* of a row, a horizontal one the other way around. Pixel i spans [i, i + 1) on the axis.
+	*/
+template <typename Real>
+struct SFanFlatFootprint {
+	Real start0;				///< edge 0 at step 0
+	Real delta0;				///< edge 0 per step
+	Real start1;				///< edge 1 at step 0
+	Real delta1;				///< edge 1 per step
+	Real length;				///< length of the central ray within one row or column
+};
+
+
+/**
+	* Is the footprint of a projection vertical? One orientation is used for all detectors
+	* of a projection, the one of its central ray, so that the footprints of neighbouring
+	* detectors tile the axis without gaps or overlaps.
+	*/
+inline bool isFanFlatFootprintVertical(const SFanProjection& _proj, int _iDetectorCount)
+{
+	float Rx = _proj.fSrcX - (_proj.fDetSX + 0.5f * _iDetectorCount * _proj.fDetUX);
+	float Ry = _proj.fSrcY - (_proj.fDetSY + 0.5f * _iDetectorCount * _proj.fDetUY);
+	return std::fabs(Rx) < std::fabs(Ry);
+}
+
+
+/**
+	* Set up the footprint of detector _iDetector of a fan beam projection.
+	*/
+template <typename Real>
+inline void setupFanFlatFootprint(const SFanProjection& _proj, int _iDetector, bool _bVertical,
+	const SLineKernelGrid<Real>& _grid, SFanFlatFootprint<Real>& _footprint)
+{
+	Real starts[2], deltas[2];
+	for (int e = 0; e < 2; ++e) {
+		Real Dx = _proj.fDetSX + Real(_iDetector + e) * _proj.fDetUX;
+		Real Dy = _proj.fDetSY + Real(_iDetector + e) * _proj.fDetUY;
+		Real Rx = _proj.fSrcX - Dx;
+		Real Ry = _proj.fSrcY - Dy;
+		if (_bVertical) {
+			Real RxOverRy = Rx / Ry;
+			starts[e] = (Dx + (_grid.Ey - Dy) * RxOverRy - _grid.Ex) * _grid.inv_pixelLengthX + Real(0.5);
+			deltas[e] = -_grid.pixelLengthY * RxOverRy * _grid.inv_pixelLengthX;
+		}
+		else {
+			Real RyOverRx = Ry / Rx;
+			starts[e] = -(Dy + (_grid.Ex - Dx) * RyOverRx - _grid.Ey) * _grid.inv_pixelLengthY + Real(0.5);
+			deltas[e] = -_grid.pixelLengthX * RyOverRx * _grid.inv_pixelLengthY;
+		}
+	}
+	_footprint.start0 = starts[0];
+	_footprint.delta0 = deltas[0];
+	_footprint.start1 = starts[1];
+	_footprint.delta1 = deltas[1];
+
+	Real Rx = _proj.fSrcX - (_proj.fDetSX + (_iDetector + Real(0.5)) * _proj.fDetUX);
+	Real Ry = _proj.fSrcY - (_proj.fDetSY + (_iDetector + Real(0.5)) * _proj.fDetUY);
+	_footprint.length = std::sqrt(Rx * Rx + Ry * Ry) / (_bVertical ? std::fabs(Ry) * _grid.inv_pixelLengthY : std::fabs(Rx) * _grid.inv_pixelLengthX);
+}
+
+
+/**
+	* Precomputed line kernel ray parameters of all rays of a fan beam geometry, in
+	* structure-of-arrays layout indexed by angle * detectorCount + detector (the ray
+	* index of the projectors).
+	*
+	* It trades the per-ray setup of the traversal (a square root and two divisions) for
+	* getMemorySize() bytes, six floats and a flag per ray. It only depends on the
+	* geometries and is read-only after initialize(), so it can be shared by threads.
+	*/
+class CFanFlatRayTable {
+
+public:
+
+	/** Default constructor, empty table.
+		*/
+	CFanFlatRayTable();
+
+	/** Destructor.
+		*/
+	~CFanFlatRayTable();
+
+	/** Compute the rays of a projection geometry on a volume geometry.
+		*/
+	void initialize(const CFanFlatVecProjectionGeometry2D* _pProjectionGeometry,
+		const CVolumeGeometry2D* _pVolumeGeometry);
+
+	/** Memory the table of a geometry would take, in bytes.
+		*/
+	static size_t getMemorySize(int _iAngleCount, int _iDetectorCount);
+
+	/** Memory taken by this table, in bytes.
+		*/
+	size_t getMemorySize() const;
+
+	/** Number of rays in the table.
+		*/
+	int getRayCount() const;
+
+	/** Get the parameters of a ray.
+		*/
+	template <typename Real>
+	void getRay(int _iRayIndex, SLineKernelRay<Real>& _ray) const;
+
+private:
+
+	float* m_pfStart;
+	float* m_pfDelta;
+	float* m_pfLength;
+	float* m_pfS;
+	float* m_pfT;
+	float* m_pfInvTminSTimesLength;
+	unsigned char* m_pbVertical;
+	int m_iRayCount;
+	void* m_pBlock;
+
+	void _release();
+
+	CFanFlatRayTable(const CFanFlatRayTable&);
+	CFanFlatRayTable& operator=(const CFanFlatRayTable&);
+};
+
+//----------------------------------------------------------------------------------------
+
+inline int CFanFlatRayTable::getRayCount() const
+{
+	return m_iRayCount;
+}
+
+inline size_t CFanFlatRayTable::getMemorySize() const
+{
+	return m_pBlock ? getMemorySize(1, m_iRayCount) : 0;
+}
+
+template <typename Real>
+inline void CFanFlatRayTable::getRay(int _iRayIndex, SLineKernelRay<Real>& _ray) const
+{
+	ASTRA_ASSERT(_iRayIndex >= 0 && _iRayIndex < m_iRayCount);
+	_ray.vertical = m_pbVertical[_iRayIndex] != 0;
+	_ray.start = m_pfStart[_iRayIndex];
+	_ray.delta = m_pfDelta[_iRayIndex];
+	_ray.length = m_pfLength[_iRayIndex];
+	_ray.S = m_pfS[_iRayIndex];
+	_ray.T = m_pfT[_iRayIndex];
+	_ray.invTminSTimesLength = m_pfInvTminSTimesLength[_iRayIndex];
+}
+
+#endif // _INC_ASTRA_FANFLATRAYTABLE
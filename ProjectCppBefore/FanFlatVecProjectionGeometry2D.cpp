@@ -45,6 +45,8 @@ CFanFlatVecProjectionGeometry2D::CFanFlatVecProjectionGeometry2D(int _iProjectio
 	int _iDetectorCount,
 	const SFanProjection* _pProjectionAngles)
 {
+	_clear();
+	m_pProjectionAngles = 0;
 	this->initialize(_iProjectionAngleCount,
 		_iDetectorCount,
 		_pProjectionAngles);
@@ -55,6 +57,7 @@ CFanFlatVecProjectionGeometry2D::CFanFlatVecProjectionGeometry2D(int _iProjectio
 CFanFlatVecProjectionGeometry2D::CFanFlatVecProjectionGeometry2D(const CFanFlatVecProjectionGeometry2D& _projGeom)
 {
 	_clear();
+	m_pProjectionAngles = 0;
 	this->initialize(_projGeom.m_iProjectionAngleCount,
 		_projGeom.m_iDetectorCount,
 		_projGeom.m_pProjectionAngles);
@@ -64,8 +67,11 @@ CFanFlatVecProjectionGeometry2D::CFanFlatVecProjectionGeometry2D(const CFanFlatV
 // Assignment operator.
 CFanFlatVecProjectionGeometry2D& CFanFlatVecProjectionGeometry2D::operator=(const CFanFlatVecProjectionGeometry2D& _other)
 {
-	if (m_bInitialized)
+	if (m_bInitialized) {
 		delete[] m_pProjectionAngles;
+		m_pProjectionAngles = 0;
+	}
+	_resetFingerprint();
 	m_bInitialized = _other.m_bInitialized;
 	if (m_bInitialized) {
 		m_iProjectionAngleCount = _other.m_iProjectionAngleCount;
@@ -75,6 +81,30 @@ CFanFlatVecProjectionGeometry2D& CFanFlatVecProjectionGeometry2D::operator=(cons
 	}
 	return *this;
 }
+
+//----------------------------------------------------------------------------------------
+// Move Constructor
+CFanFlatVecProjectionGeometry2D::CFanFlatVecProjectionGeometry2D(CFanFlatVecProjectionGeometry2D&& _projGeom)
+{
+	_clear();
+	_takeProjectionGeometry(_projGeom);
+	m_pProjectionAngles = _projGeom.m_pProjectionAngles;
+	_projGeom.m_pProjectionAngles = 0;
+}
+
+//----------------------------------------------------------------------------------------
+// Move assignment operator.
+CFanFlatVecProjectionGeometry2D& CFanFlatVecProjectionGeometry2D::operator=(CFanFlatVecProjectionGeometry2D&& _other)
+{
+	if (this != &_other) {
+		delete[] m_pProjectionAngles;
+		_takeProjectionGeometry(_other);
+		m_pProjectionAngles = _other.m_pProjectionAngles;
+		_other.m_pProjectionAngles = 0;
+	}
+	return *this;
+}
+
 //----------------------------------------------------------------------------------------
 // Destructor.
 CFanFlatVecProjectionGeometry2D::~CFanFlatVecProjectionGeometry2D()
@@ -90,8 +120,10 @@ bool CFanFlatVecProjectionGeometry2D::initialize(int _iProjectionAngleCount,
 	int _iDetectorCount,
 	const SFanProjection* _pProjectionAngles)
 {
+	_resetFingerprint();
 	m_iProjectionAngleCount = _iProjectionAngleCount;
 	m_iDetectorCount = _iDetectorCount;
+	delete[] m_pProjectionAngles;
 	m_pProjectionAngles = new SFanProjection[m_iProjectionAngleCount];
 	for (int i = 0; i < m_iProjectionAngleCount; ++i)
 		m_pProjectionAngles[i] = _pProjectionAngles[i];
@@ -176,18 +208,31 @@ bool CFanFlatVecProjectionGeometry2D::isEqual(CProjectionGeometry2D* _pGeom2) co
 
 	// both objects must be initialized
 	if (!m_bInitialized || !pGeom2->m_bInitialized) return false;
+	if (_isKnownEqual(pGeom2)) return true;
 
 	// check all values
 	if (m_iProjectionAngleCount != pGeom2->m_iProjectionAngleCount) return false;
 	if (m_iDetectorCount != pGeom2->m_iDetectorCount) return false;
 
+	// fast reject, then the vectors themselves, as different geometries may share a fingerprint
+	if (getFingerprint() != pGeom2->getFingerprint()) return false;
 	for (int i = 0; i < m_iProjectionAngleCount; ++i) {
 		if (memcmp(&m_pProjectionAngles[i], &pGeom2->m_pProjectionAngles[i], sizeof(m_pProjectionAngles[i])) != 0) return false;
 	}
 
+	_setKnownEqual(pGeom2);
 	return true;
 }
 
+//----------------------------------------------------------------------------------------
+// Fingerprint
+void CFanFlatVecProjectionGeometry2D::_fingerprint(CFingerprint& _fingerprint) const
+{
+	_fingerprint.add("fanflat_vec");
+	CProjectionGeometry2D::_fingerprint(_fingerprint);
+	_fingerprint.add(m_pProjectionAngles, m_iProjectionAngleCount * sizeof(m_pProjectionAngles[0]));
+}
+
 //----------------------------------------------------------------------------------------
 // Is of type
 bool CFanFlatVecProjectionGeometry2D::isOfType(const std::string& _sType)
@@ -35,6 +35,10 @@ protected:
 
 	SFanProjection* m_pProjectionAngles;
 
+	/** Add the type, the common values and the projection vectors to _fingerprint.
+		*/
+	virtual void _fingerprint(CFingerprint& _fingerprint) const;
+
 public:
 
 	/** Default constructor. Sets all variables to zero. Note that this constructor leaves the object in an unusable state and must
@@ -60,6 +64,14 @@ public:
 		*/
 	CFanFlatVecProjectionGeometry2D& operator=(const CFanFlatVecProjectionGeometry2D& _other);
 
+	/** Move constructor. Takes over the projection vectors of _projGeom, which is left cleared.
+		*/
+	CFanFlatVecProjectionGeometry2D(CFanFlatVecProjectionGeometry2D&& _projGeom);
+
+	/** Move assignment operator. Takes over the projection vectors of _other, which is left cleared.
+		*/
+	CFanFlatVecProjectionGeometry2D& operator=(CFanFlatVecProjectionGeometry2D&& _other);
+
 	/** Destructor.
 		*/
 	virtual ~CFanFlatVecProjectionGeometry2D();
@@ -0,0 +1,272 @@
+#include "FilteredBackProjectionAlgorithm.h"
+
+#include "FanFlatProjectionGeometry2D.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <cmath>
+
+// type of the algorithm, needed to register with CAlgorithmFactory
+std::string CFilteredBackProjectionAlgorithm::type = "FBP";
+
+//----------------------------------------------------------------------------------------
+// Constructor - Default
+CFilteredBackProjectionAlgorithm::CFilteredBackProjectionAlgorithm()
+{
+	_clear();
+}
+
+//----------------------------------------------------------------------------------------
+// Constructor
+CFilteredBackProjectionAlgorithm::CFilteredBackProjectionAlgorithm(CFloat32ProjectionData2D* _pSinogram,
+	CFloat32VolumeData2D* _pReconstruction,
+	EFilterType _eFilter)
+{
+	_clear();
+	initialize(_pSinogram, _pReconstruction, _eFilter);
+}
+
+//----------------------------------------------------------------------------------------
+// Destructor
+CFilteredBackProjectionAlgorithm::~CFilteredBackProjectionAlgorithm()
+{
+	clear();
+}
+
+//---------------------------------------------------------------------------------------
+// Clear - Constructors
+void CFilteredBackProjectionAlgorithm::_clear()
+{
+	m_pSinogram = NULL;
+	m_pReconstruction = NULL;
+	m_pVecProjectionGeometry = NULL;
+	m_eFilter = FILTER_RAMLAK;
+	m_bIsInitialized = false;
+}
+
+//---------------------------------------------------------------------------------------
+// Clear - Public
+void CFilteredBackProjectionAlgorithm::clear()
+{
+	m_pSinogram = NULL;
+	m_pReconstruction = NULL;
+	delete m_pVecProjectionGeometry;
+	m_pVecProjectionGeometry = NULL;
+	m_filtered.clear();
+	m_pFFT.reset();
+	m_pSpectrum.reset();
+	m_bIsInitialized = false;
+}
+
+//----------------------------------------------------------------------------------------
+// Check
+bool CFilteredBackProjectionAlgorithm::_check()
+{
+	// check pointers
+	ASTRA_CONFIG_CHECK(m_pSinogram, "FBP", "Invalid Projection Data Object.");
+	ASTRA_CONFIG_CHECK(m_pReconstruction, "FBP", "Invalid Reconstruction Data Object.");
+
+	// check initializations
+	ASTRA_CONFIG_CHECK(m_pSinogram->isInitialized(), "FBP", "Projection Data Object Not Initialized.");
+	ASTRA_CONFIG_CHECK(m_pReconstruction->isInitialized(), "FBP", "Reconstruction Data Object Not Initialized.");
+
+	// check geometry
+	ASTRA_CONFIG_CHECK(m_pVecProjectionGeometry && m_pVecProjectionGeometry->isInitialized(), "FBP", "Unsupported projection geometry, FBP needs a fan flat geometry.");
+
+	// success
+	return true;
+}
+
+//----------------------------------------------------------------------------------------
+// Initialize
+bool CFilteredBackProjectionAlgorithm::initialize(CFloat32ProjectionData2D* _pSinogram,
+	CFloat32VolumeData2D* _pReconstruction,
+	EFilterType _eFilter)
+{
+	clear();
+
+	// store classes
+	m_pSinogram = _pSinogram;
+	m_pReconstruction = _pReconstruction;
+	m_eFilter = _eFilter;
+
+	// vector form of the fan beam geometry
+	if (m_pSinogram) {
+		CProjectionGeometry2D* pGeometry = m_pSinogram->getGeometry();
+		if (CFanFlatProjectionGeometry2D* pFanGeometry = dynamic_cast<CFanFlatProjectionGeometry2D*>(pGeometry))
+			m_pVecProjectionGeometry = pFanGeometry->toVectorGeometry();
+		else if (dynamic_cast<CFanFlatVecProjectionGeometry2D*>(pGeometry))
+			m_pVecProjectionGeometry = dynamic_cast<CFanFlatVecProjectionGeometry2D*>(pGeometry->clone());
+	}
+
+	// return success
+	m_bIsInitialized = _check();
+	return m_bIsInitialized;
+}
+
+//----------------------------------------------------------------------------------------
+// Weight and filter a range of angles
+void CFilteredBackProjectionAlgorithm::_filter(int _iAngleFrom, int _iAngleTo)
+{
+	ASTRA_TIMER(STAGE_FILTERING);
+
+	const int iAngleCount = m_pVecProjectionGeometry->getProjectionAngleCount();
+	const int iDetCount = m_pVecProjectionGeometry->getDetectorCount();
+	const int iFilteredStride = iDetCount + 3;
+	const SFanProjection* pProjections = m_pVecProjectionGeometry->getProjectionVectors();
+	const float* pfSinogram = m_pSinogram->getDataConst();
+	const int iSinogramStride = m_pSinogram->getStride();
+
+	std::vector<std::complex<double> > buffer(m_pFFT->getSize());
+	float fScale[2] = { 0.0f, 0.0f };
+
+	for (int iAngle = _iAngleFrom; iAngle < _iAngleTo; iAngle += 2) {
+		int iPairCount = std::min(2, _iAngleTo - iAngle);
+
+		for (int k = 0; k < iPairCount; ++k) {
+			const int i = iAngle + k;
+			const SFanProjection& proj = pProjections[i];
+			double R = sqrt((double)proj.fSrcX * proj.fSrcX + (double)proj.fSrcY * proj.fSrcY);
+
+			// detector spacing rescaled to the rotation centre
+			double dDetU = sqrt((double)proj.fDetUX * proj.fDetUX + (double)proj.fDetUY * proj.fDetUY);
+			double dSourceDetector = fabs(proj.fDetUX * ((double)proj.fSrcY - proj.fDetSY) - proj.fDetUY * ((double)proj.fSrcX - proj.fDetSX)) / dDetU;
+			double dIsoSpacing = dDetU * R / dSourceDetector;
+
+			// angular weight: half the distance between the neighbouring source positions
+			double dAngle = atan2((double)proj.fSrcY, (double)proj.fSrcX);
+			double dPrev = 0.0, dNext = 0.0;
+			if (i > 0)
+				dPrev = fabs(remainder(dAngle - atan2((double)pProjections[i - 1].fSrcY, (double)pProjections[i - 1].fSrcX), 2.0 * M_PI));
+			if (i + 1 < iAngleCount)
+				dNext = fabs(remainder(atan2((double)pProjections[i + 1].fSrcY, (double)pProjections[i + 1].fSrcX) - dAngle, 2.0 * M_PI));
+			double dAngleWeight = (i > 0 && i + 1 < iAngleCount) ? 0.5 * (dPrev + dNext) : (iAngleCount > 1 ? dPrev + dNext : 2.0 * M_PI);
+
+			// the 1/2 of the full scan redundancy, the spacing of the convolution and the 1 / spacing^2 of the kernel
+			fScale[k] = (float)(dAngleWeight * 0.5 / dIsoSpacing);
+
+			// cosine weighting
+			const float* pfIn = pfSinogram + (size_t)i * iSinogramStride;
+			float* pfOut = &m_filtered[(size_t)i * iFilteredStride + 1];
+			for (int iDetector = 0; iDetector < iDetCount; ++iDetector) {
+				double Rx = proj.fDetSX + (iDetector + 0.5) * proj.fDetUX - proj.fSrcX;
+				double Ry = proj.fDetSY + (iDetector + 0.5) * proj.fDetUY - proj.fSrcY;
+				double dCos = -(Rx * proj.fSrcX + Ry * proj.fSrcY) / (R * sqrt(Rx * Rx + Ry * Ry));
+				pfOut[iDetector] = (float)(pfIn[iDetector] * dCos);
+			}
+		}
+
+		m_pFFT->filterRealPair(&m_filtered[(size_t)iAngle * iFilteredStride + 1],
+			iPairCount == 2 ? &m_filtered[(size_t)(iAngle + 1) * iFilteredStride + 1] : NULL,
+			iDetCount, &(*m_pSpectrum)[0], fScale[0], fScale[1], &buffer[0]);
+	}
+}
+
+//----------------------------------------------------------------------------------------
+// Backproject a range of rows
+void CFilteredBackProjectionAlgorithm::_backProject(int _iRowFrom, int _iRowTo)
+{
+	ASTRA_TIMER(STAGE_BACKPROJECTION);
+
+	const CVolumeGeometry2D* pVolumeGeometry = m_pReconstruction->getGeometry();
+	const int iColCount = pVolumeGeometry->getGridColCount();
+	const double dMinX = pVolumeGeometry->getWindowMinX();
+	const double dMaxY = pVolumeGeometry->getWindowMaxY();
+	const double dPixelLengthX = pVolumeGeometry->getPixelLengthX();
+	const double dPixelLengthY = pVolumeGeometry->getPixelLengthY();
+
+	const int iAngleCount = m_pVecProjectionGeometry->getProjectionAngleCount();
+	const int iDetCount = m_pVecProjectionGeometry->getDetectorCount();
+	const int iFilteredStride = iDetCount + 3;
+	const float fMaxIndex = (float)(iDetCount + 1);
+	const SFanProjection* pProjections = m_pVecProjectionGeometry->getProjectionVectors();
+
+	float* pfReconstruction = m_pReconstruction->getData();
+	const int iStride = m_pReconstruction->getStride();
+
+	for (int iRow = _iRowFrom; iRow < _iRowTo; ++iRow) {
+		const double dy = dMaxY - (iRow + 0.5) * dPixelLengthY;
+		float* pfRow = pfReconstruction + (size_t)iRow * iStride;
+		std::fill(pfRow, pfRow + iColCount, 0.0f);
+
+		for (int iAngle = 0; iAngle < iAngleCount; ++iAngle) {
+			const SFanProjection& proj = pProjections[iAngle];
+			const float* pfFiltered = &m_filtered[(size_t)iAngle * iFilteredStride];
+
+			// P - S = (dx0 + iCol * pixelLengthX, y - Sy)
+			const double Sx = proj.fSrcX, Sy = proj.fSrcY;
+			const double dx0 = dMinX + 0.5 * dPixelLengthX - Sx;
+			const double dy0 = dy - Sy;
+			const double inv_R2 = 1.0 / (Sx * Sx + Sy * Sy);
+
+			// detector coordinate of the ray from the source through the pixel centre,
+			// S + t (P - S) = DetS + u DetU, as the ratio of two linear functions of the column
+			const float fNum0 = (float)((Sx - proj.fDetSX) * dy0 - (Sy - proj.fDetSY) * dx0);
+			const float fNum1 = (float)(-(Sy - proj.fDetSY) * dPixelLengthX);
+			const float fDen0 = (float)(proj.fDetUX * dy0 - proj.fDetUY * dx0);
+			const float fDen1 = (float)(-proj.fDetUY * dPixelLengthX);
+
+			// U, the distance to the source along the central ray over R
+			const float fU0 = (float)(-(dx0 * Sx + dy0 * Sy) * inv_R2);
+			const float fU1 = (float)(-dPixelLengthX * Sx * inv_R2);
+
+			for (int iCol = 0; iCol < iColCount; ++iCol) {
+				const float c = (float)iCol;
+
+				// index in the padded row, u - 0.5 + 1; outside the detector it lands on the zero padding
+				float t = (fNum0 + fNum1 * c) / (fDen0 + fDen1 * c) + 0.5f;
+				t = std::min(std::max(t, 0.0f), fMaxIndex);
+				int j = (int)t;
+				float f = t - (float)j;
+				float v = pfFiltered[j] + f * (pfFiltered[j + 1] - pfFiltered[j]);
+
+				float U = fU0 + fU1 * c;
+				pfRow[iCol] += v / (U * U);
+			}
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------
+// Iterate
+void CFilteredBackProjectionAlgorithm::run(int _iNrIterations)
+{
+	// check initialized
+	ASTRA_ASSERT(m_bIsInitialized);
+
+	ASTRA_RECORD(m_instrumentation);
+
+	const int iAngleCount = m_pVecProjectionGeometry->getProjectionAngleCount();
+	const int iDetCount = m_pVecProjectionGeometry->getDetectorCount();
+	const int iRowCount = m_pReconstruction->getGeometry()->getGridRowCount();
+
+	// rows are zero-padded to at least twice their length, against the wrap-around of the circular convolution
+	int iSize = CFastFourierTransform::nextPowerOfTwo(2 * iDetCount);
+	if (!m_pFFT || m_pFFT->getSize() != iSize)
+		m_pFFT.reset(new CFastFourierTransform(iSize));
+	m_pSpectrum = getFilterSpectrum(m_eFilter, iSize);
+	m_filtered.assign((size_t)iAngleCount * (iDetCount + 3), 0.0f);
+
+	// progress counts the filtered angles and the backprojected rows
+	m_control.beginRun();
+	m_control.addTotal(iAngleCount + iRowCount);
+
+	// filter, in blocks of an even number of angles so rows are transformed in pairs
+	parallelFor(0, iAngleCount, 16, [this](int _iFrom, int _iTo) {
+		if (m_control.checkAbort())
+			return;
+		_filter(_iFrom, _iTo);
+		m_control.advance(_iTo - _iFrom);
+	});
+	if (m_control.checkAbort())
+		return;
+
+	// backproject
+	parallelFor(0, iRowCount, 4, [this](int _iFrom, int _iTo) {
+		if (m_control.checkAbort())
+			return;
+		_backProject(_iFrom, _iTo);
+		m_control.advance(_iTo - _iFrom);
+	});
+}
+//----------------------------------------------------------------------------------------
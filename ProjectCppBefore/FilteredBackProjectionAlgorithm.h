@@ -0,0 +1,161 @@
+#ifndef _INC_ASTRA_FILTEREDBACKPROJECTIONALGORITHM
+#define _INC_ASTRA_FILTEREDBACKPROJECTIONALGORITHM
+
+#include "Algorithm.h"
+
+#include "Globals.h"
+
+#include "Filters.h"
+#include "Fourier.h"
+#include "FanFlatVecProjectionGeometry2D.h"
+#include "Float32ProjectionData2D.h"
+#include "Float32VolumeData2D.h"
+
+#include <memory>
+#include <vector>
+
+/**
+	* \brief
+	* This class contains the implementation of the filtered backprojection (FBP) for fan
+	* beam geometries with a flat detector.
+	*
+	* run() reconstructs in one pass:
+	* - every detector value is multiplied by the cosine of the angle between its ray and the
+	*   central ray of the fan,
+	* - every row is filtered with the ramp filter (optionally windowed, see EFilterType) by
+	*   FFT, zero-padded to at least twice the detector count, two rows per transform,
+	* - the filtered sinogram is backprojected pixel-driven, with linear interpolation on the
+	*   detector and the 1 / U^2 distance weight, in parallel over the rows of the volume.
+	*
+	* The detector is rescaled to the rotation centre for the filter. Every angle is weighted
+	* with the angular distance to its neighbours, so irregular angles are handled, but the
+	* scan must cover the full circle: short scans need redundancy (Parker) weights, which
+	* are not applied.
+	*/
+class CFilteredBackProjectionAlgorithm : public CAlgorithm {
+
+protected:
+
+	/** Initial clearing. Only to be used by constructors.
+		*/
+	virtual void _clear();
+
+	/** Check the values of this object.  If everything is ok, the object can be set to the initialized state.
+		* The following statements are then guaranteed to hold:
+		* - valid data objects
+		* - fan beam projection geometry
+		*/
+	virtual bool _check();
+
+	/** Weight and filter the sinogram into m_filtered, angles [_iAngleFrom, _iAngleTo).
+		*/
+	void _filter(int _iAngleFrom, int _iAngleTo);
+
+	/** Backproject m_filtered into the reconstruction, rows [_iRowFrom, _iRowTo).
+		*/
+	void _backProject(int _iRowFrom, int _iRowTo);
+
+	//< ProjectionData2D object containing the sinogram.
+	CFloat32ProjectionData2D* m_pSinogram;
+	//< VolumeData2D object for storing the reconstruction.
+	CFloat32VolumeData2D* m_pReconstruction;
+
+	//< Vector form of the projection geometry. Owned.
+	CFanFlatVecProjectionGeometry2D* m_pVecProjectionGeometry;
+
+	//< Filter
+	EFilterType m_eFilter;
+
+	//< Weighted and filtered sinogram, angles x (one zero, detectors, two zeros)
+	std::vector<float> m_filtered;
+
+	//< FFT of the zero-padded rows and the filter spectrum of that size, set up by run()
+	std::unique_ptr<CFastFourierTransform> m_pFFT;
+	std::shared_ptr<const std::vector<double> > m_pSpectrum;
+
+public:
+
+	// type of the algorithm, needed to register with CAlgorithmFactory
+	static std::string type;
+
+	/** Default constructor, containing no code.
+		*/
+	CFilteredBackProjectionAlgorithm();
+
+	/** Initializing constructor.
+		*
+		* @param _pSinogram		ProjectionData2D object containing the sinogram to reconstruct.
+		* @param _pReconstruction	VolumeData2D object to store the reconstruction in.
+		* @param _eFilter		Filter to use.
+		*/
+	CFilteredBackProjectionAlgorithm(CFloat32ProjectionData2D* _pSinogram,
+		CFloat32VolumeData2D* _pReconstruction,
+		EFilterType _eFilter = FILTER_RAMLAK);
+
+	/** Destructor.
+		*/
+	virtual ~CFilteredBackProjectionAlgorithm();
+
+	/** Clear this class.
+		*/
+	virtual void clear();
+
+	/** Initialize class.
+		*
+		* @param _pSinogram		ProjectionData2D object containing the sinogram to reconstruct.
+		*						Its geometry must be a CFanFlatProjectionGeometry2D or CFanFlatVecProjectionGeometry2D.
+		* @param _pReconstruction	VolumeData2D object to store the reconstruction in.
+		* @param _eFilter		Filter to use.
+		* @return success
+		*/
+	bool initialize(CFloat32ProjectionData2D* _pSinogram,
+		CFloat32VolumeData2D* _pReconstruction,
+		EFilterType _eFilter = FILTER_RAMLAK);
+
+	/** Set the filter.
+		*
+		* @param _eFilter filter
+		*/
+	void setFilter(EFilterType _eFilter);
+
+	/** Get the filter.
+		*
+		* @return filter
+		*/
+	EFilterType getFilter() const;
+
+	/** Get sinogram data object
+		*
+		* @return sinogram data object
+		*/
+	CFloat32ProjectionData2D* getSinogram() const;
+
+	/** Get reconstruction data object
+		*
+		* @return reconstruction data object
+		*/
+	CFloat32VolumeData2D* getReconstruction() const;
+
+	/** Reconstruct. The number of iterations is ignored, FBP is a single pass.
+		*
+		* @param _iNrIterations ignored.
+		*/
+	virtual void run(int _iNrIterations = 0);
+
+	/** Get a description of the class.
+		*
+		* @return description string
+		*/
+	virtual std::string description() const;
+
+};
+
+// inline functions
+inline std::string CFilteredBackProjectionAlgorithm::description() const { return CFilteredBackProjectionAlgorithm::type; };
+inline void CFilteredBackProjectionAlgorithm::setFilter(EFilterType _eFilter) { m_eFilter = _eFilter; }
+inline EFilterType CFilteredBackProjectionAlgorithm::getFilter() const { return m_eFilter; }
+inline CFloat32ProjectionData2D* CFilteredBackProjectionAlgorithm::getSinogram() const { return m_pSinogram; }
+inline CFloat32VolumeData2D* CFilteredBackProjectionAlgorithm::getReconstruction() const { return m_pReconstruction; }
+
+
+#endif
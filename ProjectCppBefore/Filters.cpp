@@ -0,0 +1,79 @@
+#include "Filters.h"
+
+#include "Fourier.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <utility>
+
+
+//----------------------------------------------------------------------------------------
+// Names
+std::string getFilterName(EFilterType _eFilter)
+{
+	switch (_eFilter) {
+	case FILTER_RAMLAK: return "ram-lak";
+	case FILTER_SHEPPLOGAN: return "shepp-logan";
+	case FILTER_HANN: return "hann";
+	default: return "unknown";
+	}
+}
+
+bool getFilterType(const std::string& _sName, EFilterType& _eFilter)
+{
+	if (_sName == "ram-lak" || _sName == "ramp") { _eFilter = FILTER_RAMLAK; return true; }
+	if (_sName == "shepp-logan") { _eFilter = FILTER_SHEPPLOGAN; return true; }
+	if (_sName == "hann") { _eFilter = FILTER_HANN; return true; }
+	return false;
+}
+
+//----------------------------------------------------------------------------------------
+// Compute a spectrum
+static std::vector<double>* _computeFilterSpectrum(EFilterType _eFilter, int _iSize)
+{
+	// spatial ramp kernel h(n) = 1/4 (n = 0), 0 (n even), -1 / (pi n)^2 (n odd), stored circularly
+	std::vector<std::complex<double> > kernel(_iSize, 0.0);
+	kernel[0] = 0.25;
+	for (int n = 1; n < _iSize / 2; n += 2) {
+		double h = -1.0 / (M_PI * M_PI * n * n);
+		kernel[n] = h;
+		kernel[_iSize - n] = h;
+	}
+	CFastFourierTransform(_iSize).forward(&kernel[0]);
+
+	std::vector<double>* pSpectrum = new std::vector<double>(_iSize);
+	for (int k = 0; k < _iSize; ++k) {
+		// frequency in cycles per sample, in [0, 0.5]
+		double f = (double)std::min(k, _iSize - k) / _iSize;
+		double dWindow = 1.0;
+		switch (_eFilter) {
+		case FILTER_SHEPPLOGAN:
+			if (f > 0.0)
+				dWindow = sin(M_PI * f) / (M_PI * f);
+			break;
+		case FILTER_HANN:
+			dWindow = 0.5 + 0.5 * cos(2.0 * M_PI * f);
+			break;
+		default:
+			break;
+		}
+		(*pSpectrum)[k] = kernel[k].real() * dWindow;
+	}
+	return pSpectrum;
+}
+
+//----------------------------------------------------------------------------------------
+// Cached spectra
+std::shared_ptr<const std::vector<double> > getFilterSpectrum(EFilterType _eFilter, int _iSize)
+{
+	static std::mutex mutex;
+	static std::map<std::pair<int, int>, std::shared_ptr<const std::vector<double> > > cache;
+
+	std::lock_guard<std::mutex> lock(mutex);
+	std::shared_ptr<const std::vector<double> >& pSpectrum = cache[std::make_pair((int)_eFilter, _iSize)];
+	if (!pSpectrum)
+		pSpectrum.reset(_computeFilterSpectrum(_eFilter, _iSize));
+	return pSpectrum;
+}
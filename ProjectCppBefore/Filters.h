@@ -0,0 +1,37 @@
+#ifndef _INC_ASTRA_FILTERS
+#define _INC_ASTRA_FILTERS
+
+#include "Globals.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+
+/** Reconstruction filters of the filtered backprojection.
+	* - FILTER_RAMLAK: ramp filter
+	* - FILTER_SHEPPLOGAN: ramp filter times sinc, damps the highest frequencies a little
+	* - FILTER_HANN: ramp filter times a Hann window, zero at the Nyquist frequency
+	*/
+enum EFilterType { FILTER_RAMLAK, FILTER_SHEPPLOGAN, FILTER_HANN };
+
+/** Name of a filter, "ram-lak", "shepp-logan" or "hann".
+	*/
+std::string getFilterName(EFilterType _eFilter);
+
+/** Filter of a name, as returned by getFilterName().
+	*
+	* @return false if the name is unknown
+	*/
+bool getFilterType(const std::string& _sName, EFilterType& _eFilter);
+
+/** Get the spectrum of a filter for FFTs of size _iSize (a power of two), for a detector
+	* spacing of 1. The spectrum is real and even, with _iSize values.
+	*
+	* The ramp is taken as the FFT of the band-limited spatial ramp kernel (Kak and Slaney,
+	* (3.61)) rather than sampled as |f|, which keeps the DC term right for zero-padded rows.
+	* Spectra are computed once per filter and size and then shared by all callers.
+	*/
+std::shared_ptr<const std::vector<double> > getFilterSpectrum(EFilterType _eFilter, int _iSize);
+
+#endif // _INC_ASTRA_FILTERS
@@ -0,0 +1,49 @@
+#ifndef _INC_ASTRA_FINGERPRINT
+#define _INC_ASTRA_FINGERPRINT
+
+#include "Globals.h"
+
+#include <cstddef>
+#include <cstring>
+#include <stdint.h>
+
+
+/**
+	* 64-bit FNV-1a content hash, used to fingerprint geometries.
+	*
+	* Floats are hashed by their bit pattern with -0.0f mapped to +0.0f, so the fingerprints of
+	* two geometries are equal exactly when their values compare equal, up to hash collisions
+	* (about 2^-64 per pair) and NaN. Raw arrays added with add(const void*, size_t) are
+	* compared bytewise.
+	*/
+class CFingerprint {
+
+	uint64_t m_iHash;
+
+public:
+
+	/** Start a new fingerprint.
+		*/
+	CFingerprint() : m_iHash(14695981039346656037ULL) { }
+
+	/** Add _iSize bytes starting at _pData.
+		*/
+	void add(const void* _pData, size_t _iSize)
+	{
+		const unsigned char* p = (const unsigned char*)_pData;
+		for (size_t i = 0; i < _iSize; ++i) {
+			m_iHash ^= p[i];
+			m_iHash *= 1099511628211ULL;
+		}
+	}
+
+	void add(int _iValue) { add(&_iValue, sizeof(_iValue)); }
+	void add(float _fValue) { if (_fValue == 0.0f) _fValue = 0.0f; add(&_fValue, sizeof(_fValue)); }
+	void add(const char* _sTag) { add(_sTag, strlen(_sTag) + 1); }
+
+	/** Get the fingerprint. Never 0, which is reserved for "not computed".
+		*/
+	uint64_t get() const { return m_iHash ? m_iHash : 1; }
+};
+
+#endif // _INC_ASTRA_FINGERPRINT
@@ -3,17 +3,22 @@
 #include <cstring>
 #include <sstream>
 
-#ifdef _MSC_VER
-#include <malloc.h>
-#else
-#include <cstdlib>
-#endif
+#include "Float32MemoryPool.h"
+#include "Instrumentation.h"
 
 
 CFloat32CustomMemory::~CFloat32CustomMemory() {
 
 }
 
+//----------------------------------------------------------------------------------------
+// Handle for memory owned by another object. Deleting it leaves the memory alone.
+class CFloat32ViewMemory : public CFloat32CustomMemory {
+public:
+	CFloat32ViewMemory(float* _pfData) { m_fPtr = _pfData; }
+	virtual ~CFloat32ViewMemory() { }
+};
+
 
 //----------------------------------------------------------------------------------------
 // Constructors
@@ -67,6 +72,15 @@ CFloat32Data2D::CFloat32Data2D(const CFloat32Data2D& _other)
 	*this = _other;
 }
 
+//----------------------------------------------------------------------------------------
+// Move constructor
+CFloat32Data2D::CFloat32Data2D(CFloat32Data2D&& _other)
+{
+	_clear();
+	m_bInitialized = false;
+	_takeData(_other);
+}
+
 //----------------------------------------------------------------------------------------
 // Assignment operator
 CFloat32Data2D& CFloat32Data2D::operator=(const CFloat32Data2D& _dataIn)
@@ -84,7 +98,7 @@ CFloat32Data2D& CFloat32Data2D::operator=(const CFloat32Data2D& _dataIn)
 			ASTRA_ASSERT(m_iSize == (size_t)m_iWidth * m_iHeight);
 			ASTRA_ASSERT(m_pfData);
 
-			memcpy(m_pfData, _dataIn.m_pfData, m_iSize * sizeof(float));
+			_copyRows(_dataIn);
 		}
 		else {
 			if (m_pCustomMemory) {
@@ -94,16 +108,52 @@ CFloat32Data2D& CFloat32Data2D::operator=(const CFloat32Data2D& _dataIn)
 			}
 			// Re-allocate data
 			_unInit();
-			_initialize(_dataIn.getWidth(), _dataIn.getHeight(), _dataIn.getDataConst());
+			_initialize(_dataIn.getWidth(), _dataIn.getHeight());
+			_copyRows(_dataIn);
 		}
 	}
 	else {
-		_initialize(_dataIn.getWidth(), _dataIn.getHeight(), _dataIn.getDataConst());
+		_initialize(_dataIn.getWidth(), _dataIn.getHeight());
+		_copyRows(_dataIn);
 	}
 
 	return (*this);
 }
 
+//----------------------------------------------------------------------------------------
+// Move assignment
+CFloat32Data2D& CFloat32Data2D::operator=(CFloat32Data2D&& _dataIn)
+{
+	if (this != &_dataIn) {
+		_takeData(_dataIn);
+	}
+	return (*this);
+}
+
+//----------------------------------------------------------------------------------------
+// Take over the data block of another object
+void CFloat32Data2D::_takeData(CFloat32Data2D& _other)
+{
+	if (m_bInitialized) {
+		_unInit();
+	}
+
+	m_iWidth = _other.m_iWidth;
+	m_iHeight = _other.m_iHeight;
+	m_iSize = _other.m_iSize;
+	m_iStride = _other.m_iStride;
+	m_pfData = _other.m_pfData;
+	m_ppfData2D = _other.m_ppfData2D;
+	m_pCustomMemory = _other.m_pCustomMemory;
+	m_fGlobalMin = _other.m_fGlobalMin;
+	m_fGlobalMax = _other.m_fGlobalMax;
+	m_fGlobalMean = _other.m_fGlobalMean;
+	m_bInitialized = _other.m_bInitialized;
+
+	_other._clear();
+	_other.m_bInitialized = false;
+}
+
 //----------------------------------------------------------------------------------------
 // Destructor. Free allocated memory
 CFloat32Data2D::~CFloat32Data2D()
@@ -131,6 +181,7 @@ bool CFloat32Data2D::_initialize(int _iWidth, int _iHeight)
 	m_iWidth = _iWidth;
 	m_iHeight = _iHeight;
 	m_iSize = (size_t)m_iWidth * m_iHeight;
+	m_iStride = m_iWidth;
 
 	// allocate memory for the data, but do not fill it
 	m_pfData = 0;
@@ -166,6 +217,7 @@ bool CFloat32Data2D::_initialize(int _iWidth, int _iHeight, const float* _pfData
 	m_iWidth = _iWidth;
 	m_iHeight = _iHeight;
 	m_iSize = (size_t)m_iWidth * m_iHeight;
+	m_iStride = m_iWidth;
 
 	// allocate memory for the data 
 	m_pfData = 0;
@@ -199,6 +251,7 @@ bool CFloat32Data2D::_initialize(int _iWidth, int _iHeight, float _fScalar)
 	m_iWidth = _iWidth;
 	m_iHeight = _iHeight;
 	m_iSize = (size_t)m_iWidth * m_iHeight;
+	m_iStride = m_iWidth;
 
 	// allocate memory for the data 
 	m_pfData = 0;
@@ -235,6 +288,7 @@ bool CFloat32Data2D::_initialize(int _iWidth, int _iHeight, CFloat32CustomMemory
 	m_iWidth = _iWidth;
 	m_iHeight = _iHeight;
 	m_iSize = (size_t)m_iWidth * m_iHeight;
+	m_iStride = m_iWidth;
 
 	// initialize the data pointers
 	m_pCustomMemory = _pCustomMemory;
@@ -247,6 +301,63 @@ bool CFloat32Data2D::_initialize(int _iWidth, int _iHeight, CFloat32CustomMemory
 }
 
 
+//----------------------------------------------------------------------------------------
+// Initializes an instance of the CFloat32Data2D class as a window into memory owned elsewhere
+bool CFloat32Data2D::_initializeView(int _iWidth, int _iHeight, int _iStride, float* _pfData)
+{
+	// basic checks
+	ASTRA_ASSERT(_iWidth > 0);
+	ASTRA_ASSERT(_iHeight > 0);
+	ASTRA_ASSERT(_iStride >= _iWidth);
+	ASTRA_ASSERT(_pfData != NULL);
+
+	if (m_bInitialized)
+	{
+		_unInit();
+	}
+
+	// calculate size
+	m_iWidth = _iWidth;
+	m_iHeight = _iHeight;
+	m_iSize = (size_t)m_iWidth * m_iHeight;
+	m_iStride = _iStride;
+
+	// the window is handled like custom memory that is never freed
+	m_pCustomMemory = new CFloat32ViewMemory(_pfData);
+	m_pfData = 0;
+	m_ppfData2D = 0;
+	_allocateData();
+
+	// set minmax to default values
+	m_fGlobalMin = 0.0;
+	m_fGlobalMax = 0.0;
+	m_fGlobalMean = 0.0;
+
+	// initialization complete
+	return true;
+}
+
+
+//----------------------------------------------------------------------------------------
+// Reinitializes an instance of the CFloat32Data2D class, keeping the data block if the shape matches.
+bool CFloat32Data2D::_reinitialize(int _iWidth, int _iHeight)
+{
+	// basic checks
+	ASTRA_ASSERT(_iWidth > 0);
+	ASTRA_ASSERT(_iHeight > 0);
+
+	if (!m_bInitialized || m_pCustomMemory || m_iWidth != _iWidth || m_iHeight != _iHeight) {
+		return _initialize(_iWidth, _iHeight);
+	}
+
+	// same shape, so no need to re-allocate memory
+	m_fGlobalMin = 0.0;
+	m_fGlobalMax = 0.0;
+	m_fGlobalMean = 0.0;
+
+	return true;
+}
+
 
 //----------------------------------------------------------------------------------------
 // Memory Allocation 
@@ -264,30 +375,32 @@ void CFloat32Data2D::_allocateData()
 	ASTRA_ASSERT(m_pfData == NULL);
 	ASTRA_ASSERT(m_ppfData2D == NULL);
 
+	// size of the data block, rounded up so that the row table starts on a new cache line
+	size_t iDataBytes = 0;
 	if (!m_pCustomMemory) {
-		std::cout << "allocating contiguous block" << std::endl;
+		iDataBytes = (size_t)m_iSize * sizeof(float);
+		iDataBytes = (iDataBytes + CFloat32MemoryPool::ALIGNMENT - 1) & ~(CFloat32MemoryPool::ALIGNMENT - 1);
+	}
 
-		// allocate contiguous block
-#ifdef _MSC_VER
-		std::cout << "_aligned_malloc" << std::endl;
-		m_pfData = (float*)_aligned_malloc(m_iSize * sizeof(float), 16);
-#else
-		int ret = posix_memalign((void**)&m_pfData, 16, m_iSize * sizeof(float));
-		ASTRA_ASSERT(ret == 0);
-#endif
+	// data and row table share a single pooled block
+	ASTRA_TIMER(STAGE_ALLOCATION);
+	ASTRA_COUNT(COUNTER_ALLOCATIONS, 1);
+	ASTRA_COUNT(COUNTER_BYTES_ALLOCATED, iDataBytes + m_iHeight * sizeof(float*));
+	char* pBlock = (char*)CFloat32MemoryPool::getSingleton().allocate(iDataBytes + m_iHeight * sizeof(float*));
+	ASTRA_ASSERT(pBlock != NULL);
 
+	if (!m_pCustomMemory) {
+		m_pfData = (float*)pBlock;
 	}
 	else {
-		std::cout << "allocating custom memory block" << std::endl;
-
 		m_pfData = m_pCustomMemory->m_fPtr;
 	}
 
 	// create array of pointers to each row of the data block
-	m_ppfData2D = new float * [m_iHeight];
+	m_ppfData2D = (float**)(pBlock + iDataBytes);
 	for (int iy = 0; iy < m_iHeight; iy++)
 	{
-		m_ppfData2D[iy] = &(m_pfData[iy * m_iWidth]);
+		m_ppfData2D[iy] = &(m_pfData[iy * m_iStride]);
 	}
 }
 
@@ -298,18 +411,13 @@ void CFloat32Data2D::_freeData()
 	// basic checks
 	ASTRA_ASSERT(m_pfData != NULL);
 	ASTRA_ASSERT(m_ppfData2D != NULL);
-	// free memory for index table
-	delete[] m_ppfData2D;
 
+	// the pooled block starts with the data, or with the row table for custom memory
 	if (!m_pCustomMemory) {
-		// free memory for data block
-#ifdef _MSC_VER
-		_aligned_free(m_pfData);
-#else
-		free(m_pfData);
-#endif
+		CFloat32MemoryPool::getSingleton().release(m_pfData);
 	}
 	else {
+		CFloat32MemoryPool::getSingleton().release(m_ppfData2D);
 		delete m_pCustomMemory;
 		m_pCustomMemory = 0;
 	}
@@ -323,6 +431,7 @@ void CFloat32Data2D::_clear()
 	m_iWidth = 0;
 	m_iHeight = 0;
 	m_iSize = 0;
+	m_iStride = 0;
 
 	m_pfData = NULL;
 	m_ppfData2D = NULL;
@@ -330,6 +439,7 @@ void CFloat32Data2D::_clear()
 
 	m_fGlobalMin = 0.0f;
 	m_fGlobalMax = 0.0f;
+	m_fGlobalMean = 0.0f;
 }
 
 //----------------------------------------------------------------------------------------
@@ -361,9 +471,25 @@ void CFloat32Data2D::copyData(const float* _pfData)
 	ASTRA_ASSERT(m_iSize > 0);
 
 	// copy data
-	size_t i;
-	for (i = 0; i < m_iSize; ++i) {
-		m_pfData[i] = _pfData[i];
+	for (int iy = 0; iy < m_iHeight; ++iy) {
+		memcpy(m_ppfData2D[iy], _pfData + (size_t)iy * m_iWidth, m_iWidth * sizeof(float));
+	}
+}
+
+//----------------------------------------------------------------------------------------
+// Copy the contents of another data object row by row.
+void CFloat32Data2D::_copyRows(const CFloat32Data2D& _other)
+{
+	// basic checks
+	ASTRA_ASSERT(m_pfData != NULL);
+	ASTRA_ASSERT(m_iWidth == _other.m_iWidth && m_iHeight == _other.m_iHeight);
+
+	if (m_iStride == m_iWidth && _other.m_iStride == _other.m_iWidth) {
+		memcpy(m_pfData, _other.m_pfData, m_iSize * sizeof(float));
+		return;
+	}
+	for (int iy = 0; iy < m_iHeight; ++iy) {
+		memcpy(m_ppfData2D[iy], _other.m_ppfData2D[iy], m_iWidth * sizeof(float));
 	}
 }
 
@@ -378,10 +504,11 @@ void CFloat32Data2D::scale()
 	ASTRA_ASSERT(m_iSize > 0);
 
 	_computeGlobalMinMax();
-	for (size_t i = 0; i < m_iSize; i++)
-	{
-		// do checks
-		m_pfData[i] = (m_pfData[i] - m_fGlobalMin) / (m_fGlobalMax - m_fGlobalMin) * 255; ;
+	for (int iy = 0; iy < m_iHeight; ++iy) {
+		float* pfRow = m_ppfData2D[iy];
+		for (int ix = 0; ix < m_iWidth; ++ix) {
+			pfRow[ix] = (pfRow[ix] - m_fGlobalMin) / (m_fGlobalMax - m_fGlobalMin) * 255;
+		}
 	}
 
 
@@ -397,10 +524,11 @@ void CFloat32Data2D::setData(float _fScalar)
 	ASTRA_ASSERT(m_iSize > 0);
 
 	// copy data
-	size_t i;
-	for (i = 0; i < m_iSize; ++i)
-	{
-		m_pfData[i] = _fScalar;
+	for (int iy = 0; iy < m_iHeight; ++iy) {
+		float* pfRow = m_ppfData2D[iy];
+		for (int ix = 0; ix < m_iWidth; ++ix) {
+			pfRow[ix] = _fScalar;
+		}
 	}
 }
 
@@ -414,9 +542,8 @@ void CFloat32Data2D::clearData()
 	ASTRA_ASSERT(m_iSize > 0);
 
 	// set data
-	size_t i;
-	for (i = 0; i < m_iSize; ++i) {
-		m_pfData[i] = 0.0f;
+	for (int iy = 0; iy < m_iHeight; ++iy) {
+		memset(m_ppfData2D[iy], 0, m_iWidth * sizeof(float));
 	}
 }
 //----------------------------------------------------------------------------------------
@@ -449,17 +576,19 @@ void CFloat32Data2D::_computeGlobalMinMax()
 	m_fGlobalMean = 0.0f;
 
 	// loop
-	for (size_t i = 0; i < m_iSize; i++)
-	{
-		// do checks
-		float v = m_pfData[i];
-		if (v < m_fGlobalMin) {
-			m_fGlobalMin = v;
-		}
-		if (v > m_fGlobalMax) {
-			m_fGlobalMax = v;
+	for (int iy = 0; iy < m_iHeight; ++iy) {
+		const float* pfRow = m_ppfData2D[iy];
+		for (int ix = 0; ix < m_iWidth; ++ix) {
+			// do checks
+			float v = pfRow[ix];
+			if (v < m_fGlobalMin) {
+				m_fGlobalMin = v;
+			}
+			if (v > m_fGlobalMax) {
+				m_fGlobalMax = v;
+			}
+			m_fGlobalMean += v;
 		}
-		m_fGlobalMean += v;
 	}
 	m_fGlobalMean /= m_iSize;
 }
@@ -469,9 +598,12 @@ void CFloat32Data2D::_computeGlobalMinMax()
 CFloat32Data2D& CFloat32Data2D::clampMin(float& _fMin)
 {
 	ASTRA_ASSERT(m_bInitialized);
-	for (size_t i = 0; i < m_iSize; i++) {
-		if (m_pfData[i] < _fMin)
-			m_pfData[i] = _fMin;
+	for (int iy = 0; iy < m_iHeight; ++iy) {
+		float* pfRow = m_ppfData2D[iy];
+		for (int ix = 0; ix < m_iWidth; ++ix) {
+			if (pfRow[ix] < _fMin)
+				pfRow[ix] = _fMin;
+		}
 	}
 	return (*this);
 }
@@ -479,9 +611,12 @@ CFloat32Data2D& CFloat32Data2D::clampMin(float& _fMin)
 CFloat32Data2D& CFloat32Data2D::clampMax(float& _fMax)
 {
 	ASTRA_ASSERT(m_bInitialized);
-	for (size_t i = 0; i < m_iSize; i++) {
-		if (m_pfData[i] > _fMax)
-			m_pfData[i] = _fMax;
+	for (int iy = 0; iy < m_iHeight; ++iy) {
+		float* pfRow = m_ppfData2D[iy];
+		for (int ix = 0; ix < m_iWidth; ++ix) {
+			if (pfRow[ix] > _fMax)
+				pfRow[ix] = _fMax;
+		}
 	}
 	return (*this);
 }
@@ -494,9 +629,13 @@ CFloat32Data2D& CFloat32Data2D::operator+=(const CFloat32Data2D& v)
 {
 	ASTRA_ASSERT(m_bInitialized);
 	ASTRA_ASSERT(v.m_bInitialized);
-	ASTRA_ASSERT(getSize() == v.getSize());
-	for (size_t i = 0; i < m_iSize; i++) {
-		m_pfData[i] += v.m_pfData[i];
+	ASTRA_ASSERT(m_iWidth == v.m_iWidth && m_iHeight == v.m_iHeight);
+	for (int iy = 0; iy < m_iHeight; ++iy) {
+		float* pfRow = m_ppfData2D[iy];
+		const float* pfOther = v.m_ppfData2D[iy];
+		for (int ix = 0; ix < m_iWidth; ++ix) {
+			pfRow[ix] += pfOther[ix];
+		}
 	}
 	return (*this);
 }
@@ -505,9 +644,13 @@ CFloat32Data2D& CFloat32Data2D::operator-=(const CFloat32Data2D& v)
 {
 	ASTRA_ASSERT(m_bInitialized);
 	ASTRA_ASSERT(v.m_bInitialized);
-	ASTRA_ASSERT(getSize() == v.getSize());
-	for (size_t i = 0; i < m_iSize; i++) {
-		m_pfData[i] -= v.m_pfData[i];
+	ASTRA_ASSERT(m_iWidth == v.m_iWidth && m_iHeight == v.m_iHeight);
+	for (int iy = 0; iy < m_iHeight; ++iy) {
+		float* pfRow = m_ppfData2D[iy];
+		const float* pfOther = v.m_ppfData2D[iy];
+		for (int ix = 0; ix < m_iWidth; ++ix) {
+			pfRow[ix] -= pfOther[ix];
+		}
 	}
 	return (*this);
 }
@@ -516,9 +659,13 @@ CFloat32Data2D& CFloat32Data2D::operator*=(const CFloat32Data2D& v)
 {
 	ASTRA_ASSERT(m_bInitialized);
 	ASTRA_ASSERT(v.m_bInitialized);
-	ASTRA_ASSERT(getSize() == v.getSize());
-	for (size_t i = 0; i < m_iSize; i++) {
-		m_pfData[i] *= v.m_pfData[i];
+	ASTRA_ASSERT(m_iWidth == v.m_iWidth && m_iHeight == v.m_iHeight);
+	for (int iy = 0; iy < m_iHeight; ++iy) {
+		float* pfRow = m_ppfData2D[iy];
+		const float* pfOther = v.m_ppfData2D[iy];
+		for (int ix = 0; ix < m_iWidth; ++ix) {
+			pfRow[ix] *= pfOther[ix];
+		}
 	}
 	return (*this);
 }
@@ -526,8 +673,11 @@ CFloat32Data2D& CFloat32Data2D::operator*=(const CFloat32Data2D& v)
 CFloat32Data2D& CFloat32Data2D::operator*=(const float& f)
 {
 	ASTRA_ASSERT(m_bInitialized);
-	for (size_t i = 0; i < m_iSize; i++) {
-		m_pfData[i] *= f;
+	for (int iy = 0; iy < m_iHeight; ++iy) {
+		float* pfRow = m_ppfData2D[iy];
+		for (int ix = 0; ix < m_iWidth; ++ix) {
+			pfRow[ix] *= f;
+		}
 	}
 	return (*this);
 }
@@ -535,8 +685,11 @@ CFloat32Data2D& CFloat32Data2D::operator*=(const float& f)
 CFloat32Data2D& CFloat32Data2D::operator/=(const float& f)
 {
 	ASTRA_ASSERT(m_bInitialized);
-	for (size_t i = 0; i < m_iSize; i++) {
-		m_pfData[i] /= f;
+	for (int iy = 0; iy < m_iHeight; ++iy) {
+		float* pfRow = m_ppfData2D[iy];
+		for (int ix = 0; ix < m_iWidth; ++ix) {
+			pfRow[ix] /= f;
+		}
 	}
 	return (*this);
 }
@@ -544,8 +697,11 @@ CFloat32Data2D& CFloat32Data2D::operator/=(const float& f)
 CFloat32Data2D& CFloat32Data2D::operator+=(const float& f)
 {
 	ASTRA_ASSERT(m_bInitialized);
-	for (size_t i = 0; i < m_iSize; i++) {
-		m_pfData[i] += f;
+	for (int iy = 0; iy < m_iHeight; ++iy) {
+		float* pfRow = m_ppfData2D[iy];
+		for (int ix = 0; ix < m_iWidth; ++ix) {
+			pfRow[ix] += f;
+		}
 	}
 	return (*this);
 }
@@ -553,12 +709,78 @@ CFloat32Data2D& CFloat32Data2D::operator+=(const float& f)
 CFloat32Data2D& CFloat32Data2D::operator-=(const float& f)
 {
 	ASTRA_ASSERT(m_bInitialized);
-	for (size_t i = 0; i < m_iSize; i++) {
-		m_pfData[i] -= f;
+	for (int iy = 0; iy < m_iHeight; ++iy) {
+		float* pfRow = m_ppfData2D[iy];
+		for (int ix = 0; ix < m_iWidth; ++ix) {
+			pfRow[ix] -= f;
+		}
 	}
 	return (*this);
 }
 
+CFloat32Data2D& CFloat32Data2D::addScaled(float _fScalar, const CFloat32Data2D& v)
+{
+	ASTRA_ASSERT(m_bInitialized);
+	ASTRA_ASSERT(v.m_bInitialized);
+	ASTRA_ASSERT(m_iWidth == v.m_iWidth && m_iHeight == v.m_iHeight);
+	for (int iy = 0; iy < m_iHeight; ++iy) {
+		float* pfRow = m_ppfData2D[iy];
+		const float* pfOther = v.m_ppfData2D[iy];
+		for (int ix = 0; ix < m_iWidth; ++ix) {
+			pfRow[ix] += _fScalar * pfOther[ix];
+		}
+	}
+	return (*this);
+}
+
+CFloat32Data2D& CFloat32Data2D::scaleAndAdd(float _fScalar, const CFloat32Data2D& v)
+{
+	ASTRA_ASSERT(m_bInitialized);
+	ASTRA_ASSERT(v.m_bInitialized);
+	ASTRA_ASSERT(m_iWidth == v.m_iWidth && m_iHeight == v.m_iHeight);
+	for (int iy = 0; iy < m_iHeight; ++iy) {
+		float* pfRow = m_ppfData2D[iy];
+		const float* pfOther = v.m_ppfData2D[iy];
+		for (int ix = 0; ix < m_iWidth; ++ix) {
+			pfRow[ix] = _fScalar * pfRow[ix] + pfOther[ix];
+		}
+	}
+	return (*this);
+}
+
+// sum of _pfA[i] * _pfB[i] in eight float lanes, so that it vectorizes without reassociation
+static double _rowDot(const float* _pfA, const float* _pfB, int _iCount)
+{
+	float fLanes[8] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+	int i = 0;
+	for (; i + 8 <= _iCount; i += 8) {
+		for (int k = 0; k < 8; ++k)
+			fLanes[k] += _pfA[i + k] * _pfB[i + k];
+	}
+	double dSum = 0.0;
+	for (; i < _iCount; ++i)
+		dSum += (double)_pfA[i] * _pfB[i];
+	for (int k = 0; k < 8; ++k)
+		dSum += fLanes[k];
+	return dSum;
+}
+
+double CFloat32Data2D::dot(const CFloat32Data2D& v) const
+{
+	ASTRA_ASSERT(m_bInitialized);
+	ASTRA_ASSERT(v.m_bInitialized);
+	ASTRA_ASSERT(m_iWidth == v.m_iWidth && m_iHeight == v.m_iHeight);
+	double dSum = 0.0;
+	for (int iy = 0; iy < m_iHeight; ++iy)
+		dSum += _rowDot(m_ppfData2D[iy], v.m_ppfData2D[iy], m_iWidth);
+	return dSum;
+}
+
+double CFloat32Data2D::squaredNorm() const
+{
+	return dot(*this);
+}
+
 
 std::string CFloat32Data2D::description() const
 {
@@ -18,6 +18,9 @@ public:
 	* elementary computations on the data.
 	* The data block is "owned" by the class, meaning that the class is
 	* responsible for deallocation of the memory involved.
+	*
+	* Rows are m_iStride floats apart. This is m_iWidth for data that owns its block; a
+	* view into a larger block (see CFloat32VolumeData2DView) has the stride of that block.
 	*/
 class CFloat32Data2D : public CFloat32Data {
 
@@ -26,12 +29,13 @@ protected:
 	int m_iWidth;			///< width of the data (x)
 	int m_iHeight;			///< height of the data (y)
 	int m_iSize;			///< total size of the data
+	int m_iStride;			///< distance in floats between the starts of two rows
 
 	/** Pointer to the data block, represented as a 1-dimensional array.
 		* Note that the data memory is "owned" by this class, meaning that the
 		* class is responsible for deallocation of the memory involved.
 		* To access element (ix, iy) internally, use
-		* m_pData[iy * m_iWidth + ix]
+		* m_pData[iy * m_iStride + ix]
 		*/
 	float* m_pfData;
 
@@ -136,6 +140,43 @@ protected:
 		*/
 	bool _initialize(int _iWidth, int _iHeight, CFloat32CustomMemory* _pCustomMemory);
 
+	/** Initialization. Reinitializes an instance of the CFloat32Data2D class, keeping the current data
+		* block if it already has the requested shape. Can only be called by derived classes.
+		*
+		* If the object is initialized with a block of _iWidth x _iHeight that is not custom memory, the
+		* block is kept and only the statistics are reset. Otherwise this behaves like
+		* _initialize(_iWidth, _iHeight). The contents of the data block is undefined afterwards.
+		* This function does not set m_bInitialized to true if everything is ok.
+		*
+		* @param _iWidth width of the 2D data (x-axis), must be > 0
+		* @param _iHeight height of the 2D data (y-axis), must be > 0
+		* @return initialization of the base class successfull
+		*/
+	bool _reinitialize(int _iWidth, int _iHeight);
+
+	/** Initialization. Initializes an instance of the CFloat32Data2D class as a window into memory
+		* that is not owned by this object. Can only be called by derived classes.
+		*
+		* Only the row table is allocated. Element (ix, iy) is _pfData[iy * _iStride + ix].
+		* If the object has been initialized before, the object is reinitialized and memory is freed.
+		* This function does not set m_bInitialized to true if everything is ok.
+		*
+		* @param _iWidth width of the 2D data (x-axis), must be > 0
+		* @param _iHeight height of the 2D data (y-axis), must be > 0
+		* @param _iStride distance in floats between the starts of two rows, must be >= _iWidth
+		* @param _pfData pointer to element (0, 0), must stay valid for the lifetime of the object
+		*/
+	bool _initializeView(int _iWidth, int _iHeight, int _iStride, float* _pfData);
+
+	/** Copy the contents of _other, which must have the same width and height, row by row.
+		*/
+	void _copyRows(const CFloat32Data2D& _other);
+
+	/** Take over the data block and all members of _other, leaving _other uninitialized.
+		* Any data block owned by this object is freed first.
+		*/
+	void _takeData(CFloat32Data2D& _other);
+
 	/** Constructor. Create an instance of the CFloat32Data2D class without initializing the data block.
 		* Can only be called by derived classes.
 		*
@@ -194,6 +235,10 @@ protected:
 		*/
 	CFloat32Data2D(const CFloat32Data2D&);
 
+	/** Move constructor. Takes over the data block of _other, which is left uninitialized.
+		*/
+	CFloat32Data2D(CFloat32Data2D&& _other);
+
 public:
 
 	/** Typedef with available datatypes: BASE, PROJECTION, VOLUME.
@@ -218,7 +263,7 @@ public:
 	virtual ~CFloat32Data2D();
 
 	/** Copy the data block pointed to by _pfData to the data block pointed to by m_pfData.
-		* The pointer _pfData must point to a block of m_iSize floats.
+		* The pointer _pfData must point to a contiguous block of m_iSize floats.
 		*
 		* @param _pfData source data block
 		*/
@@ -245,6 +290,7 @@ public:
 		* caller of this function. If changes are made to this data, the
 		* function updateStatistics() should be called after completion of
 		* all changes.
+		* Element (ix, iy) is at index iy * getStride() + ix.
 		*
 		* @return pointer to the 1-dimensional 32-bit floating point data block
 		*/
@@ -335,6 +381,18 @@ public:
 		*/
 	int getSize() const;
 
+	/** Get the distance in floats between the starts of two rows of the data block.
+		*
+		* @return row stride of the data block
+		*/
+	int getStride() const;
+
+	/** Are the rows stored back to back, i.e. is getStride() equal to getWidth()?
+		*
+		* @return data block is contiguous
+		*/
+	bool isContiguous() const;
+
 	/** which type is this class?
 		*
 		* @return DataType: ASTRA_DATATYPE_FLOAT32_PROJECTION or
@@ -426,8 +484,52 @@ public:
 		*/
 	CFloat32Data2D& operator-=(const float& _fScalar);
 
+	/**
+		* Fused update: data += scalar * data (pointwise, axpy)
+		*
+		* @param _fScalar scale of _data
+		* @param _data r-value
+		* @return l-value
+		*/
+	CFloat32Data2D& addScaled(float _fScalar, const CFloat32Data2D& _data);
+
+	/**
+		* Fused update: data = scalar * data + data (pointwise, xpay)
+		*
+		* @param _fScalar scale of this data
+		* @param _data r-value
+		* @return l-value
+		*/
+	CFloat32Data2D& scaleAndAdd(float _fScalar, const CFloat32Data2D& _data);
+
+	/**
+		* Inner product with another data block of the same size. Rows are summed in
+		* float lanes, the row sums in double.
+		*
+		* @param _data r-value
+		* @return sum of the pointwise products
+		*/
+	double dot(const CFloat32Data2D& _data) const;
+
+	/**
+		* Squared Euclidean norm, dot(*this).
+		*
+		* @return sum of the squares
+		*/
+	double squaredNorm() const;
+
 	CFloat32Data2D& operator=(const CFloat32Data2D& _dataIn);
 
+	/**
+		* Move assignment. Frees the current data block and takes over the one of _dataIn,
+		* which is left uninitialized. Use this to hand a buffer to the next stage of a
+		* pipeline without copying.
+		*
+		* @param _dataIn r-value, uninitialized afterwards
+		* @return l-value
+		*/
+	CFloat32Data2D& operator=(CFloat32Data2D&& _dataIn);
+
 	float& getData(int _index);
 
 
@@ -477,6 +579,22 @@ inline int CFloat32Data2D::getSize() const
 	return m_iSize;
 }
 
+//----------------------------------------------------------------------------------------
+// Get the row stride of the data block.
+inline int CFloat32Data2D::getStride() const
+{
+	ASTRA_ASSERT(m_bInitialized);
+	return m_iStride;
+}
+
+//----------------------------------------------------------------------------------------
+// Are the rows stored back to back?
+inline bool CFloat32Data2D::isContiguous() const
+{
+	ASTRA_ASSERT(m_bInitialized);
+	return m_iStride == m_iWidth;
+}
+
 //----------------------------------------------------------------------------------------
 // Get a pointer to the data block, represented as a 1-dimensional array of float values.
 inline float* CFloat32Data2D::getData()
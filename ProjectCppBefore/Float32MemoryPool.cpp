@@ -0,0 +1,318 @@
+#include "Float32MemoryPool.h"
+
+#include <cstring>
+
+#ifdef _MSC_VER
+#include <malloc.h>
+#else
+#include <cstdlib>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+
+DEFINE_SINGLETON(CFloat32MemoryPool)
+
+
+// blocks from this size on are mapped directly, so that their pages are placed by first touch
+static const size_t MIN_MAPPED_BYTES = 64 * 1024;
+
+// default upper limit of the free lists
+static const size_t DEFAULT_MAX_CACHED_BYTES = (size_t)1024 * 1024 * 1024;
+
+// get_mempolicy flags (numaif.h): return the node of the page at the given address
+static const unsigned long GET_MEMPOLICY_NODE_OF_ADDRESS = (1 << 0) | (1 << 1);
+
+
+//----------------------------------------------------------------------------------------
+// Constructor
+CFloat32MemoryPool::CFloat32MemoryPool()
+{
+	memset(&m_stats, 0, sizeof(m_stats));
+	m_iMaxCachedBytes = DEFAULT_MAX_CACHED_BYTES;
+	m_eHugePageMode = HUGEPAGES_TRANSPARENT;
+}
+
+//----------------------------------------------------------------------------------------
+// Destructor
+CFloat32MemoryPool::~CFloat32MemoryPool()
+{
+	trim();
+}
+
+//----------------------------------------------------------------------------------------
+// Size class of a request. Four classes per power of two, the smallest class is 256 bytes.
+int CFloat32MemoryPool::_sizeClass(size_t _iBytes)
+{
+	if (_iBytes <= 256) return 0;
+
+	// 2^e < _iBytes <= 2^(e+1)
+	int e = 8;
+	while (((size_t)2 << e) < _iBytes) ++e;
+
+	size_t iStep = (size_t)1 << (e - 2);
+	int q = (int)((_iBytes - 1 - ((size_t)1 << e)) / iStep) + 1;
+	return (e - 8) * 4 + q;
+}
+
+//----------------------------------------------------------------------------------------
+// Number of bytes in a size class.
+size_t CFloat32MemoryPool::_classBytes(int _iClass)
+{
+	if (_iClass == 0) return 256;
+	int e = 8 + (_iClass - 1) / 4;
+	int q = (_iClass - 1) % 4 + 1;
+	return ((size_t)1 << e) + q * ((size_t)1 << (e - 2));
+}
+
+//----------------------------------------------------------------------------------------
+// NUMA node of the calling thread
+int CFloat32MemoryPool::getCurrentNode()
+{
+#if defined(__linux__) && defined(SYS_getcpu)
+	unsigned int iCpu = 0, iNode = 0;
+	if (syscall(SYS_getcpu, &iCpu, &iNode, NULL) == 0)
+		return (int)iNode;
+#endif
+	return 0;
+}
+
+//----------------------------------------------------------------------------------------
+// NUMA node of the pages of a block
+int CFloat32MemoryPool::_blockNode(const SBlockHeader* _pHeader)
+{
+#if defined(__linux__) && defined(SYS_get_mempolicy)
+	// a page in the middle of the block: the first one holds the header, which the pool
+	// wrote itself, the others are placed by whichever thread touched them first. Small
+	// blocks come from the heap and share their pages, so they are not worth the system call.
+	if (_pHeader->m_bMapped) {
+		const char* pPage = (const char*)_pHeader + _pHeader->m_iClassBytes / 2;
+		int iNode = -1;
+		if (syscall(SYS_get_mempolicy, &iNode, NULL, 0UL, pPage, GET_MEMPOLICY_NODE_OF_ADDRESS) == 0 && iNode >= 0)
+			return iNode;
+	}
+#endif
+	return getCurrentNode();
+}
+
+//----------------------------------------------------------------------------------------
+// Get a fresh block from the system
+CFloat32MemoryPool::SBlockHeader* CFloat32MemoryPool::_systemAllocate(int _iClass)
+{
+	size_t iClassBytes = _classBytes(_iClass);
+	void* pBase = NULL;
+	size_t iMappedBytes = iClassBytes;
+	bool bMapped = false;
+
+#ifdef _MSC_VER
+	pBase = _aligned_malloc(iClassBytes, ALIGNMENT);
+#else
+	if (iClassBytes >= MIN_MAPPED_BYTES) {
+		bMapped = true;
+		EHugePageMode eHugePageMode = m_eHugePageMode;
+		bool bHuge = (eHugePageMode != HUGEPAGES_NONE) && (iClassBytes >= HUGEPAGE_SIZE);
+		if (bHuge) {
+			iMappedBytes = (iClassBytes + HUGEPAGE_SIZE - 1) / HUGEPAGE_SIZE * HUGEPAGE_SIZE;
+		}
+
+#ifdef MAP_HUGETLB
+		if (bHuge && eHugePageMode == HUGEPAGES_EXPLICIT) {
+			void* p = mmap(NULL, iMappedBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+			if (p != MAP_FAILED) {
+				pBase = p;
+			}
+			else {
+				++m_stats.iHugePageFallbacks;
+			}
+		}
+#endif
+
+		if (!pBase && bHuge) {
+			// over-allocate so that the block can start on a huge page boundary
+			void* p = mmap(NULL, iMappedBytes + HUGEPAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if (p != MAP_FAILED) {
+				char* pRaw = (char*)p;
+				char* pAligned = (char*)(((size_t)pRaw + HUGEPAGE_SIZE - 1) & ~(HUGEPAGE_SIZE - 1));
+				size_t iHead = pAligned - pRaw;
+				size_t iTail = HUGEPAGE_SIZE - iHead;
+				if (iHead) munmap(pRaw, iHead);
+				if (iTail) munmap(pAligned + iMappedBytes, iTail);
+#ifdef MADV_HUGEPAGE
+				madvise(pAligned, iMappedBytes, MADV_HUGEPAGE);
+#endif
+				pBase = pAligned;
+			}
+		}
+
+		if (!pBase && !bHuge) {
+			void* p = mmap(NULL, iMappedBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if (p != MAP_FAILED) pBase = p;
+		}
+	}
+	else {
+		if (posix_memalign(&pBase, ALIGNMENT, iClassBytes) != 0)
+			pBase = NULL;
+	}
+#endif
+
+	if (!pBase) return NULL;
+
+	++m_stats.iSystemAllocations;
+
+	// the header only touches the first cache line of the block
+	SBlockHeader* pHeader = (SBlockHeader*)pBase;
+	pHeader->m_pBase = pBase;
+	pHeader->m_iMappedBytes = iMappedBytes;
+	pHeader->m_iClassBytes = iClassBytes;
+	pHeader->m_iClass = _iClass;
+	pHeader->m_iNode = 0;
+	pHeader->m_bMapped = bMapped;
+	return pHeader;
+}
+
+//----------------------------------------------------------------------------------------
+// Return a block to the system
+void CFloat32MemoryPool::_systemFree(SBlockHeader* _pHeader)
+{
+	++m_stats.iSystemFrees;
+
+#ifdef _MSC_VER
+	_aligned_free(_pHeader->m_pBase);
+#else
+	if (_pHeader->m_bMapped) {
+		munmap(_pHeader->m_pBase, _pHeader->m_iMappedBytes);
+	}
+	else {
+		free(_pHeader->m_pBase);
+	}
+#endif
+}
+
+//----------------------------------------------------------------------------------------
+// Allocate
+void* CFloat32MemoryPool::allocate(size_t _iBytes)
+{
+	ASTRA_ASSERT(_iBytes > 0);
+	ASTRA_ASSERT(sizeof(SBlockHeader) <= ALIGNMENT);
+
+	int iClass = _sizeClass(_iBytes + ALIGNMENT);
+	int iNode = getCurrentNode() % MAX_NODES;
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	++m_stats.iRequests;
+
+	SBlockHeader* pHeader = NULL;
+
+	// prefer a block that lives on the node of this thread
+	if (!m_freeLists[iNode][iClass].empty()) {
+		pHeader = m_freeLists[iNode][iClass].back();
+		m_freeLists[iNode][iClass].pop_back();
+		++m_stats.iPoolHits;
+	}
+	else {
+		for (int n = 0; n < MAX_NODES && !pHeader; ++n) {
+			if (!m_freeLists[n][iClass].empty()) {
+				pHeader = m_freeLists[n][iClass].back();
+				m_freeLists[n][iClass].pop_back();
+				++m_stats.iPoolHits;
+				++m_stats.iRemoteHits;
+			}
+		}
+	}
+
+	if (pHeader) {
+		m_stats.iBytesCached -= pHeader->m_iClassBytes;
+	}
+	else {
+		pHeader = _systemAllocate(iClass);
+		if (!pHeader) return NULL;
+	}
+
+	m_stats.iBytesInUse += pHeader->m_iClassBytes;
+	if (m_stats.iBytesInUse > m_stats.iPeakBytesInUse)
+		m_stats.iPeakBytesInUse = m_stats.iBytesInUse;
+
+	return (char*)pHeader + ALIGNMENT;
+}
+
+//----------------------------------------------------------------------------------------
+// Release
+void CFloat32MemoryPool::release(void* _pBlock)
+{
+	if (!_pBlock) return;
+
+	SBlockHeader* pHeader = (SBlockHeader*)((char*)_pBlock - ALIGNMENT);
+	int iNode = _blockNode(pHeader) % MAX_NODES;
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_stats.iBytesInUse -= pHeader->m_iClassBytes;
+
+	if (m_stats.iBytesCached + pHeader->m_iClassBytes > m_iMaxCachedBytes) {
+		_systemFree(pHeader);
+		return;
+	}
+
+	pHeader->m_iNode = iNode;
+	m_freeLists[iNode][pHeader->m_iClass].push_back(pHeader);
+	m_stats.iBytesCached += pHeader->m_iClassBytes;
+}
+
+//----------------------------------------------------------------------------------------
+// Return all cached blocks to the system
+void CFloat32MemoryPool::trim()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	for (int n = 0; n < MAX_NODES; ++n) {
+		for (int c = 0; c < CLASS_COUNT; ++c) {
+			for (size_t i = 0; i < m_freeLists[n][c].size(); ++i) {
+				_systemFree(m_freeLists[n][c][i]);
+			}
+			m_freeLists[n][c].clear();
+		}
+	}
+	m_stats.iBytesCached = 0;
+}
+
+//----------------------------------------------------------------------------------------
+// Huge page policy
+void CFloat32MemoryPool::setHugePageMode(EHugePageMode _eMode)
+{
+	m_eHugePageMode = _eMode;
+}
+
+//----------------------------------------------------------------------------------------
+// Cache limit
+void CFloat32MemoryPool::setMaxCachedBytes(size_t _iBytes)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_iMaxCachedBytes = _iBytes;
+		if (m_stats.iBytesCached <= m_iMaxCachedBytes) return;
+	}
+	trim();
+}
+
+//----------------------------------------------------------------------------------------
+// Statistics
+SMemoryPoolStatistics CFloat32MemoryPool::getStatistics() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_stats;
+}
+
+//----------------------------------------------------------------------------------------
+// Reset statistics
+void CFloat32MemoryPool::resetStatistics()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	size_t iBytesInUse = m_stats.iBytesInUse;
+	size_t iBytesCached = m_stats.iBytesCached;
+	memset(&m_stats, 0, sizeof(m_stats));
+	m_stats.iBytesInUse = iBytesInUse;
+	m_stats.iPeakBytesInUse = iBytesInUse;
+	m_stats.iBytesCached = iBytesCached;
+}
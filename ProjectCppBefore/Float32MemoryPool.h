@@ -0,0 +1,174 @@
+#ifndef _INC_ASTRA_FLOAT32MEMORYPOOL
+#define _INC_ASTRA_FLOAT32MEMORYPOOL
+
+#include "Globals.h"
+#include "Singleton.h"
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+
+/**
+	* Huge page policy for blocks obtained from the operating system.
+	*/
+enum EHugePageMode {
+	HUGEPAGES_NONE,			///< regular pages only
+	HUGEPAGES_TRANSPARENT,	///< 2 MiB aligned mappings advised with MADV_HUGEPAGE
+	HUGEPAGES_EXPLICIT		///< MAP_HUGETLB mappings, falls back to transparent if the reservation is exhausted
+};
+
+/**
+	* Allocation counters of a CFloat32MemoryPool. A workload that has reached
+	* steady state shows no growth in iSystemAllocations.
+	*/
+struct SMemoryPoolStatistics
+{
+	size_t iRequests;			///< number of calls to allocate()
+	size_t iPoolHits;			///< requests served from a free list
+	size_t iRemoteHits;			///< pool hits on a block whose pages are on another NUMA node
+	size_t iSystemAllocations;	///< blocks obtained from the operating system
+	size_t iSystemFrees;		///< blocks returned to the operating system
+	size_t iHugePageFallbacks;	///< explicit huge page requests that fell back to regular pages
+	size_t iBytesInUse;			///< bytes currently handed out (size class granularity)
+	size_t iPeakBytesInUse;		///< maximum of iBytesInUse since the last reset
+	size_t iBytesCached;		///< bytes sitting in free lists
+};
+
+
+/**
+	* Process-wide pool for the data blocks of CFloat32Data2D objects.
+	*
+	* Requests are rounded up to a size class (four classes per power of two) and
+	* released blocks are kept on a free list per class and per NUMA node, so
+	* repeatedly creating same-shape temporaries does not reach the system
+	* allocator. Every block is ALIGNMENT aligned.
+	*
+	* Fresh blocks are mapped but never written by the pool, so their pages are
+	* placed on the node of the first thread that touches them (first-touch).
+	* A released block is filed under the node its pages are on (small heap blocks
+	* under the node of the releasing thread), and reuse prefers blocks on the node
+	* of the calling thread.
+	*/
+class CFloat32MemoryPool : public Singleton<CFloat32MemoryPool> {
+
+public:
+
+	/** Alignment of every block returned by allocate(), in bytes.
+		*/
+	static const size_t ALIGNMENT = 64;
+
+	/** Size of a huge page, in bytes.
+		*/
+	static const size_t HUGEPAGE_SIZE = 2 * 1024 * 1024;
+
+	/** Default constructor.
+		*/
+	CFloat32MemoryPool();
+
+	/** Destructor. Returns all cached blocks to the system.
+		*/
+	virtual ~CFloat32MemoryPool();
+
+	/** Get a block of at least _iBytes bytes, aligned to ALIGNMENT bytes.
+		* The contents of the block is undefined.
+		*
+		* @param _iBytes requested size in bytes, must be > 0
+		* @return pointer to the block, NULL if the system is out of memory
+		*/
+	void* allocate(size_t _iBytes);
+
+	/** Hand a block obtained from allocate() back to the pool.
+		*
+		* @param _pBlock the block, may be NULL
+		*/
+	void release(void* _pBlock);
+
+	/** Return all cached blocks to the system.
+		*/
+	void trim();
+
+	/** Set the huge page policy for blocks that are obtained from the system from now on.
+		*/
+	void setHugePageMode(EHugePageMode _eMode);
+
+	/** Get the huge page policy.
+		*/
+	EHugePageMode getHugePageMode() const;
+
+	/** Set the maximum number of bytes kept in the free lists. Blocks released beyond
+		* this limit are returned to the system immediately.
+		*/
+	void setMaxCachedBytes(size_t _iBytes);
+
+	/** Get a snapshot of the allocation counters.
+		*/
+	SMemoryPoolStatistics getStatistics() const;
+
+	/** Reset all counters, except the ones describing the current state (bytes in use and cached).
+		*/
+	void resetStatistics();
+
+	/** Get the NUMA node of the CPU the calling thread is running on.
+		*
+		* @return node index, 0 if it cannot be determined
+		*/
+	static int getCurrentNode();
+
+protected:
+
+	/** Header stored in front of every block.
+		*/
+	struct SBlockHeader
+	{
+		void* m_pBase;			///< start of the underlying system allocation
+		size_t m_iMappedBytes;	///< size of the underlying system allocation
+		size_t m_iClassBytes;	///< usable size of the block
+		int m_iClass;			///< size class index
+		int m_iNode;			///< NUMA node of the pages of the block, when it was last released
+		bool m_bMapped;			///< obtained through mmap (true) or the aligned heap (false)
+	};
+
+	static const int MAX_NODES = 8;
+	static const int CLASS_COUNT = 256;
+
+	/** Size class of a request (payload + header).
+		*/
+	static int _sizeClass(size_t _iBytes);
+
+	/** Number of bytes in a size class.
+		*/
+	static size_t _classBytes(int _iClass);
+
+	/** Get a fresh block from the system.
+		*/
+	SBlockHeader* _systemAllocate(int _iClass);
+
+	/** Return a block to the system.
+		*/
+	void _systemFree(SBlockHeader* _pHeader);
+
+	/** NUMA node the pages of a mapped block are on. The node of the calling thread for
+		* heap blocks, or if the system cannot tell.
+		*/
+	static int _blockNode(const SBlockHeader* _pHeader);
+
+	mutable std::mutex m_mutex;
+	std::vector<SBlockHeader*> m_freeLists[MAX_NODES][CLASS_COUNT];
+	SMemoryPoolStatistics m_stats;
+	size_t m_iMaxCachedBytes;
+	std::atomic<EHugePageMode> m_eHugePageMode;	///< atomic, as getHugePageMode() does not lock
+};
+
+//----------------------------------------------------------------------------------------
+// Inline member functions
+//----------------------------------------------------------------------------------------
+
+// Get the huge page policy.
+inline EHugePageMode CFloat32MemoryPool::getHugePageMode() const
+{
+	return m_eHugePageMode;
+}
+
+#endif // _INC_ASTRA_FLOAT32MEMORYPOOL
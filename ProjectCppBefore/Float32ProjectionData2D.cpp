@@ -26,7 +26,7 @@ along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
 */
 
 #include "Float32ProjectionData2D.h"
-#include <iostream>
+#include <utility>
 
 //----------------------------------------------------------------------------------------
 // Default constructor
@@ -49,7 +49,6 @@ CFloat32ProjectionData2D::CFloat32ProjectionData2D(CProjectionGeometry2D* _pGeom
 // Create an instance of the CFloat32ProjectionData2D class with initialization of the data.
 CFloat32ProjectionData2D::CFloat32ProjectionData2D(CProjectionGeometry2D* _pGeometry, float* _pfData)
 {
-	std::cout << "data set by pointer." << std::endl;
 	m_bInitialized = false;
 	m_bInitialized = initialize(_pGeometry, _pfData);
 }
@@ -58,8 +57,6 @@ CFloat32ProjectionData2D::CFloat32ProjectionData2D(CProjectionGeometry2D* _pGeom
 // Create an instance of the CFloat32ProjectionData2D class with scalar initialization of the data.
 CFloat32ProjectionData2D::CFloat32ProjectionData2D(CProjectionGeometry2D* _pGeometry, float _fScalar)
 {
-	std::cout << "data set by scalar." << std::endl;
-
 	m_bInitialized = false;
 	m_bInitialized = initialize(_pGeometry, _fScalar);
 }
@@ -74,6 +71,15 @@ CFloat32ProjectionData2D::CFloat32ProjectionData2D(const CFloat32ProjectionData2
 	m_bInitialized = true;
 }
 
+//----------------------------------------------------------------------------------------
+// Move constructor
+CFloat32ProjectionData2D::CFloat32ProjectionData2D(CFloat32ProjectionData2D&& _other) : CFloat32Data2D(std::move(_other))
+{
+	// Data is taken over by parent constructor
+	m_pGeometry = _other.m_pGeometry;
+	_other.m_pGeometry = NULL;
+}
+
 //----------------------------------------------------------------------------------------
 // Create an instance of the CFloat32ProjectionData2D class with pre-allocated data
 CFloat32ProjectionData2D::CFloat32ProjectionData2D(CProjectionGeometry2D* _pGeometry, CFloat32CustomMemory* _pCustomMemory)
@@ -99,12 +105,28 @@ CFloat32ProjectionData2D& CFloat32ProjectionData2D::operator=(const CFloat32Proj
 	return *this;
 }
 
+// Move assignment
+
+CFloat32ProjectionData2D& CFloat32ProjectionData2D::operator=(CFloat32ProjectionData2D&& _other)
+{
+	if (this == &_other)
+		return *this;
+
+	if (m_bInitialized)
+		delete m_pGeometry;
+	*((CFloat32Data2D*)this) = std::move(_other);
+	m_pGeometry = _other.m_pGeometry;
+	_other.m_pGeometry = NULL;
+
+	return *this;
+}
+
 
 //----------------------------------------------------------------------------------------
 // Initialization
 bool CFloat32ProjectionData2D::initialize(CProjectionGeometry2D* _pGeometry)
 {
-	m_pGeometry = _pGeometry->clone();
+	_setGeometry(_pGeometry);
 	m_bInitialized = _initialize(m_pGeometry->getDetectorCount(), m_pGeometry->getProjectionAngleCount());
 	return m_bInitialized;
 }
@@ -113,7 +135,7 @@ bool CFloat32ProjectionData2D::initialize(CProjectionGeometry2D* _pGeometry)
 // Initialization
 bool CFloat32ProjectionData2D::initialize(CProjectionGeometry2D* _pGeometry, const float* _pfData)
 {
-	m_pGeometry = _pGeometry->clone();
+	_setGeometry(_pGeometry);
 	m_bInitialized = _initialize(m_pGeometry->getDetectorCount(), m_pGeometry->getProjectionAngleCount(), _pfData);
 	return m_bInitialized;
 }
@@ -122,7 +144,7 @@ bool CFloat32ProjectionData2D::initialize(CProjectionGeometry2D* _pGeometry, con
 // Initialization
 bool CFloat32ProjectionData2D::initialize(CProjectionGeometry2D* _pGeometry, float _fScalar)
 {
-	m_pGeometry = _pGeometry->clone();
+	_setGeometry(_pGeometry);
 	m_bInitialized = _initialize(m_pGeometry->getDetectorCount(), m_pGeometry->getProjectionAngleCount(), _fScalar);
 	return m_bInitialized;
 }
@@ -131,7 +153,7 @@ bool CFloat32ProjectionData2D::initialize(CProjectionGeometry2D* _pGeometry, flo
 // Initialization
 bool CFloat32ProjectionData2D::initialize(CProjectionGeometry2D* _pGeometry, CFloat32CustomMemory* _pCustomMemory)
 {
-	m_pGeometry = _pGeometry->clone();
+	_setGeometry(_pGeometry);
 	m_bInitialized = _initialize(m_pGeometry->getDetectorCount(), m_pGeometry->getProjectionAngleCount(), _pCustomMemory);
 	return m_bInitialized;
 }
@@ -145,6 +167,27 @@ CFloat32ProjectionData2D::~CFloat32ProjectionData2D()
 	m_pGeometry = 0;
 }
 
+//----------------------------------------------------------------------------------------
+// Reinitialization, reusing geometry and data block where possible
+bool CFloat32ProjectionData2D::reinitialize(CProjectionGeometry2D* _pGeometry)
+{
+	if (!m_bInitialized || !m_pGeometry->isEqual(_pGeometry))
+		_setGeometry(_pGeometry);
+	m_bInitialized = _reinitialize(m_pGeometry->getDetectorCount(), m_pGeometry->getProjectionAngleCount());
+	return m_bInitialized;
+}
+
+//----------------------------------------------------------------------------------------
+// Replace the geometry
+void CFloat32ProjectionData2D::_setGeometry(CProjectionGeometry2D* _pGeometry)
+{
+	// clone first, _pGeometry may be the current geometry
+	CProjectionGeometry2D* pGeometry = _pGeometry->clone();
+	if (m_bInitialized)
+		delete m_pGeometry;
+	m_pGeometry = pGeometry;
+}
+
 //----------------------------------------------------------------------------------------
 void CFloat32ProjectionData2D::changeGeometry(CProjectionGeometry2D* _pGeometry)
 {
@@ -73,6 +73,11 @@ public:
 		*/
 	CFloat32ProjectionData2D(const CFloat32ProjectionData2D& _other);
 
+	/**
+		* Move constructor. Takes over the data block and geometry of _other, which is left uninitialized.
+		*/
+	CFloat32ProjectionData2D(CFloat32ProjectionData2D&& _other);
+
 	/** Constructor. Create an instance of the CFloat32ProjectionData2D class with pre-allocated memory.
 		*
 		* Creates an instance of the CFloat32ProjectionData2D class. Memory
@@ -91,6 +96,11 @@ public:
 		*/
 	CFloat32ProjectionData2D& operator=(const CFloat32ProjectionData2D& _other);
 
+	/**
+		* Move assignment. Takes over the data block and geometry of _other, which is left uninitialized.
+		*/
+	CFloat32ProjectionData2D& operator=(CFloat32ProjectionData2D&& _other);
+
 	/**
 		* Destructor.
 		*/
@@ -145,6 +155,18 @@ public:
 		*/
 	bool initialize(CProjectionGeometry2D* _pGeometry, CFloat32CustomMemory* _pCustomMemory);
 
+	/** Initialization. Reinitializes the object for the given geometry, reusing the current data block
+		* when the shape does not change.
+		*
+		* The geometry is only copied if it differs from the current one, and the data block is only
+		* reallocated if the dimensions change or the object uses custom memory. The contents of the
+		* data block is undefined afterwards.
+		*
+		* @param _pGeometry Projection Geometry of the data. This object will be HARDCOPIED into this class if it differs.
+		* @return Initialization of the base class successfull.
+		*/
+	bool reinitialize(CProjectionGeometry2D* _pGeometry);
+
 	/** Get the number of detectors.
 		*
 		* @return number of detectors
@@ -198,6 +220,10 @@ public:
 
 protected:
 
+	/** Replace the geometry by a hardcopy of _pGeometry.
+		*/
+	void _setGeometry(CProjectionGeometry2D* _pGeometry);
+
 	/** The projection geometry for this data.
 		*/
 	CProjectionGeometry2D* m_pGeometry;
@@ -1,5 +1,5 @@
 #include "Float32VolumeData2D.h"
-#include <iostream>
+#include <utility>
 
 //----------------------------------------------------------------------------------------
 // Default constructor
@@ -22,7 +22,6 @@ CFloat32VolumeData2D::CFloat32VolumeData2D(CVolumeGeometry2D* _pGeometry)
 // Create an instance of the CFloat32VolumeData2D class with initialization of the data.
 CFloat32VolumeData2D::CFloat32VolumeData2D(CVolumeGeometry2D* _pGeometry, float* _pfData)
 {
-	std::cout << "initialized with pointer" << std::endl;
 	m_bInitialized = false;
 	m_bInitialized = initialize(_pGeometry, _pfData);
 }
@@ -31,7 +30,6 @@ CFloat32VolumeData2D::CFloat32VolumeData2D(CVolumeGeometry2D* _pGeometry, float*
 // Create an instance of the CFloat32VolumeData2D class with initialization of the data.
 CFloat32VolumeData2D::CFloat32VolumeData2D(CVolumeGeometry2D* _pGeometry, float _fScalar)
 {
-	std::cout << "initialized with scalar" << std::endl;
 	m_bInitialized = false;
 	m_bInitialized = initialize(_pGeometry, _fScalar);
 }
@@ -44,6 +42,15 @@ CFloat32VolumeData2D::CFloat32VolumeData2D(const CFloat32VolumeData2D& _other) :
 	m_bInitialized = true;
 }
 
+//----------------------------------------------------------------------------------------
+// Move constructor
+CFloat32VolumeData2D::CFloat32VolumeData2D(CFloat32VolumeData2D&& _other) : CFloat32Data2D(std::move(_other))
+{
+	// Data is taken over by parent constructor
+	m_pGeometry = _other.m_pGeometry;
+	_other.m_pGeometry = NULL;
+}
+
 //----------------------------------------------------------------------------------------
 // Create an instance of the CFloat32VolumeData2D class with pre-allocated data
 CFloat32VolumeData2D::CFloat32VolumeData2D(CVolumeGeometry2D* _pGeometry, CFloat32CustomMemory* _pCustomMemory)
@@ -68,6 +75,22 @@ CFloat32VolumeData2D& CFloat32VolumeData2D::operator=(const CFloat32VolumeData2D
 	return *this;
 }
 
+// Move assignment
+
+CFloat32VolumeData2D& CFloat32VolumeData2D::operator=(CFloat32VolumeData2D&& _other)
+{
+	if (this == &_other)
+		return *this;
+
+	if (m_bInitialized)
+		delete m_pGeometry;
+	*((CFloat32Data2D*)this) = std::move(_other);
+	m_pGeometry = _other.m_pGeometry;
+	_other.m_pGeometry = NULL;
+
+	return *this;
+}
+
 //----------------------------------------------------------------------------------------
 // Destructor
 CFloat32VolumeData2D::~CFloat32VolumeData2D()
@@ -81,7 +104,7 @@ CFloat32VolumeData2D::~CFloat32VolumeData2D()
 // Initialization
 bool CFloat32VolumeData2D::initialize(CVolumeGeometry2D* _pGeometry)
 {
-	m_pGeometry = _pGeometry->clone();
+	_setGeometry(_pGeometry);
 	m_bInitialized = _initialize(m_pGeometry->getGridColCount(), m_pGeometry->getGridRowCount());
 	return m_bInitialized;
 }
@@ -90,7 +113,7 @@ bool CFloat32VolumeData2D::initialize(CVolumeGeometry2D* _pGeometry)
 // Initialization
 bool CFloat32VolumeData2D::initialize(CVolumeGeometry2D* _pGeometry, const float* _pfData)
 {
-	m_pGeometry = _pGeometry->clone();
+	_setGeometry(_pGeometry);
 	m_bInitialized = _initialize(m_pGeometry->getGridColCount(), m_pGeometry->getGridRowCount(), _pfData);
 	return m_bInitialized;
 }
@@ -99,7 +122,7 @@ bool CFloat32VolumeData2D::initialize(CVolumeGeometry2D* _pGeometry, const float
 // Initialization
 bool CFloat32VolumeData2D::initialize(CVolumeGeometry2D* _pGeometry, float _fScalar)
 {
-	m_pGeometry = _pGeometry->clone();
+	_setGeometry(_pGeometry);
 	m_bInitialized = _initialize(m_pGeometry->getGridColCount(), m_pGeometry->getGridRowCount(), _fScalar);
 	return m_bInitialized;
 }
@@ -108,12 +131,33 @@ bool CFloat32VolumeData2D::initialize(CVolumeGeometry2D* _pGeometry, float _fSca
 // Initialization
 bool CFloat32VolumeData2D::initialize(CVolumeGeometry2D* _pGeometry, CFloat32CustomMemory* _pCustomMemory)
 {
-	m_pGeometry = _pGeometry->clone();
+	_setGeometry(_pGeometry);
 	m_bInitialized = _initialize(m_pGeometry->getGridColCount(), m_pGeometry->getGridRowCount(), _pCustomMemory);
 	return m_bInitialized;
 }
 
 
+//----------------------------------------------------------------------------------------
+// Reinitialization, reusing geometry and data block where possible
+bool CFloat32VolumeData2D::reinitialize(CVolumeGeometry2D* _pGeometry)
+{
+	if (!m_bInitialized || !m_pGeometry->isEqual(_pGeometry))
+		_setGeometry(_pGeometry);
+	m_bInitialized = _reinitialize(m_pGeometry->getGridColCount(), m_pGeometry->getGridRowCount());
+	return m_bInitialized;
+}
+
+//----------------------------------------------------------------------------------------
+// Replace the geometry
+void CFloat32VolumeData2D::_setGeometry(CVolumeGeometry2D* _pGeometry)
+{
+	// clone first, _pGeometry may be the current geometry
+	CVolumeGeometry2D* pGeometry = _pGeometry->clone();
+	if (m_bInitialized)
+		delete m_pGeometry;
+	m_pGeometry = pGeometry;
+}
+
 //----------------------------------------------------------------------------------------
 void CFloat32VolumeData2D::changeGeometry(CVolumeGeometry2D* _pGeometry)
 {
@@ -63,6 +63,11 @@ public:
 		*/
 	CFloat32VolumeData2D(const CFloat32VolumeData2D& _other);
 
+	/**
+		* Move constructor. Takes over the data block and geometry of _other, which is left uninitialized.
+		*/
+	CFloat32VolumeData2D(CFloat32VolumeData2D&& _other);
+
 	/** Constructor. Create an instance of the CFloat32VolumeData2D class with pre-allocated memory.
 		*
 		* Creates an instance of the CFloat32VolumeData2D class. Memory
@@ -81,6 +86,11 @@ public:
 		*/
 	CFloat32VolumeData2D& operator=(const CFloat32VolumeData2D& _other);
 
+	/**
+		* Move assignment. Takes over the data block and geometry of _other, which is left uninitialized.
+		*/
+	CFloat32VolumeData2D& operator=(CFloat32VolumeData2D&& _other);
+
 	/** Initialization. Initializes of the CFloat32VolumeData2D class without initializing the data.
 		*
 		* Memory is allocated for the data block. The allocated memory is not cleared and
@@ -128,6 +138,18 @@ public:
 		*/
 	bool initialize(CVolumeGeometry2D* _pGeometry, CFloat32CustomMemory* _pCustomMemory);
 
+	/** Initialization. Reinitializes the object for the given geometry, reusing the current data block
+		* when the shape does not change.
+		*
+		* The geometry is only copied if it differs from the current one, and the data block is only
+		* reallocated if the dimensions change or the object uses custom memory. The contents of the
+		* data block is undefined afterwards.
+		*
+		* @param _pGeometry Volume Geometry of the data. This object will be HARDCOPIED into this class if it differs.
+		* @return Initialization of the base class successfull.
+		*/
+	bool reinitialize(CVolumeGeometry2D* _pGeometry);
+
 	/** Destructor.
 		*/
 	virtual ~CFloat32VolumeData2D();
@@ -151,6 +173,10 @@ public:
 
 protected:
 
+	/** Replace the geometry by a hardcopy of _pGeometry.
+		*/
+	void _setGeometry(CVolumeGeometry2D* _pGeometry);
+
 	/** The projection geometry for this data.
 		*/
 	CVolumeGeometry2D* m_pGeometry;
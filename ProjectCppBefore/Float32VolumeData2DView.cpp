@@ -0,0 +1,99 @@
+#include "Float32VolumeData2DView.h"
+
+//----------------------------------------------------------------------------------------
+// Default constructor
+CFloat32VolumeData2DView::CFloat32VolumeData2DView() :
+	CFloat32VolumeData2D()
+{
+	m_pParent = NULL;
+	m_iOffsetX = 0;
+	m_iOffsetY = 0;
+}
+
+//----------------------------------------------------------------------------------------
+// Create a view on a region of another volume
+CFloat32VolumeData2DView::CFloat32VolumeData2DView(CFloat32VolumeData2D* _pParent, int _iOffsetX, int _iOffsetY, int _iWidth, int _iHeight) :
+	CFloat32VolumeData2D()
+{
+	m_pParent = NULL;
+	m_iOffsetX = 0;
+	m_iOffsetY = 0;
+	initialize(_pParent, _iOffsetX, _iOffsetY, _iWidth, _iHeight);
+}
+
+//----------------------------------------------------------------------------------------
+// Create a volume in a padded block of its own
+CFloat32VolumeData2DView::CFloat32VolumeData2DView(CVolumeGeometry2D* _pGeometry, int _iStride, float _fScalar) :
+	CFloat32VolumeData2D()
+{
+	m_pParent = NULL;
+	m_iOffsetX = 0;
+	m_iOffsetY = 0;
+	initialize(_pGeometry, _iStride, _fScalar);
+}
+
+//----------------------------------------------------------------------------------------
+// Destructor
+CFloat32VolumeData2DView::~CFloat32VolumeData2DView()
+{
+	// the row table and the geometry are freed by the base classes, an owned parent by
+	// m_pOwnedParent
+}
+
+//----------------------------------------------------------------------------------------
+// Initialization
+bool CFloat32VolumeData2DView::initialize(CFloat32VolumeData2D* _pParent, int _iOffsetX, int _iOffsetY, int _iWidth, int _iHeight)
+{
+	ASTRA_ASSERT(_pParent != NULL && _pParent->isInitialized());
+	ASTRA_ASSERT(_iOffsetX >= 0 && _iOffsetY >= 0);
+	ASTRA_ASSERT(_iWidth > 0 && _iHeight > 0);
+	ASTRA_ASSERT(_iOffsetX + _iWidth <= _pParent->getWidth());
+	ASTRA_ASSERT(_iOffsetY + _iHeight <= _pParent->getHeight());
+
+	// sub-window of the parent geometry; row 0 is at the top (maximal y)
+	const CVolumeGeometry2D* pParentGeometry = _pParent->getGeometry();
+	float fPixelLengthX = pParentGeometry->getPixelLengthX();
+	float fPixelLengthY = pParentGeometry->getPixelLengthY();
+	float fMinX = pParentGeometry->getWindowMinX() + _iOffsetX * fPixelLengthX;
+	float fMaxY = pParentGeometry->getWindowMaxY() - _iOffsetY * fPixelLengthY;
+	CVolumeGeometry2D geometry(_iWidth, _iHeight,
+		fMinX, fMaxY - _iHeight * fPixelLengthY,
+		fMinX + _iWidth * fPixelLengthX, fMaxY);
+
+	_setGeometry(&geometry);
+	m_bInitialized = _initializeView(_iWidth, _iHeight, _pParent->getStride(),
+		_pParent->getData2D()[_iOffsetY] + _iOffsetX);
+
+	m_pParent = _pParent;
+	m_iOffsetX = _iOffsetX;
+	m_iOffsetY = _iOffsetY;
+	if (m_pOwnedParent.get() != _pParent)
+		m_pOwnedParent.reset();
+	return m_bInitialized;
+}
+
+//----------------------------------------------------------------------------------------
+// Initialization in a padded block of its own
+bool CFloat32VolumeData2DView::initialize(CVolumeGeometry2D* _pGeometry, int _iStride, float _fScalar)
+{
+	ASTRA_ASSERT(_pGeometry != NULL);
+	ASTRA_ASSERT(_iStride >= _pGeometry->getGridColCount());
+
+	// the parent is the geometry widened to the stride, so the padding is part of its block
+	float fMinX = _pGeometry->getWindowMinX();
+	CVolumeGeometry2D paddedGeometry(_iStride, _pGeometry->getGridRowCount(),
+		fMinX, _pGeometry->getWindowMinY(),
+		fMinX + _iStride * _pGeometry->getPixelLengthX(), _pGeometry->getWindowMaxY());
+	std::unique_ptr<CFloat32VolumeData2D> pParent(new CFloat32VolumeData2D(&paddedGeometry, _fScalar));
+
+	// the geometry of the view is _pGeometry itself, not a recomputed sub-window of the parent
+	_setGeometry(_pGeometry);
+	m_bInitialized = _initializeView(_pGeometry->getGridColCount(), _pGeometry->getGridRowCount(), _iStride,
+		pParent->getData());
+
+	m_pParent = pParent.get();
+	m_iOffsetX = 0;
+	m_iOffsetY = 0;
+	m_pOwnedParent = std::move(pParent);
+	return m_bInitialized;
+}
@@ -0,0 +1,126 @@
+#ifndef _INC_ASTRA_FLOAT32VOLUMEDATA2DVIEW
+#define _INC_ASTRA_FLOAT32VOLUMEDATA2DVIEW
+
+#include "Float32VolumeData2D.h"
+
+#include <memory>
+
+/**
+	* This class represents a rectangular region of interest of another CFloat32VolumeData2D,
+	* without copying it.
+	*
+	* The view does not own its data: it points into the data block of the parent, with the
+	* row stride of the parent, and only allocates a row table. Its geometry is the sub-window
+	* of the parent geometry covered by the region, so a projector created with getGeometry()
+	* traces the rays through the region only and touches no memory outside it.
+	* The view can be passed wherever a CFloat32VolumeData2D is accepted; the projector must
+	* then be told the stride with CProjector2D::setVolumeStride(getStride()).
+	*
+	* The parent must stay initialized, and must not be reallocated, for the lifetime of the view.
+	* A view may also own its parent: a padded block of the given row stride, for work volumes
+	* that have to match the stride of a projector set up for another view.
+	* Copying a view (e.g. with the CFloat32VolumeData2D copy constructor) yields a contiguous
+	* volume that owns a copy of the region.
+	*/
+class CFloat32VolumeData2DView : public CFloat32VolumeData2D {
+
+public:
+
+	/** Default constructor. The view must be initialized before it can be used.
+		*/
+	CFloat32VolumeData2DView();
+
+	/** Constructor. Create a view on a region of _pParent.
+		*
+		* @param _pParent volume data to take the region from, may itself be a view
+		* @param _iOffsetX first column of the region in _pParent
+		* @param _iOffsetY first row of the region in _pParent
+		* @param _iWidth number of columns of the region, must be > 0
+		* @param _iHeight number of rows of the region, must be > 0
+		*/
+	CFloat32VolumeData2DView(CFloat32VolumeData2D* _pParent, int _iOffsetX, int _iOffsetY, int _iWidth, int _iHeight);
+
+	/** Constructor. Create a volume of _pGeometry with rows _iStride floats apart, in a block
+		* owned by the view. The padding at the end of the rows is filled with _fScalar as well.
+		*
+		* @param _pGeometry Volume Geometry object.  This object will be HARDCOPIED into this class.
+		* @param _iStride distance in floats between two rows, at least the number of columns
+		* @param _fScalar value of every element, padding included
+		*/
+	CFloat32VolumeData2DView(CVolumeGeometry2D* _pGeometry, int _iStride, float _fScalar);
+
+	/** Destructor. The data of the parent is left alone.
+		*/
+	virtual ~CFloat32VolumeData2DView();
+
+	/** Initialization. Make this a view on a region of _pParent.
+		*
+		* @param _pParent volume data to take the region from, may itself be a view
+		* @param _iOffsetX first column of the region in _pParent
+		* @param _iOffsetY first row of the region in _pParent
+		* @param _iWidth number of columns of the region, must be > 0
+		* @param _iHeight number of rows of the region, must be > 0
+		* @return initialization successful
+		*/
+	bool initialize(CFloat32VolumeData2D* _pParent, int _iOffsetX, int _iOffsetY, int _iWidth, int _iHeight);
+
+	/** Initialization. Make this a volume of _pGeometry with rows _iStride floats apart, in a
+		* block owned by the view.
+		*
+		* @param _pGeometry Volume Geometry object.  This object will be HARDCOPIED into this class.
+		* @param _iStride distance in floats between two rows, at least the number of columns
+		* @param _fScalar value of every element, padding included
+		* @return initialization successful
+		*/
+	bool initialize(CVolumeGeometry2D* _pGeometry, int _iStride, float _fScalar);
+
+	/** Get the volume data this is a view on.
+		*/
+	CFloat32VolumeData2D* getParent() const;
+
+	/** Get the first column of the region in the parent.
+		*/
+	int getOffsetX() const;
+
+	/** Get the first row of the region in the parent.
+		*/
+	int getOffsetY() const;
+
+protected:
+
+	CFloat32VolumeData2D* m_pParent;	///< volume data this is a view on
+	int m_iOffsetX;						///< first column of the region in the parent
+	int m_iOffsetY;						///< first row of the region in the parent
+	std::unique_ptr<CFloat32VolumeData2D> m_pOwnedParent;	///< padded block, if the view owns its parent
+
+private:
+
+	/** Not implemented, a view can not be copied. Copy into a CFloat32VolumeData2D instead.
+		*/
+	CFloat32VolumeData2DView(const CFloat32VolumeData2DView&);
+	CFloat32VolumeData2DView& operator=(const CFloat32VolumeData2DView&);
+};
+
+//----------------------------------------------------------------------------------------
+// Get the parent
+inline CFloat32VolumeData2D* CFloat32VolumeData2DView::getParent() const
+{
+	ASTRA_ASSERT(m_bInitialized);
+	return m_pParent;
+}
+
+//----------------------------------------------------------------------------------------
+// Get the offsets
+inline int CFloat32VolumeData2DView::getOffsetX() const
+{
+	ASTRA_ASSERT(m_bInitialized);
+	return m_iOffsetX;
+}
+
+inline int CFloat32VolumeData2DView::getOffsetY() const
+{
+	ASTRA_ASSERT(m_bInitialized);
+	return m_iOffsetY;
+}
+
+#endif // _INC_ASTRA_FLOAT32VOLUMEDATA2DVIEW
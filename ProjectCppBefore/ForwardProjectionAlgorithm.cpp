@@ -69,6 +69,7 @@ void CForwardProjectionAlgorithm::_clear()
 	m_pForwardProjector = NULL;
 	m_bUseSinogramMask = false;
 	m_bUseVolumeMask = false;
+	m_eAccumulationMode = ACCUMULATE_FLOAT;
 	m_bIsInitialized = false;
 }
 
@@ -101,6 +102,10 @@ bool CForwardProjectionAlgorithm::_check()
 	// check compatibility between projector and data classes
 	ASTRA_CONFIG_CHECK(m_pSinogram->getGeometry()->isEqual(m_pProjector->getProjectionGeometry()), "ForwardProjection", "Projection Data not compatible with the specified Projector.");
 	ASTRA_CONFIG_CHECK(m_pVolume->getGeometry()->isEqual(m_pProjector->getVolumeGeometry()), "ForwardProjection", "Volume Data not compatible with the specified Projector.");
+	ASTRA_CONFIG_CHECK(m_pVolume->getStride() == m_pProjector->getVolumeStride(), "ForwardProjection", "Volume Data row stride does not match the Projector, see CProjector2D::setVolumeStride.");
+	if (m_bUseVolumeMask) {
+		ASTRA_CONFIG_CHECK(m_pVolumeMask->getStride() == m_pProjector->getVolumeStride(), "ForwardProjection", "Volume Mask row stride does not match the Projector.");
+	}
 
 	ASTRA_CONFIG_CHECK(m_pForwardProjector, "ForwardProjection", "Invalid FP Policy");
 
@@ -131,14 +136,38 @@ bool CForwardProjectionAlgorithm::initialize(CProjector2D* _pProjector,
 // Initialize Data Projectors - private
 void CForwardProjectionAlgorithm::_init()
 {
+	delete m_pForwardProjector;
+
 	// forward projection data projector
-	m_pForwardProjector = dispatchDataProjector(
-		m_pProjector,
-		SinogramMaskPolicy(m_pSinogramMask),			// sinogram mask
-		ReconstructionMaskPolicy(m_pVolumeMask),		// reconstruction mask
-		DefaultFPPolicy(m_pVolume, m_pSinogram),		// forward projection
-		m_bUseSinogramMask, m_bUseVolumeMask, true		// options on/off
-	);
+	switch (m_eAccumulationMode) {
+	case ACCUMULATE_DOUBLE:
+		m_pForwardProjector = dispatchDataProjector(
+			m_pProjector,
+			SinogramMaskPolicy(m_pSinogramMask),			// sinogram mask
+			ReconstructionMaskPolicy(m_pVolumeMask),		// reconstruction mask
+			DoubleFPPolicy(m_pVolume, m_pSinogram),			// forward projection
+			m_bUseSinogramMask, m_bUseVolumeMask, true		// options on/off
+		);
+		break;
+	case ACCUMULATE_KAHAN:
+		m_pForwardProjector = dispatchDataProjector(
+			m_pProjector,
+			SinogramMaskPolicy(m_pSinogramMask),			// sinogram mask
+			ReconstructionMaskPolicy(m_pVolumeMask),		// reconstruction mask
+			KahanFPPolicy(m_pVolume, m_pSinogram),			// forward projection
+			m_bUseSinogramMask, m_bUseVolumeMask, true		// options on/off
+		);
+		break;
+	default:
+		m_pForwardProjector = dispatchDataProjector(
+			m_pProjector,
+			SinogramMaskPolicy(m_pSinogramMask),			// sinogram mask
+			ReconstructionMaskPolicy(m_pVolumeMask),		// reconstruction mask
+			DefaultFPPolicy(m_pVolume, m_pSinogram),		// forward projection
+			m_bUseSinogramMask, m_bUseVolumeMask, true		// options on/off
+		);
+		break;
+	}
 }
 
 //----------------------------------------------------------------------------------------
@@ -165,6 +194,19 @@ void CForwardProjectionAlgorithm::setSinogramMask(CFloat32ProjectionData2D* _pMa
 	}
 }
 
+//----------------------------------------------------------------------------------------
+// Set Accumulation Mode
+void CForwardProjectionAlgorithm::setAccumulationMode(EAccumulationMode _eMode)
+{
+	if (m_eAccumulationMode == _eMode)
+		return;
+	m_eAccumulationMode = _eMode;
+
+	// rebuild the data projector if it was already created
+	if (m_bIsInitialized)
+		_init();
+}
+
 //----------------------------------------------------------------------------------------
 // Iterate
 void CForwardProjectionAlgorithm::run(int _iNrIterations)
@@ -172,12 +214,17 @@ void CForwardProjectionAlgorithm::run(int _iNrIterations)
 	// check initialized
 	ASTRA_ASSERT(m_bIsInitialized);
 
+	ASTRA_RECORD(m_instrumentation);
+
 	m_pSinogram->setData(0.0f);
 
+	m_control.beginRun();
+	m_pForwardProjector->setControl(&m_control);
+
 	//	if (m_bUseVoxelProjector) {
 	//		m_pForwardProjector->projectAllVoxels();
 	//	} else {
-	m_pForwardProjector->project();
+	m_pForwardProjector->projectParallel();
 	//	}
 
 }
@@ -18,6 +18,15 @@
 	*/
 class CForwardProjectionAlgorithm : public CAlgorithm {
 
+public:
+
+	/** How each ray sum is accumulated. Storage is float32 in all modes.
+		* - ACCUMULATE_FLOAT: float32 sum and stepping (default, fastest)
+		* - ACCUMULATE_DOUBLE: float64 sum and float64 ray stepping
+		* - ACCUMULATE_KAHAN: compensated float32 sum, float32 ray stepping
+		*/
+	enum EAccumulationMode { ACCUMULATE_FLOAT, ACCUMULATE_DOUBLE, ACCUMULATE_KAHAN };
+
 protected:
 
 	/** Init stuff
@@ -58,6 +67,9 @@ protected:
 	//< Use the fixed reconstruction mask?
 	bool m_bUseSinogramMask;
 
+	//< Ray sum accumulation mode
+	EAccumulationMode m_eAccumulationMode;
+
 public:
 
 	// type of the algorithm, needed to register with CAlgorithmFactory
@@ -112,6 +124,19 @@ public:
 		*/
 	void setSinogramMask(CFloat32ProjectionData2D* _pMask, bool _bEnable = true);
 
+	/** Set the ray sum accumulation mode. ACCUMULATE_DOUBLE and ACCUMULATE_KAHAN trade
+		* throughput for accuracy on long rays through large volumes.
+		*
+		* @param _eMode accumulation mode
+		*/
+	void setAccumulationMode(EAccumulationMode _eMode);
+
+	/** Get the ray sum accumulation mode.
+		*
+		* @return accumulation mode
+		*/
+	EAccumulationMode getAccumulationMode() const;
+
 	/** Get projector object
 		*
 		* @return projector
@@ -150,6 +175,7 @@ inline std::string CForwardProjectionAlgorithm::description() const { return CFo
 inline CProjector2D* CForwardProjectionAlgorithm::getProjector() const { return m_pProjector; }
 inline CFloat32ProjectionData2D* CForwardProjectionAlgorithm::getSinogram() const { return m_pSinogram; }
 inline CFloat32VolumeData2D* CForwardProjectionAlgorithm::getVolume() const { return m_pVolume; }
+inline CForwardProjectionAlgorithm::EAccumulationMode CForwardProjectionAlgorithm::getAccumulationMode() const { return m_eAccumulationMode; }
 
 
 #endif
@@ -0,0 +1,107 @@
+#include "Fourier.h"
+
+#include <cmath>
+#include <utility>
+
+
+//----------------------------------------------------------------------------------------
+// Constructor
+CFastFourierTransform::CFastFourierTransform(int _iSize)
+{
+	ASTRA_ASSERT(_iSize > 0 && (_iSize & (_iSize - 1)) == 0);
+	m_iSize = _iSize;
+
+	m_twiddles.resize(_iSize / 2);
+	for (int k = 0; k < _iSize / 2; ++k) {
+		double dAngle = -2.0 * M_PI * k / _iSize;
+		m_twiddles[k] = std::complex<double>(cos(dAngle), sin(dAngle));
+	}
+
+	int iBits = 0;
+	while ((1 << iBits) < _iSize)
+		++iBits;
+	m_bitReverse.resize(_iSize);
+	for (int i = 0; i < _iSize; ++i) {
+		int r = 0;
+		for (int b = 0; b < iBits; ++b)
+			r |= ((i >> b) & 1) << (iBits - 1 - b);
+		m_bitReverse[i] = r;
+	}
+}
+
+//----------------------------------------------------------------------------------------
+// Next power of two
+int CFastFourierTransform::nextPowerOfTwo(int _iValue)
+{
+	int iSize = 1;
+	while (iSize < _iValue)
+		iSize <<= 1;
+	return iSize;
+}
+
+//----------------------------------------------------------------------------------------
+// Transform
+void CFastFourierTransform::_transform(std::complex<double>* _pData, bool _bInverse) const
+{
+	for (int i = 0; i < m_iSize; ++i) {
+		int r = m_bitReverse[i];
+		if (i < r)
+			std::swap(_pData[i], _pData[r]);
+	}
+
+	for (int iHalf = 1; iHalf < m_iSize; iHalf <<= 1) {
+		int iTwiddleStep = m_iSize / (2 * iHalf);
+		for (int iStart = 0; iStart < m_iSize; iStart += 2 * iHalf) {
+			for (int k = 0; k < iHalf; ++k) {
+				std::complex<double> w = m_twiddles[k * iTwiddleStep];
+				if (_bInverse)
+					w = std::conj(w);
+				std::complex<double> a = _pData[iStart + k];
+				std::complex<double> b = _pData[iStart + k + iHalf] * w;
+				_pData[iStart + k] = a + b;
+				_pData[iStart + k + iHalf] = a - b;
+			}
+		}
+	}
+
+	if (_bInverse) {
+		double dScale = 1.0 / m_iSize;
+		for (int i = 0; i < m_iSize; ++i)
+			_pData[i] *= dScale;
+	}
+}
+
+void CFastFourierTransform::forward(std::complex<double>* _pData) const
+{
+	_transform(_pData, false);
+}
+
+void CFastFourierTransform::inverse(std::complex<double>* _pData) const
+{
+	_transform(_pData, true);
+}
+
+//----------------------------------------------------------------------------------------
+// Filter two real rows
+void CFastFourierTransform::filterRealPair(float* _pfRowA, float* _pfRowB, int _iLength, const double* _pdSpectrum,
+	float _fScaleA, float _fScaleB, std::complex<double>* _pBuffer) const
+{
+	ASTRA_ASSERT(_iLength <= m_iSize);
+
+	for (int i = 0; i < _iLength; ++i)
+		_pBuffer[i] = std::complex<double>(_pfRowA[i], _pfRowB ? _pfRowB[i] : 0.0f);
+	for (int i = _iLength; i < m_iSize; ++i)
+		_pBuffer[i] = 0.0;
+
+	forward(_pBuffer);
+	for (int k = 0; k < m_iSize; ++k)
+		_pBuffer[k] *= _pdSpectrum[k];
+	inverse(_pBuffer);
+
+	for (int i = 0; i < _iLength; ++i)
+		_pfRowA[i] = (float)(_pBuffer[i].real() * _fScaleA);
+	if (_pfRowB) {
+		for (int i = 0; i < _iLength; ++i)
+			_pfRowB[i] = (float)(_pBuffer[i].imag() * _fScaleB);
+	}
+}
@@ -0,0 +1,80 @@
+#ifndef _INC_ASTRA_FOURIER
+#define _INC_ASTRA_FOURIER
+
+#include "Globals.h"
+
+#include <complex>
+#include <vector>
+
+
+/**
+	* One-dimensional complex FFT of a power of two size, iterative radix-2.
+	*
+	* The twiddle factors and the bit reversal permutation are computed once in the
+	* constructor, so a transform can be reused for all rows of a sinogram, and, being
+	* read-only afterwards, by several threads at the same time.
+	*
+	* Two real rows are transformed at once by packing them as real and imaginary part:
+	* when the rows are multiplied by a real, even spectrum (a symmetric filter), the
+	* inverse transform gives back the two filtered rows in the real and imaginary part,
+	* see filterRealPair().
+	*/
+class CFastFourierTransform {
+
+public:
+
+	/** Constructor.
+		*
+		* @param _iSize size of the transform, a power of two
+		*/
+	explicit CFastFourierTransform(int _iSize);
+
+	/** Get the size of the transform.
+		*/
+	int getSize() const;
+
+	/** In-place forward transform, X[k] = sum_n x[n] exp(-2 pi i k n / N).
+		*/
+	void forward(std::complex<double>* _pData) const;
+
+	/** In-place inverse transform, including the 1 / N scaling.
+		*/
+	void inverse(std::complex<double>* _pData) const;
+
+	/** Filter two real rows with a real, even spectrum: one forward transform of
+		* _pfRowA + i * _pfRowB, zero-padded to the transform size, a multiplication with
+		* _pdSpectrum and one inverse transform. The first _iLength values of the results
+		* are multiplied by _fScale and written back over the rows. _pfRowB may be NULL.
+		*
+		* @param _pfRowA		first row, _iLength values
+		* @param _pfRowB		second row, _iLength values, or NULL
+		* @param _iLength		row length, at most getSize()
+		* @param _pdSpectrum	getSize() real spectrum values, with _pdSpectrum[k] == _pdSpectrum[N - k]
+		* @param _fScaleA		factor for the filtered first row
+		* @param _fScaleB		factor for the filtered second row
+		* @param _pBuffer		work space of getSize() elements
+		*/
+	void filterRealPair(float* _pfRowA, float* _pfRowB, int _iLength, const double* _pdSpectrum,
+		float _fScaleA, float _fScaleB, std::complex<double>* _pBuffer) const;
+
+	/** Smallest power of two not smaller than _iValue.
+		*/
+	static int nextPowerOfTwo(int _iValue);
+
+private:
+
+	void _transform(std::complex<double>* _pData, bool _bInverse) const;
+
+	int m_iSize;
+	std::vector<std::complex<double> > m_twiddles;	///< exp(-2 pi i k / N), k < N / 2
+	std::vector<int> m_bitReverse;
+};
+
+//----------------------------------------------------------------------------------------
+
+inline int CFastFourierTransform::getSize() const
+{
+	return m_iSize;
+}
+
+#endif // _INC_ASTRA_FOURIER
@@ -1,62 +1,324 @@
 #include "GeometryUtil2D.h"
+#include "Float32MemoryPool.h"
 
+#include <algorithm>
 #include <iostream>
 #include <cmath>
 #include <cstdio>
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define GEOMETRY_SIMD_TARGET(x) __attribute__((target(x)))
+#define GEOMETRY_HAS_AVX2() __builtin_cpu_supports("avx2")
+#define GEOMETRY_SIMD
+#elif defined(_MSC_VER) && defined(__AVX2__)
+#include <immintrin.h>
+#define GEOMETRY_SIMD_TARGET(x)
+#define GEOMETRY_HAS_AVX2() true
+#define GEOMETRY_SIMD
+#endif
+
+
+//----------------------------------------------------------------------------------------
+// sincos
+//----------------------------------------------------------------------------------------
+
+// angles are reduced to [-pi/4, pi/4] with pi/2 split in three parts (fdlibm); the first
+// two have 33 significant bits, so q * part is exact for the quadrants up to this bound
+static const double SINCOS_MAX_ARGUMENT = 1e5;
+static const double TWO_OVER_PI = 6.36619772367581382433e-01;
+static const double PIO2_1 = 1.57079632673412561417e+00;
+static const double PIO2_2 = 6.07710050630396597660e-11;
+static const double PIO2_3 = 2.02226624879595063154e-21;
+
+// minimax polynomials on [-pi/4, pi/4] (fdlibm __kernel_sin, __kernel_cos)
+static const double S1 = -1.66666666666666324348e-01;
+static const double S2 = 8.33333333332248946124e-03;
+static const double S3 = -1.98412698298579493134e-04;
+static const double S4 = 2.75573137070700676789e-06;
+static const double S5 = -2.50507602534068634195e-08;
+static const double S6 = 1.58969099521155010221e-10;
+static const double C1 = 4.16666666666666019037e-02;
+static const double C2 = -1.38888888888741095749e-03;
+static const double C3 = 2.48015872894767294178e-05;
+static const double C4 = -2.75573143513906633035e-07;
+static const double C5 = 2.08757232129817482790e-09;
+static const double C6 = -1.13596475577881948265e-11;
+
+static inline void _sincosScalar(double x, double& s, double& c)
+{
+	if (!(fabs(x) <= SINCOS_MAX_ARGUMENT)) {
+		s = sin(x);
+		c = cos(x);
+		return;
+	}
 
+	double q = nearbyint(x * TWO_OVER_PI);
+	double r = x - q * PIO2_1;
+	r = r - q * PIO2_2;
+	r = r - q * PIO2_3;
+	double z = r * r;
+	double rs = r + r * z * (S1 + z * (S2 + z * (S3 + z * (S4 + z * (S5 + z * S6)))));
+	double rc = (1.0 - 0.5 * z) + z * z * (C1 + z * (C2 + z * (C3 + z * (C4 + z * (C5 + z * C6)))));
+
+	// quadrant: swap for odd q, sin negative for q = 2, 3 and cos for q = 1, 2 (mod 4)
+	int iq = (int)q;
+	s = (iq & 1) ? rc : rs;
+	c = (iq & 1) ? rs : rc;
+	if (iq & 2) s = -s;
+	if ((iq + 1) & 2) c = -c;
+}
 
-SParProjection* genParProjections(unsigned int iProjAngles,
-	unsigned int iProjDets,
-	double fDetSize,
-	const float* pfAngles,
-	const float* pfExtraOffsets)
+#ifdef GEOMETRY_SIMD
+
+// same operations in the same order as _sincosScalar, no FMA
+GEOMETRY_SIMD_TARGET("avx2")
+static void _sincosAVX2(const float* _pfAngles, unsigned int _iCount, double* _pdSin, double* _pdCos)
 {
-	SParProjection base;
-	base.fRayX = 0.0f;
-	base.fRayY = 1.0f;
+	const __m256d absMask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7fffffffffffffffLL));
+	const __m256d maxArgument = _mm256_set1_pd(SINCOS_MAX_ARGUMENT);
+	const __m128i one = _mm_set1_epi32(1);
+	const __m128i two = _mm_set1_epi32(2);
+
+	unsigned int i = 0;
+	for (; i + 4 <= _iCount; i += 4) {
+		__m256d x = _mm256_cvtps_pd(_mm_loadu_ps(_pfAngles + i));
+		if (_mm256_movemask_pd(_mm256_cmp_pd(_mm256_and_pd(x, absMask), maxArgument, _CMP_LE_OQ)) != 0xF) {
+			for (unsigned int j = i; j < i + 4; ++j)
+				_sincosScalar(_pfAngles[j], _pdSin[j], _pdCos[j]);
+			continue;
+		}
 
-	base.fDetSX = iProjDets * fDetSize * -0.5f;
-	base.fDetSY = 0.0f;
+		__m256d q = _mm256_round_pd(_mm256_mul_pd(x, _mm256_set1_pd(TWO_OVER_PI)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+		__m256d r = _mm256_sub_pd(x, _mm256_mul_pd(q, _mm256_set1_pd(PIO2_1)));
+		r = _mm256_sub_pd(r, _mm256_mul_pd(q, _mm256_set1_pd(PIO2_2)));
+		r = _mm256_sub_pd(r, _mm256_mul_pd(q, _mm256_set1_pd(PIO2_3)));
+		__m256d z = _mm256_mul_pd(r, r);
+
+		__m256d ps = _mm256_add_pd(_mm256_set1_pd(S5), _mm256_mul_pd(z, _mm256_set1_pd(S6)));
+		ps = _mm256_add_pd(_mm256_set1_pd(S4), _mm256_mul_pd(z, ps));
+		ps = _mm256_add_pd(_mm256_set1_pd(S3), _mm256_mul_pd(z, ps));
+		ps = _mm256_add_pd(_mm256_set1_pd(S2), _mm256_mul_pd(z, ps));
+		ps = _mm256_add_pd(_mm256_set1_pd(S1), _mm256_mul_pd(z, ps));
+		__m256d rs = _mm256_add_pd(r, _mm256_mul_pd(_mm256_mul_pd(r, z), ps));
+
+		__m256d pc = _mm256_add_pd(_mm256_set1_pd(C5), _mm256_mul_pd(z, _mm256_set1_pd(C6)));
+		pc = _mm256_add_pd(_mm256_set1_pd(C4), _mm256_mul_pd(z, pc));
+		pc = _mm256_add_pd(_mm256_set1_pd(C3), _mm256_mul_pd(z, pc));
+		pc = _mm256_add_pd(_mm256_set1_pd(C2), _mm256_mul_pd(z, pc));
+		pc = _mm256_add_pd(_mm256_set1_pd(C1), _mm256_mul_pd(z, pc));
+		__m256d rc = _mm256_add_pd(_mm256_sub_pd(_mm256_set1_pd(1.0), _mm256_mul_pd(_mm256_set1_pd(0.5), z)),
+			_mm256_mul_pd(_mm256_mul_pd(z, z), pc));
+
+		__m128i iq = _mm256_cvtpd_epi32(q);
+		__m256d swap = _mm256_castsi256_pd(_mm256_cvtepi32_epi64(_mm_cmpeq_epi32(_mm_and_si128(iq, one), one)));
+		__m256d sinSign = _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_cvtepi32_epi64(_mm_and_si128(iq, two)), 62));
+		__m256d cosSign = _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_cvtepi32_epi64(_mm_and_si128(_mm_add_epi32(iq, one), two)), 62));
+
+		_mm256_storeu_pd(_pdSin + i, _mm256_xor_pd(_mm256_blendv_pd(rs, rc, swap), sinSign));
+		_mm256_storeu_pd(_pdCos + i, _mm256_xor_pd(_mm256_blendv_pd(rc, rs, swap), cosSign));
+	}
 
-	base.fDetUX = fDetSize;
-	base.fDetUY = 0.0f;
+	for (; i < _iCount; ++i)
+		_sincosScalar(_pfAngles[i], _pdSin[i], _pdCos[i]);
+}
 
-	SParProjection* p = new SParProjection[iProjAngles];
+#endif
+
+void sincosBatch(const float* pfAngles, unsigned int iCount, double* pdSin, double* pdCos)
+{
+#ifdef GEOMETRY_SIMD
+	if (GEOMETRY_HAS_AVX2()) {
+		_sincosAVX2(pfAngles, iCount, pdSin, pdCos);
+		return;
+	}
+#endif
+	for (unsigned int i = 0; i < iCount; ++i)
+		_sincosScalar(pfAngles[i], pdSin[i], pdCos[i]);
+}
 
-#define ROTATE0(name,i,alpha) do { p[i].f##name##X = base.f##name##X * cos(alpha) - base.f##name##Y * sin(alpha); p[i].f##name##Y = base.f##name##X * sin(alpha) + base.f##name##Y * cos(alpha); } while(0)
 
-	for (unsigned int i = 0; i < iProjAngles; ++i) {
-		if (pfExtraOffsets) {
-			// TODO
-		}
+//----------------------------------------------------------------------------------------
+// batches
+//----------------------------------------------------------------------------------------
 
-		ROTATE0(Ray, i, pfAngles[i]);
-		ROTATE0(DetS, i, pfAngles[i]);
-		ROTATE0(DetU, i, pfAngles[i]);
+// angles per sincosBatch() call, keeps the temporary sines and cosines in L1
+static const unsigned int SINCOS_BLOCK = 256;
 
-		if (pfExtraOffsets) {
-			float d = pfExtraOffsets[i];
-			p[i].fDetSX -= d * p[i].fDetUX;
-			p[i].fDetSY -= d * p[i].fDetUY;
-		}
+// six arrays in one pooled block, each starting on an ALIGNMENT boundary
+static void* _allocateArrays(unsigned int _iCount, float** _ppfArrays[6])
+{
+	size_t iStride = ((size_t)_iCount * sizeof(float) + CFloat32MemoryPool::ALIGNMENT - 1) & ~(CFloat32MemoryPool::ALIGNMENT - 1);
+	char* pBlock = (char*)CFloat32MemoryPool::getSingleton().allocate(6 * iStride);
+	for (int i = 0; i < 6; ++i)
+		*_ppfArrays[i] = (float*)(pBlock + i * iStride);
+	return pBlock;
+}
+
+SParProjectionBatch::SParProjectionBatch()
+	: pfRayX(NULL), pfRayY(NULL), pfDetSX(NULL), pfDetSY(NULL), pfDetUX(NULL), pfDetUY(NULL),
+	  iCount(0), m_pBlock(NULL), m_iCapacity(0)
+{
+}
+
+SParProjectionBatch::~SParProjectionBatch()
+{
+	if (m_pBlock)
+		CFloat32MemoryPool::getSingleton().release(m_pBlock);
+}
+
+void SParProjectionBatch::resize(unsigned int _iCount)
+{
+	if (_iCount > m_iCapacity) {
+		if (m_pBlock)
+			CFloat32MemoryPool::getSingleton().release(m_pBlock);
+		float** arrays[6] = { &pfRayX, &pfRayY, &pfDetSX, &pfDetSY, &pfDetUX, &pfDetUY };
+		m_pBlock = _allocateArrays(_iCount, arrays);
+		m_iCapacity = _iCount;
 	}
+	iCount = _iCount;
+}
+
+SParProjection SParProjectionBatch::get(unsigned int _i) const
+{
+	SParProjection p;
+	p.fRayX = pfRayX[_i];
+	p.fRayY = pfRayY[_i];
+	p.fDetSX = pfDetSX[_i];
+	p.fDetSY = pfDetSY[_i];
+	p.fDetUX = pfDetUX[_i];
+	p.fDetUY = pfDetUY[_i];
+	return p;
+}
+
+SFanProjectionBatch::SFanProjectionBatch()
+	: pfSrcX(NULL), pfSrcY(NULL), pfDetSX(NULL), pfDetSY(NULL), pfDetUX(NULL), pfDetUY(NULL),
+	  iCount(0), m_pBlock(NULL), m_iCapacity(0)
+{
+}
+
+SFanProjectionBatch::~SFanProjectionBatch()
+{
+	if (m_pBlock)
+		CFloat32MemoryPool::getSingleton().release(m_pBlock);
+}
 
-#undef ROTATE0
+void SFanProjectionBatch::resize(unsigned int _iCount)
+{
+	if (_iCount > m_iCapacity) {
+		if (m_pBlock)
+			CFloat32MemoryPool::getSingleton().release(m_pBlock);
+		float** arrays[6] = { &pfSrcX, &pfSrcY, &pfDetSX, &pfDetSY, &pfDetUX, &pfDetUY };
+		m_pBlock = _allocateArrays(_iCount, arrays);
+		m_iCapacity = _iCount;
+	}
+	iCount = _iCount;
+}
 
+SFanProjection SFanProjectionBatch::get(unsigned int _i) const
+{
+	SFanProjection p;
+	p.fSrcX = pfSrcX[_i];
+	p.fSrcY = pfSrcY[_i];
+	p.fDetSX = pfDetSX[_i];
+	p.fDetSY = pfDetSY[_i];
+	p.fDetUX = pfDetUX[_i];
+	p.fDetUY = pfDetUY[_i];
 	return p;
 }
 
-/*
-#define ROTATE0(name,i,alpha) do { pProjs[i].f##name##X = f##name##X0 * cos(alpha) - f##name##Y0 * sin(alpha); pProjs[i].f##name##Y = f##name##X0 * sin(alpha) + f##name##Y0 * cos(alpha); } while(0)
 
-void rotate(name, i, alpha) {
-	pProjs[i].f##name##X = f##name##X0 * cos(alpha) - f##name##Y0 * sin(alpha);
-	pProjs[i].fSrcY = fSrcX0 * sin(alpha) + fSrcY0 * cos(alpha);
-	pProjs[i].fDetSY = fDetSX0 * sin(alpha) + fDetSY0 * cos(alpha);
+//----------------------------------------------------------------------------------------
+// generators
+//----------------------------------------------------------------------------------------
+
+// rotate (x0, y0) by the angle with the given sine and cosine
+#define ROTATE(x0, y0, s, c, x, y) do { x = (float)((x0) * (c) - (y0) * (s)); y = (float)((x0) * (s) + (y0) * (c)); } while (0)
+
+void genParProjectionsBatch(unsigned int iProjAngles,
+	unsigned int iProjDets,
+	double fDetSize,
+	const float* pfAngles,
+	const float* pfExtraOffsets,
+	SParProjectionBatch& batch)
+{
+	const float fRayX0 = 0.0f;
+	const float fRayY0 = 1.0f;
+	const float fDetSX0 = iProjDets * fDetSize * -0.5f;
+	const float fDetSY0 = 0.0f;
+	const float fDetUX0 = fDetSize;
+	const float fDetUY0 = 0.0f;
+
+	batch.resize(iProjAngles);
+
+	double pdSin[SINCOS_BLOCK];
+	double pdCos[SINCOS_BLOCK];
+	for (unsigned int iStart = 0; iStart < iProjAngles; iStart += SINCOS_BLOCK) {
+		unsigned int iBlock = std::min(SINCOS_BLOCK, iProjAngles - iStart);
+		sincosBatch(pfAngles + iStart, iBlock, pdSin, pdCos);
+
+		for (unsigned int j = 0; j < iBlock; ++j) {
+			unsigned int i = iStart + j;
+			ROTATE(fRayX0, fRayY0, pdSin[j], pdCos[j], batch.pfRayX[i], batch.pfRayY[i]);
+			ROTATE(fDetSX0, fDetSY0, pdSin[j], pdCos[j], batch.pfDetSX[i], batch.pfDetSY[i]);
+			ROTATE(fDetUX0, fDetUY0, pdSin[j], pdCos[j], batch.pfDetUX[i], batch.pfDetUY[i]);
+		}
+
+		if (pfExtraOffsets) {
+			for (unsigned int i = iStart; i < iStart + iBlock; ++i) {
+				float d = pfExtraOffsets[i];
+				batch.pfDetSX[i] -= d * batch.pfDetUX[i];
+				batch.pfDetSY[i] -= d * batch.pfDetUY[i];
+			}
+		}
+	}
+}
+
+void genFanProjectionsBatch(unsigned int iProjAngles,
+	unsigned int iProjDets,
+	double fOriginSource, double fOriginDetector,
+	double fDetSize,
+	const float* pfAngles,
+	SFanProjectionBatch& batch)
+{
+	const float fSrcX0 = 0.0f;
+	const float fSrcY0 = -fOriginSource;
+	const float fDetUX0 = fDetSize;
+	const float fDetUY0 = 0.0f;
+	const float fDetSX0 = iProjDets * fDetUX0 / -2.0f;
+	const float fDetSY0 = fOriginDetector;
+
+	batch.resize(iProjAngles);
+
+	double pdSin[SINCOS_BLOCK];
+	double pdCos[SINCOS_BLOCK];
+	for (unsigned int iStart = 0; iStart < iProjAngles; iStart += SINCOS_BLOCK) {
+		unsigned int iBlock = std::min(SINCOS_BLOCK, iProjAngles - iStart);
+		sincosBatch(pfAngles + iStart, iBlock, pdSin, pdCos);
+
+		for (unsigned int j = 0; j < iBlock; ++j) {
+			unsigned int i = iStart + j;
+			ROTATE(fSrcX0, fSrcY0, pdSin[j], pdCos[j], batch.pfSrcX[i], batch.pfSrcY[i]);
+			ROTATE(fDetSX0, fDetSY0, pdSin[j], pdCos[j], batch.pfDetSX[i], batch.pfDetSY[i]);
+			ROTATE(fDetUX0, fDetUY0, pdSin[j], pdCos[j], batch.pfDetUX[i], batch.pfDetUY[i]);
+		}
+	}
 }
-*/
 
+SParProjection* genParProjections(unsigned int iProjAngles,
+	unsigned int iProjDets,
+	double fDetSize,
+	const float* pfAngles,
+	const float* pfExtraOffsets)
+{
+	SParProjectionBatch batch;
+	genParProjectionsBatch(iProjAngles, iProjDets, fDetSize, pfAngles, pfExtraOffsets, batch);
+
+	SParProjection* p = new SParProjection[iProjAngles];
+	for (unsigned int i = 0; i < iProjAngles; ++i)
+		p[i] = batch.get(i);
+	return p;
+}
 
 SFanProjection* genFanProjections(
 	unsigned int iProjAngles,
@@ -64,31 +326,18 @@ SFanProjection* genFanProjections(
 	double fOriginSource, double fOriginDetector,
 	double fDetSize,
 	const float* pfAngles)
-	//                                  const float *pfExtraOffsets)
 {
-	SFanProjection* pProjs = new SFanProjection[iProjAngles];
-
-	float fSrcX0 = 0.0f;
-	float fSrcY0 = -fOriginSource;
-	float fDetUX0 = fDetSize;
-	float fDetUY0 = 0.0f;
-	float fDetSX0 = iProjDets * fDetUX0 / -2.0f;
-	float fDetSY0 = fOriginDetector;
-
-	std::cout << "source distance: " << fOriginSource << std::endl;
-
-#define ROTATE0(name,i,alpha) do { pProjs[i].f##name##X = f##name##X0 * cos(alpha) - f##name##Y0 * sin(alpha); pProjs[i].f##name##Y = f##name##X0 * sin(alpha) + f##name##Y0 * cos(alpha); } while(0)
-	for (unsigned int i = 0; i < iProjAngles; ++i) {
-		ROTATE0(Src, i, pfAngles[i]);
-		ROTATE0(DetS, i, pfAngles[i]);
-		ROTATE0(DetU, i, pfAngles[i]);
-	}
-
-#undef ROTATE0
+	SFanProjectionBatch batch;
+	genFanProjectionsBatch(iProjAngles, iProjDets, fOriginSource, fOriginDetector, fDetSize, pfAngles, batch);
 
+	SFanProjection* pProjs = new SFanProjection[iProjAngles];
+	for (unsigned int i = 0; i < iProjAngles; ++i)
+		pProjs[i] = batch.get(i);
 	return pProjs;
 }
 
+#undef ROTATE
+
 // Convert a SParProjection back into its set of "standard" circular parallel
 // beam parameters. This is always possible.
 bool getParParameters(const SParProjection& proj, unsigned int iProjDets, float& fAngle, float& fDetSize, float& fOffset)
@@ -56,6 +56,100 @@ struct SFanProjection {
 
 
 
+/**
+	* Structure-of-arrays buffer of parallel beam projection vectors, one array per
+	* component. The arrays are 64-byte aligned and come from the CFloat32MemoryPool, so
+	* regenerating a geometry of the same size does not allocate.
+	*/
+struct SParProjectionBatch {
+	float* pfRayX;
+	float* pfRayY;
+	float* pfDetSX;
+	float* pfDetSY;
+	float* pfDetUX;
+	float* pfDetUY;
+	unsigned int iCount;
+
+	SParProjectionBatch();
+	~SParProjectionBatch();
+
+	/** Set the number of projections. The contents are undefined afterwards.
+		*/
+	void resize(unsigned int _iCount);
+
+	/** Get projection _i as an SParProjection.
+		*/
+	SParProjection get(unsigned int _i) const;
+
+private:
+	void* m_pBlock;
+	unsigned int m_iCapacity;
+
+	SParProjectionBatch(const SParProjectionBatch&);
+	SParProjectionBatch& operator=(const SParProjectionBatch&);
+};
+
+
+/**
+	* Structure-of-arrays buffer of fan beam projection vectors, see SParProjectionBatch.
+	*/
+struct SFanProjectionBatch {
+	float* pfSrcX;
+	float* pfSrcY;
+	float* pfDetSX;
+	float* pfDetSY;
+	float* pfDetUX;
+	float* pfDetUY;
+	unsigned int iCount;
+
+	SFanProjectionBatch();
+	~SFanProjectionBatch();
+
+	/** Set the number of projections. The contents are undefined afterwards.
+		*/
+	void resize(unsigned int _iCount);
+
+	/** Get projection _i as an SFanProjection.
+		*/
+	SFanProjection get(unsigned int _i) const;
+
+private:
+	void* m_pBlock;
+	unsigned int m_iCapacity;
+
+	SFanProjectionBatch(const SFanProjectionBatch&);
+	SFanProjectionBatch& operator=(const SFanProjectionBatch&);
+};
+
+
+/**
+	* Sine and cosine of iCount angles, in double precision (within an ulp or so of the
+	* libm result). Uses AVX2 when the CPU has it. Every lane and the scalar fallback
+	* perform exactly the same operations, so the result does not depend on the CPU.
+	*/
+void sincosBatch(const float* pfAngles, unsigned int iCount, double* pdSin, double* pdCos);
+
+/**
+	* Fill a batch with parallel beam projection vectors, see genParProjections().
+	*/
+void genParProjectionsBatch(unsigned int iProjAngles,
+	unsigned int iProjDets,
+	double fDetSize,
+	const float* pfAngles,
+	const float* pfExtraOffsets,
+	SParProjectionBatch& batch);
+
+/**
+	* Fill a batch with fan beam projection vectors, see genFanProjections().
+	*/
+void genFanProjectionsBatch(unsigned int iProjAngles,
+	unsigned int iProjDets,
+	double fOriginSource, double fOriginDetector,
+	double fDetSize,
+	const float* pfAngles,
+	SFanProjectionBatch& batch);
+
+
 SParProjection* genParProjections(unsigned int iProjAngles,
 	unsigned int iProjDets,
 	double fDetSize,
@@ -120,6 +120,15 @@ struct SDetector3D
 
 #endif
 
+//----------------------------------------------------------------------------------------
+// per-ISA variants of hot functions: with ASTRA_ENABLE_ISA_VARIANTS, gcc builds an
+// x86-64 baseline plus x86-64-v2/v3/v4 clones and the loader picks one (ifunc)
+#if defined(ASTRA_ENABLE_ISA_VARIANTS) && defined(__GNUC__) && !defined(__clang__) && (__GNUC__ >= 11) && defined(__x86_64__) && defined(__ELF__)
+#define ASTRA_ISA_VARIANTS __attribute__((target_clones("default", "arch=x86-64-v2", "arch=x86-64-v3", "arch=x86-64-v4")))
+#else
+#define ASTRA_ISA_VARIANTS
+#endif
+
 //----------------------------------------------------------------------------------------
 // use pthreads on Linux and OSX
 #if defined(__linux__) || defined(__MACH__)
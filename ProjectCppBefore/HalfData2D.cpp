@@ -0,0 +1,201 @@
+#include "HalfData2D.h"
+#include "Float32MemoryPool.h"
+
+#include <cstring>
+#include <utility>
+
+
+//----------------------------------------------------------------------------------------
+// Default constructor.
+template<typename T>
+CHalfData2D<T>::CHalfData2D()
+{
+	_clear();
+}
+
+//----------------------------------------------------------------------------------------
+// Create an instance, allocating (but not initializing) the data block.
+template<typename T>
+CHalfData2D<T>::CHalfData2D(int _iWidth, int _iHeight)
+{
+	_clear();
+	initialize(_iWidth, _iHeight);
+}
+
+//----------------------------------------------------------------------------------------
+// Create an instance converted from float32 data.
+template<typename T>
+CHalfData2D<T>::CHalfData2D(const CFloat32Data2D& _data)
+{
+	_clear();
+	initialize(_data);
+}
+
+//----------------------------------------------------------------------------------------
+// Copy constructor
+template<typename T>
+CHalfData2D<T>::CHalfData2D(const CHalfData2D& _other)
+{
+	_clear();
+	*this = _other;
+}
+
+//----------------------------------------------------------------------------------------
+// Move constructor
+template<typename T>
+CHalfData2D<T>::CHalfData2D(CHalfData2D&& _other)
+{
+	_clear();
+	*this = std::move(_other);
+}
+
+//----------------------------------------------------------------------------------------
+// Destructor
+template<typename T>
+CHalfData2D<T>::~CHalfData2D()
+{
+	if (m_bInitialized)
+		_unInit();
+}
+
+//----------------------------------------------------------------------------------------
+// Assignment operator
+template<typename T>
+CHalfData2D<T>& CHalfData2D<T>::operator=(const CHalfData2D& _other)
+{
+	if (this == &_other)
+		return *this;
+
+	if (!_other.m_bInitialized) {
+		if (m_bInitialized)
+			_unInit();
+		return *this;
+	}
+
+	initialize(_other.m_iWidth, _other.m_iHeight);
+	memcpy(m_pData, _other.m_pData, getMemorySize());
+	return *this;
+}
+
+//----------------------------------------------------------------------------------------
+// Move assignment
+template<typename T>
+CHalfData2D<T>& CHalfData2D<T>::operator=(CHalfData2D&& _other)
+{
+	if (this == &_other)
+		return *this;
+
+	if (m_bInitialized)
+		_unInit();
+
+	m_bInitialized = _other.m_bInitialized;
+	m_iWidth = _other.m_iWidth;
+	m_iHeight = _other.m_iHeight;
+	m_iSize = _other.m_iSize;
+	m_pData = _other.m_pData;
+
+	_other._clear();
+	return *this;
+}
+
+//----------------------------------------------------------------------------------------
+// Clear all member variables
+template<typename T>
+void CHalfData2D<T>::_clear()
+{
+	m_bInitialized = false;
+	m_iWidth = 0;
+	m_iHeight = 0;
+	m_iSize = 0;
+	m_pData = NULL;
+}
+
+//----------------------------------------------------------------------------------------
+// Free the data block
+template<typename T>
+void CHalfData2D<T>::_unInit()
+{
+	ASTRA_ASSERT(m_bInitialized);
+	CFloat32MemoryPool::getSingleton().release(m_pData);
+	_clear();
+}
+
+//----------------------------------------------------------------------------------------
+// Initialization
+template<typename T>
+bool CHalfData2D<T>::initialize(int _iWidth, int _iHeight)
+{
+	ASTRA_ASSERT(_iWidth > 0);
+	ASTRA_ASSERT(_iHeight > 0);
+
+	if (m_bInitialized) {
+		if (m_iWidth == _iWidth && m_iHeight == _iHeight)
+			return true;
+		_unInit();
+	}
+
+	m_iWidth = _iWidth;
+	m_iHeight = _iHeight;
+	m_iSize = (size_t)m_iWidth * m_iHeight;
+	m_pData = (T*)CFloat32MemoryPool::getSingleton().allocate(getMemorySize());
+	ASTRA_ASSERT(m_pData != NULL);
+
+	m_bInitialized = true;
+	return true;
+}
+
+//----------------------------------------------------------------------------------------
+// Initialization with conversion
+template<typename T>
+bool CHalfData2D<T>::initialize(const CFloat32Data2D& _data)
+{
+	ASTRA_ASSERT(_data.isInitialized());
+
+	if (!initialize(_data.getWidth(), _data.getHeight()))
+		return false;
+
+	if (_data.isContiguous()) {
+		convertToHalf(_data.getDataConst(), m_pData, m_iSize);
+	}
+	else {
+		const float** ppfRows = _data.getData2DConst();
+		for (int iy = 0; iy < m_iHeight; ++iy)
+			convertToHalf(ppfRows[iy], m_pData + (size_t)iy * m_iWidth, m_iWidth);
+	}
+	return true;
+}
+
+//----------------------------------------------------------------------------------------
+// Convert to float32
+template<typename T>
+void CHalfData2D<T>::copyTo(CFloat32Data2D& _data) const
+{
+	ASTRA_ASSERT(m_bInitialized);
+	ASTRA_ASSERT(_data.getWidth() == m_iWidth && _data.getHeight() == m_iHeight);
+
+	if (_data.isContiguous()) {
+		convertToFloat(m_pData, _data.getData(), m_iSize);
+	}
+	else {
+		float** ppfRows = _data.getData2D();
+		for (int iy = 0; iy < m_iHeight; ++iy)
+			convertToFloat(m_pData + (size_t)iy * m_iWidth, ppfRows[iy], m_iWidth);
+	}
+}
+
+//----------------------------------------------------------------------------------------
+// Set all data to zero. Both formats encode +0 as all bits zero.
+template<typename T>
+void CHalfData2D<T>::clearData()
+{
+	ASTRA_ASSERT(m_bInitialized);
+	memset(m_pData, 0, getMemorySize());
+}
+
+
+//----------------------------------------------------------------------------------------
+// Explicit instantiations
+//----------------------------------------------------------------------------------------
+
+template class CHalfData2D<SFloat16>;
+template class CHalfData2D<SBFloat16>;
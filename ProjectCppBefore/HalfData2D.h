@@ -0,0 +1,188 @@
+#ifndef _INC_ASTRA_HALFDATA2D
+#define _INC_ASTRA_HALFDATA2D
+
+#include "Globals.h"
+#include "HalfFloat.h"
+#include "Float32Data2D.h"
+
+
+/**
+	* This class represents a 2-dimensional block of 16-bit floating point data,
+	* stored as binary16 (CFloat16Data2D) or bfloat16 (CBFloat16Data2D).
+	*
+	* It is a storage format only: values are converted to float32 when they are
+	* read by a projection policy, and all arithmetic happens in float32. Use it for
+	* volumes and sinograms of large batch workloads, where it halves resident size
+	* and memory traffic compared to CFloat32Data2D. The layout is row-major with
+	* the same shape conventions as CFloat32Data2D (x = width, y = height).
+	*
+	* The data block is "owned" by the class and taken from CFloat32MemoryPool.
+	*/
+template<typename T>
+class CHalfData2D {
+
+protected:
+
+	bool m_bInitialized;	///< has the object been initialized?
+	int m_iWidth;			///< width of the data (x)
+	int m_iHeight;			///< height of the data (y)
+	int m_iSize;			///< total size of the data
+
+	/** Pointer to the data block. To access element (ix, iy), use m_pData[iy * m_iWidth + ix]
+		*/
+	T* m_pData;
+
+	/** Clear all member variables, setting all numeric variables to 0 and all pointers to NULL.
+		*/
+	void _clear();
+
+	/** Free the data block and bring the object back in the uninitialized state.
+		*/
+	void _unInit();
+
+public:
+
+	typedef T ValueType;
+
+	/** Default constructor. The object must be initialized before it can be used.
+		*/
+	CHalfData2D();
+
+	/** Constructor. Allocates (but does not initialize) a block of _iWidth x _iHeight values.
+		*/
+	CHalfData2D(int _iWidth, int _iHeight);
+
+	/** Constructor. Allocates a block with the shape of _data and converts its contents.
+		*/
+	explicit CHalfData2D(const CFloat32Data2D& _data);
+
+	/** Copy constructor.
+		*/
+	CHalfData2D(const CHalfData2D& _other);
+
+	/** Move constructor. Takes over the data block of _other, which is left uninitialized.
+		*/
+	CHalfData2D(CHalfData2D&& _other);
+
+	/** Destructor.
+		*/
+	~CHalfData2D();
+
+	/** Assignment operator.
+		*/
+	CHalfData2D& operator=(const CHalfData2D& _other);
+
+	/** Move assignment. Takes over the data block of _other, which is left uninitialized.
+		*/
+	CHalfData2D& operator=(CHalfData2D&& _other);
+
+	/** Initialization. Allocates (but does not initialize) a block of _iWidth x _iHeight values.
+		* The current block is kept if it already has this shape.
+		*
+		* @param _iWidth width of the 2D data (x-axis), must be > 0
+		* @param _iHeight height of the 2D data (y-axis), must be > 0
+		* @return initialization successful
+		*/
+	bool initialize(int _iWidth, int _iHeight);
+
+	/** Initialization. Takes the shape of _data and converts its contents, rounding to nearest even.
+		*
+		* @param _data initialized float32 data
+		* @return initialization successful
+		*/
+	bool initialize(const CFloat32Data2D& _data);
+
+	/** Convert the data block to float32. _data must have the same shape.
+		*
+		* @param _data destination
+		*/
+	void copyTo(CFloat32Data2D& _data) const;
+
+	/** Set all data to zero.
+		*/
+	void clearData();
+
+	/** Get a pointer to the data block. The data memory is still "owned" by this object.
+		*/
+	T* getData();
+
+	/** Get a const pointer to the data block.
+		*/
+	const T* getDataConst() const;
+
+	/** Get the initialization state of the object.
+		*/
+	bool isInitialized() const;
+
+	/** Get the width of the data block.
+		*/
+	int getWidth() const;
+
+	/** Get the height of the data block.
+		*/
+	int getHeight() const;
+
+	/** Get the total size (width*height) of the data block.
+		*/
+	int getSize() const;
+
+	/** Get the size of the data block in bytes.
+		*/
+	size_t getMemorySize() const;
+};
+
+typedef CHalfData2D<SFloat16> CFloat16Data2D;
+typedef CHalfData2D<SBFloat16> CBFloat16Data2D;
+
+
+//----------------------------------------------------------------------------------------
+// Inline member functions
+//----------------------------------------------------------------------------------------
+
+template<typename T>
+inline T* CHalfData2D<T>::getData()
+{
+	return m_pData;
+}
+
+template<typename T>
+inline const T* CHalfData2D<T>::getDataConst() const
+{
+	ASTRA_ASSERT(m_bInitialized);
+	return m_pData;
+}
+
+template<typename T>
+inline bool CHalfData2D<T>::isInitialized() const
+{
+	return m_bInitialized;
+}
+
+template<typename T>
+inline int CHalfData2D<T>::getWidth() const
+{
+	ASTRA_ASSERT(m_bInitialized);
+	return m_iWidth;
+}
+
+template<typename T>
+inline int CHalfData2D<T>::getHeight() const
+{
+	ASTRA_ASSERT(m_bInitialized);
+	return m_iHeight;
+}
+
+template<typename T>
+inline int CHalfData2D<T>::getSize() const
+{
+	ASTRA_ASSERT(m_bInitialized);
+	return m_iSize;
+}
+
+template<typename T>
+inline size_t CHalfData2D<T>::getMemorySize() const
+{
+	return (size_t)m_iSize * sizeof(T);
+}
+
+#endif // _INC_ASTRA_HALFDATA2D
@@ -0,0 +1,212 @@
+#include "HalfFloat.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define HALF_SIMD_TARGET(x) __attribute__((target(x)))
+#define HALF_HAS_AVX512F() __builtin_cpu_supports("avx512f")
+#define HALF_HAS_AVX2() (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("f16c"))
+#define HALF_SIMD
+#elif defined(_MSC_VER) && defined(__AVX2__)
+#include <immintrin.h>
+#define HALF_SIMD_TARGET(x)
+#ifdef __AVX512F__
+#define HALF_HAS_AVX512F() true
+#else
+#define HALF_HAS_AVX512F() false
+#endif
+#define HALF_HAS_AVX2() true
+#define HALF_SIMD
+#endif
+
+
+//----------------------------------------------------------------------------------------
+// Scalar loops
+//----------------------------------------------------------------------------------------
+
+template<typename T>
+static void _toHalfScalar(const float* _pfSrc, T* _pDst, size_t _iCount)
+{
+	for (size_t i = 0; i < _iCount; ++i)
+		_pDst[i] = fromFloat<T>(_pfSrc[i]);
+}
+
+template<typename T>
+static void _toFloatScalar(const T* _pSrc, float* _pfDst, size_t _iCount)
+{
+	for (size_t i = 0; i < _iCount; ++i)
+		_pfDst[i] = toFloat(_pSrc[i]);
+}
+
+
+#ifdef HALF_SIMD
+
+//----------------------------------------------------------------------------------------
+// binary16, AVX-512F
+//----------------------------------------------------------------------------------------
+
+HALF_SIMD_TARGET("avx512f")
+static void _toFloat16AVX512(const float* _pfSrc, SFloat16* _pDst, size_t _iCount)
+{
+	size_t i = 0;
+	for (; i + 16 <= _iCount; i += 16) {
+		__m256i h = _mm512_cvtps_ph(_mm512_loadu_ps(_pfSrc + i), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+		_mm256_storeu_si256((__m256i*)(_pDst + i), h);
+	}
+	_toHalfScalar(_pfSrc + i, _pDst + i, _iCount - i);
+}
+
+HALF_SIMD_TARGET("avx512f")
+static void _fromFloat16AVX512(const SFloat16* _pSrc, float* _pfDst, size_t _iCount)
+{
+	size_t i = 0;
+	for (; i + 16 <= _iCount; i += 16) {
+		_mm512_storeu_ps(_pfDst + i, _mm512_cvtph_ps(_mm256_loadu_si256((const __m256i*)(_pSrc + i))));
+	}
+	_toFloatScalar(_pSrc + i, _pfDst + i, _iCount - i);
+}
+
+//----------------------------------------------------------------------------------------
+// binary16, F16C
+//----------------------------------------------------------------------------------------
+
+HALF_SIMD_TARGET("avx,f16c")
+static void _toFloat16F16C(const float* _pfSrc, SFloat16* _pDst, size_t _iCount)
+{
+	size_t i = 0;
+	for (; i + 8 <= _iCount; i += 8) {
+		__m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(_pfSrc + i), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+		_mm_storeu_si128((__m128i*)(_pDst + i), h);
+	}
+	_toHalfScalar(_pfSrc + i, _pDst + i, _iCount - i);
+}
+
+HALF_SIMD_TARGET("avx,f16c")
+static void _fromFloat16F16C(const SFloat16* _pSrc, float* _pfDst, size_t _iCount)
+{
+	size_t i = 0;
+	for (; i + 8 <= _iCount; i += 8) {
+		_mm256_storeu_ps(_pfDst + i, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(_pSrc + i))));
+	}
+	_toFloatScalar(_pSrc + i, _pfDst + i, _iCount - i);
+}
+
+//----------------------------------------------------------------------------------------
+// bfloat16, AVX-512F. Same rounding as toBFloat16().
+//----------------------------------------------------------------------------------------
+
+HALF_SIMD_TARGET("avx512f")
+static void _toBFloat16AVX512(const float* _pfSrc, SBFloat16* _pDst, size_t _iCount)
+{
+	const __m512i one = _mm512_set1_epi32(1);
+	const __m512i bias = _mm512_set1_epi32(0x7FFF);
+	const __m512i absMask = _mm512_set1_epi32(0x7FFFFFFF);
+	const __m512i inf = _mm512_set1_epi32(0x7F800000);
+	const __m512i quiet = _mm512_set1_epi32(0x00400000);
+
+	size_t i = 0;
+	for (; i + 16 <= _iCount; i += 16) {
+		__m512i x = _mm512_castps_si512(_mm512_loadu_ps(_pfSrc + i));
+		__m512i lsb = _mm512_and_si512(_mm512_srli_epi32(x, 16), one);
+		__m512i r = _mm512_add_epi32(x, _mm512_add_epi32(bias, lsb));
+		__mmask16 nan = _mm512_cmpgt_epi32_mask(_mm512_and_si512(x, absMask), inf);
+		r = _mm512_mask_blend_epi32(nan, r, _mm512_or_si512(x, quiet));
+		_mm256_storeu_si256((__m256i*)(_pDst + i), _mm512_cvtepi32_epi16(_mm512_srli_epi32(r, 16)));
+	}
+	_toHalfScalar(_pfSrc + i, _pDst + i, _iCount - i);
+}
+
+HALF_SIMD_TARGET("avx512f")
+static void _fromBFloat16AVX512(const SBFloat16* _pSrc, float* _pfDst, size_t _iCount)
+{
+	size_t i = 0;
+	for (; i + 16 <= _iCount; i += 16) {
+		__m512i x = _mm512_cvtepu16_epi32(_mm256_loadu_si256((const __m256i*)(_pSrc + i)));
+		_mm512_storeu_ps(_pfDst + i, _mm512_castsi512_ps(_mm512_slli_epi32(x, 16)));
+	}
+	_toFloatScalar(_pSrc + i, _pfDst + i, _iCount - i);
+}
+
+//----------------------------------------------------------------------------------------
+// bfloat16, AVX2
+//----------------------------------------------------------------------------------------
+
+HALF_SIMD_TARGET("avx2")
+static void _toBFloat16AVX2(const float* _pfSrc, SBFloat16* _pDst, size_t _iCount)
+{
+	const __m256i one = _mm256_set1_epi32(1);
+	const __m256i bias = _mm256_set1_epi32(0x7FFF);
+	const __m256i absMask = _mm256_set1_epi32(0x7FFFFFFF);
+	const __m256i inf = _mm256_set1_epi32(0x7F800000);
+	const __m256i quiet = _mm256_set1_epi32(0x00400000);
+
+	size_t i = 0;
+	for (; i + 8 <= _iCount; i += 8) {
+		__m256i x = _mm256_castps_si256(_mm256_loadu_ps(_pfSrc + i));
+		__m256i lsb = _mm256_and_si256(_mm256_srli_epi32(x, 16), one);
+		__m256i r = _mm256_add_epi32(x, _mm256_add_epi32(bias, lsb));
+		__m256i nan = _mm256_cmpgt_epi32(_mm256_and_si256(x, absMask), inf);
+		r = _mm256_blendv_epi8(r, _mm256_or_si256(x, quiet), nan);
+		r = _mm256_srli_epi32(r, 16);
+		// pack within the 128-bit lanes, then gather the two low halves
+		__m256i p = _mm256_permute4x64_epi64(_mm256_packus_epi32(r, r), 0x08);
+		_mm_storeu_si128((__m128i*)(_pDst + i), _mm256_castsi256_si128(p));
+	}
+	_toHalfScalar(_pfSrc + i, _pDst + i, _iCount - i);
+}
+
+HALF_SIMD_TARGET("avx2")
+static void _fromBFloat16AVX2(const SBFloat16* _pSrc, float* _pfDst, size_t _iCount)
+{
+	size_t i = 0;
+	for (; i + 8 <= _iCount; i += 8) {
+		__m256i x = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(_pSrc + i)));
+		_mm256_storeu_ps(_pfDst + i, _mm256_castsi256_ps(_mm256_slli_epi32(x, 16)));
+	}
+	_toFloatScalar(_pSrc + i, _pfDst + i, _iCount - i);
+}
+
+#endif // HALF_SIMD
+
+
+//----------------------------------------------------------------------------------------
+// Dispatch
+//----------------------------------------------------------------------------------------
+
+void convertToHalf(const float* _pfSrc, SFloat16* _pDst, size_t _iCount)
+{
+#ifdef HALF_SIMD
+	if (HALF_HAS_AVX512F()) { _toFloat16AVX512(_pfSrc, _pDst, _iCount); return; }
+	if (HALF_HAS_AVX2()) { _toFloat16F16C(_pfSrc, _pDst, _iCount); return; }
+#endif
+	_toHalfScalar(_pfSrc, _pDst, _iCount);
+}
+
+//----------------------------------------------------------------------------------------
+void convertToHalf(const float* _pfSrc, SBFloat16* _pDst, size_t _iCount)
+{
+#ifdef HALF_SIMD
+	if (HALF_HAS_AVX512F()) { _toBFloat16AVX512(_pfSrc, _pDst, _iCount); return; }
+	if (HALF_HAS_AVX2()) { _toBFloat16AVX2(_pfSrc, _pDst, _iCount); return; }
+#endif
+	_toHalfScalar(_pfSrc, _pDst, _iCount);
+}
+
+//----------------------------------------------------------------------------------------
+void convertToFloat(const SFloat16* _pSrc, float* _pfDst, size_t _iCount)
+{
+#ifdef HALF_SIMD
+	if (HALF_HAS_AVX512F()) { _fromFloat16AVX512(_pSrc, _pfDst, _iCount); return; }
+	if (HALF_HAS_AVX2()) { _fromFloat16F16C(_pSrc, _pfDst, _iCount); return; }
+#endif
+	_toFloatScalar(_pSrc, _pfDst, _iCount);
+}
+
+//----------------------------------------------------------------------------------------
+void convertToFloat(const SBFloat16* _pSrc, float* _pfDst, size_t _iCount)
+{
+#ifdef HALF_SIMD
+	if (HALF_HAS_AVX512F()) { _fromBFloat16AVX512(_pSrc, _pfDst, _iCount); return; }
+	if (HALF_HAS_AVX2()) { _fromBFloat16AVX2(_pSrc, _pfDst, _iCount); return; }
+#endif
+	_toFloatScalar(_pSrc, _pfDst, _iCount);
+}
@@ -0,0 +1,161 @@
+#ifndef _INC_ASTRA_HALFFLOAT
+#define _INC_ASTRA_HALFFLOAT
+
+#include "Globals.h"
+
+#include <cstddef>
+#include <cstring>
+#include <stdint.h>
+
+#ifdef __F16C__
+#include <immintrin.h>
+#endif
+
+
+/**
+	* IEEE 754 binary16 value: 1 sign bit, 5 exponent bits, 10 mantissa bits.
+	* Range up to 65504, about 3 significant decimal digits.
+	*/
+struct SFloat16
+{
+	uint16_t m_iBits;
+};
+
+/**
+	* bfloat16 value: the upper 16 bits of a float32. Same range as float32,
+	* about 2 significant decimal digits.
+	*/
+struct SBFloat16
+{
+	uint16_t m_iBits;
+};
+
+
+//----------------------------------------------------------------------------------------
+// Scalar conversions. Rounding is to nearest even, NaN stays NaN.
+//----------------------------------------------------------------------------------------
+
+FORCEINLINE uint32_t _floatBits(float _f)
+{
+	uint32_t i;
+	memcpy(&i, &_f, sizeof(i));
+	return i;
+}
+
+FORCEINLINE float _bitsFloat(uint32_t _i)
+{
+	float f;
+	memcpy(&f, &_i, sizeof(f));
+	return f;
+}
+
+/** Convert a float to binary16.
+	*/
+FORCEINLINE SFloat16 toFloat16(float _f)
+{
+#ifdef __F16C__
+	SFloat16 r;
+	r.m_iBits = (uint16_t)_cvtss_sh(_f, _MM_FROUND_TO_NEAREST_INT);
+	return r;
+#else
+	uint32_t x = _floatBits(_f);
+	uint32_t iSign = (x >> 16) & 0x8000;
+	x &= 0x7FFFFFFF;
+
+	SFloat16 h;
+	if (x >= 0x47800000) {
+		// overflow, infinity or NaN
+		h.m_iBits = (uint16_t)(iSign | ((x > 0x7F800000) ? 0x7E00 : 0x7C00));
+	}
+	else if (x < 0x38800000) {
+		// subnormal or zero, let the FPU do the rounding
+		float f = _bitsFloat(x) + 0.5f;
+		h.m_iBits = (uint16_t)(iSign | (_floatBits(f) - 0x3F000000));
+	}
+	else {
+		uint32_t iMantissaOdd = (x >> 13) & 1;
+		x += ((uint32_t)(15 - 127) << 23) + 0xFFF + iMantissaOdd;
+		h.m_iBits = (uint16_t)(iSign | (x >> 13));
+	}
+	return h;
+#endif
+}
+
+/** Convert a binary16 to float. Exact.
+	*/
+FORCEINLINE float toFloat(SFloat16 _h)
+{
+#ifdef __F16C__
+	return _cvtsh_ss(_h.m_iBits);
+#else
+	const uint32_t iShiftedExp = 0x7C00 << 13;
+	uint32_t x = (uint32_t)(_h.m_iBits & 0x7FFF) << 13;
+	uint32_t iExp = x & iShiftedExp;
+	x += (uint32_t)(127 - 15) << 23;
+
+	if (iExp == iShiftedExp) {
+		// infinity or NaN
+		x += (uint32_t)(128 - 16) << 23;
+	}
+	else if (iExp == 0) {
+		// zero or subnormal, renormalize
+		x += 1 << 23;
+		x = _floatBits(_bitsFloat(x) - _bitsFloat(113 << 23));
+	}
+
+	return _bitsFloat(x | ((uint32_t)(_h.m_iBits & 0x8000) << 16));
+#endif
+}
+
+/** Convert a float to bfloat16.
+	*/
+FORCEINLINE SBFloat16 toBFloat16(float _f)
+{
+	uint32_t x = _floatBits(_f);
+	SBFloat16 h;
+	if ((x & 0x7FFFFFFF) > 0x7F800000) {
+		h.m_iBits = (uint16_t)((x >> 16) | 0x0040);
+	}
+	else {
+		x += 0x7FFF + ((x >> 16) & 1);
+		h.m_iBits = (uint16_t)(x >> 16);
+	}
+	return h;
+}
+
+/** Convert a bfloat16 to float. Exact.
+	*/
+FORCEINLINE float toFloat(SBFloat16 _h)
+{
+	return _bitsFloat((uint32_t)_h.m_iBits << 16);
+}
+
+/** Convert a float to the storage type T (SFloat16 or SBFloat16).
+	*/
+template<typename T> T fromFloat(float _f);
+template<> FORCEINLINE SFloat16 fromFloat<SFloat16>(float _f) { return toFloat16(_f); }
+template<> FORCEINLINE SBFloat16 fromFloat<SBFloat16>(float _f) { return toBFloat16(_f); }
+
+
+//----------------------------------------------------------------------------------------
+// Bulk conversions. These pick the widest instruction set available at run time
+// (AVX-512F, F16C/AVX2) and fall back to the scalar conversions above.
+//----------------------------------------------------------------------------------------
+
+/** Convert _iCount floats to binary16.
+	*/
+void convertToHalf(const float* _pfSrc, SFloat16* _pDst, size_t _iCount);
+
+/** Convert _iCount floats to bfloat16.
+	*/
+void convertToHalf(const float* _pfSrc, SBFloat16* _pDst, size_t _iCount);
+
+/** Convert _iCount binary16 values to float.
+	*/
+void convertToFloat(const SFloat16* _pSrc, float* _pfDst, size_t _iCount);
+
+/** Convert _iCount bfloat16 values to float.
+	*/
+void convertToFloat(const SBFloat16* _pSrc, float* _pfDst, size_t _iCount);
+
+#endif // _INC_ASTRA_HALFFLOAT
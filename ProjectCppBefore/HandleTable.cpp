@@ -0,0 +1,175 @@
+#include "HandleTable.h"
+
+
+//----------------------------------------------------------------------------------------
+// Constructor
+CHandleTable::CHandleTable()
+{
+	for (int i = 0; i < SEGMENT_COUNT; ++i)
+		m_pSegments[i].store(NULL, std::memory_order_relaxed);
+	m_iSlotCount.store(0, std::memory_order_relaxed);
+	m_iFreeHead.store(NO_SLOT, std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------
+// Destructor
+CHandleTable::~CHandleTable()
+{
+	for (int i = 0; i < SEGMENT_COUNT; ++i)
+		delete[] m_pSegments[i].load(std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------
+// Get a slot, allocating its segment
+CHandleTable::SSlot* CHandleTable::_allocateSlot(uint32_t _iSlot)
+{
+	std::atomic<SSlot*>& segment = m_pSegments[_iSlot >> SEGMENT_BITS];
+	SSlot* pSegment = segment.load(std::memory_order_acquire);
+	if (!pSegment) {
+		SSlot* pNew = new SSlot[SEGMENT_SIZE];
+		for (int i = 0; i < SEGMENT_SIZE; ++i) {
+			pNew[i].m_iState.store(0, std::memory_order_relaxed);
+			pNew[i].m_iNextFree.store(NO_SLOT, std::memory_order_relaxed);
+			pNew[i].m_pOwner.store(NULL, std::memory_order_relaxed);
+			pNew[i].m_pObject.store(NULL, std::memory_order_relaxed);
+		}
+		// several threads may race to allocate the same segment, only one wins
+		if (segment.compare_exchange_strong(pSegment, pNew, std::memory_order_acq_rel, std::memory_order_acquire)) {
+			pSegment = pNew;
+		}
+		else {
+			delete[] pNew;
+		}
+	}
+	return &pSegment[_iSlot & (SEGMENT_SIZE - 1)];
+}
+
+//----------------------------------------------------------------------------------------
+// Pop from the free list
+uint32_t CHandleTable::_popFree()
+{
+	uint64_t iHead = m_iFreeHead.load(std::memory_order_acquire);
+	while ((uint32_t)iHead != NO_SLOT) {
+		uint32_t iSlot = (uint32_t)iHead;
+		uint32_t iNext = _usedSlot(iSlot)->m_iNextFree.load(std::memory_order_relaxed);
+		uint64_t iNewHead = (((iHead >> 32) + 1) << 32) | iNext;
+		if (m_iFreeHead.compare_exchange_weak(iHead, iNewHead, std::memory_order_acq_rel, std::memory_order_acquire))
+			return iSlot;
+	}
+	return NO_SLOT;
+}
+
+//----------------------------------------------------------------------------------------
+// Push onto the free list
+void CHandleTable::_pushFree(uint32_t _iSlot)
+{
+	SSlot* pSlot = _usedSlot(_iSlot);
+	uint64_t iHead = m_iFreeHead.load(std::memory_order_relaxed);
+	uint64_t iNewHead;
+	do {
+		pSlot->m_iNextFree.store((uint32_t)iHead, std::memory_order_relaxed);
+		iNewHead = (((iHead >> 32) + 1) << 32) | _iSlot;
+	} while (!m_iFreeHead.compare_exchange_weak(iHead, iNewHead, std::memory_order_release, std::memory_order_relaxed));
+}
+
+//----------------------------------------------------------------------------------------
+// Store
+int CHandleTable::store(const void* _pOwner, void* _pObject)
+{
+	ASTRA_ASSERT(_pObject);
+
+	uint32_t iSlot = _popFree();
+	SSlot* pSlot;
+	if (iSlot != NO_SLOT) {
+		pSlot = _usedSlot(iSlot);
+	}
+	else {
+		iSlot = m_iSlotCount.fetch_add(1, std::memory_order_relaxed);
+		if (iSlot >= (uint32_t)MAX_SLOTS) {
+			m_iSlotCount.fetch_sub(1, std::memory_order_relaxed);
+			return 0;
+		}
+		pSlot = _allocateSlot(iSlot);
+	}
+
+	// the slot is ours until the occupied bit is published
+	uint32_t iGeneration = (pSlot->m_iState.load(std::memory_order_relaxed) >> 1) + 1;
+	ASTRA_ASSERT(iGeneration <= MAX_GENERATION);
+	pSlot->m_pOwner.store(_pOwner, std::memory_order_relaxed);
+	pSlot->m_pObject.store(_pObject, std::memory_order_relaxed);
+	pSlot->m_iState.store((iGeneration << 1) | 1, std::memory_order_release);
+
+	return (int)((iGeneration << SLOT_BITS) | iSlot);
+}
+
+//----------------------------------------------------------------------------------------
+// Get owner
+const void* CHandleTable::getOwner(int _iHandle) const
+{
+	if (_iHandle <= 0)
+		return NULL;
+	uint32_t iSlot = (uint32_t)_iHandle & (MAX_SLOTS - 1);
+	uint32_t iState = (((uint32_t)_iHandle >> SLOT_BITS) << 1) | 1;
+	const SSlot* pSlot = _slot(iSlot);
+	if (!pSlot || pSlot->m_iState.load(std::memory_order_acquire) != iState)
+		return NULL;
+	const void* pOwner = pSlot->m_pOwner.load(std::memory_order_acquire);
+	if (pSlot->m_iState.load(std::memory_order_acquire) != iState)
+		return NULL;
+	return pOwner;
+}
+
+//----------------------------------------------------------------------------------------
+// Remove
+void* CHandleTable::remove(int _iHandle, const void* _pOwner)
+{
+	if (_iHandle <= 0)
+		return NULL;
+	uint32_t iSlot = (uint32_t)_iHandle & (MAX_SLOTS - 1);
+	uint32_t iGeneration = (uint32_t)_iHandle >> SLOT_BITS;
+	SSlot* pSlot = _slot(iSlot);
+	if (!pSlot)
+		return NULL;
+
+	// the owner is stable while the state matches, check it before claiming the slot
+	uint32_t iState = (iGeneration << 1) | 1;
+	if (pSlot->m_iState.load(std::memory_order_acquire) != iState)
+		return NULL;
+	if (pSlot->m_pOwner.load(std::memory_order_relaxed) != _pOwner)
+		return NULL;
+	void* pObject = pSlot->m_pObject.load(std::memory_order_relaxed);
+	if (!pSlot->m_iState.compare_exchange_strong(iState, iGeneration << 1, std::memory_order_acq_rel, std::memory_order_relaxed))
+		return NULL;
+
+	// a slot whose generations are used up is retired, so handles are never reused
+	if (iGeneration < MAX_GENERATION)
+		_pushFree(iSlot);
+
+	return pObject;
+}
+
+//----------------------------------------------------------------------------------------
+// Slot count
+int CHandleTable::getSlotCount() const
+{
+	return (int)m_iSlotCount.load(std::memory_order_acquire);
+}
+
+//----------------------------------------------------------------------------------------
+// Get slot
+bool CHandleTable::getSlot(int _iSlot, int& _iHandle, const void*& _pOwner, void*& _pObject) const
+{
+	ASTRA_ASSERT(_iSlot >= 0 && _iSlot < MAX_SLOTS);
+	const SSlot* pSlot = _slot((uint32_t)_iSlot);
+	if (!pSlot)
+		return false;
+	uint32_t iState = pSlot->m_iState.load(std::memory_order_acquire);
+	if (!(iState & 1))
+		return false;
+	_pOwner = pSlot->m_pOwner.load(std::memory_order_acquire);
+	_pObject = pSlot->m_pObject.load(std::memory_order_acquire);
+	if (pSlot->m_iState.load(std::memory_order_acquire) != iState)
+		return false;
+	_iHandle = (int)(((iState >> 1) << SLOT_BITS) | (uint32_t)_iSlot);
+	return true;
+}
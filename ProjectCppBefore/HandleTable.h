@@ -0,0 +1,177 @@
+#ifndef _INC_ASTRA_HANDLETABLE
+#define _INC_ASTRA_HANDLETABLE
+
+#include "Globals.h"
+
+#include <atomic>
+#include <stdint.h>
+
+
+/**
+	* Concurrent table that maps int handles to (owner, object) pointer pairs.
+	*
+	* Handles encode a slot index and the generation of that slot:
+	*   handle = (generation << SLOT_BITS) | slot
+	* A slot's generation is bumped every time it is reused, so a stale handle never resolves
+	* to the object that took over its slot. A slot is retired once its generation is used up,
+	* which means a handle is never handed out twice.
+	*
+	* get() is wait-free and does not write to shared memory. store() and remove() are lock-free:
+	* free slots are kept on a tagged Treiber stack, and new slots are taken from a counter.
+	* Slots live in segments that are allocated on first use and never move, so a slot can be
+	* read without synchronizing with growth of the table.
+	*
+	* The table does not own the objects. A pointer returned by get() is only valid as long as
+	* no other thread removes and deletes the object.
+	*/
+class CHandleTable {
+
+public:
+
+	/** Number of bits of a handle that select the slot.
+		*/
+	static const int SLOT_BITS = 20;
+
+	/** Maximum number of live entries.
+		*/
+	static const int MAX_SLOTS = 1 << SLOT_BITS;
+
+	/** Default constructor. The table starts empty and allocates nothing.
+		*/
+	CHandleTable();
+
+	/** Destructor. Does not touch the stored objects.
+		*/
+	~CHandleTable();
+
+	/** Store an object.
+		*
+		* @param _pOwner owner of the object, returned by getOwner()
+		* @param _pObject the object, must not be NULL
+		* @return handle, always >= 1. 0 if the table is full.
+		*/
+	int store(const void* _pOwner, void* _pObject);
+
+	/** Get an object.
+		*
+		* @param _iHandle handle returned by store()
+		* @param _pOwner expected owner
+		* @return the object, NULL if the handle is not live or has a different owner
+		*/
+	void* get(int _iHandle, const void* _pOwner) const;
+
+	/** Get the owner of an object.
+		*
+		* @param _iHandle handle returned by store()
+		* @return the owner, NULL if the handle is not live
+		*/
+	const void* getOwner(int _iHandle) const;
+
+	/** Remove an object. Only one of several concurrent removes of the same handle succeeds.
+		*
+		* @param _iHandle handle returned by store()
+		* @param _pOwner expected owner
+		* @return the object that was removed, NULL if the handle was not live or has a different owner
+		*/
+	void* remove(int _iHandle, const void* _pOwner);
+
+	/** Get the number of slots that have ever been used. Together with getSlot() this allows
+		* iterating over all entries.
+		*/
+	int getSlotCount() const;
+
+	/** Get the entry in a slot.
+		*
+		* @param _iSlot slot index, 0 <= _iSlot < getSlotCount()
+		* @param _iHandle output: handle of the entry
+		* @param _pOwner output: owner of the entry
+		* @param _pObject output: the object
+		* @return true if the slot holds a live entry
+		*/
+	bool getSlot(int _iSlot, int& _iHandle, const void*& _pOwner, void*& _pObject) const;
+
+protected:
+
+	static const int SEGMENT_BITS = 10;
+	static const int SEGMENT_SIZE = 1 << SEGMENT_BITS;
+	static const int SEGMENT_COUNT = MAX_SLOTS / SEGMENT_SIZE;
+	static const uint32_t MAX_GENERATION = (1u << (31 - SLOT_BITS)) - 1;
+	static const uint32_t NO_SLOT = 0xFFFFFFFFu;
+
+	/** One entry. m_iState holds (generation << 1) | occupied; the pointers are only
+		* meaningful while the occupied bit is set.
+		*/
+	struct SSlot
+	{
+		std::atomic<uint32_t> m_iState;
+		std::atomic<uint32_t> m_iNextFree;
+		std::atomic<const void*> m_pOwner;
+		std::atomic<void*> m_pObject;
+	};
+
+	/** Get a slot, NULL if its segment has not been allocated.
+		*/
+	SSlot* _slot(uint32_t _iSlot) const;
+
+	/** Get a slot that has been handed out before, so its segment exists: the slots on the
+		* free list.
+		*/
+	SSlot* _usedSlot(uint32_t _iSlot) const;
+
+	/** Get a slot, allocating its segment if needed.
+		*/
+	SSlot* _allocateSlot(uint32_t _iSlot);
+
+	/** Take a slot from the free list, NO_SLOT if it is empty.
+		*/
+	uint32_t _popFree();
+
+	/** Put a slot on the free list.
+		*/
+	void _pushFree(uint32_t _iSlot);
+
+	std::atomic<SSlot*> m_pSegments[SEGMENT_COUNT];
+	std::atomic<uint32_t> m_iSlotCount;
+	std::atomic<uint64_t> m_iFreeHead;	///< (tag << 32) | slot, the tag avoids ABA
+};
+
+//----------------------------------------------------------------------------------------
+// Inline member functions
+//----------------------------------------------------------------------------------------
+
+// Get a slot.
+inline CHandleTable::SSlot* CHandleTable::_slot(uint32_t _iSlot) const
+{
+	SSlot* pSegment = m_pSegments[_iSlot >> SEGMENT_BITS].load(std::memory_order_acquire);
+	if (!pSegment)
+		return NULL;
+	return &pSegment[_iSlot & (SEGMENT_SIZE - 1)];
+}
+
+// Get a slot whose segment exists.
+inline CHandleTable::SSlot* CHandleTable::_usedSlot(uint32_t _iSlot) const
+{
+	SSlot* pSegment = m_pSegments[_iSlot >> SEGMENT_BITS].load(std::memory_order_acquire);
+	ASTRA_ASSERT(pSegment);
+	return &pSegment[_iSlot & (SEGMENT_SIZE - 1)];
+}
+
+// Get an object.
+inline void* CHandleTable::get(int _iHandle, const void* _pOwner) const
+{
+	if (_iHandle <= 0)
+		return NULL;
+	uint32_t iSlot = (uint32_t)_iHandle & (MAX_SLOTS - 1);
+	uint32_t iState = (((uint32_t)_iHandle >> SLOT_BITS) << 1) | 1;
+	const SSlot* pSlot = _slot(iSlot);
+	if (!pSlot || pSlot->m_iState.load(std::memory_order_acquire) != iState)
+		return NULL;
+	const void* pOwner = pSlot->m_pOwner.load(std::memory_order_acquire);
+	void* pObject = pSlot->m_pObject.load(std::memory_order_acquire);
+	// the slot may have been removed and reused while reading
+	if (pSlot->m_iState.load(std::memory_order_acquire) != iState || pOwner != _pOwner)
+		return NULL;
+	return pObject;
+}
+
+#endif // _INC_ASTRA_HANDLETABLE
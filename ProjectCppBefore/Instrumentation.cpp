@@ -0,0 +1,255 @@
+#include "Instrumentation.h"
+
+#include <cstdio>
+#include <sstream>
+
+
+DEFINE_SINGLETON(CInstrumentation)
+
+
+//----------------------------------------------------------------------------------------
+// Report
+SInstrumentationReport::SInstrumentationReport()
+{
+	for (int i = 0; i < STAGE_COUNT; ++i) {
+		m_iStageNanoseconds[i] = 0;
+		m_iStageCalls[i] = 0;
+	}
+	for (int i = 0; i < COUNTER_COUNT; ++i)
+		m_iCounters[i] = 0;
+}
+
+double SInstrumentationReport::getStageSeconds(EInstrumentationStage _eStage) const
+{
+	return m_iStageNanoseconds[_eStage] * 1e-9;
+}
+
+SInstrumentationReport SInstrumentationReport::operator-(const SInstrumentationReport& _other) const
+{
+	SInstrumentationReport res;
+	for (int i = 0; i < STAGE_COUNT; ++i) {
+		res.m_iStageNanoseconds[i] = m_iStageNanoseconds[i] - _other.m_iStageNanoseconds[i];
+		res.m_iStageCalls[i] = m_iStageCalls[i] - _other.m_iStageCalls[i];
+	}
+	for (int i = 0; i < COUNTER_COUNT; ++i)
+		res.m_iCounters[i] = m_iCounters[i] - _other.m_iCounters[i];
+	return res;
+}
+
+std::string SInstrumentationReport::toString() const
+{
+	std::ostringstream s;
+	for (int i = 0; i < STAGE_COUNT; ++i) {
+		s << getStageName((EInstrumentationStage)i) << ": " << getStageSeconds((EInstrumentationStage)i)
+		  << " s in " << m_iStageCalls[i] << " calls" << std::endl;
+	}
+	for (int i = 0; i < COUNTER_COUNT; ++i)
+		s << getCounterName((EInstrumentationCounter)i) << ": " << m_iCounters[i] << std::endl;
+	return s.str();
+}
+
+const char* SInstrumentationReport::getStageName(EInstrumentationStage _eStage)
+{
+	switch (_eStage) {
+	case STAGE_ALGORITHM_RUN: return "algorithm run";
+	case STAGE_GEOMETRY_SETUP: return "geometry setup";
+	case STAGE_PROJECTION: return "projection";
+	case STAGE_MATRIX: return "system matrix";
+	case STAGE_ALLOCATION: return "allocation";
+	case STAGE_FILTERING: return "filtering";
+	case STAGE_BACKPROJECTION: return "backprojection";
+	default: return "unknown";
+	}
+}
+
+const char* SInstrumentationReport::getCounterName(EInstrumentationCounter _eCounter)
+{
+	switch (_eCounter) {
+	case COUNTER_RAYS: return "rays traced";
+	case COUNTER_PIXELS: return "pixels visited";
+	case COUNTER_BYTES_ALLOCATED: return "bytes allocated";
+	case COUNTER_ALLOCATIONS: return "allocations";
+	default: return "unknown";
+	}
+}
+
+
+//----------------------------------------------------------------------------------------
+// Releases the block of a thread when the thread ends
+struct SThreadBlockHolder
+{
+	CInstrumentation::SThreadBlock* m_pBlock;
+
+	SThreadBlockHolder() : m_pBlock(NULL) { }
+	~SThreadBlockHolder() {
+		if (m_pBlock)
+			m_pBlock->m_bInUse.store(false, std::memory_order_release);
+	}
+};
+
+static thread_local SThreadBlockHolder s_threadBlock;
+
+
+//----------------------------------------------------------------------------------------
+// Constructor
+CInstrumentation::CInstrumentation()
+{
+	m_bTracing.store(false);
+	m_traceEpoch = std::chrono::steady_clock::now();
+}
+
+//----------------------------------------------------------------------------------------
+// Destructor
+CInstrumentation::~CInstrumentation()
+{
+	for (size_t i = 0; i < m_blocks.size(); ++i)
+		delete m_blocks[i];
+}
+
+//----------------------------------------------------------------------------------------
+// Enabled?
+bool CInstrumentation::isEnabled()
+{
+#ifdef ASTRA_ENABLE_INSTRUMENTATION
+	return true;
+#else
+	return false;
+#endif
+}
+
+//----------------------------------------------------------------------------------------
+// Get or create the block of this thread
+CInstrumentation::SThreadBlock* CInstrumentation::_threadBlock()
+{
+	if (!s_threadBlock.m_pBlock)
+		s_threadBlock.m_pBlock = getSingleton()._acquireBlock();
+	return s_threadBlock.m_pBlock;
+}
+
+CInstrumentation::SThreadBlock* CInstrumentation::_acquireBlock()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	for (size_t i = 0; i < m_blocks.size(); ++i) {
+		bool bInUse = false;
+		if (m_blocks[i]->m_bInUse.compare_exchange_strong(bInUse, true, std::memory_order_acquire))
+			return m_blocks[i];
+	}
+
+	SThreadBlock* pBlock = new SThreadBlock();
+	for (int i = 0; i < STAGE_COUNT; ++i) {
+		pBlock->m_iStageNanoseconds[i].store(0, std::memory_order_relaxed);
+		pBlock->m_iStageCalls[i].store(0, std::memory_order_relaxed);
+	}
+	for (int i = 0; i < COUNTER_COUNT; ++i)
+		pBlock->m_iCounters[i].store(0, std::memory_order_relaxed);
+	pBlock->m_bInUse.store(true, std::memory_order_relaxed);
+	pBlock->m_iIndex = (int)m_blocks.size();
+	m_blocks.push_back(pBlock);
+	return pBlock;
+}
+
+//----------------------------------------------------------------------------------------
+// Counters and stages
+void CInstrumentation::addCounter(EInstrumentationCounter _eCounter, uint64_t _iValue)
+{
+	std::atomic<uint64_t>& counter = _threadBlock()->m_iCounters[_eCounter];
+	counter.store(counter.load(std::memory_order_relaxed) + _iValue, std::memory_order_relaxed);
+}
+
+void CInstrumentation::addStage(EInstrumentationStage _eStage, std::chrono::steady_clock::time_point _start,
+	std::chrono::steady_clock::time_point _end)
+{
+	SThreadBlock* pBlock = _threadBlock();
+	int64_t iDuration = std::chrono::duration_cast<std::chrono::nanoseconds>(_end - _start).count();
+
+	std::atomic<uint64_t>& time = pBlock->m_iStageNanoseconds[_eStage];
+	time.store(time.load(std::memory_order_relaxed) + iDuration, std::memory_order_relaxed);
+	std::atomic<uint64_t>& calls = pBlock->m_iStageCalls[_eStage];
+	calls.store(calls.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+	CInstrumentation& instrumentation = getSingleton();
+	if (instrumentation.isTracing()) {
+		STraceEvent event;
+		event.m_eStage = _eStage;
+		event.m_iStart = std::chrono::duration_cast<std::chrono::nanoseconds>(_start - instrumentation.m_traceEpoch).count();
+		event.m_iDuration = iDuration;
+		std::lock_guard<std::mutex> lock(pBlock->m_traceMutex);
+		pBlock->m_traceEvents.push_back(event);
+	}
+}
+
+//----------------------------------------------------------------------------------------
+// Report
+SInstrumentationReport CInstrumentation::getReport() const
+{
+	SInstrumentationReport report;
+	std::lock_guard<std::mutex> lock(m_mutex);
+	for (size_t b = 0; b < m_blocks.size(); ++b) {
+		const SThreadBlock* pBlock = m_blocks[b];
+		for (int i = 0; i < STAGE_COUNT; ++i) {
+			report.m_iStageNanoseconds[i] += pBlock->m_iStageNanoseconds[i].load(std::memory_order_relaxed);
+			report.m_iStageCalls[i] += pBlock->m_iStageCalls[i].load(std::memory_order_relaxed);
+		}
+		for (int i = 0; i < COUNTER_COUNT; ++i)
+			report.m_iCounters[i] += pBlock->m_iCounters[i].load(std::memory_order_relaxed);
+	}
+	return report;
+}
+
+//----------------------------------------------------------------------------------------
+// Trace
+void CInstrumentation::startTrace()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	for (size_t b = 0; b < m_blocks.size(); ++b) {
+		std::lock_guard<std::mutex> blockLock(m_blocks[b]->m_traceMutex);
+		m_blocks[b]->m_traceEvents.clear();
+	}
+	m_bTracing.store(true, std::memory_order_relaxed);
+}
+
+void CInstrumentation::stopTrace()
+{
+	m_bTracing.store(false, std::memory_order_relaxed);
+}
+
+bool CInstrumentation::writeTrace(const std::string& _sFilename) const
+{
+	FILE* pFile = fopen(_sFilename.c_str(), "w");
+	if (!pFile)
+		return false;
+
+	fprintf(pFile, "{\"traceEvents\":[");
+	bool bFirst = true;
+	std::lock_guard<std::mutex> lock(m_mutex);
+	for (size_t b = 0; b < m_blocks.size(); ++b) {
+		std::lock_guard<std::mutex> blockLock(m_blocks[b]->m_traceMutex);
+		const std::vector<STraceEvent>& events = m_blocks[b]->m_traceEvents;
+		for (size_t i = 0; i < events.size(); ++i) {
+			fprintf(pFile, "%s\n{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d}",
+				bFirst ? "" : ",",
+				SInstrumentationReport::getStageName(events[i].m_eStage),
+				events[i].m_iStart * 1e-3, events[i].m_iDuration * 1e-3,
+				m_blocks[b]->m_iIndex);
+			bFirst = false;
+		}
+	}
+	fprintf(pFile, "\n],\"displayTimeUnit\":\"ms\"}\n");
+	return fclose(pFile) == 0;
+}
+
+
+//----------------------------------------------------------------------------------------
+// Recorder
+CInstrumentationRecorder::CInstrumentationRecorder(SInstrumentationReport& _report)
+	: m_report(_report)
+{
+	m_before = CInstrumentation::getSingleton().getReport();
+	m_start = std::chrono::steady_clock::now();
+}
+
+CInstrumentationRecorder::~CInstrumentationRecorder()
+{
+	CInstrumentation::addStage(STAGE_ALGORITHM_RUN, m_start, std::chrono::steady_clock::now());
+	m_report = CInstrumentation::getSingleton().getReport() - m_before;
+}
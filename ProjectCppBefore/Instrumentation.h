@@ -0,0 +1,250 @@
+#ifndef _INC_ASTRA_INSTRUMENTATION
+#define _INC_ASTRA_INSTRUMENTATION
+
+#include "Globals.h"
+#include "Singleton.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#ifndef _MSC_VER
+#include <stdint.h>
+#endif
+
+
+/**
+	* Hot-path instrumentation: per-stage timers, counters and an optional Chrome trace.
+	*
+	* The macros below are the only way the library records anything. They expand to
+	* nothing unless ASTRA_ENABLE_INSTRUMENTATION is defined, so a build without it has no
+	* instrumentation code in its hot paths at all. The query side (CInstrumentation,
+	* SInstrumentationReport, CAlgorithm::getInstrumentation()) is always available and
+	* reports zeros in such a build.
+	*
+	*   ASTRA_TIMER(stage)          time the rest of the enclosing scope as the given stage
+	*   ASTRA_COUNT(counter, n)     add n to a counter
+	*   ASTRA_INSTRUMENT(code)      code that is only compiled with instrumentation enabled
+	*   ASTRA_RECORD(report)        store the instrumentation of the rest of the enclosing
+	*                               scope in report, timed as STAGE_ALGORITHM_RUN
+	*
+	* Every thread accumulates into its own block, without atomic read-modify-writes or
+	* locks; getReport() sums the blocks. Stage times are summed over threads, so with
+	* parallel angle blocks STAGE_PROJECTION is thread time, not wall time.
+	*/
+
+#ifdef ASTRA_ENABLE_INSTRUMENTATION
+#define ASTRA_INSTRUMENT(...) __VA_ARGS__
+#define ASTRA_INSTRUMENT_CONCAT2(a, b) a##b
+#define ASTRA_INSTRUMENT_CONCAT(a, b) ASTRA_INSTRUMENT_CONCAT2(a, b)
+#define ASTRA_TIMER(stage) CScopedTimer ASTRA_INSTRUMENT_CONCAT(astraTimer, __LINE__)(stage)
+#define ASTRA_COUNT(counter, n) CInstrumentation::addCounter(counter, n)
+#define ASTRA_RECORD(report) CInstrumentationRecorder ASTRA_INSTRUMENT_CONCAT(astraRecorder, __LINE__)(report)
+#else
+#define ASTRA_INSTRUMENT(...)
+#define ASTRA_TIMER(stage) do { } while (false)
+#define ASTRA_COUNT(counter, n) do { } while (false)
+#define ASTRA_RECORD(report) do { } while (false)
+#endif
+
+
+/** Timed stages.
+	*/
+enum EInstrumentationStage {
+	STAGE_ALGORITHM_RUN,		///< CAlgorithm::run()
+	STAGE_GEOMETRY_SETUP,		///< conversion to vector geometries
+	STAGE_PROJECTION,			///< ray traversal including the policy callbacks
+	STAGE_MATRIX,				///< building an explicit system matrix
+	STAGE_ALLOCATION,			///< allocating data blocks
+	STAGE_FILTERING,			///< weighting and filtering of the sinogram (FBP)
+	STAGE_BACKPROJECTION,		///< pixel-driven backprojection (FBP)
+	STAGE_COUNT
+};
+
+/** Counters.
+	*/
+enum EInstrumentationCounter {
+	COUNTER_RAYS,				///< rays traced
+	COUNTER_PIXELS,				///< pixels visited by traced rays
+	COUNTER_BYTES_ALLOCATED,	///< bytes of data blocks allocated
+	COUNTER_ALLOCATIONS,		///< data blocks allocated
+	COUNTER_COUNT
+};
+
+
+/**
+	* Totals of all stages and counters.
+	*/
+struct SInstrumentationReport
+{
+	uint64_t m_iStageNanoseconds[STAGE_COUNT];
+	uint64_t m_iStageCalls[STAGE_COUNT];
+	uint64_t m_iCounters[COUNTER_COUNT];
+
+	/** Default constructor, all zero.
+		*/
+	SInstrumentationReport();
+
+	/** Time spent in a stage, in seconds.
+		*/
+	double getStageSeconds(EInstrumentationStage _eStage) const;
+
+	/** Value of a counter.
+		*/
+	uint64_t getCounter(EInstrumentationCounter _eCounter) const { return m_iCounters[_eCounter]; }
+
+	/** Difference of two reports, for the work done between them.
+		*/
+	SInstrumentationReport operator-(const SInstrumentationReport& _other) const;
+
+	/** Human readable summary, one line per stage and counter.
+		*/
+	std::string toString() const;
+
+	static const char* getStageName(EInstrumentationStage _eStage);
+	static const char* getCounterName(EInstrumentationCounter _eCounter);
+};
+
+
+/**
+	* Process-wide registry of the per-thread instrumentation blocks.
+	*/
+class CInstrumentation : public Singleton<CInstrumentation> {
+
+public:
+
+	/** Default constructor.
+		*/
+	CInstrumentation();
+
+	/** Destructor.
+		*/
+	virtual ~CInstrumentation();
+
+	/** Was the library built with ASTRA_ENABLE_INSTRUMENTATION?
+		*/
+	static bool isEnabled();
+
+	/** Sum of all threads, since the start of the process.
+		*/
+	SInstrumentationReport getReport() const;
+
+	/** Start recording trace events. Clears the events recorded before.
+		*/
+	void startTrace();
+
+	/** Stop recording trace events.
+		*/
+	void stopTrace();
+
+	/** Are trace events being recorded?
+		*/
+	bool isTracing() const { return m_bTracing.load(std::memory_order_relaxed); }
+
+	/** Write the recorded trace events in the Chrome trace event format (JSON), to be
+		* opened in chrome://tracing or Perfetto.
+		*
+		* @return false if the file could not be written
+		*/
+	bool writeTrace(const std::string& _sFilename) const;
+
+	/** Add _iValue to a counter of the calling thread.
+		*/
+	static void addCounter(EInstrumentationCounter _eCounter, uint64_t _iValue);
+
+	/** Add a finished stage to the calling thread. _start is used for the trace.
+		*/
+	static void addStage(EInstrumentationStage _eStage, std::chrono::steady_clock::time_point _start,
+		std::chrono::steady_clock::time_point _end);
+
+protected:
+
+	/** One complete ("X") trace event.
+		*/
+	struct STraceEvent
+	{
+		EInstrumentationStage m_eStage;
+		int64_t m_iStart;		///< ns since the trace epoch
+		int64_t m_iDuration;	///< ns
+	};
+
+	/** Values of one thread. Only that thread writes them, so plain loads and stores of
+		* the atomics suffice; the atomics only make concurrent getReport() calls safe.
+		*/
+	struct SThreadBlock
+	{
+		std::atomic<uint64_t> m_iStageNanoseconds[STAGE_COUNT];
+		std::atomic<uint64_t> m_iStageCalls[STAGE_COUNT];
+		std::atomic<uint64_t> m_iCounters[COUNTER_COUNT];
+		std::atomic<bool> m_bInUse;
+		int m_iIndex;
+		mutable std::mutex m_traceMutex;
+		std::vector<STraceEvent> m_traceEvents;
+	};
+
+	/** Get the block of the calling thread, creating or reusing one on first use.
+		*/
+	static SThreadBlock* _threadBlock();
+
+	/** Take a block for a new thread. Blocks of finished threads are reused, their
+		* values are kept so that the totals stay correct.
+		*/
+	SThreadBlock* _acquireBlock();
+
+	friend struct SThreadBlockHolder;
+
+	mutable std::mutex m_mutex;
+	std::vector<SThreadBlock*> m_blocks;
+	std::atomic<bool> m_bTracing;
+	std::chrono::steady_clock::time_point m_traceEpoch;
+};
+
+
+/**
+	* Times the scope it lives in as one stage, see ASTRA_TIMER.
+	*/
+class CScopedTimer {
+
+public:
+
+	explicit CScopedTimer(EInstrumentationStage _eStage)
+		: m_eStage(_eStage), m_start(std::chrono::steady_clock::now()) { }
+
+	~CScopedTimer() { CInstrumentation::addStage(m_eStage, m_start, std::chrono::steady_clock::now()); }
+
+private:
+
+	EInstrumentationStage m_eStage;
+	std::chrono::steady_clock::time_point m_start;
+
+	CScopedTimer(const CScopedTimer&);
+	CScopedTimer& operator=(const CScopedTimer&);
+};
+
+
+/**
+	* Stores the instrumentation of the scope it lives in, see ASTRA_RECORD.
+	* Work of other threads that runs at the same time, such as a second algorithm, is
+	* included as well.
+	*/
+class CInstrumentationRecorder {
+
+public:
+
+	explicit CInstrumentationRecorder(SInstrumentationReport& _report);
+
+	~CInstrumentationRecorder();
+
+private:
+
+	SInstrumentationReport& m_report;
+	SInstrumentationReport m_before;
+	std::chrono::steady_clock::time_point m_start;
+
+	CInstrumentationRecorder(const CInstrumentationRecorder&);
+	CInstrumentationRecorder& operator=(const CInstrumentationRecorder&);
+};
+
+#endif // _INC_ASTRA_INSTRUMENTATION
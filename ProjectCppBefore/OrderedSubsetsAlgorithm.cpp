@@ -0,0 +1,309 @@
+#include "OrderedSubsetsAlgorithm.h"
+
+#include "DataProjectorPolicies.h"
+#include "Float32VolumeData2DView.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Projector2DImpl.inl"
+
+// type of the algorithm, needed to register with CAlgorithmFactory
+std::string COrderedSubsetsAlgorithm::type = "OS-SART";
+
+//----------------------------------------------------------------------------------------
+// Constructor - Default
+COrderedSubsetsAlgorithm::COrderedSubsetsAlgorithm()
+{
+	_clear();
+}
+
+//----------------------------------------------------------------------------------------
+// Constructor
+COrderedSubsetsAlgorithm::COrderedSubsetsAlgorithm(CProjector2D* _pProjector,
+	CFloat32ProjectionData2D* _pSinogram,
+	CFloat32VolumeData2D* _pReconstruction,
+	int _iSubsetCount)
+{
+	_clear();
+	initialize(_pProjector, _pSinogram, _pReconstruction, _iSubsetCount);
+}
+
+//----------------------------------------------------------------------------------------
+// Destructor
+COrderedSubsetsAlgorithm::~COrderedSubsetsAlgorithm()
+{
+	clear();
+}
+
+//---------------------------------------------------------------------------------------
+// Clear - Constructors
+void COrderedSubsetsAlgorithm::_clear()
+{
+	m_pProjector = NULL;
+	m_pSinogram = NULL;
+	m_pReconstruction = NULL;
+	m_iSubsetCount = 1;
+	m_eSubsetOrder = ORDER_SEQUENTIAL;
+	m_fRelaxation = 1.0f;
+	m_iNormalizedSubsetCount = 0;
+	m_pTotalRayLength = NULL;
+	m_bCachedPixelWeights = false;
+	m_pDiffSinogram = NULL;
+	m_pForwardProjector = NULL;
+	m_fBackProjectorRelaxation = 0.0f;
+	m_bIsInitialized = false;
+}
+
+//---------------------------------------------------------------------------------------
+// Clear - Public
+void COrderedSubsetsAlgorithm::clear()
+{
+	_clearNormalization();
+	delete m_pForwardProjector;
+	m_pForwardProjector = NULL;
+	delete m_pDiffSinogram;
+	m_pDiffSinogram = NULL;
+	m_pProjector = NULL;
+	m_pSinogram = NULL;
+	m_pReconstruction = NULL;
+	m_subsets.clear();
+	m_order.clear();
+	m_bIsInitialized = false;
+}
+
+//---------------------------------------------------------------------------------------
+// Clear the normalization
+void COrderedSubsetsAlgorithm::_clearNormalization()
+{
+	for (size_t i = 0; i < m_backProjectors.size(); ++i)
+		delete m_backProjectors[i];
+	m_backProjectors.clear();
+	for (size_t i = 0; i < m_pixelWeightProjectors.size(); ++i)
+		delete m_pixelWeightProjectors[i];
+	m_pixelWeightProjectors.clear();
+	for (size_t i = 0; i < m_subsetPixelWeights.size(); ++i)
+		delete m_subsetPixelWeights[i];
+	m_subsetPixelWeights.clear();
+	delete m_pTotalRayLength;
+	m_pTotalRayLength = NULL;
+	m_iNormalizedSubsetCount = 0;
+}
+
+//----------------------------------------------------------------------------------------
+// Check
+bool COrderedSubsetsAlgorithm::_check()
+{
+	// check pointers
+	ASTRA_CONFIG_CHECK(m_pProjector, "OS-SART", "Invalid Projector Object.");
+	ASTRA_CONFIG_CHECK(m_pSinogram, "OS-SART", "Invalid Projection Data Object.");
+	ASTRA_CONFIG_CHECK(m_pReconstruction, "OS-SART", "Invalid Reconstruction Data Object.");
+
+	// check initializations
+	ASTRA_CONFIG_CHECK(m_pProjector->isInitialized(), "OS-SART", "Projector Object Not Initialized.");
+	ASTRA_CONFIG_CHECK(m_pSinogram->isInitialized(), "OS-SART", "Projection Data Object Not Initialized.");
+	ASTRA_CONFIG_CHECK(m_pReconstruction->isInitialized(), "OS-SART", "Reconstruction Data Object Not Initialized.");
+
+	// check compatibility between projector and data classes
+	ASTRA_CONFIG_CHECK(m_pSinogram->getGeometry()->isEqual(m_pProjector->getProjectionGeometry()), "OS-SART", "Projection Data not compatible with the specified Projector.");
+	ASTRA_CONFIG_CHECK(m_pReconstruction->getGeometry()->isEqual(m_pProjector->getVolumeGeometry()), "OS-SART", "Reconstruction Data not compatible with the specified Projector.");
+	ASTRA_CONFIG_CHECK(m_pReconstruction->getStride() == m_pProjector->getVolumeStride(), "OS-SART", "Reconstruction Data row stride does not match the Projector, see CProjector2D::setVolumeStride.");
+
+	ASTRA_CONFIG_CHECK(m_pForwardProjector, "OS-SART", "Invalid Diff FP Policy");
+
+	// success
+	return true;
+}
+
+//----------------------------------------------------------------------------------------
+// Initialize
+bool COrderedSubsetsAlgorithm::initialize(CProjector2D* _pProjector,
+	CFloat32ProjectionData2D* _pSinogram,
+	CFloat32VolumeData2D* _pReconstruction,
+	int _iSubsetCount)
+{
+	clear();
+
+	// store classes
+	m_pProjector = _pProjector;
+	m_pSinogram = _pSinogram;
+	m_pReconstruction = _pReconstruction;
+
+	if (m_pProjector && m_pSinogram && m_pReconstruction && m_pSinogram->isInitialized()) {
+		// residual of the current subset
+		m_pDiffSinogram = new CFloat32ProjectionData2D(m_pSinogram->getGeometry(), 0.0f);
+		m_pForwardProjector = dispatchDataProjector(m_pProjector, DiffFPPolicy(m_pReconstruction, m_pDiffSinogram, m_pSinogram));
+
+		setSubsetCount(_iSubsetCount);
+	}
+
+	// return success
+	m_bIsInitialized = _check();
+	return m_bIsInitialized;
+}
+
+//----------------------------------------------------------------------------------------
+// Subset count
+void COrderedSubsetsAlgorithm::setSubsetCount(int _iSubsetCount)
+{
+	if (!m_pSinogram) {
+		m_iSubsetCount = std::max(_iSubsetCount, 1);
+		return;
+	}
+
+	int iAngleCount = m_pSinogram->getGeometry()->getProjectionAngleCount();
+	m_iSubsetCount = std::min(std::max(_iSubsetCount, 1), std::max(iAngleCount, 1));
+
+	// interleaved subsets: subset k has angles k, k + S, k + 2S, ...
+	m_subsets.assign(m_iSubsetCount, std::vector<int>());
+	for (int iAngle = 0; iAngle < iAngleCount; ++iAngle)
+		m_subsets[iAngle % m_iSubsetCount].push_back(iAngle);
+
+	m_order.clear();
+}
+
+//----------------------------------------------------------------------------------------
+// Subset order
+void COrderedSubsetsAlgorithm::setSubsetOrder(ESubsetOrder _eOrder, unsigned int _iSeed)
+{
+	m_eSubsetOrder = _eOrder;
+	m_random.seed(_iSeed);
+	m_order.clear();
+}
+
+void COrderedSubsetsAlgorithm::_nextOrder()
+{
+	const int S = m_iSubsetCount;
+
+	// sequential and golden angle orders do not change between iterations
+	if ((int)m_order.size() == S && m_eSubsetOrder != ORDER_RANDOM)
+		return;
+
+	m_order.resize(S);
+	for (int i = 0; i < S; ++i)
+		m_order[i] = i;
+
+	if (m_eSubsetOrder == ORDER_RANDOM) {
+		std::shuffle(m_order.begin(), m_order.end(), m_random);
+	}
+	else if (m_eSubsetOrder == ORDER_GOLDEN_ANGLE) {
+		// step S / phi further for every next subset, taking the nearest one not used yet
+		const double dStep = S * 0.6180339887498949;
+		std::vector<bool> used(S, false);
+		for (int k = 0; k < S; ++k) {
+			int iTarget = (int)floor(fmod(k * dStep, (double)S));
+			int iBest = -1;
+			for (int d = 0; d < S && iBest < 0; ++d) {
+				if (!used[(iTarget + d) % S]) iBest = (iTarget + d) % S;
+				else if (!used[(iTarget - d + S) % S]) iBest = (iTarget - d + S) % S;
+			}
+			used[iBest] = true;
+			m_order[k] = iBest;
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------
+// Project a subset
+void COrderedSubsetsAlgorithm::_projectSubset(CDataProjectorInterface* _pDataProjector, const std::vector<int>& _angles)
+{
+	if (!_pDataProjector->isAngleParallel()) {
+		for (size_t i = 0; i < _angles.size(); ++i)
+			_pDataProjector->projectSingleProjection(_angles[i]);
+		return;
+	}
+
+	// projectAngleRange, not projectSingleProjection: only the former gives every task its
+	// own copy of the policy
+	parallelFor(0, (int)_angles.size(), 1, [_pDataProjector, &_angles](int _iFrom, int _iTo) {
+		for (int i = _iFrom; i < _iTo; ++i)
+			_pDataProjector->projectAngleRange(_angles[i], _angles[i] + 1);
+	});
+}
+
+//----------------------------------------------------------------------------------------
+// Normalization
+void COrderedSubsetsAlgorithm::_updateNormalization()
+{
+	if (m_iNormalizedSubsetCount != m_iSubsetCount) {
+		_clearNormalization();
+
+		// total ray lengths, the same for every subset
+		m_pTotalRayLength = new CFloat32ProjectionData2D(m_pSinogram->getGeometry(), 0.0f);
+		CDataProjectorInterface* pRayLengthProjector = dispatchDataProjector(m_pProjector, TotalRayLengthPolicy(m_pTotalRayLength));
+		pRayLengthProjector->projectParallel();
+		delete pRayLengthProjector;
+
+		// total pixel weights per subset, cached if they fit
+		size_t iVolumeBytes = (size_t)m_pReconstruction->getSize() * sizeof(float);
+		m_bCachedPixelWeights = (size_t)m_iSubsetCount * iVolumeBytes <= MAX_CACHED_WEIGHTS_BYTES;
+		int iWeightCount = m_bCachedPixelWeights ? m_iSubsetCount : 1;
+		for (int i = 0; i < iWeightCount; ++i) {
+			// indexed like the reconstruction, so with its row stride if that is a view
+			CFloat32VolumeData2D* pPixelWeight = new CFloat32VolumeData2DView(m_pReconstruction->getGeometry(), m_pProjector->getVolumeStride(), 0.0f);
+			m_subsetPixelWeights.push_back(pPixelWeight);
+			m_pixelWeightProjectors.push_back(dispatchDataProjector(m_pProjector, TotalPixelWeightPolicy(pPixelWeight)));
+			if (m_bCachedPixelWeights)
+				_projectSubset(m_pixelWeightProjectors[i], m_subsets[i]);
+		}
+
+		m_iNormalizedSubsetCount = m_iSubsetCount;
+	}
+
+	// update data projectors, the relaxation is part of their policy
+	if (m_backProjectors.empty() || m_fBackProjectorRelaxation != m_fRelaxation) {
+		for (size_t i = 0; i < m_backProjectors.size(); ++i)
+			delete m_backProjectors[i];
+		m_backProjectors.clear();
+		for (size_t i = 0; i < m_subsetPixelWeights.size(); ++i) {
+			m_backProjectors.push_back(dispatchDataProjector(m_pProjector,
+				SIRTBPPolicy(m_pReconstruction, m_pDiffSinogram, m_subsetPixelWeights[i], m_pTotalRayLength, m_fRelaxation)));
+		}
+		m_fBackProjectorRelaxation = m_fRelaxation;
+	}
+}
+
+//----------------------------------------------------------------------------------------
+// Iterate
+void COrderedSubsetsAlgorithm::run(int _iNrIterations)
+{
+	// check initialized
+	ASTRA_ASSERT(m_bIsInitialized);
+
+	ASTRA_RECORD(m_instrumentation);
+
+	_updateNormalization();
+
+	m_control.beginRun();
+	m_control.addTotal(_iNrIterations * m_pSinogram->getGeometry()->getProjectionAngleCount());
+
+	for (int iIteration = 0; iIteration < _iNrIterations; ++iIteration) {
+		_nextOrder();
+
+		for (int k = 0; k < m_iSubsetCount; ++k) {
+			if (m_control.checkAbort())
+				return;
+
+			const int iSubset = m_order[k];
+			const std::vector<int>& angles = m_subsets[iSubset];
+
+			// C_s, unless cached
+			int iWeights = iSubset;
+			if (!m_bCachedPixelWeights) {
+				iWeights = 0;
+				m_subsetPixelWeights[0]->setData(0.0f);
+				_projectSubset(m_pixelWeightProjectors[0], angles);
+			}
+
+			// b_s - A_s x
+			_projectSubset(m_pForwardProjector, angles);
+
+			// x += lambda C_s^-1 A_s^T R^-1 (b_s - A_s x)
+			_projectSubset(m_backProjectors[iWeights], angles);
+
+			m_control.advance((int)angles.size());
+		}
+	}
+}
+//----------------------------------------------------------------------------------------
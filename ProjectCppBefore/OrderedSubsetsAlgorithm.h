@@ -0,0 +1,219 @@
+#ifndef _INC_ASTRA_ORDEREDSUBSETSALGORITHM
+#define _INC_ASTRA_ORDEREDSUBSETSALGORITHM
+
+#include "Algorithm.h"
+
+#include "Globals.h"
+
+#include "Projector2D.h"
+#include "Float32ProjectionData2D.h"
+#include "Float32VolumeData2D.h"
+
+#include "DataProjector.h"
+
+#include <random>
+#include <vector>
+
+/**
+	* \brief
+	* This class contains the implementation of the ordered subsets SART / SIRT algorithm.
+	*
+	* The projection angles are divided into subsets of interleaved angles, subset k holding
+	* the angles k, k + S, k + 2S, ... for S subsets. Every subset updates the reconstruction
+	* with the SIRT step restricted to its own angles,
+	*
+	*   x += lambda * C_s^-1 A_s^T R^-1 (b_s - A_s x)
+	*
+	* with R the total ray lengths and C_s the total pixel weights of subset s. One subset is
+	* SIRT, one subset per angle is SART. An iteration visits every subset once, in the order
+	* set by setSubsetOrder().
+	*
+	* The ray lengths and the pixel weights of every subset only depend on the projector and
+	* the subset count, so they are computed once and reused by all iterations and runs. When
+	* the pixel weights of all subsets would take more than MAX_CACHED_WEIGHTS_BYTES (SART on
+	* large volumes), those of a subset are recomputed every time it is visited instead.
+	*/
+class COrderedSubsetsAlgorithm : public CAlgorithm {
+
+public:
+
+	/** Order in which the subsets are visited during an iteration.
+		* - ORDER_SEQUENTIAL: 0, 1, 2, ...
+		* - ORDER_GOLDEN_ANGLE: every next subset about S / phi further on (phi the golden
+		*   ratio), so consecutive subsets cover far apart angles
+		* - ORDER_RANDOM: a new random permutation every iteration
+		*/
+	enum ESubsetOrder { ORDER_SEQUENTIAL, ORDER_GOLDEN_ANGLE, ORDER_RANDOM };
+
+	/** Largest total size of the cached subset pixel weights.
+		*/
+	static const size_t MAX_CACHED_WEIGHTS_BYTES = 256 << 20;
+
+protected:
+
+	/** Initial clearing. Only to be used by constructors.
+		*/
+	virtual void _clear();
+
+	/** Check the values of this object.  If everything is ok, the object can be set to the initialized state.
+		* The following statements are then guaranteed to hold:
+		* - valid projector
+		* - valid data objects
+		*/
+	virtual bool _check();
+
+	/** Compute the ray lengths and the subset pixel weights, if the subset count changed.
+		*/
+	void _updateNormalization();
+
+	/** Free the ray lengths, the subset pixel weights and their data projectors.
+		*/
+	void _clearNormalization();
+
+	/** Project the angles of a subset with a data projector, on the thread pool if the
+		* data projector allows it.
+		*/
+	void _projectSubset(CDataProjectorInterface* _pDataProjector, const std::vector<int>& _angles);
+
+	/** Fill m_order with the subset order of the next iteration.
+		*/
+	void _nextOrder();
+
+	//< Projector object.
+	CProjector2D* m_pProjector;
+	//< ProjectionData2D object containing the sinogram.
+	CFloat32ProjectionData2D* m_pSinogram;
+	//< VolumeData2D object for storing the reconstruction.
+	CFloat32VolumeData2D* m_pReconstruction;
+
+	//< Number of subsets and their order
+	int m_iSubsetCount;
+	ESubsetOrder m_eSubsetOrder;
+	//< Relaxation parameter lambda
+	float m_fRelaxation;
+
+	//< Angles of every subset
+	std::vector<std::vector<int> > m_subsets;
+	//< Subset order of the current iteration
+	std::vector<int> m_order;
+	//< Random generator of ORDER_RANDOM
+	std::mt19937 m_random;
+
+	//< Subset count the normalization was computed for, 0 if none
+	int m_iNormalizedSubsetCount;
+	//< Total ray length of every ray
+	CFloat32ProjectionData2D* m_pTotalRayLength;
+	//< Total pixel weight of every subset, or a single one recomputed per subset
+	std::vector<CFloat32VolumeData2D*> m_subsetPixelWeights;
+	bool m_bCachedPixelWeights;
+	//< Residual b - A x of the rays of the current subset
+	CFloat32ProjectionData2D* m_pDiffSinogram;
+
+	//< Data projectors: residual, pixel weights and update of every entry of m_subsetPixelWeights
+	CDataProjectorInterface* m_pForwardProjector;
+	std::vector<CDataProjectorInterface*> m_pixelWeightProjectors;
+	std::vector<CDataProjectorInterface*> m_backProjectors;
+	//< Relaxation the update data projectors were made with
+	float m_fBackProjectorRelaxation;
+
+public:
+
+	// type of the algorithm, needed to register with CAlgorithmFactory
+	static std::string type;
+
+	/** Default constructor, containing no code.
+		*/
+	COrderedSubsetsAlgorithm();
+
+	/** Initializing constructor.
+		*
+		* @param _pProjector		Projector to use.
+		* @param _pSinogram		ProjectionData2D object containing the sinogram to reconstruct.
+		* @param _pReconstruction	VolumeData2D object containing the initial reconstruction, updated in place.
+		* @param _iSubsetCount		Number of subsets.
+		*/
+	COrderedSubsetsAlgorithm(CProjector2D* _pProjector,
+		CFloat32ProjectionData2D* _pSinogram,
+		CFloat32VolumeData2D* _pReconstruction,
+		int _iSubsetCount = 10);
+
+	/** Destructor.
+		*/
+	virtual ~COrderedSubsetsAlgorithm();
+
+	/** Clear this class.
+		*/
+	virtual void clear();
+
+	/** Initialize class.
+		*
+		* @param _pProjector		Projector to use.
+		* @param _pSinogram		ProjectionData2D object containing the sinogram to reconstruct.
+		* @param _pReconstruction	VolumeData2D object containing the initial reconstruction, updated in place.
+		* @param _iSubsetCount		Number of subsets, between 1 (SIRT) and the number of angles (SART).
+		* @return success
+		*/
+	bool initialize(CProjector2D* _pProjector,
+		CFloat32ProjectionData2D* _pSinogram,
+		CFloat32VolumeData2D* _pReconstruction,
+		int _iSubsetCount = 10);
+
+	/** Set the number of subsets. The normalization of the new subsets is computed on the next run().
+		*
+		* @param _iSubsetCount number of subsets, clamped to [1, number of angles]
+		*/
+	void setSubsetCount(int _iSubsetCount);
+
+	/** Get the number of subsets.
+		*/
+	int getSubsetCount() const;
+
+	/** Set the subset order.
+		*
+		* @param _eOrder subset order
+		* @param _iSeed seed of the random order
+		*/
+	void setSubsetOrder(ESubsetOrder _eOrder, unsigned int _iSeed = 0);
+
+	/** Get the subset order.
+		*/
+	ESubsetOrder getSubsetOrder() const;
+
+	/** Set the relaxation parameter.
+		*
+		* @param _fRelaxation relaxation parameter, 1 by default
+		*/
+	void setRelaxation(float _fRelaxation);
+
+	/** Get the relaxation parameter.
+		*/
+	float getRelaxation() const;
+
+	/** Get the angles of a subset.
+		*/
+	const std::vector<int>& getSubset(int _iSubset) const;
+
+	/** Perform a number of iterations, every iteration visiting all subsets once.
+		*
+		* @param _iNrIterations amount of iterations to perform.
+		*/
+	virtual void run(int _iNrIterations = 0);
+
+	/** Get a description of the class.
+		*
+		* @return description string
+		*/
+	virtual std::string description() const;
+
+};
+
+// inline functions
+inline std::string COrderedSubsetsAlgorithm::description() const { return COrderedSubsetsAlgorithm::type; };
+inline int COrderedSubsetsAlgorithm::getSubsetCount() const { return m_iSubsetCount; }
+inline COrderedSubsetsAlgorithm::ESubsetOrder COrderedSubsetsAlgorithm::getSubsetOrder() const { return m_eSubsetOrder; }
+inline void COrderedSubsetsAlgorithm::setRelaxation(float _fRelaxation) { m_fRelaxation = _fRelaxation; }
+inline float COrderedSubsetsAlgorithm::getRelaxation() const { return m_fRelaxation; }
+inline const std::vector<int>& COrderedSubsetsAlgorithm::getSubset(int _iSubset) const { return m_subsets[_iSubset]; }
+
+
+#endif
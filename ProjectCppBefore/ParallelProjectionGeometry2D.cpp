@@ -1,5 +1,6 @@
 #include "ParallelProjectionGeometry2D.h"
 #include "GeometryUtil2D.h"
+#include "Instrumentation.h"
 
 #include <cstring>
 
@@ -41,6 +42,7 @@ CParallelProjectionGeometry2D& CParallelProjectionGeometry2D::operator=(const CP
 {
 	if (m_bInitialized)
 		delete[] m_pfProjectionAngles;
+	_resetFingerprint();
 	m_bInitialized = _other.m_bInitialized;
 	if (_other.m_bInitialized) {
 		m_iProjectionAngleCount = _other.m_iProjectionAngleCount;
@@ -96,19 +98,31 @@ bool CParallelProjectionGeometry2D::isEqual(CProjectionGeometry2D* _pGeom2) cons
 
 	// both objects must be initialized
 	if (!m_bInitialized || !pGeom2->m_bInitialized) return false;
+	if (_isKnownEqual(pGeom2)) return true;
 
 	// check all values
 	if (m_iProjectionAngleCount != pGeom2->m_iProjectionAngleCount) return false;
 	if (m_iDetectorCount != pGeom2->m_iDetectorCount) return false;
 	if (m_fDetectorWidth != pGeom2->m_fDetectorWidth) return false;
 
+	// fast reject, then the angles themselves, as different geometries may share a fingerprint
+	if (getFingerprint() != pGeom2->getFingerprint()) return false;
 	for (int i = 0; i < m_iProjectionAngleCount; ++i) {
-		//	if (m_pfProjectionAngles[i] != pGeom2->m_pfProjectionAngles[i]) return false;
+		if (m_pfProjectionAngles[i] != pGeom2->m_pfProjectionAngles[i]) return false;
 	}
 
+	_setKnownEqual(pGeom2);
 	return true;
 }
 
+//----------------------------------------------------------------------------------------
+// Fingerprint
+void CParallelProjectionGeometry2D::_fingerprint(CFingerprint& _fingerprint) const
+{
+	_fingerprint.add("parallel");
+	CProjectionGeometry2D::_fingerprint(_fingerprint);
+}
+
 //----------------------------------------------------------------------------------------
 // is of type
 bool CParallelProjectionGeometry2D::isOfType(const std::string& _sType)
@@ -119,6 +133,8 @@ bool CParallelProjectionGeometry2D::isOfType(const std::string& _sType)
 //----------------------------------------------------------------------------------------
 CParallelVecProjectionGeometry2D* CParallelProjectionGeometry2D::toVectorGeometry()
 {
+	ASTRA_TIMER(STAGE_GEOMETRY_SETUP);
+
 	SParProjection* vectors = genParProjections(m_iProjectionAngleCount,
 		m_iDetectorCount,
 		m_fDetectorWidth,
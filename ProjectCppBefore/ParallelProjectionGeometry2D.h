@@ -32,6 +32,12 @@
 	*/
 class CParallelProjectionGeometry2D : public CProjectionGeometry2D
 {
+protected:
+
+	/** Add the type and the common values to _fingerprint.
+		*/
+	virtual void _fingerprint(CFingerprint& _fingerprint) const;
+
 public:
 
 	/** Default constructor. Sets all numeric member variables to 0 and all pointer member variables to NULL.
@@ -47,6 +47,7 @@ bool CParallelVecProjectionGeometry2D::initialize(int _iProjectionAngleCount,
 	int _iDetectorCount,
 	const SParProjection* _pProjectionAngles)
 {
+	_resetFingerprint();
 	m_iProjectionAngleCount = _iProjectionAngleCount;
 	m_iDetectorCount = _iDetectorCount;
 	m_pProjectionAngles = new SParProjection[m_iProjectionAngleCount];
@@ -79,18 +80,31 @@ bool CParallelVecProjectionGeometry2D::isEqual(CProjectionGeometry2D* _pGeom2) c
 
 	// both objects must be initialized
 	if (!m_bInitialized || !pGeom2->m_bInitialized) return false;
+	if (_isKnownEqual(pGeom2)) return true;
 
 	// check all values
 	if (m_iProjectionAngleCount != pGeom2->m_iProjectionAngleCount) return false;
 	if (m_iDetectorCount != pGeom2->m_iDetectorCount) return false;
 
+	// fast reject, then the vectors themselves, as different geometries may share a fingerprint
+	if (getFingerprint() != pGeom2->getFingerprint()) return false;
 	for (int i = 0; i < m_iProjectionAngleCount; ++i) {
 		if (memcmp(&m_pProjectionAngles[i], &pGeom2->m_pProjectionAngles[i], sizeof(m_pProjectionAngles[i])) != 0) return false;
 	}
 
+	_setKnownEqual(pGeom2);
 	return true;
 }
 
+//----------------------------------------------------------------------------------------
+// Fingerprint
+void CParallelVecProjectionGeometry2D::_fingerprint(CFingerprint& _fingerprint) const
+{
+	_fingerprint.add("parallel_vec");
+	CProjectionGeometry2D::_fingerprint(_fingerprint);
+	_fingerprint.add(m_pProjectionAngles, m_iProjectionAngleCount * sizeof(m_pProjectionAngles[0]));
+}
+
 //----------------------------------------------------------------------------------------
 // Is of type
 bool CParallelVecProjectionGeometry2D::isOfType(const std::string& _sType)
@@ -102,6 +102,10 @@ public:
 	const SParProjection* getProjectionVectors() const { return m_pProjectionAngles; }
 
 protected:
+
+	/** Add the type, the common values and the projection vectors to _fingerprint.
+		*/
+	virtual void _fingerprint(CFingerprint& _fingerprint) const;
 };
 
 
@@ -0,0 +1,78 @@
+#include "ProjectionControl.h"
+
+
+//----------------------------------------------------------------------------------------
+// Constructor
+CProjectionControl::CProjectionControl()
+{
+	m_bAbort.store(false);
+	m_bAbortNextRun.store(false);
+	m_bStoppedEarly.store(false);
+	m_iDone.store(0);
+	m_iTotal.store(0);
+}
+
+//----------------------------------------------------------------------------------------
+// Abort
+void CProjectionControl::signalAbort()
+{
+	m_bAbort.store(true, std::memory_order_relaxed);
+}
+
+void CProjectionControl::signalAbortIncludingNextRun()
+{
+	m_bAbortNextRun.store(true, std::memory_order_relaxed);
+	m_bAbort.store(true, std::memory_order_relaxed);
+}
+
+void CProjectionControl::clearAbort()
+{
+	m_bAbortNextRun.store(false, std::memory_order_relaxed);
+	m_bAbort.store(false, std::memory_order_relaxed);
+}
+
+bool CProjectionControl::checkAbort()
+{
+	if (!shouldAbort())
+		return false;
+	m_bStoppedEarly.store(true, std::memory_order_relaxed);
+	return true;
+}
+
+//----------------------------------------------------------------------------------------
+// Run
+void CProjectionControl::beginRun()
+{
+	m_bAbort.store(m_bAbortNextRun.exchange(false, std::memory_order_relaxed), std::memory_order_relaxed);
+	m_bStoppedEarly.store(false, std::memory_order_relaxed);
+	m_iDone.store(0, std::memory_order_relaxed);
+	m_iTotal.store(0, std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------
+// Progress
+void CProjectionControl::addTotal(int _iCount)
+{
+	m_iTotal.fetch_add(_iCount, std::memory_order_relaxed);
+}
+
+void CProjectionControl::advance(int _iCount)
+{
+	int iDone = m_iDone.fetch_add(_iCount, std::memory_order_relaxed) + _iCount;
+	if (m_callback)
+		m_callback(iDone, getTotal());
+}
+
+float CProjectionControl::getProgress() const
+{
+	int iTotal = getTotal();
+	if (iTotal <= 0)
+		return 0.0f;
+	float fProgress = (float)getDone() / (float)iTotal;
+	return fProgress < 1.0f ? fProgress : 1.0f;
+}
+
+void CProjectionControl::setProgressCallback(const ProgressCallback& _callback)
+{
+	m_callback = _callback;
+}
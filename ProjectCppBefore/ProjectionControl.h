@@ -0,0 +1,107 @@
+#ifndef _INC_ASTRA_PROJECTIONCONTROL
+#define _INC_ASTRA_PROJECTIONCONTROL
+
+#include "Globals.h"
+
+#include <atomic>
+#include <functional>
+
+
+/**
+	* Cooperative cancellation and progress of a long-running projection.
+	*
+	* A CAlgorithm owns one of these and hands it to its data projectors. The data projector
+	* looks at it once per block of angles, never per ray: before a block it checks the abort
+	* flag, after a block it adds the number of angles done. Projectors themselves may be
+	* shared between algorithms (see CProjectorCache), so this state does not live on them.
+	*/
+class CProjectionControl {
+
+public:
+
+	/** Progress callback, called with the number of angles done and the total.
+		*/
+	typedef std::function<void(int, int)> ProgressCallback;
+
+	/** Default constructor.
+		*/
+	CProjectionControl();
+
+	/** Ask the running projection to stop after the blocks that are in progress.
+		* The flag stays set until the next beginRun() or clearAbort().
+		*/
+	void signalAbort();
+
+	/** Ask the running projection to stop, like signalAbort(), and also the next run if it
+		* has not called beginRun() yet. For a run that is about to start on another thread.
+		*/
+	void signalAbortIncludingNextRun();
+
+	/** Clear the abort flags.
+		*/
+	void clearAbort();
+
+	/** Has an abort been signalled?
+		*/
+	bool shouldAbort() const;
+
+	/** Has an abort been signalled? If so, the caller stops its work, and the run is marked
+		* as stopped early (see stoppedEarly()).
+		*/
+	bool checkAbort();
+
+	/** Did the current (or last) run stop early because of an abort?
+		*/
+	bool stoppedEarly() const;
+
+	/** Start a run: reset the progress counters, and clear the abort flag that a previous
+		* run may have left, unless signalAbortIncludingNextRun() asked to abort this run.
+		*/
+	void beginRun();
+
+	/** Add _iCount angles to the amount of work.
+		*/
+	void addTotal(int _iCount);
+
+	/** Mark _iCount angles as done and call the progress callback, if any.
+		* Called from worker threads.
+		*/
+	void advance(int _iCount);
+
+	/** Get the number of angles done.
+		*/
+	int getDone() const;
+
+	/** Get the total number of angles.
+		*/
+	int getTotal() const;
+
+	/** Get the fraction of the work done, in [0, 1].
+		*/
+	float getProgress() const;
+
+	/** Set the progress callback. It is called from worker threads, after every block of
+		* angles, so it should be short. Must not be changed while a projection is running.
+		*/
+	void setProgressCallback(const ProgressCallback& _callback);
+
+private:
+
+	std::atomic<bool> m_bAbort;
+	std::atomic<bool> m_bAbortNextRun;
+	std::atomic<bool> m_bStoppedEarly;
+	std::atomic<int> m_iDone;
+	std::atomic<int> m_iTotal;
+	ProgressCallback m_callback;
+
+	CProjectionControl(const CProjectionControl&);
+	CProjectionControl& operator=(const CProjectionControl&);
+};
+
+// inline functions
+inline bool CProjectionControl::shouldAbort() const { return m_bAbort.load(std::memory_order_relaxed); }
+inline bool CProjectionControl::stoppedEarly() const { return m_bStoppedEarly.load(std::memory_order_relaxed); }
+inline int CProjectionControl::getDone() const { return m_iDone.load(std::memory_order_relaxed); }
+inline int CProjectionControl::getTotal() const { return m_iTotal.load(std::memory_order_relaxed); }
+
+#endif // _INC_ASTRA_PROJECTIONCONTROL
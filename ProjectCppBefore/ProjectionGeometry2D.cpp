@@ -37,6 +37,8 @@ void CProjectionGeometry2D::_clear()
 	m_iDetectorCount = 0;
 	m_fDetectorWidth = 0.0f;
 	m_pfProjectionAngles = NULL;
+	m_iFingerprint = 0;
+	m_iEqualityClass = 0;
 	m_bInitialized = false;
 }
 
@@ -51,9 +53,30 @@ void CProjectionGeometry2D::clear()
 		delete[] m_pfProjectionAngles;
 	}
 	m_pfProjectionAngles = NULL;
+	m_iFingerprint = 0;
+	m_iEqualityClass = 0;
 	m_bInitialized = false;
 }
 
+//----------------------------------------------------------------------------------------
+// Take over all members of another geometry.
+void CProjectionGeometry2D::_takeProjectionGeometry(CProjectionGeometry2D& _other)
+{
+	if (m_bInitialized) {
+		CProjectionGeometry2D::clear();
+	}
+
+	m_iProjectionAngleCount = _other.m_iProjectionAngleCount;
+	m_iDetectorCount = _other.m_iDetectorCount;
+	m_fDetectorWidth = _other.m_fDetectorWidth;
+	m_pfProjectionAngles = _other.m_pfProjectionAngles;
+	m_iFingerprint = _other.m_iFingerprint.load();
+	m_iEqualityClass = _other.m_iEqualityClass.load();
+	m_bInitialized = _other.m_bInitialized;
+
+	_other._clear();
+}
+
 //----------------------------------------------------------------------------------------
 // Check all variable values.
 bool CProjectionGeometry2D::_check()
@@ -85,6 +108,8 @@ bool CProjectionGeometry2D::_initialize(int _iProjectionAngleCount,
 	}
 
 	// copy parameters
+	m_iFingerprint = 0;
+	m_iEqualityClass = 0;
 	m_iProjectionAngleCount = _iProjectionAngleCount;
 	m_iDetectorCount = _iDetectorCount;
 	m_fDetectorWidth = _fDetectorWidth;
@@ -97,3 +122,33 @@ bool CProjectionGeometry2D::_initialize(int _iProjectionAngleCount,
 	return true;
 }
 //---------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------
+// Remember an equal geometry. Racing calls may leave a geometry in the class of either
+// partner, which are then all equal, so a class never holds geometries that differ.
+void CProjectionGeometry2D::_setKnownEqual(const CProjectionGeometry2D* _pGeom2) const
+{
+	static std::atomic<uint64_t> s_iNextEqualityClass(1);
+
+	uint64_t iClass = m_iEqualityClass.load(std::memory_order_relaxed);
+	if (iClass == 0)
+		iClass = _pGeom2->m_iEqualityClass.load(std::memory_order_relaxed);
+	if (iClass == 0)
+		iClass = s_iNextEqualityClass.fetch_add(1, std::memory_order_relaxed);
+	m_iEqualityClass.store(iClass, std::memory_order_relaxed);
+	_pGeom2->m_iEqualityClass.store(iClass, std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------
+// Add the common values to a fingerprint.
+void CProjectionGeometry2D::_fingerprint(CFingerprint& _fingerprint) const
+{
+	_fingerprint.add(m_iProjectionAngleCount);
+	_fingerprint.add(m_iDetectorCount);
+	_fingerprint.add(m_fDetectorWidth);
+	if (m_pfProjectionAngles) {
+		for (int i = 0; i < m_iProjectionAngleCount; ++i)
+			_fingerprint.add(m_pfProjectionAngles[i]);
+	}
+}
+//---------------------------------------------------------------------------------------
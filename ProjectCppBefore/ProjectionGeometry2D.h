@@ -2,7 +2,9 @@
 #define _INC_ASTRA_PROJECTIONGEOMETRY2D
 
 #include "Globals.h"
+#include "Fingerprint.h"
 
+#include <atomic>
 #include <string>
 #include <cmath>
 #include <vector>
@@ -37,6 +39,16 @@ protected:
 		*/
 	float* m_pfProjectionAngles;
 
+	/** Content hash of the geometry, see getFingerprint(). 0 if it has not been computed yet.
+		* Atomic, as const geometries of shared projectors compute it from several threads.
+		*/
+	mutable std::atomic<uint64_t> m_iFingerprint;
+
+	/** Geometries with the same nonzero equality class have been found equal by isEqual(),
+		* and have not changed since; see _isKnownEqual(). 0 if there are none.
+		*/
+	mutable std::atomic<uint64_t> m_iEqualityClass;
+
 	/** Default constructor. Sets all numeric member variables to 0 and all pointer member variables to NULL.
 		*
 		* If an object is constructed using this default constructor, it must always be followed by a call
@@ -72,6 +84,31 @@ protected:
 		*/
 	void _clear();
 
+	/** Take over all members of _other, including its projection angle array, leaving _other cleared.
+		* Used by the move constructors and move assignment operators of derived classes.
+		*/
+	void _takeProjectionGeometry(CProjectionGeometry2D& _other);
+
+	/** Add all values that define the geometry to _fingerprint. Derived classes add a type tag
+		* and their own values, and call this for the common ones.
+		*/
+	virtual void _fingerprint(CFingerprint& _fingerprint) const;
+
+	/** Forget the fingerprint and the geometries this one was found equal to. Must be called
+		* whenever a value that defines the geometry changes.
+		*/
+	void _resetFingerprint();
+
+	/** Has isEqual() found this geometry equal to _pGeom2 before? Lets isEqual() skip the
+		* comparison of all angles when the same pair is checked again, as every _check() does.
+		*/
+	bool _isKnownEqual(const CProjectionGeometry2D* _pGeom2) const;
+
+	/** Remember that isEqual() found this geometry equal to _pGeom2, by giving both the same
+		* equality class.
+		*/
+	void _setKnownEqual(const CProjectionGeometry2D* _pGeom2) const;
+
 	/** Initialization. Initializes an instance of the CProjectionGeometry2D class. If the object has been
 		* initialized before, the object is reinitialized and memory is freed and reallocated if necessary.
 		*
@@ -111,6 +148,14 @@ public:
 		*/
 	virtual bool isEqual(CProjectionGeometry2D*) const = 0;
 
+	/** Get a 64-bit content hash of the geometry. It is computed on first use and kept until
+		* the geometry changes, so geometries with different fingerprints differ, and are told apart
+		* in O(1). Equal fingerprints do not guarantee equal geometries, see isEqual().
+		*
+		* @return fingerprint, never 0
+		*/
+	uint64_t getFingerprint() const;
+
 	/** Get the number of projection angles.
 		*
 		* @return Number of projection angles
@@ -210,6 +255,38 @@ inline bool CProjectionGeometry2D::isInitialized() const
 }
 
 
+// Get the content hash.
+inline uint64_t CProjectionGeometry2D::getFingerprint() const
+{
+	ASTRA_ASSERT(m_bInitialized);
+	// threads that race here compute the same value
+	uint64_t iFingerprint = m_iFingerprint.load(std::memory_order_relaxed);
+	if (iFingerprint == 0) {
+		CFingerprint fingerprint;
+		_fingerprint(fingerprint);
+		iFingerprint = fingerprint.get();
+		m_iFingerprint.store(iFingerprint, std::memory_order_relaxed);
+	}
+	return iFingerprint;
+}
+
+// Forget the content hash and known equalities.
+inline void CProjectionGeometry2D::_resetFingerprint()
+{
+	m_iFingerprint = 0;
+	m_iEqualityClass = 0;
+}
+
+// Found equal before?
+inline bool CProjectionGeometry2D::_isKnownEqual(const CProjectionGeometry2D* _pGeom2) const
+{
+	if (_pGeom2 == this)
+		return true;
+	uint64_t iClass = m_iEqualityClass.load(std::memory_order_relaxed);
+	return iClass != 0 && iClass == _pGeom2->m_iEqualityClass.load(std::memory_order_relaxed);
+}
+
+
 // Get the number of detectors.
 inline int CProjectionGeometry2D::getDetectorCount() const
 {
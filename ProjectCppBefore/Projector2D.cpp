@@ -5,6 +5,11 @@
 #include "FanFlatVecProjectionGeometry2D.h"
 #include "SparseMatrixProjectionGeometry2D.h"
 #include "SparseMatrix.h"
+#include "RayWeightCache.h"
+#include "ThreadPool.h"
+#include "Instrumentation.h"
+
+#include <algorithm>
 
 
 //----------------------------------------------------------------------------------------
@@ -12,6 +17,8 @@
 CProjector2D::CProjector2D()
 {
 
+	m_iVolumeStride = 0;
+	m_pRayWeightCache = NULL;
 	m_bIsInitialized = false;
 }
 
@@ -21,6 +28,8 @@ CProjector2D::CProjector2D(CProjectionGeometry2D* _pProjectionGeometry, CVolumeG
 {
 	m_pProjectionGeometry = _pProjectionGeometry->clone();
 	m_pVolumeGeometry = _pVolumeGeometry->clone();
+	m_iVolumeStride = 0;
+	m_pRayWeightCache = NULL;
 	m_bIsInitialized = true;
 }
 
@@ -37,6 +46,8 @@ void CProjector2D::_clear()
 {
 	m_pProjectionGeometry = NULL;
 	m_pVolumeGeometry = NULL;
+	m_iVolumeStride = 0;
+	m_pRayWeightCache = NULL;
 	m_bIsInitialized = false;
 }
 
@@ -52,9 +63,36 @@ void CProjector2D::clear()
 		delete m_pVolumeGeometry;
 		m_pVolumeGeometry = NULL;
 	}
+	delete m_pRayWeightCache;
+	m_pRayWeightCache = NULL;
 	m_bIsInitialized = false;
 }
 
+//----------------------------------------------------------------------------------------
+// Volume stride, the volume indices of the cached weights depend on it
+void CProjector2D::setVolumeStride(int _iStride)
+{
+	if (m_pRayWeightCache && _iStride != m_iVolumeStride)
+		m_pRayWeightCache->clear();
+	m_iVolumeStride = _iStride;
+}
+
+//----------------------------------------------------------------------------------------
+// Ray weight cache
+void CProjector2D::setRayWeightCacheCapacity(size_t _iBytes)
+{
+	if (_iBytes == 0) {
+		delete m_pRayWeightCache;
+		m_pRayWeightCache = NULL;
+	}
+	else if (m_pRayWeightCache) {
+		m_pRayWeightCache->setCapacity(_iBytes);
+	}
+	else {
+		m_pRayWeightCache = new CRayWeightCache(this, _iBytes);
+	}
+}
+
 //---------------------------------------------------------------------------------------
 // Check
 bool CProjector2D::_check()
@@ -88,21 +126,71 @@ void CProjector2D::computeProjectionRayWeights(int _iProjection, SPixelWeight* _
 
 }
 
+//----------------------------------------------------------------------------------------
+// weights of each detector in a projection angle, compressed
+void CProjector2D::computeProjectionWeights(int _iProjection, SProjectionWeights& _weights)
+{
+	const int iDetectorCount = m_pProjectionGeometry->getDetectorCount();
+	const int iPixelBufferSize = getProjectionWeightsCount(_iProjection);
+	const int iBlockCount = (iDetectorCount + PROJECTION_WEIGHTS_BLOCK_SIZE - 1) / PROJECTION_WEIGHTS_BLOCK_SIZE;
+
+	// every block packs its rays on its own, then the blocks are put back to back
+	std::vector<std::vector<int> > blockIndices(iBlockCount);
+	std::vector<std::vector<float> > blockWeights(iBlockCount);
+	_weights.m_rayStarts.assign(iDetectorCount + 1, 0);
+
+	parallelFor(0, iBlockCount, 1, [&](int _iFrom, int _iTo) {
+		// one ray of the longest kind per task, so the block arrays only grow by stored weights
+		std::vector<int> rayIndices(iPixelBufferSize);
+		std::vector<float> rayWeights(iPixelBufferSize);
+		for (int iBlock = _iFrom; iBlock < _iTo; ++iBlock) {
+			std::vector<int>& indices = blockIndices[iBlock];
+			std::vector<float>& weights = blockWeights[iBlock];
+			const int iDetTo = std::min(iDetectorCount, (iBlock + 1) * PROJECTION_WEIGHTS_BLOCK_SIZE);
+			for (int iDetector = iBlock * PROJECTION_WEIGHTS_BLOCK_SIZE; iDetector < iDetTo; ++iDetector) {
+				int iCount = 0;
+				computeSingleRaySplitWeights(_iProjection, iDetector, &rayIndices[0], &rayWeights[0], iPixelBufferSize, iCount);
+				indices.insert(indices.end(), rayIndices.begin(), rayIndices.begin() + iCount);
+				weights.insert(weights.end(), rayWeights.begin(), rayWeights.begin() + iCount);
+				_weights.m_rayStarts[iDetector + 1] = iCount;
+			}
+		}
+	});
+
+	// ray counts to offsets
+	for (int iDetector = 0; iDetector < iDetectorCount; ++iDetector)
+		_weights.m_rayStarts[iDetector + 1] += _weights.m_rayStarts[iDetector];
+
+	const int iTotal = _weights.m_rayStarts[iDetectorCount];
+	_weights.m_indices.clear();
+	_weights.m_weights.clear();
+	_weights.m_indices.reserve(iTotal);
+	_weights.m_weights.reserve(iTotal);
+	for (int iBlock = 0; iBlock < iBlockCount; ++iBlock) {
+		_weights.m_indices.insert(_weights.m_indices.end(), blockIndices[iBlock].begin(), blockIndices[iBlock].end());
+		_weights.m_weights.insert(_weights.m_weights.end(), blockWeights[iBlock].begin(), blockWeights[iBlock].end());
+	}
+}
+
 //----------------------------------------------------------------------------------------
 // explicit projection matrix
 CSparseMatrix* CProjector2D::getMatrix()
 {
+	ASTRA_TIMER(STAGE_MATRIX);
+
+	// matrix columns are grid indices, so the volume rows must be back to back
+	if (getVolumeStride() != m_pVolumeGeometry->getGridColCount())
+		return 0;
+
 	unsigned int iProjectionCount = m_pProjectionGeometry->getProjectionAngleCount();
 	unsigned int iDetectorCount = m_pProjectionGeometry->getDetectorCount();
 	unsigned int iRayCount = iProjectionCount * iDetectorCount;
 	unsigned int iVolumeSize = m_pVolumeGeometry->getGridTotCount();
 	unsigned long lSize = 0;
-	unsigned int iMaxRayLength = 0;
+	std::vector<int> rayLengths(iProjectionCount);
 	for (unsigned int i = 0; i < iProjectionCount; ++i) {
-		unsigned int iRayLength = getProjectionWeightsCount(i);
-		lSize += iDetectorCount * iRayLength;
-		if (iRayLength > iMaxRayLength)
-			iMaxRayLength = iRayLength;
+		rayLengths[i] = getProjectionWeightsCount(i);
+		lSize += iDetectorCount * rayLengths[i];
 	}
 	CSparseMatrix* pMatrix = new CSparseMatrix(iRayCount, iVolumeSize, lSize);
 
@@ -111,25 +199,20 @@ CSparseMatrix* CProjector2D::getMatrix()
 		return 0;
 	}
 
-	SPixelWeight* pEntries = new SPixelWeight[iMaxRayLength];
+	// the rows are written in place, the room left is at least the longest ray of the angle;
+	// the column indices are unsigned, which may be written through a signed pointer
 	unsigned long lMatrixIndex = 0;
 	for (unsigned int iRay = 0; iRay < iRayCount; ++iRay) {
 		pMatrix->m_plRowStarts[iRay] = lMatrixIndex;
 		int iPixelCount;
 		int iProjIndex, iDetIndex;
 		m_pProjectionGeometry->indexToAngleDetectorIndex(iRay, iProjIndex, iDetIndex);
-		computeSingleRayWeights(iProjIndex, iDetIndex, pEntries, iMaxRayLength, iPixelCount);
-
-		for (int i = 0; i < iPixelCount; ++i) {
-			pMatrix->m_piColIndices[lMatrixIndex] = pEntries[i].m_iIndex;
-			pMatrix->m_pfValues[lMatrixIndex] = pEntries[i].m_fWeight;
-			++lMatrixIndex;
-		}
-
+		computeSingleRaySplitWeights(iProjIndex, iDetIndex, (int*)&pMatrix->m_piColIndices[lMatrixIndex],
+			&pMatrix->m_pfValues[lMatrixIndex], rayLengths[iProjIndex], iPixelCount);
+		lMatrixIndex += iPixelCount;
 	}
 	pMatrix->m_plRowStarts[iRayCount] = lMatrixIndex;
 
-	delete[] pEntries;
 	return pMatrix;
 }
 
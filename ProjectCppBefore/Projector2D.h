@@ -12,6 +12,25 @@
 
 
 class CSparseMatrix;
+class CRayWeightCache;
+
+
+/**
+	* The pixel weights of all rays of one projection angle in compressed row form, without
+	* empty slots: the weights of detector d are entries m_rayStarts[d] up to
+	* m_rayStarts[d + 1] of m_indices and m_weights, in the order in which the projector
+	* visits them.
+	*/
+struct SProjectionWeights
+{
+	std::vector<int> m_rayStarts;		///< detector count + 1 offsets
+	std::vector<int> m_indices;			///< volume index of every weight
+	std::vector<float> m_weights;		///< weights of all rays, back to back
+
+	/** Memory taken by the weights, in bytes.
+		*/
+	size_t getMemorySize() const;
+};
 
 
 /** This is a base interface class for a two-dimensional projector.  Each subclass should at least
@@ -30,6 +49,8 @@ protected:
 	CProjectionGeometry2D* m_pProjectionGeometry; ///< Used projection geometry
 	CVolumeGeometry2D* m_pVolumeGeometry; ///< Used volume geometry
 	bool m_bIsInitialized; ///< Has this class been initialized?
+	int m_iVolumeStride; ///< Distance between two volume rows in the volume data, 0 = grid column count
+	CRayWeightCache* m_pRayWeightCache; ///< Weights of recently projected angles, NULL if disabled. Owned.
 
 	/** Default Constructor.
 		*/
@@ -75,6 +96,37 @@ public:
 		*/
 	CVolumeGeometry2D* getVolumeGeometry();
 
+	/** Set the distance in floats between two volume rows in the volume data that is projected,
+		* for volume data that is a view into a larger block (see CFloat32VolumeData2DView).
+		* Volume indices passed to the policies are then row * stride + column. All volume data used
+		* in the same projection (masks, weights) must have this stride.
+		*
+		* @param _iStride row stride, 0 to use the grid column count (the default)
+		*/
+	void setVolumeStride(int _iStride);
+
+	/** Get the distance in floats between two volume rows in the volume data that is projected.
+		*
+		* @return row stride of the volume data
+		*/
+	int getVolumeStride() const;
+
+	/** Keep the pixel weights of recently projected angles in a cache of at most _iBytes
+		* bytes (see CRayWeightCache). Data projectors with float stepping policies then take
+		* the weights of an angle from the cache instead of tracing its rays, which pays off
+		* for algorithms that project the same angles over and over. Off by default. Not to be
+		* called while the projector is in use, or on projectors shared by a CProjectorCache.
+		*
+		* @param _iBytes capacity of the cache in bytes, 0 to release the cache
+		*/
+	void setRayWeightCacheCapacity(size_t _iBytes);
+
+	/** Get the ray weight cache.
+		*
+		* @return cache, NULL if disabled
+		*/
+	CRayWeightCache* getRayWeightCache() const;
+
 	/** Compute the pixel weights for a single ray, from the source to a detector pixel.
 		*
 		* @param _iProjectionIndex	Index of the projection
@@ -93,6 +145,25 @@ public:
 		int _iMaxPixelCount,
 		int& _iStoredPixelCount) = 0;
 
+	/** Compute the pixel weights for a single ray, with the volume indices and the weights
+		* stored in separate arrays instead of interleaved in SPixelWeight elements. Rows of
+		* a CSparseMatrix, or of SProjectionWeights, are written in place this way.
+		*
+		* @param _iProjectionIndex	Index of the projection
+		* @param _iDetectorIndex	Index of the detector pixel
+		* @param _piIndices			Pointer to a pre-allocated array of _iMaxPixelCount volume indices.
+		* @param _pfWeights			Pointer to a pre-allocated array of _iMaxPixelCount weights.
+		* @param _iMaxPixelCount	Maximum number of pixels (and corresponding weights) that can be stored.
+		*							This number MUST be greater than the total number of pixels on the ray.
+		* @param _iStoredPixelCount On return, this variable contains the total number of pixels on the ray.
+		*/
+	virtual void computeSingleRaySplitWeights(int _iProjectionIndex,
+		int _iDetectorIndex,
+		int* _piIndices,
+		float* _pfWeights,
+		int _iMaxPixelCount,
+		int& _iStoredPixelCount) = 0;
+
 	/** Compute the pixel weights for all rays in a single projection, from the source to a each of the
 		* detector pixels. All pixels and their weights are stored consecutively in the array _pWeightedPixels.
 		* The array starts with all pixels on the first ray, followed by all pixels on the second ray, the third
@@ -111,6 +182,21 @@ public:
 		SPixelWeight* _pfWeightedPixels,
 		int* _piRayStoredPixelCount);
 
+	/** Detectors per task of computeProjectionWeights().
+		*/
+	static const int PROJECTION_WEIGHTS_BLOCK_SIZE = 32;
+
+	/** Compute the pixel weights for all rays in a single projection, in compressed row form.
+		* Only the weights themselves are stored, so the memory is independent of
+		* getProjectionWeightsCount(). The rays are computed in blocks of
+		* PROJECTION_WEIGHTS_BLOCK_SIZE detectors in parallel on the CThreadPool; the result is
+		* the same as computing them one after the other.
+		*
+		* @param _iProjectionIndex Index of the projection (zero-based).
+		* @param _weights On return, the weights of all rays of the projection.
+		*/
+	virtual void computeProjectionWeights(int _iProjectionIndex, SProjectionWeights& _weights);
+
 	/** Returns the number of weights required for storage of all weights of one projection ray.
 		*
 		* @param _iProjectionIndex Index of the projection (zero-based).
@@ -119,7 +205,9 @@ public:
 	virtual int getProjectionWeightsCount(int _iProjectionIndex) = 0;
 
 	/** Returns the projection as an explicit sparse matrix.
-		* @return a newly allocated CSparseMatrix. Delete afterwards.
+		* @return a newly allocated CSparseMatrix. Delete afterwards. NULL if the allocation
+		*         fails, or if the projector is set up for a volume view (a row stride other
+		*         than the grid width).
 		*/
 	CSparseMatrix* getMatrix();
 
@@ -141,9 +229,12 @@ private:
 };
 
 // inline functions
+inline size_t SProjectionWeights::getMemorySize() const { return sizeof(SProjectionWeights) + (m_rayStarts.capacity() + m_indices.capacity()) * sizeof(int) + m_weights.capacity() * sizeof(float); }
 inline bool CProjector2D::isInitialized() const { return m_bIsInitialized; }
 inline CProjectionGeometry2D* CProjector2D::getProjectionGeometry() { return m_pProjectionGeometry; }
 inline CVolumeGeometry2D* CProjector2D::getVolumeGeometry() { return m_pVolumeGeometry; }
+inline CRayWeightCache* CProjector2D::getRayWeightCache() const { return m_pRayWeightCache; }
+inline int CProjector2D::getVolumeStride() const { return (m_iVolumeStride > 0) ? m_iVolumeStride : m_pVolumeGeometry->getGridColCount(); }
 
 
 #endif /* INC_ASTRA_PROJECTOR2D */
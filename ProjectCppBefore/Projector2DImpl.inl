@@ -3,7 +3,11 @@
 //#include "ParallelBeamLineKernelProjector2D.inl"
 //#include "ParallelBeamStripKernelProjector2D.inl"
 //#include "ParallelBeamBlobKernelProjector2D.inl"
-//#include "FanFlatBeamStripKernelProjector2D.inl"
 #include "FanFlatBeamLineKernelProjector2D.inl"
+#include "FanFlatBeamSiddonKernelProjector2D.inl"
+#include "FanFlatBeamJosephKernelProjector2D.inl"
+#include "FanFlatBeamDistanceDrivenProjector2D.inl"
+#include "FanFlatBeamStripKernelProjector2D.inl"
+#include "FanFlatBeamBlobKernelProjector2D.inl"
 //#include "SparseMatrixProjector2D.inl"
 
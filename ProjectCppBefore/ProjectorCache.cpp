@@ -0,0 +1,180 @@
+#include "ProjectorCache.h"
+
+#include <cstring>
+
+
+DEFINE_SINGLETON(CProjectorCache)
+
+
+//----------------------------------------------------------------------------------------
+// Constructor
+CProjectorCache::CProjectorCache()
+{
+	memset(&m_stats, 0, sizeof(m_stats));
+	m_iCapacity = DEFAULT_CAPACITY;
+}
+
+//----------------------------------------------------------------------------------------
+// Destructor
+CProjectorCache::~CProjectorCache()
+{
+	clear();
+}
+
+//----------------------------------------------------------------------------------------
+// Find or create an entry
+std::shared_ptr<CProjectorCache::SEntry> CProjectorCache::_getEntry(CFanFlatProjectionGeometry2D* _pProjectionGeometry,
+	CVolumeGeometry2D* _pVolumeGeometry)
+{
+	ASTRA_ASSERT(_pProjectionGeometry && _pProjectionGeometry->isInitialized());
+	ASTRA_ASSERT(_pVolumeGeometry && _pVolumeGeometry->isInitialized());
+
+	SKey key;
+	key.m_sType = CFanFlatBeamLineKernelProjector2D::type;
+	key.m_iProjectionFingerprint = _pProjectionGeometry->getFingerprint();
+	key.m_iVolumeFingerprint = _pVolumeGeometry->getFingerprint();
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stats.iRequests++;
+		std::shared_ptr<SEntry> pEntry = _findEntry(key, _pProjectionGeometry, _pVolumeGeometry);
+		if (pEntry) {
+			m_stats.iHits++;
+			return pEntry;
+		}
+		m_stats.iMisses++;
+	}
+
+	// built outside the lock, so other entries stay available meanwhile
+	std::shared_ptr<CFanFlatBeamLineKernelProjector2D> pProjector(new CFanFlatBeamLineKernelProjector2D(_pProjectionGeometry, _pVolumeGeometry));
+	if (!pProjector->isInitialized()) {
+		return std::shared_ptr<SEntry>();
+	}
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	// another thread built the same projector meanwhile
+	std::shared_ptr<SEntry> pEntry = _findEntry(key, _pProjectionGeometry, _pVolumeGeometry);
+	if (pEntry)
+		return pEntry;
+
+	pEntry.reset(new SEntry());
+	pEntry->m_pProjector = pProjector;
+	m_lru.push_front(key);
+	pEntry->m_lruPosition = m_lru.begin();
+	m_entries[key] = pEntry;
+	_evict();
+	m_stats.iEntries = m_entries.size();
+	return pEntry;
+}
+
+//----------------------------------------------------------------------------------------
+// Look up an entry
+std::shared_ptr<CProjectorCache::SEntry> CProjectorCache::_findEntry(const SKey& _key,
+	CFanFlatProjectionGeometry2D* _pProjectionGeometry, CVolumeGeometry2D* _pVolumeGeometry)
+{
+	std::map<SKey, std::shared_ptr<SEntry> >::iterator i = m_entries.find(_key);
+	if (i == m_entries.end())
+		return std::shared_ptr<SEntry>();
+
+	// equal fingerprints do not guarantee equal geometries; isEqual() compares all values
+	std::shared_ptr<SEntry> pEntry = i->second;
+	if (pEntry->m_pProjector->getProjectionGeometry()->isEqual(_pProjectionGeometry) &&
+		pEntry->m_pProjector->getVolumeGeometry()->isEqual(_pVolumeGeometry)) {
+		m_lru.splice(m_lru.begin(), m_lru, pEntry->m_lruPosition);
+		return pEntry;
+	}
+
+	// a fingerprint collision, the entry makes room for the new geometries
+	m_lru.erase(pEntry->m_lruPosition);
+	m_entries.erase(i);
+	m_stats.iEntries = m_entries.size();
+	return std::shared_ptr<SEntry>();
+}
+
+//----------------------------------------------------------------------------------------
+// Get projector
+std::shared_ptr<CFanFlatBeamLineKernelProjector2D> CProjectorCache::getProjector(CFanFlatProjectionGeometry2D* _pProjectionGeometry,
+	CVolumeGeometry2D* _pVolumeGeometry)
+{
+	std::shared_ptr<SEntry> pEntry = _getEntry(_pProjectionGeometry, _pVolumeGeometry);
+	if (!pEntry)
+		return std::shared_ptr<CFanFlatBeamLineKernelProjector2D>();
+	return pEntry->m_pProjector;
+}
+
+//----------------------------------------------------------------------------------------
+// Get system matrix
+std::shared_ptr<const CSparseMatrix> CProjectorCache::getSystemMatrix(CFanFlatProjectionGeometry2D* _pProjectionGeometry,
+	CVolumeGeometry2D* _pVolumeGeometry)
+{
+	std::shared_ptr<SEntry> pEntry = _getEntry(_pProjectionGeometry, _pVolumeGeometry);
+	if (!pEntry)
+		return std::shared_ptr<const CSparseMatrix>();
+
+	// computed outside the cache lock, so other entries stay available meanwhile
+	SEntry* p = pEntry.get();
+	std::call_once(p->m_matrixOnce, [this, p]() {
+		p->m_pMatrix.reset(p->m_pProjector->getMatrix());
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stats.iMatricesBuilt++;
+	});
+	return pEntry->m_pMatrix;
+}
+
+//----------------------------------------------------------------------------------------
+// Drop entries beyond the capacity
+void CProjectorCache::_evict()
+{
+	while (m_entries.size() > m_iCapacity) {
+		m_entries.erase(m_lru.back());
+		m_lru.pop_back();
+		m_stats.iEvictions++;
+	}
+}
+
+//----------------------------------------------------------------------------------------
+// Clear
+void CProjectorCache::clear()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_entries.clear();
+	m_lru.clear();
+	m_stats.iEntries = 0;
+}
+
+//----------------------------------------------------------------------------------------
+// Set capacity
+void CProjectorCache::setCapacity(size_t _iCapacity)
+{
+	ASTRA_ASSERT(_iCapacity > 0);
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_iCapacity = _iCapacity;
+	_evict();
+	m_stats.iEntries = m_entries.size();
+}
+
+//----------------------------------------------------------------------------------------
+// Get capacity
+size_t CProjectorCache::getCapacity() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_iCapacity;
+}
+
+//----------------------------------------------------------------------------------------
+// Get statistics
+SProjectorCacheStatistics CProjectorCache::getStatistics() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_stats;
+}
+
+//----------------------------------------------------------------------------------------
+// Reset statistics
+void CProjectorCache::resetStatistics()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	memset(&m_stats, 0, sizeof(m_stats));
+	m_stats.iEntries = m_entries.size();
+}
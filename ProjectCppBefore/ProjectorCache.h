@@ -0,0 +1,166 @@
+#ifndef _INC_ASTRA_PROJECTORCACHE
+#define _INC_ASTRA_PROJECTORCACHE
+
+#include "Globals.h"
+#include "Singleton.h"
+#include "FanFlatBeamLineKernelProjector2D.h"
+#include "SparseMatrix.h"
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdint.h>
+#include <string>
+
+
+/**
+	* Counters of a CProjectorCache.
+	*/
+struct SProjectorCacheStatistics
+{
+	size_t iRequests;			///< number of projector or matrix requests
+	size_t iHits;				///< requests served by an existing entry
+	size_t iMisses;				///< requests that created a new entry
+	size_t iEvictions;			///< entries dropped because the cache was full
+	size_t iMatricesBuilt;		///< system matrices computed
+	size_t iEntries;			///< entries currently in the cache
+};
+
+
+/**
+	* Process-wide cache of initialized projectors, keyed by the fingerprints of their
+	* projection and volume geometry (see CProjectionGeometry2D::getFingerprint()).
+	*
+	* Building a projector copies both geometries and precomputes the vector form of the
+	* projection geometry; a service that sees the same few geometries over and over only
+	* pays for this once per geometry pair. The system matrix of an entry is built on the
+	* first request for it.
+	*
+	* Returned projectors are shared between all callers and must be treated as immutable:
+	* do not call initialize(), clear(), setVolumeStride() or setRayWeightCacheCapacity() on
+	* them. setRayTableEnabled() is the one exception, it swaps the table safely under running
+	* projections. Projecting with them from several threads at once is fine. Entries stay
+	* valid for as long as a caller holds them, also after they have been evicted or the
+	* cache has been cleared.
+	*/
+class CProjectorCache : public Singleton<CProjectorCache> {
+
+public:
+
+	/** Default capacity, in entries.
+		*/
+	static const size_t DEFAULT_CAPACITY = 64;
+
+	/** Default constructor.
+		*/
+	CProjectorCache();
+
+	/** Destructor.
+		*/
+	virtual ~CProjectorCache();
+
+	/** Get the shared projector for a pair of geometries, creating it if it is not cached.
+		*
+		* @param _pProjectionGeometry	projection geometry, is copied on a miss
+		* @param _pVolumeGeometry		volume geometry, is copied on a miss
+		* @return the projector, empty if it could not be initialized with these geometries
+		*/
+	std::shared_ptr<CFanFlatBeamLineKernelProjector2D> getProjector(CFanFlatProjectionGeometry2D* _pProjectionGeometry,
+		CVolumeGeometry2D* _pVolumeGeometry);
+
+	/** Get the shared system matrix for a pair of geometries. The matrix is computed once per
+		* entry; concurrent first requests for the same entry wait for a single computation.
+		*
+		* @param _pProjectionGeometry	projection geometry
+		* @param _pVolumeGeometry		volume geometry
+		* @return the matrix, empty if the projector or the matrix could not be created
+		*/
+	std::shared_ptr<const CSparseMatrix> getSystemMatrix(CFanFlatProjectionGeometry2D* _pProjectionGeometry,
+		CVolumeGeometry2D* _pVolumeGeometry);
+
+	/** Drop all entries. Projectors and matrices still held by callers stay valid.
+		*/
+	void clear();
+
+	/** Set the maximum number of entries. The least recently used entries are dropped
+		* when the cache grows beyond it.
+		*
+		* @param _iCapacity maximum number of entries, must be > 0
+		*/
+	void setCapacity(size_t _iCapacity);
+
+	/** Get the maximum number of entries.
+		*/
+	size_t getCapacity() const;
+
+	/** Get a snapshot of the counters.
+		*/
+	SProjectorCacheStatistics getStatistics() const;
+
+	/** Reset all counters, except iEntries.
+		*/
+	void resetStatistics();
+
+protected:
+
+	/** Cache key: projector type and the fingerprints of both geometries.
+		*/
+	struct SKey
+	{
+		std::string m_sType;
+		uint64_t m_iProjectionFingerprint;
+		uint64_t m_iVolumeFingerprint;
+
+		bool operator<(const SKey& _other) const;
+	};
+
+	/** One cached projector and its lazily built system matrix.
+		*/
+	struct SEntry
+	{
+		std::shared_ptr<CFanFlatBeamLineKernelProjector2D> m_pProjector;
+		std::shared_ptr<const CSparseMatrix> m_pMatrix;
+		std::once_flag m_matrixOnce;
+		std::list<SKey>::iterator m_lruPosition;
+	};
+
+	/** Find or create the entry for a pair of geometries. Takes the lock, but builds a new
+		* projector without it.
+		*/
+	std::shared_ptr<SEntry> _getEntry(CFanFlatProjectionGeometry2D* _pProjectionGeometry,
+		CVolumeGeometry2D* _pVolumeGeometry);
+
+	/** Find the entry for a key and confirm that it has these geometries. An entry with the
+		* same key but other geometries is dropped. Lock must be held.
+		*/
+	std::shared_ptr<SEntry> _findEntry(const SKey& _key, CFanFlatProjectionGeometry2D* _pProjectionGeometry,
+		CVolumeGeometry2D* _pVolumeGeometry);
+
+	/** Drop least recently used entries until the capacity is respected. Lock must be held.
+		*/
+	void _evict();
+
+	mutable std::mutex m_mutex;
+	std::map<SKey, std::shared_ptr<SEntry> > m_entries;
+	std::list<SKey> m_lru;			///< keys, most recently used first
+	size_t m_iCapacity;
+	SProjectorCacheStatistics m_stats;
+};
+
+//----------------------------------------------------------------------------------------
+// Inline member functions
+//----------------------------------------------------------------------------------------
+
+// Compare keys.
+inline bool CProjectorCache::SKey::operator<(const SKey& _other) const
+{
+	if (m_iProjectionFingerprint != _other.m_iProjectionFingerprint)
+		return m_iProjectionFingerprint < _other.m_iProjectionFingerprint;
+	if (m_iVolumeFingerprint != _other.m_iVolumeFingerprint)
+		return m_iVolumeFingerprint < _other.m_iVolumeFingerprint;
+	return m_sType < _other.m_sType;
+}
+
+#endif // _INC_ASTRA_PROJECTORCACHE
@@ -7,9 +7,19 @@
 // Projector2D
 #include "Projector2D.h"
 #include "FanFlatBeamLineKernelProjector2D.h"
+#include "FanFlatBeamSiddonKernelProjector2D.h"
+#include "FanFlatBeamJosephKernelProjector2D.h"
+#include "FanFlatBeamDistanceDrivenProjector2D.h"
+#include "FanFlatBeamStripKernelProjector2D.h"
+#include "FanFlatBeamBlobKernelProjector2D.h"
 
-typedef TYPELIST_1(
-	CFanFlatBeamLineKernelProjector2D)
+typedef TYPELIST_6(
+	CFanFlatBeamLineKernelProjector2D,
+	CFanFlatBeamSiddonKernelProjector2D,
+	CFanFlatBeamJosephKernelProjector2D,
+	CFanFlatBeamDistanceDrivenProjector2D,
+	CFanFlatBeamStripKernelProjector2D,
+	CFanFlatBeamBlobKernelProjector2D)
 	Projector2DTypeList;
 
 
@@ -0,0 +1,127 @@
+#include "RayWeightCache.h"
+
+#include <cstring>
+
+
+//----------------------------------------------------------------------------------------
+// Constructor
+CRayWeightCache::CRayWeightCache(CProjector2D* _pProjector, size_t _iCapacity)
+{
+	memset(&m_stats, 0, sizeof(m_stats));
+	m_pProjector = _pProjector;
+	m_iCapacity = _iCapacity;
+}
+
+//----------------------------------------------------------------------------------------
+// Destructor
+CRayWeightCache::~CRayWeightCache()
+{
+	clear();
+}
+
+//----------------------------------------------------------------------------------------
+// Get the weights of a projection angle
+std::shared_ptr<const SProjectionWeights> CRayWeightCache::getProjectionWeights(int _iProjection)
+{
+	ASTRA_ASSERT(m_pProjector && m_pProjector->isInitialized());
+	ASTRA_ASSERT(_iProjection >= 0 && _iProjection < m_pProjector->getProjectionGeometry()->getProjectionAngleCount());
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stats.iRequests++;
+
+		std::map<int, SEntry>::iterator i = m_entries.find(_iProjection);
+		if (i != m_entries.end()) {
+			m_lru.splice(m_lru.begin(), m_lru, i->second.m_lruPosition);
+			m_stats.iHits++;
+			return i->second.m_pWeights;
+		}
+		m_stats.iMisses++;
+	}
+
+	// computed outside the lock, so other angles stay available meanwhile
+	std::shared_ptr<SProjectionWeights> pWeights(new SProjectionWeights());
+	m_pProjector->computeProjectionWeights(_iProjection, *pWeights);
+	const size_t iBytes = pWeights->getMemorySize();
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	// another thread computed the same angle meanwhile
+	std::map<int, SEntry>::iterator i = m_entries.find(_iProjection);
+	if (i != m_entries.end())
+		return i->second.m_pWeights;
+
+	if (iBytes <= m_iCapacity) {
+		SEntry& entry = m_entries[_iProjection];
+		entry.m_pWeights = pWeights;
+		entry.m_iBytes = iBytes;
+		m_lru.push_front(_iProjection);
+		entry.m_lruPosition = m_lru.begin();
+		m_stats.iBytes += iBytes;
+		_evict();
+		m_stats.iEntries = m_entries.size();
+	}
+	return pWeights;
+}
+
+//----------------------------------------------------------------------------------------
+// Drop entries beyond the capacity
+void CRayWeightCache::_evict()
+{
+	while (m_stats.iBytes > m_iCapacity) {
+		std::map<int, SEntry>::iterator i = m_entries.find(m_lru.back());
+		m_stats.iBytes -= i->second.m_iBytes;
+		m_entries.erase(i);
+		m_lru.pop_back();
+		m_stats.iEvictions++;
+	}
+}
+
+//----------------------------------------------------------------------------------------
+// Clear
+void CRayWeightCache::clear()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_entries.clear();
+	m_lru.clear();
+	m_stats.iEntries = 0;
+	m_stats.iBytes = 0;
+}
+
+//----------------------------------------------------------------------------------------
+// Set capacity
+void CRayWeightCache::setCapacity(size_t _iCapacity)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_iCapacity = _iCapacity;
+	_evict();
+	m_stats.iEntries = m_entries.size();
+}
+
+//----------------------------------------------------------------------------------------
+// Get capacity
+size_t CRayWeightCache::getCapacity() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_iCapacity;
+}
+
+//----------------------------------------------------------------------------------------
+// Get statistics
+SRayWeightCacheStatistics CRayWeightCache::getStatistics() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_stats;
+}
+
+//----------------------------------------------------------------------------------------
+// Reset statistics
+void CRayWeightCache::resetStatistics()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	size_t iEntries = m_entries.size();
+	size_t iBytes = m_stats.iBytes;
+	memset(&m_stats, 0, sizeof(m_stats));
+	m_stats.iEntries = iEntries;
+	m_stats.iBytes = iBytes;
+}
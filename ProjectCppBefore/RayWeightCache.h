@@ -0,0 +1,145 @@
+#ifndef _INC_ASTRA_RAYWEIGHTCACHE
+#define _INC_ASTRA_RAYWEIGHTCACHE
+
+#include "Globals.h"
+#include "Projector2D.h"
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+
+/**
+	* Counters of a CRayWeightCache.
+	*/
+struct SRayWeightCacheStatistics
+{
+	size_t iRequests;			///< number of projection angle requests
+	size_t iHits;				///< requests served by a cached angle
+	size_t iMisses;				///< requests that computed the weights
+	size_t iEvictions;			///< angles dropped because the cache was full
+	size_t iEntries;			///< angles currently in the cache
+	size_t iBytes;				///< memory taken by the cached angles
+};
+
+
+/**
+	* Cache of the pixel weights of recently projected angles of a projector, bounded in
+	* bytes. Iterative algorithms project the same angles in every iteration; with the cache,
+	* the rays of an angle are traced once and the following projections only read back their
+	* weights (see projectCachedWeights()). This trades memory for compute without building
+	* the whole system matrix: a capacity of a few angles already serves the subsets of an
+	* ordered subsets method, a capacity of all angles holds the matrix one angle at a time.
+	*
+	* The cache belongs to a projector (see CProjector2D::setRayWeightCacheCapacity()) and is
+	* cleared when its geometries or volume stride change. It can be used by several threads
+	* at once; the weights of a missing angle are computed outside the lock.
+	*/
+class CRayWeightCache {
+
+public:
+
+	/** Constructor.
+		*
+		* @param _pProjector		projector whose weights are cached, not owned
+		* @param _iCapacity		maximum memory taken by the cached weights, in bytes
+		*/
+	CRayWeightCache(CProjector2D* _pProjector, size_t _iCapacity);
+
+	/** Destructor.
+		*/
+	~CRayWeightCache();
+
+	/** Get the weights of all rays of a projection angle, computing them if they are not
+		* cached. The least recently used angles are dropped to make room for them; an angle
+		* larger than the whole capacity is returned without being cached.
+		*
+		* @param _iProjection	index of the projection angle
+		* @return the weights, valid for as long as the caller holds them
+		*/
+	std::shared_ptr<const SProjectionWeights> getProjectionWeights(int _iProjection);
+
+	/** Drop all cached angles. Weights still held by callers stay valid.
+		*/
+	void clear();
+
+	/** Set the maximum memory taken by the cached weights, dropping the least recently
+		* used angles if needed.
+		*
+		* @param _iCapacity capacity in bytes
+		*/
+	void setCapacity(size_t _iCapacity);
+
+	/** Get the maximum memory taken by the cached weights, in bytes.
+		*/
+	size_t getCapacity() const;
+
+	/** Get a snapshot of the counters.
+		*/
+	SRayWeightCacheStatistics getStatistics() const;
+
+	/** Reset all counters, except iEntries and iBytes.
+		*/
+	void resetStatistics();
+
+protected:
+
+	/** One cached angle.
+		*/
+	struct SEntry
+	{
+		std::shared_ptr<const SProjectionWeights> m_pWeights;
+		size_t m_iBytes;
+		std::list<int>::iterator m_lruPosition;
+	};
+
+	/** Drop least recently used angles until the capacity is respected. Lock must be held.
+		*/
+	void _evict();
+
+	CProjector2D* m_pProjector;
+
+	mutable std::mutex m_mutex;
+	std::map<int, SEntry> m_entries;
+	std::list<int> m_lru;			///< projection angles, most recently used first
+	size_t m_iCapacity;
+	SRayWeightCacheStatistics m_stats;
+};
+
+
+/**
+	* Project the rays of one projection angle with cached weights. The policy sees the same
+	* calls, in the same order, as when the projector traces the rays with float stepping.
+	*
+	* @param _weights		weights of the projection angle
+	* @param _iProjection	index of the projection angle
+	* @param p				policy object
+	*/
+template <typename Policy>
+void projectCachedWeights(const SProjectionWeights& _weights, int _iProjection, Policy& p)
+{
+	const int iDetectorCount = (int)_weights.m_rayStarts.size() - 1;
+	const int* piIndices = _weights.m_indices.empty() ? NULL : &_weights.m_indices[0];
+	const float* pfWeights = _weights.m_weights.empty() ? NULL : &_weights.m_weights[0];
+
+	for (int iDetector = 0; iDetector < iDetectorCount; ++iDetector) {
+		int iRayIndex = _iProjection * iDetectorCount + iDetector;
+
+		if (!p.rayPrior(iRayIndex)) continue;
+
+		for (int i = _weights.m_rayStarts[iDetector]; i < _weights.m_rayStarts[iDetector + 1]; ++i) {
+			int iVolumeIndex = piIndices[i];
+			if (p.pixelPrior(iVolumeIndex)) {
+				p.addWeight(iRayIndex, iVolumeIndex, pfWeights[i]);
+				p.pixelPosterior(iVolumeIndex);
+			}
+		}
+
+		p.rayPosterior(iRayIndex);
+	}
+}
+
+#endif // _INC_ASTRA_RAYWEIGHTCACHE
@@ -1,7 +1,9 @@
 #ifndef _INC_ASTRA_SINGLETON
 #define _INC_ASTRA_SINGLETON
 
+#include <atomic>
 #include <cassert>
+#include <mutex>
 
 #ifndef _MSC_VER
 #include <stdint.h>
@@ -9,6 +11,9 @@
 
 /**
 	* This singleton interface class ensures that any of its children can be instatiated only once. This is used by the ObjectFactories.
+	*
+	* The first call to getSingleton() constructs the instance; concurrent first calls from several
+	* threads construct it exactly once. After that, getSingleton() is a single atomic load.
 	**/
 template<typename T>
 class Singleton {
@@ -20,28 +25,32 @@ public:
 
 	// destructor
 	virtual ~Singleton() {
-		assert(m_singleton);
-		m_singleton = 0;
+		assert(m_singleton.load());
+		m_singleton.store(0);
 	}
 
 	static void construct();
 
 	// get singleton
 	static T& getSingleton() {
-		if (!m_singleton)
-			construct();
-		return *m_singleton;
+		return *getSingletonPtr();
 	}
 	static T* getSingletonPtr() {
-		if (!m_singleton)
-			construct();
-		return m_singleton;
+		T* p = m_singleton.load(std::memory_order_acquire);
+		if (!p) {
+			std::call_once(m_constructed, &Singleton<T>::construct);
+			p = m_singleton.load(std::memory_order_acquire);
+		}
+		return p;
 	}
 
 private:
 
 	// the singleton
-	static T* m_singleton;
+	static std::atomic<T*> m_singleton;
+
+	// guards the construction
+	static std::once_flag m_constructed;
 
 };
 
@@ -53,15 +62,17 @@ private:
 // libastra. This situation would cause issues when .mex files are unloaded.
 
 #define DEFINE_SINGLETON(T) \
-template<> T* Singleton<T >::m_singleton = 0; \
-template<> void Singleton<T >::construct() { assert(!m_singleton); m_singleton = new T(); }
+template<> std::atomic<T*> Singleton<T >::m_singleton(0); \
+template<> std::once_flag Singleton<T >::m_constructed{}; \
+template<> void Singleton<T >::construct() { assert(!m_singleton.load()); m_singleton.store(new T(), std::memory_order_release); }
 
 
 // This is a hack to support statements like
 // DEFINE_SINGLETON2(CTemplatedClass<C1, C2>);
 #define DEFINE_SINGLETON2(A,B) \
-template<> A,B* Singleton<A,B >::m_singleton = 0; \
-template<> void Singleton<A,B >::construct() { assert(!m_singleton); m_singleton = new A,B(); }
+template<> std::atomic<A,B*> Singleton<A,B >::m_singleton(0); \
+template<> std::once_flag Singleton<A,B >::m_constructed{}; \
+template<> void Singleton<A,B >::construct() { assert(!m_singleton.load()); m_singleton.store(new A,B(), std::memory_order_release); }
 
 
 #endif
@@ -0,0 +1,216 @@
+#include "SliceStackForwardProjectionAlgorithm.h"
+
+#include "DataProjectorPolicies.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+
+#include "Projector2DImpl.inl"
+
+// type of the algorithm, needed to register with CAlgorithmFactory
+std::string CSliceStackForwardProjectionAlgorithm::type = "FP_STACK";
+
+//----------------------------------------------------------------------------------------
+// Constructor - Default
+CSliceStackForwardProjectionAlgorithm::CSliceStackForwardProjectionAlgorithm()
+{
+	_clear();
+}
+
+//----------------------------------------------------------------------------------------
+// Constructor
+CSliceStackForwardProjectionAlgorithm::CSliceStackForwardProjectionAlgorithm(CProjector2D* _pProjector,
+	const float* _pVolumeStack,
+	float* _pSinogramStack,
+	int _iSliceCount)
+{
+	_clear();
+	initialize(_pProjector, _pVolumeStack, _pSinogramStack, _iSliceCount);
+}
+
+//----------------------------------------------------------------------------------------
+// Destructor
+CSliceStackForwardProjectionAlgorithm::~CSliceStackForwardProjectionAlgorithm()
+{
+	clear();
+}
+
+//---------------------------------------------------------------------------------------
+// Clear - Constructors
+void CSliceStackForwardProjectionAlgorithm::_clear()
+{
+	m_pProjector = NULL;
+	m_pVolumeStack = NULL;
+	m_pSinogramStack = NULL;
+	m_iSliceCount = 0;
+	m_buffers.clear();
+	m_blocks.clear();
+	m_forwardProjectors.clear();
+	m_bIsInitialized = false;
+}
+
+//---------------------------------------------------------------------------------------
+// Clear - Public
+void CSliceStackForwardProjectionAlgorithm::clear()
+{
+	for (size_t i = 0; i < m_forwardProjectors.size(); ++i)
+		delete m_forwardProjectors[i];
+	_clear();
+}
+
+//----------------------------------------------------------------------------------------
+// Check
+bool CSliceStackForwardProjectionAlgorithm::_check()
+{
+	// check pointers
+	ASTRA_CONFIG_CHECK(m_pProjector, "SliceStackForwardProjection", "Invalid Projector Object.");
+	ASTRA_CONFIG_CHECK(m_pVolumeStack, "SliceStackForwardProjection", "Invalid Volume Stack.");
+	ASTRA_CONFIG_CHECK(m_pSinogramStack, "SliceStackForwardProjection", "Invalid Sinogram Stack.");
+	ASTRA_CONFIG_CHECK(m_iSliceCount > 0, "SliceStackForwardProjection", "Slice count must be positive.");
+
+	// check initializations
+	ASTRA_CONFIG_CHECK(m_pProjector->isInitialized(), "SliceStackForwardProjection", "Projector Object Not Initialized.");
+
+	ASTRA_CONFIG_CHECK(!m_forwardProjectors.empty() && m_forwardProjectors[0], "SliceStackForwardProjection", "Invalid FP Policy");
+
+	// success
+	return true;
+}
+
+//----------------------------------------------------------------------------------------
+// Initialize
+bool CSliceStackForwardProjectionAlgorithm::initialize(CProjector2D* _pProjector,
+	const float* _pVolumeStack,
+	float* _pSinogramStack,
+	int _iSliceCount)
+{
+	clear();
+
+	// store classes
+	m_pProjector = _pProjector;
+	m_pVolumeStack = _pVolumeStack;
+	m_pSinogramStack = _pSinogramStack;
+	m_iSliceCount = _iSliceCount;
+
+	if (m_pProjector && m_pProjector->isInitialized() && m_iSliceCount > 0) {
+		const size_t iBufferSize = (size_t)m_pProjector->getVolumeGeometry()->getGridRowCount() * m_pProjector->getVolumeStride() * SliceStackFPPolicy::SLICE_LANES;
+
+		// one block in flight per worker, within the memory budget
+		int iBlockCount = (m_iSliceCount + SliceStackFPPolicy::SLICE_LANES - 1) / SliceStackFPPolicy::SLICE_LANES;
+		int iBufferCount = std::min(iBlockCount, CThreadPool::getSingleton().getThreadCount());
+		iBufferCount = (int)std::min<size_t>(iBufferCount, MAX_BLOCK_BUFFER_BYTES / (iBufferSize * sizeof(float)));
+		iBufferCount = std::max(iBufferCount, 1);
+
+		// the padding columns of a volume stride stay zero
+		m_buffers.resize(iBufferCount, std::vector<float>(iBufferSize, 0.0f));
+		m_blocks.resize(iBufferCount);
+		for (int b = 0; b < iBufferCount; ++b) {
+			m_blocks[b].m_pVolume = &m_buffers[b][0];
+			m_blocks[b].m_pSinograms = m_pSinogramStack;
+			m_blocks[b].m_iSliceCount = 0;
+			m_blocks[b].m_iRayCount = m_pProjector->getProjectionGeometry()->getProjectionAngleCount() * m_pProjector->getProjectionGeometry()->getDetectorCount();
+			m_forwardProjectors.push_back(dispatchDataProjector(m_pProjector, SliceStackFPPolicy(&m_blocks[b])));
+		}
+	}
+
+	// return success
+	m_bIsInitialized = _check();
+	return m_bIsInitialized;
+}
+
+//----------------------------------------------------------------------------------------
+// Interleave the rows [_iRowFrom, _iRowTo) of a block of slices
+void CSliceStackForwardProjectionAlgorithm::_interleave(int _iBuffer, int _iBlock, int _iRowFrom, int _iRowTo)
+{
+	const int L = SliceStackFPPolicy::SLICE_LANES;
+	const int iRowCount = m_pProjector->getVolumeGeometry()->getGridRowCount();
+	const int iColCount = m_pProjector->getVolumeGeometry()->getGridColCount();
+	const int iStride = m_pProjector->getVolumeStride();
+	const size_t iSliceSize = (size_t)iRowCount * iColCount;
+
+	const int iFirstSlice = _iBlock * L;
+	const int iSliceCount = std::min(L, m_iSliceCount - iFirstSlice);
+
+	float* pBuffer = &m_buffers[_iBuffer][0];
+	for (int iRow = _iRowFrom; iRow < _iRowTo; ++iRow) {
+		float* pOut = pBuffer + (size_t)iRow * iStride * L;
+		for (int k = 0; k < L; ++k) {
+			if (k < iSliceCount) {
+				const float* pIn = m_pVolumeStack + (iFirstSlice + k) * iSliceSize + (size_t)iRow * iColCount;
+				for (int iCol = 0; iCol < iColCount; ++iCol)
+					pOut[iCol * L + k] = pIn[iCol];
+			}
+			else {
+				for (int iCol = 0; iCol < iColCount; ++iCol)
+					pOut[iCol * L + k] = 0.0f;
+			}
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------
+// Iterate
+void CSliceStackForwardProjectionAlgorithm::run(int _iNrIterations)
+{
+	// check initialized
+	ASTRA_ASSERT(m_bIsInitialized);
+
+	ASTRA_RECORD(m_instrumentation);
+
+	const int iRowCount = m_pProjector->getVolumeGeometry()->getGridRowCount();
+	const int iAngleCount = m_pProjector->getProjectionGeometry()->getProjectionAngleCount();
+	const int iAngleBlockSize = CDataProjectorInterface::DEFAULT_ANGLE_BLOCK_SIZE;
+	const int iAngleBlockCount = (iAngleCount + iAngleBlockSize - 1) / iAngleBlockSize;
+	const int iBlockCount = (m_iSliceCount + SliceStackFPPolicy::SLICE_LANES - 1) / SliceStackFPPolicy::SLICE_LANES;
+	const int iBufferCount = (int)m_buffers.size();
+
+	m_control.beginRun();
+	m_control.addTotal(iBlockCount * iAngleCount);
+
+	std::atomic<bool> bAborted(false);
+	for (int iFirstBlock = 0; iFirstBlock < iBlockCount; iFirstBlock += iBufferCount) {
+		if (m_control.checkAbort())
+			return;
+
+		const int iInFlight = std::min(iBufferCount, iBlockCount - iFirstBlock);
+
+		// point the buffers at the sinograms of their blocks, before the tasks below share them
+		for (int iBuffer = 0; iBuffer < iInFlight; ++iBuffer) {
+			const int iFirstSlice = (iFirstBlock + iBuffer) * SliceStackFPPolicy::SLICE_LANES;
+			SliceStackFPPolicy::SBlock& block = m_blocks[iBuffer];
+			block.m_pSinograms = m_pSinogramStack + (size_t)iFirstSlice * block.m_iRayCount;
+			block.m_iSliceCount = std::min((int)SliceStackFPPolicy::SLICE_LANES, m_iSliceCount - iFirstSlice);
+		}
+
+		// interleave the blocks in flight, in ranges of rows
+		parallelFor(0, iInFlight * iRowCount, 16, [this, iRowCount, iFirstBlock](int _iFrom, int _iTo) {
+			while (_iFrom < _iTo) {
+				int iBuffer = _iFrom / iRowCount;
+				int iRowFrom = _iFrom - iBuffer * iRowCount;
+				int iRowTo = std::min(iRowCount, iRowFrom + (_iTo - _iFrom));
+				_interleave(iBuffer, iFirstBlock + iBuffer, iRowFrom, iRowTo);
+				_iFrom += iRowTo - iRowFrom;
+			}
+		});
+
+		// project the angle blocks of all blocks in flight together
+		parallelFor(0, iInFlight * iAngleBlockCount, 1, [this, iAngleCount, iAngleBlockSize, iAngleBlockCount, &bAborted](int _iFrom, int _iTo) {
+			for (int iTask = _iFrom; iTask < _iTo; ++iTask) {
+				if (m_control.checkAbort()) {
+					bAborted.store(true, std::memory_order_relaxed);
+					return;
+				}
+				int iBuffer = iTask / iAngleBlockCount;
+				int iAngleFrom = (iTask - iBuffer * iAngleBlockCount) * iAngleBlockSize;
+				int iAngleTo = std::min(iAngleFrom + iAngleBlockSize, iAngleCount);
+				m_forwardProjectors[iBuffer]->projectAngleRange(iAngleFrom, iAngleTo);
+				m_control.advance(iAngleTo - iAngleFrom);
+			}
+		});
+
+		if (bAborted.load())
+			return;
+	}
+}
+//----------------------------------------------------------------------------------------
@@ -0,0 +1,142 @@
+#ifndef _INC_ASTRA_SLICESTACKFORWARDPROJECTIONALGORITHM
+#define _INC_ASTRA_SLICESTACKFORWARDPROJECTIONALGORITHM
+
+#include "Algorithm.h"
+
+#include "Globals.h"
+
+#include "Projector2D.h"
+
+#include "DataProjector.h"
+
+#include <vector>
+
+/**
+	* \brief
+	* This class contains the implementation of an algorithm that forward projects a stack of
+	* 2D slices that share one projector, such as the slices of a fan beam scan.
+	*
+	* The volume stack is [slice][row][col] and the sinogram stack [slice][angle][detector],
+	* both contiguous. The slices are projected in blocks of SliceStackFPPolicy::SLICE_LANES:
+	* a block is interleaved so that the slice is the innermost dimension, and every ray is
+	* traced once for all slices of the block. The ray setup and weights of the projector are
+	* thus shared by the slices, and the innermost loop runs across slices in one vector.
+	*
+	* Several blocks are in flight at once (slice parallelism) and their angle ranges are
+	* scheduled together on the thread pool (ray parallelism), so there is enough work for
+	* all cores for few slices with many angles as well as many slices with few angles.
+	* The result equals CForwardProjectionAlgorithm run on every slice.
+	*/
+class CSliceStackForwardProjectionAlgorithm : public CAlgorithm {
+
+public:
+
+	/** Largest total size of the interleaved blocks in flight.
+		*/
+	static const size_t MAX_BLOCK_BUFFER_BYTES = 64 << 20;
+
+protected:
+
+	/** Initial clearing. Only to be used by constructors.
+		*/
+	virtual void _clear();
+
+	/** Check the values of this object.  If everything is ok, the object can be set to the initialized state.
+		* The following statements are then guaranteed to hold:
+		* - valid projector
+		* - valid data stacks
+		*/
+	virtual bool _check();
+
+	/** Interleave the rows [_iRowFrom, _iRowTo) of the slices of block _iBlock of the stack
+		* into buffer _iBuffer. Concurrent calls for disjoint rows are fine.
+		*/
+	void _interleave(int _iBuffer, int _iBlock, int _iRowFrom, int _iRowTo);
+
+	//< Projector object.
+	CProjector2D* m_pProjector;
+	//< Volume stack, [slice][row][col]
+	const float* m_pVolumeStack;
+	//< Sinogram stack, [slice][angle][detector]
+	float* m_pSinogramStack;
+	//< Number of slices
+	int m_iSliceCount;
+
+	//< Interleaved blocks in flight, their policy blocks and data projectors
+	std::vector<std::vector<float> > m_buffers;
+	std::vector<SliceStackFPPolicy::SBlock> m_blocks;
+	std::vector<CDataProjectorInterface*> m_forwardProjectors;
+
+public:
+
+	// type of the algorithm, needed to register with CAlgorithmFactory
+	static std::string type;
+
+	/** Default constructor, containing no code.
+		*/
+	CSliceStackForwardProjectionAlgorithm();
+
+	/** Initializing constructor.
+		*
+		* @param _pProjector		Projector to use, shared by all slices.
+		* @param _pVolumeStack		_iSliceCount volumes of the volume geometry of the projector, one after the other.
+		* @param _pSinogramStack	_iSliceCount sinograms of the projection geometry of the projector, one after the other.
+		* @param _iSliceCount		Number of slices.
+		*/
+	CSliceStackForwardProjectionAlgorithm(CProjector2D* _pProjector,
+		const float* _pVolumeStack,
+		float* _pSinogramStack,
+		int _iSliceCount);
+
+	/** Destructor.
+		*/
+	virtual ~CSliceStackForwardProjectionAlgorithm();
+
+	/** Clear this class.
+		*/
+	virtual void clear();
+
+	/** Initialize class.
+		*
+		* @param _pProjector		Projector to use, shared by all slices.
+		* @param _pVolumeStack		_iSliceCount volumes of the volume geometry of the projector, one after the other.
+		* @param _pSinogramStack	_iSliceCount sinograms of the projection geometry of the projector, one after the other.
+		* @param _iSliceCount		Number of slices.
+		* @return success
+		*/
+	bool initialize(CProjector2D* _pProjector,
+		const float* _pVolumeStack,
+		float* _pSinogramStack,
+		int _iSliceCount);
+
+	/** Get projector object
+		*
+		* @return projector
+		*/
+	CProjector2D* getProjector() const;
+
+	/** Get the number of slices.
+		*/
+	int getSliceCount() const;
+
+	/** Forward project all slices.
+		*
+		* @param _iNrIterations unused.
+		*/
+	virtual void run(int _iNrIterations = 0);
+
+	/** Get a description of the class.
+		*
+		* @return description string
+		*/
+	virtual std::string description() const;
+
+};
+
+// inline functions
+inline std::string CSliceStackForwardProjectionAlgorithm::description() const { return CSliceStackForwardProjectionAlgorithm::type; };
+inline CProjector2D* CSliceStackForwardProjectionAlgorithm::getProjector() const { return m_pProjector; }
+inline int CSliceStackForwardProjectionAlgorithm::getSliceCount() const { return m_iSliceCount; }
+
+
+#endif
@@ -29,6 +29,7 @@ along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
 
 #include "Globals.h"
 #include "SparseMatrix.h"
+#include "Instrumentation.h"
 
 
 //----------------------------------------------------------------------------------------
@@ -36,6 +37,9 @@ along with the ASTRA Toolbox. If not, see <http://www.gnu.org/licenses/>.
 
 CSparseMatrix::CSparseMatrix()
 {
+	m_pfValues = 0;
+	m_piColIndices = 0;
+	m_plRowStarts = 0;
 	m_bInitialized = false;
 }
 
@@ -66,6 +70,9 @@ bool CSparseMatrix::initialize(unsigned int _iHeight, unsigned int _iWidth,
 	m_iWidth = _iWidth;
 	m_lSize = _lSize;
 
+	ASTRA_COUNT(COUNTER_ALLOCATIONS, 3);
+	ASTRA_COUNT(COUNTER_BYTES_ALLOCATED, _lSize * (sizeof(float) + sizeof(unsigned int)) + (_iHeight + 1) * sizeof(unsigned long));
+
 	m_pfValues = new float[_lSize];
 	m_piColIndices = new unsigned int[_lSize];
 	m_plRowStarts = new unsigned long[_iHeight + 1];
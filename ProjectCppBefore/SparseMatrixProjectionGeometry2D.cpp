@@ -35,6 +35,7 @@ CSparseMatrixProjectionGeometry2D::CSparseMatrixProjectionGeometry2D(const CSpar
 
 CSparseMatrixProjectionGeometry2D& CSparseMatrixProjectionGeometry2D::operator=(const CSparseMatrixProjectionGeometry2D& _other)
 {
+	_resetFingerprint();
 	m_bInitialized = _other.m_bInitialized;
 	if (_other.m_bInitialized) {
 		m_pMatrix = _other.m_pMatrix;
@@ -62,6 +63,7 @@ bool CSparseMatrixProjectionGeometry2D::initialize(int _iProjectionAngleCount,
 		clear();
 	}
 
+	_resetFingerprint();
 	m_iProjectionAngleCount = _iProjectionAngleCount;
 	m_iDetectorCount = _iDetectorCount;
 
@@ -131,3 +133,11 @@ bool CSparseMatrixProjectionGeometry2D::isOfType(const std::string& _sType)
 	return (_sType == "sparse_matrix");
 }
 
+//----------------------------------------------------------------------------------------
+// Fingerprint
+void CSparseMatrixProjectionGeometry2D::_fingerprint(CFingerprint& _fingerprint) const
+{
+	_fingerprint.add("sparse_matrix");
+	CProjectionGeometry2D::_fingerprint(_fingerprint);
+	_fingerprint.add(&m_pMatrix, sizeof(m_pMatrix));
+}
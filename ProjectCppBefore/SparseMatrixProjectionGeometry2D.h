@@ -96,6 +96,11 @@ protected:
 		*/
 	bool _check();
 
+	/** Add the type, the common values and the matrix to _fingerprint. The matrix is
+		* identified by its address, the same as in isEqual().
+		*/
+	virtual void _fingerprint(CFingerprint& _fingerprint) const;
+
 	const CSparseMatrix* m_pMatrix;
 };
 
@@ -0,0 +1,374 @@
+/**
+	* Consistency tests of the fan beam projector kernels, run by ctest.
+	*
+	*   Adjoint       <A x, y> = <x, A^T y> for random x and y: the backprojection of every
+	*                 kernel is the transpose of its forward projection
+	*   SplitWeights  computeProjectionWeights() against computeSingleRayWeights()
+	*   RayTable      the line kernel with its ray table against the direct ray setup
+	*   RayCache      projections replayed from the ray weight cache against traced ones
+	*   Matrix        getMatrix() refuses a projector set up for a volume view
+	*   View          algorithms reconstructing into a volume view against a contiguous volume
+	*   NonSquare     central rays through a constant volume of 1 x 2 pixels against Siddon
+	*   IsEqual       geometry equality remembered by isEqual() is forgotten when a geometry changes
+	*
+	* Every test runs on two geometries, detectors finer and coarser than the volume, at
+	* angles that are not multiples of 45 degrees. A failing check is printed, and the exit
+	* code is the number of failed checks.
+	*
+	* Usage: ProjectorTests
+	*/
+
+#include "../FanFlatProjectionGeometry2D.h"
+#include "../FanFlatBeamLineKernelProjector2D.h"
+#include "../FanFlatBeamSiddonKernelProjector2D.h"
+#include "../FanFlatBeamJosephKernelProjector2D.h"
+#include "../FanFlatBeamDistanceDrivenProjector2D.h"
+#include "../FanFlatBeamStripKernelProjector2D.h"
+#include "../FanFlatBeamBlobKernelProjector2D.h"
+#include "../VolumeGeometry2D.h"
+#include "../Float32VolumeData2D.h"
+#include "../Float32VolumeData2DView.h"
+#include "../Float32ProjectionData2D.h"
+#include "../DataProjector.h"
+#include "../DataProjectorPolicies.h"
+#include "../RayWeightCache.h"
+#include "../SparseMatrix.h"
+#include "../OrderedSubsetsAlgorithm.h"
+#include "../CglsAlgorithm.h"
+
+#include "../Projector2DImpl.inl"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+static const int SIZE = 64;
+static const int ANGLES = 37;
+
+static int g_iFailures = 0;
+
+
+//----------------------------------------------------------------------------------------
+// Report a check
+static void check(bool _bPassed, const char* _pcTest, const char* _pcKernel, const char* _pcGeometry, double _dError)
+{
+	printf("%-4s %-12s %-6s %-6s error %.3g\n", _bPassed ? "ok" : "FAIL", _pcTest, _pcKernel, _pcGeometry, _dError);
+	if (!_bPassed)
+		++g_iFailures;
+}
+
+//----------------------------------------------------------------------------------------
+// Uniform random values in [-1, 1)
+static void fillRandom(CFloat32Data2D* _pData, unsigned int _iSeed)
+{
+	mt19937 generator(_iSeed);
+	uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+	for (int i = 0; i < _pData->getSize(); ++i)
+		_pData->getData()[i] = distribution(generator);
+}
+
+static double dot(const CFloat32Data2D* _pA, const CFloat32Data2D* _pB)
+{
+	double dSum = 0.0;
+	for (int i = 0; i < _pA->getSize(); ++i)
+		dSum += double(_pA->getDataConst()[i]) * _pB->getDataConst()[i];
+	return dSum;
+}
+
+// largest absolute difference, relative to the largest absolute value of _pExpected; row
+// by row, so either may be a view
+static double maxDifference(const CFloat32Data2D* _pExpected, const CFloat32Data2D* _pActual)
+{
+	double dDifference = 0.0, dScale = 0.0;
+	for (int iy = 0; iy < _pExpected->getHeight(); ++iy) {
+		const float* pfExpected = _pExpected->getData2DConst()[iy];
+		const float* pfActual = _pActual->getData2DConst()[iy];
+		for (int ix = 0; ix < _pExpected->getWidth(); ++ix) {
+			dDifference = max(dDifference, fabs(double(pfExpected[ix]) - pfActual[ix]));
+			dScale = max(dScale, fabs(double(pfExpected[ix])));
+		}
+	}
+	return dScale > 0.0 ? dDifference / dScale : dDifference;
+}
+
+//----------------------------------------------------------------------------------------
+// sinogram = A volume, with all angles at once or through the angle blocks (and so the
+// ray weight cache, if enabled)
+static void forwardProject(CProjector2D* _pProjector, CFloat32VolumeData2D* _pVolume, CFloat32ProjectionData2D* _pSinogram, bool _bBlocks)
+{
+	unique_ptr<CDataProjectorInterface> pProjector(dispatchDataProjector(_pProjector, DefaultFPPolicy(_pVolume, _pSinogram)));
+	if (_bBlocks)
+		pProjector->projectParallel();
+	else
+		pProjector->project();
+}
+
+// volume = A^T sinogram
+static void backProject(CProjector2D* _pProjector, CFloat32VolumeData2D* _pVolume, CFloat32ProjectionData2D* _pSinogram, bool _bBlocks)
+{
+	_pVolume->setData(0.0f);
+	unique_ptr<CDataProjectorInterface> pProjector(dispatchDataProjector(_pProjector, DefaultBPPolicy(_pVolume, _pSinogram)));
+	if (_bBlocks)
+		pProjector->projectParallel();
+	else
+		pProjector->project();
+}
+
+//----------------------------------------------------------------------------------------
+// <A x, y> = <x, A^T y>
+static void testAdjoint(CProjector2D* _pProjector, const char* _pcKernel, const char* _pcGeometry)
+{
+	CFloat32VolumeData2D x(_pProjector->getVolumeGeometry(), 0.0f);
+	CFloat32VolumeData2D ATy(_pProjector->getVolumeGeometry(), 0.0f);
+	CFloat32ProjectionData2D y(_pProjector->getProjectionGeometry(), 0.0f);
+	CFloat32ProjectionData2D Ax(_pProjector->getProjectionGeometry(), 0.0f);
+	fillRandom(&x, 1);
+	fillRandom(&y, 2);
+
+	forwardProject(_pProjector, &x, &Ax, false);
+	backProject(_pProjector, &ATy, &y, false);
+
+	// float sums of a few hundred terms per ray or pixel
+	const double dLeft = dot(&Ax, &y);
+	const double dRight = dot(&x, &ATy);
+	const double dError = fabs(dLeft - dRight) / max(fabs(dLeft), fabs(dRight));
+	check(dError < 1e-4, "Adjoint", _pcKernel, _pcGeometry, dError);
+}
+
+//----------------------------------------------------------------------------------------
+// compact weights of every angle against the rays one by one
+static void testSplitWeights(CProjector2D* _pProjector, const char* _pcKernel, const char* _pcGeometry)
+{
+	const int iAngleCount = _pProjector->getProjectionGeometry()->getProjectionAngleCount();
+	const int iDetectorCount = _pProjector->getProjectionGeometry()->getDetectorCount();
+
+	int iMismatches = 0;
+	for (int iAngle = 0; iAngle < iAngleCount; ++iAngle) {
+		SProjectionWeights weights;
+		_pProjector->computeProjectionWeights(iAngle, weights);
+
+		const int iBufferSize = _pProjector->getProjectionWeightsCount(iAngle);
+		vector<SPixelWeight> ray(iBufferSize);
+		for (int iDetector = 0; iDetector < iDetectorCount; ++iDetector) {
+			int iCount = 0;
+			_pProjector->computeSingleRayWeights(iAngle, iDetector, &ray[0], iBufferSize, iCount);
+			const int iStart = weights.m_rayStarts[iDetector];
+			if (weights.m_rayStarts[iDetector + 1] - iStart != iCount) {
+				++iMismatches;
+				continue;
+			}
+			for (int i = 0; i < iCount; ++i)
+				if (weights.m_indices[iStart + i] != ray[i].m_iIndex || weights.m_weights[iStart + i] != ray[i].m_fWeight)
+					++iMismatches;
+		}
+	}
+	check(iMismatches == 0, "SplitWeights", _pcKernel, _pcGeometry, iMismatches);
+}
+
+//----------------------------------------------------------------------------------------
+// forward and backprojection replayed from the ray weight cache against traced ones
+static void testRayCache(CProjector2D* _pProjector, const char* _pcKernel, const char* _pcGeometry)
+{
+	CFloat32VolumeData2D x(_pProjector->getVolumeGeometry(), 0.0f);
+	CFloat32VolumeData2D ATy(_pProjector->getVolumeGeometry(), 0.0f);
+	CFloat32VolumeData2D ATyCached(_pProjector->getVolumeGeometry(), 0.0f);
+	CFloat32ProjectionData2D y(_pProjector->getProjectionGeometry(), 0.0f);
+	CFloat32ProjectionData2D Ax(_pProjector->getProjectionGeometry(), 0.0f);
+	CFloat32ProjectionData2D AxCached(_pProjector->getProjectionGeometry(), 0.0f);
+	fillRandom(&x, 3);
+	fillRandom(&y, 4);
+
+	forwardProject(_pProjector, &x, &Ax, true);
+	backProject(_pProjector, &ATy, &y, true);
+
+	// twice: filling the cache, then replaying it
+	_pProjector->setRayWeightCacheCapacity(size_t(256) << 20);
+	for (int i = 0; i < 2; ++i) {
+		forwardProject(_pProjector, &x, &AxCached, true);
+		backProject(_pProjector, &ATyCached, &y, true);
+		const double dError = max(maxDifference(&Ax, &AxCached), maxDifference(&ATy, &ATyCached));
+		const bool bReplayed = i == 0 || _pProjector->getRayWeightCache()->getStatistics().iHits > 0;
+		check(dError < 1e-6 && bReplayed, i == 0 ? "RayCacheMiss" : "RayCacheHit", _pcKernel, _pcGeometry, dError);
+	}
+	_pProjector->setRayWeightCacheCapacity(0);
+}
+
+//----------------------------------------------------------------------------------------
+// forward projection with the ray table against the direct ray setup
+static void testRayTable(CFanFlatBeamLineKernelProjector2D* _pProjector, const char* _pcGeometry)
+{
+	CFloat32VolumeData2D x(_pProjector->getVolumeGeometry(), 0.0f);
+	CFloat32ProjectionData2D Ax(_pProjector->getProjectionGeometry(), 0.0f);
+	CFloat32ProjectionData2D AxTable(_pProjector->getProjectionGeometry(), 0.0f);
+	fillRandom(&x, 5);
+
+	forwardProject(_pProjector, &x, &Ax, false);
+	_pProjector->setRayTableEnabled(true);
+	forwardProject(_pProjector, &x, &AxTable, false);
+	_pProjector->setRayTableEnabled(false);
+
+	const double dError = maxDifference(&Ax, &AxTable);
+	check(dError < 1e-6, "RayTable", "line", _pcGeometry, dError);
+}
+
+//----------------------------------------------------------------------------------------
+// the sparse matrix columns are grid indices, which a view stride would break
+static void testMatrixStride(CProjector2D* _pProjector, const char* _pcGeometry)
+{
+	unique_ptr<CSparseMatrix> pMatrix(_pProjector->getMatrix());
+	_pProjector->setVolumeStride(SIZE + 8);
+	unique_ptr<CSparseMatrix> pViewMatrix(_pProjector->getMatrix());
+	_pProjector->setVolumeStride(SIZE);
+	check(pMatrix && !pViewMatrix, "Matrix", "line", _pcGeometry, 0.0);
+}
+
+//----------------------------------------------------------------------------------------
+// a reconstruction into a SIZE x SIZE view in the middle of a volume twice as large, against
+// the same reconstruction into a contiguous volume; the rest of the parent is left alone
+template <typename Algorithm>
+static void testView(Algorithm* _pAlgorithm, Algorithm* _pViewAlgorithm, const char* _pcAlgorithm,
+	CFanFlatProjectionGeometry2D* _pProjectionGeometry, const char* _pcGeometry)
+{
+	CVolumeGeometry2D volumeGeometry(SIZE, SIZE);
+	CVolumeGeometry2D parentGeometry(2 * SIZE, 2 * SIZE);
+	CFloat32VolumeData2D parent(&parentGeometry, 5.0f);
+	CFloat32VolumeData2DView view(&parent, SIZE / 2, SIZE / 2, SIZE, SIZE);
+	CFloat32VolumeData2D reconstruction(&volumeGeometry, 0.0f);
+	view.setData(0.0f);
+
+	CFanFlatBeamLineKernelProjector2D projector(_pProjectionGeometry, &volumeGeometry);
+	CFanFlatBeamLineKernelProjector2D viewProjector(_pProjectionGeometry, view.getGeometry());
+	viewProjector.setVolumeStride(view.getStride());
+
+	CFloat32VolumeData2D phantom(&volumeGeometry, 0.0f);
+	CFloat32ProjectionData2D sinogram(_pProjectionGeometry, 0.0f);
+	fillRandom(&phantom, 6);
+	forwardProject(&projector, &phantom, &sinogram, false);
+
+	bool bInitialized = _pAlgorithm->initialize(&projector, &sinogram, &reconstruction)
+		&& _pViewAlgorithm->initialize(&viewProjector, &sinogram, &view);
+	if (!bInitialized) {
+		check(false, "View", _pcAlgorithm, _pcGeometry, 0.0);
+		return;
+	}
+	_pAlgorithm->run(3);
+	_pViewAlgorithm->run(3);
+
+	int iTouched = 0;
+	for (int iy = 0; iy < 2 * SIZE; ++iy)
+		for (int ix = 0; ix < 2 * SIZE; ++ix)
+			if ((ix < SIZE / 2 || ix >= SIZE / 2 + SIZE || iy < SIZE / 2 || iy >= SIZE / 2 + SIZE) && parent.getData2D()[iy][ix] != 5.0f)
+				++iTouched;
+	const double dError = maxDifference(&reconstruction, &view);
+	check(dError < 1e-6 && iTouched == 0, "View", _pcAlgorithm, _pcGeometry, dError);
+}
+
+//----------------------------------------------------------------------------------------
+// the central ray of a constant volume of pixels twice as high as wide is the length of the
+// chord, which Siddon computes exactly, at angles stepping along either axis
+template <typename Projector>
+static void testNonSquare(const char* _pcKernel)
+{
+	const int iDetectorCount = 33;
+	const float fAngles[4] = { 0.0f, 0.3f, 0.5f * float(M_PI), 1.9f };
+	CVolumeGeometry2D volumeGeometry(32, 32, -16.0f, -32.0f, 16.0f, 32.0f);
+	CFanFlatProjectionGeometry2D projectionGeometry(4, iDetectorCount, 1.0f, fAngles, 200.0f, 100.0f);
+
+	CFloat32VolumeData2D volume(&volumeGeometry, 1.0f);
+	CFloat32ProjectionData2D expected(&projectionGeometry, 0.0f);
+	CFloat32ProjectionData2D actual(&projectionGeometry, 0.0f);
+	CFanFlatBeamSiddonKernelProjector2D siddon(&projectionGeometry, &volumeGeometry);
+	Projector projector(&projectionGeometry, &volumeGeometry);
+	if (!projector.isInitialized()) {
+		check(false, "NonSquare", _pcKernel, "1x2", 0.0);
+		return;
+	}
+	forwardProject(&siddon, &volume, &expected, false);
+	forwardProject(&projector, &volume, &actual, false);
+
+	double dError = 0.0;
+	for (int iAngle = 0; iAngle < 4; ++iAngle) {
+		const float fExpected = expected.getData2DConst()[iAngle][iDetectorCount / 2];
+		const float fActual = actual.getData2DConst()[iAngle][iDetectorCount / 2];
+		dError = max(dError, fabs(double(fActual) - fExpected) / fExpected);
+	}
+	check(dError < 1e-3, "NonSquare", _pcKernel, "1x2", dError);
+}
+
+//----------------------------------------------------------------------------------------
+// a copy is equal, twice (the second time remembered), and no longer once it is changed
+static void testIsEqual(CFanFlatProjectionGeometry2D* _pGeometry, const char* _pcGeometry)
+{
+	CFanFlatProjectionGeometry2D copy(*_pGeometry);
+	const bool bEqual = copy.isEqual(_pGeometry) && _pGeometry->isEqual(&copy) && copy.isEqual(_pGeometry);
+
+	vector<float> angles(_pGeometry->getProjectionAngles(), _pGeometry->getProjectionAngles() + ANGLES);
+	angles[ANGLES - 1] += 0.01f;
+	copy.initialize(ANGLES, _pGeometry->getDetectorCount(), _pGeometry->getDetectorWidth(), &angles[0],
+		_pGeometry->getOriginSourceDistance(), _pGeometry->getOriginDetectorDistance());
+	const bool bChanged = !copy.isEqual(_pGeometry) && !_pGeometry->isEqual(&copy);
+
+	check(bEqual && bChanged, "IsEqual", "-", _pcGeometry, 0.0);
+}
+
+//----------------------------------------------------------------------------------------
+template <typename Projector>
+static void testKernel(const char* _pcKernel, CFanFlatProjectionGeometry2D* _pProjectionGeometry, CVolumeGeometry2D* _pVolumeGeometry, const char* _pcGeometry)
+{
+	Projector projector(_pProjectionGeometry, _pVolumeGeometry);
+	if (!projector.isInitialized()) {
+		check(false, "Initialize", _pcKernel, _pcGeometry, 0.0);
+		return;
+	}
+	testAdjoint(&projector, _pcKernel, _pcGeometry);
+	testSplitWeights(&projector, _pcKernel, _pcGeometry);
+	testRayCache(&projector, _pcKernel, _pcGeometry);
+}
+
+int main(int argc, char** argv)
+{
+	vector<float> angles(ANGLES);
+	for (int i = 0; i < ANGLES; ++i)
+		angles[i] = 0.3f + 2.0f * float(M_PI) * i / ANGLES;
+
+	CVolumeGeometry2D volumeGeometry(SIZE, SIZE);
+
+	// magnification 3: detector pixels of 1 and 4 are a third and more than a pixel at the centre
+	CFanFlatProjectionGeometry2D fineGeometry(ANGLES, 3 * SIZE / 2, 1.0f, &angles[0], 1.5f * SIZE, 3.0f * SIZE);
+	CFanFlatProjectionGeometry2D coarseGeometry(ANGLES, SIZE / 2, 4.0f, &angles[0], 1.5f * SIZE, 3.0f * SIZE);
+
+	CFanFlatProjectionGeometry2D* pGeometries[2] = { &fineGeometry, &coarseGeometry };
+	const char* pcGeometries[2] = { "fine", "coarse" };
+	for (int g = 0; g < 2; ++g) {
+		testKernel<CFanFlatBeamLineKernelProjector2D>("line", pGeometries[g], &volumeGeometry, pcGeometries[g]);
+		testKernel<CFanFlatBeamSiddonKernelProjector2D>("siddon", pGeometries[g], &volumeGeometry, pcGeometries[g]);
+		testKernel<CFanFlatBeamJosephKernelProjector2D>("joseph", pGeometries[g], &volumeGeometry, pcGeometries[g]);
+		testKernel<CFanFlatBeamDistanceDrivenProjector2D>("dd", pGeometries[g], &volumeGeometry, pcGeometries[g]);
+		testKernel<CFanFlatBeamStripKernelProjector2D>("strip", pGeometries[g], &volumeGeometry, pcGeometries[g]);
+		testKernel<CFanFlatBeamBlobKernelProjector2D>("blob", pGeometries[g], &volumeGeometry, pcGeometries[g]);
+
+		testIsEqual(pGeometries[g], pcGeometries[g]);
+
+		CFanFlatBeamLineKernelProjector2D projector(pGeometries[g], &volumeGeometry);
+		testRayTable(&projector, pcGeometries[g]);
+		testMatrixStride(&projector, pcGeometries[g]);
+
+		COrderedSubsetsAlgorithm os, osView;
+		testView(&os, &osView, "os", pGeometries[g], pcGeometries[g]);
+		CCglsAlgorithm cgls, cglsView;
+		testView(&cgls, &cglsView, "cgls", pGeometries[g], pcGeometries[g]);
+	}
+
+	// the line and blob kernels require square pixels
+	testNonSquare<CFanFlatBeamJosephKernelProjector2D>("joseph");
+	testNonSquare<CFanFlatBeamDistanceDrivenProjector2D>("dd");
+	testNonSquare<CFanFlatBeamStripKernelProjector2D>("strip");
+
+	printf("%d failed\n", g_iFailures);
+	return g_iFailures;
+}
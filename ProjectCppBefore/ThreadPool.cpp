@@ -0,0 +1,278 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+
+DEFINE_SINGLETON(CThreadPool)
+
+
+// index of the worker running on this thread, -1 outside the pool
+static thread_local int s_iCurrentWorker = -1;
+
+
+//----------------------------------------------------------------------------------------
+// Constructor
+CThreadPool::CThreadPool()
+{
+	m_iQueuedCount.store(0);
+	m_bStopping = false;
+	_start(0);
+}
+
+//----------------------------------------------------------------------------------------
+// Destructor
+CThreadPool::~CThreadPool()
+{
+	_stop();
+}
+
+//----------------------------------------------------------------------------------------
+// Start workers
+void CThreadPool::_start(int _iThreadCount)
+{
+	if (_iThreadCount <= 0)
+		_iThreadCount = std::max(1u, std::thread::hardware_concurrency());
+
+	for (int i = 0; i < _iThreadCount; ++i)
+		m_queues.push_back(new SWorkerQueue());
+	for (int i = 0; i < _iThreadCount; ++i)
+		m_threads.push_back(std::thread(&CThreadPool::_workerLoop, this, i));
+}
+
+//----------------------------------------------------------------------------------------
+// Stop workers
+void CThreadPool::_stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_sleepMutex);
+		m_bStopping = true;
+	}
+	m_wakeUp.notify_all();
+	for (size_t i = 0; i < m_threads.size(); ++i)
+		m_threads[i].join();
+	m_threads.clear();
+
+	for (size_t i = 0; i < m_queues.size(); ++i)
+		delete m_queues[i];
+	m_queues.clear();
+
+	m_bStopping = false;
+}
+
+//----------------------------------------------------------------------------------------
+// Thread count
+int CThreadPool::getThreadCount() const
+{
+	return (int)m_threads.size();
+}
+
+//----------------------------------------------------------------------------------------
+// Change thread count
+void CThreadPool::setThreadCount(int _iThreadCount)
+{
+	ASTRA_ASSERT(s_iCurrentWorker < 0);
+	_stop();
+	_start(_iThreadCount);
+}
+
+//----------------------------------------------------------------------------------------
+// Current worker
+int CThreadPool::getCurrentWorker()
+{
+	return s_iCurrentWorker;
+}
+
+//----------------------------------------------------------------------------------------
+// Submit
+void CThreadPool::submit(Task _task)
+{
+	SWorkerQueue* pQueue = (s_iCurrentWorker >= 0) ? m_queues[s_iCurrentWorker] : &m_injection;
+	{
+		std::lock_guard<std::mutex> lock(pQueue->m_mutex);
+		pQueue->m_tasks.push_back(std::move(_task));
+	}
+	{
+		// taking the lock orders the increment with a worker that is about to sleep
+		std::lock_guard<std::mutex> lock(m_sleepMutex);
+		m_iQueuedCount.fetch_add(1);
+	}
+	m_wakeUp.notify_one();
+}
+
+//----------------------------------------------------------------------------------------
+// Take a task
+bool CThreadPool::_takeTask(int _iWorker, Task& _task)
+{
+	if (m_iQueuedCount.load() == 0)
+		return false;
+
+	// own deque, newest first
+	if (_iWorker >= 0) {
+		SWorkerQueue* pQueue = m_queues[_iWorker];
+		std::lock_guard<std::mutex> lock(pQueue->m_mutex);
+		if (!pQueue->m_tasks.empty()) {
+			_task = std::move(pQueue->m_tasks.back());
+			pQueue->m_tasks.pop_back();
+			m_iQueuedCount.fetch_sub(1);
+			return true;
+		}
+	}
+
+	// injection queue, oldest first
+	{
+		std::lock_guard<std::mutex> lock(m_injection.m_mutex);
+		if (!m_injection.m_tasks.empty()) {
+			_task = std::move(m_injection.m_tasks.front());
+			m_injection.m_tasks.pop_front();
+			m_iQueuedCount.fetch_sub(1);
+			return true;
+		}
+	}
+
+	// steal from the others, oldest first
+	int iCount = (int)m_queues.size();
+	for (int i = 1; i <= iCount; ++i) {
+		int iVictim = (_iWorker + i + iCount) % iCount;
+		if (iVictim == _iWorker)
+			continue;
+		SWorkerQueue* pQueue = m_queues[iVictim];
+		std::lock_guard<std::mutex> lock(pQueue->m_mutex);
+		if (!pQueue->m_tasks.empty()) {
+			_task = std::move(pQueue->m_tasks.front());
+			pQueue->m_tasks.pop_front();
+			m_iQueuedCount.fetch_sub(1);
+			return true;
+		}
+	}
+	return false;
+}
+
+//----------------------------------------------------------------------------------------
+// Run a pending task
+bool CThreadPool::runPendingTask()
+{
+	Task task;
+	if (!_takeTask(s_iCurrentWorker, task))
+		return false;
+	task();
+	return true;
+}
+
+//----------------------------------------------------------------------------------------
+// Worker main loop
+void CThreadPool::_workerLoop(int _iWorker)
+{
+	s_iCurrentWorker = _iWorker;
+	Task task;
+	while (true) {
+		if (_takeTask(_iWorker, task)) {
+			task();
+			task = Task();
+			continue;
+		}
+		std::unique_lock<std::mutex> lock(m_sleepMutex);
+		m_wakeUp.wait(lock, [this]() { return m_bStopping || m_iQueuedCount.load() > 0; });
+		if (m_bStopping && m_iQueuedCount.load() == 0)
+			break;
+	}
+	s_iCurrentWorker = -1;
+}
+
+
+//----------------------------------------------------------------------------------------
+// Task group
+CTaskGroup::CTaskGroup() :
+	m_pState(new SState())
+{
+	m_pState->m_iPending = 0;
+}
+
+CTaskGroup::~CTaskGroup()
+{
+	// an exception that was not collected with wait() is dropped
+	_waitForTasks();
+}
+
+void CTaskGroup::run(CThreadPool::Task _task)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_pState->m_mutex);
+		m_pState->m_tasks.push_back(std::move(_task));
+		++m_pState->m_iPending;
+	}
+	std::shared_ptr<SState> pState = m_pState;
+	CThreadPool::getSingleton().submit([pState]() { _runTask(*pState); });
+}
+
+bool CTaskGroup::_runTask(SState& _state)
+{
+	CThreadPool::Task task;
+	{
+		std::lock_guard<std::mutex> lock(_state.m_mutex);
+		if (_state.m_tasks.empty())
+			return false;
+		task = std::move(_state.m_tasks.front());
+		_state.m_tasks.pop_front();
+	}
+
+	std::exception_ptr pException;
+	try {
+		task();
+	}
+	catch (...) {
+		pException = std::current_exception();
+	}
+
+	// counted down in all cases, or wait() would never return
+	std::lock_guard<std::mutex> lock(_state.m_mutex);
+	if (pException && !_state.m_pException)
+		_state.m_pException = pException;
+	if (--_state.m_iPending == 0)
+		_state.m_done.notify_all();
+	return true;
+}
+
+void CTaskGroup::wait()
+{
+	_waitForTasks();
+	std::exception_ptr pException;
+	{
+		std::lock_guard<std::mutex> lock(m_pState->m_mutex);
+		pException = m_pState->m_pException;
+		m_pState->m_pException = std::exception_ptr();
+	}
+	if (pException)
+		std::rethrow_exception(pException);
+}
+
+void CTaskGroup::_waitForTasks()
+{
+	SState& state = *m_pState;
+	while (_runTask(state)) { }
+
+	// the rest is running on workers
+	std::unique_lock<std::mutex> lock(state.m_mutex);
+	state.m_done.wait(lock, [&state]() { return state.m_iPending == 0; });
+}
+
+
+//----------------------------------------------------------------------------------------
+// Parallel for
+void parallelFor(int _iBegin, int _iEnd, int _iGrain, const std::function<void(int, int)>& _function)
+{
+	if (_iEnd <= _iBegin)
+		return;
+	if (_iGrain < 1)
+		_iGrain = 1;
+
+	CTaskGroup group;
+	int iFrom = _iBegin;
+	for (; iFrom + _iGrain < _iEnd; iFrom += _iGrain) {
+		int iTo = iFrom + _iGrain;
+		group.run([&_function, iFrom, iTo]() { _function(iFrom, iTo); });
+	}
+	// the last range runs on the calling thread; if it throws, the destructor of the group
+	// still waits for the other ranges, which use _function, before the exception leaves
+	_function(iFrom, _iEnd);
+	group.wait();
+}
@@ -0,0 +1,180 @@
+#ifndef _INC_ASTRA_THREADPOOL
+#define _INC_ASTRA_THREADPOOL
+
+#include "Globals.h"
+#include "Singleton.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+/**
+	* Process-wide work-stealing thread pool.
+	*
+	* Every worker has its own task deque. A worker pushes and pops at the back of its own
+	* deque (newest first, good for cache reuse of nested work) and steals from the front of
+	* the others (oldest first, the largest pieces of work). Tasks submitted from threads
+	* outside the pool go to a shared injection queue.
+	*
+	* Everything that runs in parallel in the library shares this pool, so concurrent
+	* algorithm runs split the cores between them instead of each starting its own threads.
+	* Threads that wait for a CTaskGroup run the tasks of that group meanwhile, which keeps
+	* nested parallelism (an asynchronous algorithm job that runs parallel angle blocks) from
+	* deadlocking the pool.
+	*/
+class CThreadPool : public Singleton<CThreadPool> {
+
+public:
+
+	typedef std::function<void()> Task;
+
+	/** Default constructor. Starts one worker per hardware thread.
+		*/
+	CThreadPool();
+
+	/** Destructor. Finishes the queued tasks and stops the workers.
+		*/
+	virtual ~CThreadPool();
+
+	/** Queue a task.
+		*
+		* @param _task task to run on one of the workers
+		*/
+	void submit(Task _task);
+
+	/** Run one pending task on the calling thread, if there is one.
+		*
+		* @return true if a task was run
+		*/
+	bool runPendingTask();
+
+	/** Get the number of worker threads.
+		*/
+	int getThreadCount() const;
+
+	/** Change the number of worker threads. Waits for the current workers to finish
+		* their queued tasks. Must not be called from a task.
+		*
+		* @param _iThreadCount number of workers, 0 for one per hardware thread
+		*/
+	void setThreadCount(int _iThreadCount);
+
+	/** Get the index of the worker the calling thread is, -1 for threads outside the pool.
+		*/
+	static int getCurrentWorker();
+
+protected:
+
+	/** Task deque of one worker.
+		*/
+	struct SWorkerQueue
+	{
+		std::mutex m_mutex;
+		std::deque<Task> m_tasks;
+	};
+
+	/** Start _iThreadCount workers.
+		*/
+	void _start(int _iThreadCount);
+
+	/** Stop all workers, after they have finished all queued tasks.
+		*/
+	void _stop();
+
+	/** Main loop of a worker.
+		*/
+	void _workerLoop(int _iWorker);
+
+	/** Take a task: own deque, then the injection queue, then steal.
+		*/
+	bool _takeTask(int _iWorker, Task& _task);
+
+	std::vector<std::thread> m_threads;
+	std::vector<SWorkerQueue*> m_queues;
+	SWorkerQueue m_injection;
+
+	std::atomic<int> m_iQueuedCount;		///< tasks in all queues
+	std::mutex m_sleepMutex;
+	std::condition_variable m_wakeUp;
+	bool m_bStopping;
+};
+
+
+/**
+	* A set of tasks on the CThreadPool that can be waited for.
+	*
+	* The tasks wait in a queue of the group; every run() submits a task to the pool that
+	* takes one of them, if any is left. The thread that waits takes them as well, so the
+	* group finishes even when all workers are busy, and it never runs tasks of other
+	* groups or jobs: a caller is not held up behind unrelated work, and stacks do not nest.
+	*/
+class CTaskGroup {
+
+public:
+
+	/** Default constructor.
+		*/
+	CTaskGroup();
+
+	/** Destructor. Waits for the remaining tasks.
+		*/
+	~CTaskGroup();
+
+	/** Queue a task as part of this group.
+		*/
+	void run(CThreadPool::Task _task);
+
+	/** Wait until all tasks of this group have finished. The calling thread runs the
+		* tasks of the group that no worker has started, then sleeps until the last one
+		* finishes. If tasks threw, the first exception is rethrown here, after all tasks
+		* have finished.
+		*/
+	void wait();
+
+private:
+
+	/** State shared with the tasks submitted to the pool, which may outlive the group
+		* when the waiting thread ran the task they were meant for.
+		*/
+	struct SState
+	{
+		std::mutex m_mutex;
+		std::condition_variable m_done;
+		std::deque<CThreadPool::Task> m_tasks;	///< tasks not started yet
+		int m_iPending;							///< tasks not finished yet
+		std::exception_ptr m_pException;		///< first exception thrown by a task
+	};
+
+	/** Run the oldest task of the group that has not been started, if there is one.
+		*
+		* @return true if a task was run
+		*/
+	static bool _runTask(SState& _state);
+
+	/** Wait until all tasks of this group have finished, without rethrowing.
+		*/
+	void _waitForTasks();
+
+	std::shared_ptr<SState> m_pState;
+
+	CTaskGroup(const CTaskGroup&);
+	CTaskGroup& operator=(const CTaskGroup&);
+};
+
+
+/**
+	* Run _function(iFrom, iTo) on consecutive ranges of at most _iGrain elements covering
+	* [_iBegin, _iEnd), in parallel on the CThreadPool. Returns when all ranges are done.
+	* The calling thread takes part in the work. If ranges threw, the first exception is
+	* rethrown once all ranges are done.
+	*/
+void parallelFor(int _iBegin, int _iEnd, int _iGrain, const std::function<void(int, int)>& _function);
+
+#endif // _INC_ASTRA_THREADPOOL
@@ -50,6 +50,8 @@ void CVolumeGeometry2D::clear()
 	m_fWindowMaxX = 0.0f;
 	m_fWindowMaxY = 0.0f;
 
+	m_iFingerprint = 0;
+
 	m_bInitialized = false;
 }
 
@@ -116,6 +118,7 @@ CVolumeGeometry2D* CVolumeGeometry2D::clone()
 	res->m_fWindowMinY = m_fWindowMinY;
 	res->m_fWindowMaxX = m_fWindowMaxX;
 	res->m_fWindowMaxY = m_fWindowMaxY;
+	res->m_iFingerprint = m_iFingerprint;
 	return res;
 }
 
@@ -172,6 +175,17 @@ void CVolumeGeometry2D::_calculateDependents()
 
 	m_fDivPixelLengthX = ((float)m_iGridColCount / m_fWindowLengthX); // == (1.0f / m_fPixelLengthX);
 	m_fDivPixelLengthY = ((float)m_iGridRowCount / m_fWindowLengthY); // == (1.0f / m_fPixelLengthY);
+
+	// all other values follow from these
+	CFingerprint fingerprint;
+	fingerprint.add("volume2d");
+	fingerprint.add(m_iGridColCount);
+	fingerprint.add(m_iGridRowCount);
+	fingerprint.add(m_fWindowMinX);
+	fingerprint.add(m_fWindowMinY);
+	fingerprint.add(m_fWindowMaxX);
+	fingerprint.add(m_fWindowMaxY);
+	m_iFingerprint = fingerprint.get();
 }
 
 //----------------------------------------------------------------------------------------
@@ -183,6 +197,9 @@ bool CVolumeGeometry2D::isEqual(CVolumeGeometry2D* _pGeom2) const
 	// both objects must be initialized
 	if (!m_bInitialized || !_pGeom2->m_bInitialized) return false;
 
+	// fast reject
+	if (m_iFingerprint != _pGeom2->m_iFingerprint)			return false;
+
 	// check all values
 	if (m_iGridColCount != _pGeom2->m_iGridColCount)		return false;
 	if (m_iGridRowCount != _pGeom2->m_iGridRowCount)		return false;
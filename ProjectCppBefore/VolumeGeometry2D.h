@@ -2,6 +2,7 @@
 #define _INC_ASTRA_VOLUMEGEOMETRY2D
 
 #include "Globals.h"
+#include "Fingerprint.h"
 
 
 /**
@@ -46,6 +47,8 @@ protected:
 	float m_fWindowMaxX;      ///< Minimal Y-coordinate in the volume window.
 	float m_fWindowMaxY;      ///< Maximal Y-coordinate in the volume window. 
 
+	uint64_t m_iFingerprint;	///< Content hash of the grid and window, see getFingerprint().
+
 	/** Check the values of this object.  If everything is ok, the object can be set to the initialized state.
 		* The following statements are then guaranteed to hold:
 		* - number of rows and columns is larger than zero
@@ -150,6 +153,12 @@ public:
 		*/
 	virtual bool isEqual(CVolumeGeometry2D*) const;
 
+	/** Get a 64-bit content hash of the grid and window. Computed once on initialization.
+		*
+		* @return fingerprint, never 0 for an initialized geometry
+		*/
+	uint64_t getFingerprint() const;
+
 	/** Get the number of columns in the volume grid.
 		*
 		* @return Number of columns in the volume grid.
@@ -327,6 +336,13 @@ inline bool CVolumeGeometry2D::isInitialized() const
 	return m_bInitialized;
 }
 
+// Get the content hash.
+inline uint64_t CVolumeGeometry2D::getFingerprint() const
+{
+	ASTRA_ASSERT(m_bInitialized);
+	return m_iFingerprint;
+}
+
 // Get the number of columns in the volume grid.
 inline int CVolumeGeometry2D::getGridColCount() const
 {
@@ -6,6 +6,7 @@ Algorithm::Algorithm() {
 	geom = NULL;
 	sino = NULL;
 	phantom = NULL;
+	doublePrecision = false;
 };
 
 Algorithm::Algorithm(
@@ -16,6 +17,7 @@ Algorithm::Algorithm(
 	geom = _geom;
 	phantom = _phantom;
 	sino = _sino;
+	doublePrecision = false;
 }
 
 Algorithm::~Algorithm() {};
@@ -29,26 +31,48 @@ void Algorithm::addWeight(int _rayIndex, int _phantomIndex, float _weight) {
 	sino->getData()[_rayIndex] += phantom->getData()[_phantomIndex] * _weight;
 };
 
+void Algorithm::setDoublePrecision(bool _doublePrecision) {
+	doublePrecision = _doublePrecision;
+}
+
+bool Algorithm::getDoublePrecision() const {
+	return doublePrecision;
+}
+
 void Algorithm::runProjection() {
+	if (doublePrecision) {
+		runProjectionImpl<double>();
+	}
+	else {
+		runProjectionImpl<float>();
+	}
+}
+
+// Real is the type used for the ray sums and the incremental stepping along the ray.
+template<typename Real>
+void Algorithm::runProjectionImpl() {
 	sino->setData(0.0f);
 
+	const float* phantomData = phantom->getData();
+	float* sinoData = sino->getData();
+
 	// precomputations
-	const float pixelWidth = geom->getPixelWidth();
-	const float pixelHeight = geom->getPixelHeight();
-	const float pixelWidth_inv = 1.0f / pixelWidth;
-	const float pixelHeight_inv = 1.0f / pixelHeight;
+	const Real pixelWidth = geom->getPixelWidth();
+	const Real pixelHeight = geom->getPixelHeight();
+	const Real pixelWidth_inv = Real(1) / pixelWidth;
+	const Real pixelHeight_inv = Real(1) / pixelHeight;
 	const int FOVColumnCount = geom->getFOVColumnCount();
 	const int FOVRowCount = geom->getFOVRowCount();
 	const int detectorCount = geom->getDetectorCount();
-	const float adjustX = geom->getWindowMinX() + pixelWidth * 0.5f;
-	const float adjustY = geom->getWindowMaxY() - pixelHeight * 0.5f;
+	const Real adjustX = geom->getWindowMinX() + pixelWidth * Real(0.5);
+	const Real adjustY = geom->getWindowMaxY() - pixelHeight * Real(0.5);
 
 	// loop angles
 	for (int angleIndex = 0; angleIndex < geom->getProjectionAngleCount(); ++angleIndex) {
 
 		// variables
-		float Dx, Dy, Rx, Ry, S, T, weight, c, r, deltac, deltar, offset, RxOverRy, RyOverRx;
-		float lengthPerRow, lengthPerCol, invTminSTimesLengthPerRow, invTminSTimesLengthPerCol;
+		Real Dx, Dy, Rx, Ry, S, T, weight, c, r, deltac, deltar, offset, RxOverRy, RyOverRx;
+		Real lengthPerRow, lengthPerCol, invTminSTimesLengthPerRow, invTminSTimesLengthPerCol;
 		int phantomIndex, rayIndex, row, col, detectorIndex;
 
 		const Coordinates* proj = &geom->getProjectionAngles()[angleIndex];  // changed to coordinates
@@ -58,9 +82,10 @@ void Algorithm::runProjection() {
 			rayIndex = angleIndex * detectorCount + detectorIndex;
 
 			//if (!initSinoData(rayIndex)) continue;
+			Real raySum = 0;
 
-			Dx = proj->detectorX0 + (detectorIndex + 0.5f) * proj->detectorPixelWidth;
-			Dy = proj->detectorY0 + (detectorIndex + 0.5f) * proj->detectorPixelHeight;
+			Dx = proj->detectorX0 + (detectorIndex + Real(0.5)) * proj->detectorPixelWidth;
+			Dy = proj->detectorY0 + (detectorIndex + Real(0.5)) * proj->detectorPixelHeight;
 
 			Rx = proj->sourceX - Dx;
 			Ry = proj->sourceY - Dy;
@@ -73,8 +98,8 @@ void Algorithm::runProjection() {
 				RxOverRy = Rx / Ry;
 				lengthPerRow = pixelWidth * sqrt(Rx * Rx + Ry * Ry) / abs(Ry);
 				deltac = -pixelHeight * RxOverRy * pixelWidth_inv;
-				S = 0.5f - 0.5f * fabs(RxOverRy);
-				T = 0.5f + 0.5f * fabs(RxOverRy);
+				S = Real(0.5) - Real(0.5) * fabs(RxOverRy);
+				T = Real(0.5) + Real(0.5) * fabs(RxOverRy);
 				invTminSTimesLengthPerRow = lengthPerRow / (T - S);
 
 				// calculate c for row 0
@@ -83,9 +108,9 @@ void Algorithm::runProjection() {
 				// for each row
 				for (row = 0; row < FOVRowCount; ++row, c += deltac) {
 
-					col = int(floor(c + 0.5f));
+					col = int(floor(c + Real(0.5)));
 					if (col < -1 || col > FOVColumnCount) { if (!isin) continue; else break; }
-					offset = c - float(col);
+					offset = c - Real(col);
 
 					// left
 					if (offset < -S) {
@@ -93,12 +118,12 @@ void Algorithm::runProjection() {
 
 						phantomIndex = row * FOVColumnCount + col - 1;
 						if (col > 0) {
-							addWeight(rayIndex, phantomIndex, lengthPerRow - weight);
+							raySum += phantomData[phantomIndex] * (lengthPerRow - weight);
 						}
 
 						phantomIndex++;
 						if (col >= 0 && col < FOVColumnCount) {
-							addWeight(rayIndex, phantomIndex, weight);
+							raySum += phantomData[phantomIndex] * weight;
 						}
 					}
 
@@ -108,19 +133,19 @@ void Algorithm::runProjection() {
 
 						phantomIndex = row * FOVColumnCount + col;
 						if (col >= 0 && col < FOVColumnCount) {
-							addWeight(rayIndex, phantomIndex, lengthPerRow - weight);
+							raySum += phantomData[phantomIndex] * (lengthPerRow - weight);
 						}
 
 						phantomIndex++;
 						if (col + 1 < FOVColumnCount) {
-							addWeight(rayIndex, phantomIndex, weight);
+							raySum += phantomData[phantomIndex] * weight;
 						}
 					}
 
 					// centre
 					else if (col >= 0 && col < FOVColumnCount) {
 						phantomIndex = row * FOVColumnCount + col;
-						addWeight(rayIndex, phantomIndex, lengthPerRow);
+						raySum += phantomData[phantomIndex] * lengthPerRow;
 					}
 					isin = true;
 				}
@@ -131,8 +156,8 @@ void Algorithm::runProjection() {
 				RyOverRx = Ry / Rx;
 				lengthPerCol = pixelHeight * sqrt(Rx * Rx + Ry * Ry) / abs(Rx);
 				deltar = -pixelWidth * RyOverRx * pixelHeight_inv;
-				S = 0.5f - 0.5f * fabs(RyOverRx);
-				T = 0.5f + 0.5f * fabs(RyOverRx);
+				S = Real(0.5) - Real(0.5) * fabs(RyOverRx);
+				T = Real(0.5) + Real(0.5) * fabs(RyOverRx);
 				invTminSTimesLengthPerCol = lengthPerCol / (T - S);
 
 				// calculate r for col 0
@@ -141,9 +166,9 @@ void Algorithm::runProjection() {
 				// for each col
 				for (col = 0; col < FOVColumnCount; ++col, r += deltar) {
 
-					row = int(floor(r + 0.5f));
+					row = int(floor(r + Real(0.5)));
 					if (row < -1 || row > FOVRowCount) { if (!isin) continue; else break; }
-					offset = r - float(row);
+					offset = r - Real(row);
 
 					// up
 					if (offset < -S) {
@@ -151,12 +176,12 @@ void Algorithm::runProjection() {
 
 						phantomIndex = (row - 1) * FOVColumnCount + col;
 						if (row > 0) {
-							addWeight(rayIndex, phantomIndex, lengthPerCol - weight);
+							raySum += phantomData[phantomIndex] * (lengthPerCol - weight);
 						}
 
 						phantomIndex += FOVColumnCount;
 						if (row >= 0 && row < FOVRowCount) {
-							addWeight(rayIndex, phantomIndex, weight);
+							raySum += phantomData[phantomIndex] * weight;
 						}
 					}
 
@@ -166,23 +191,25 @@ void Algorithm::runProjection() {
 
 						phantomIndex = row * FOVColumnCount + col;
 						if (row >= 0 && row < FOVRowCount) {
-							addWeight(rayIndex, phantomIndex, lengthPerCol - weight);
+							raySum += phantomData[phantomIndex] * (lengthPerCol - weight);
 						}
 
 						phantomIndex += FOVColumnCount;
 						if (row + 1 < FOVRowCount) {
-							addWeight(rayIndex, phantomIndex, weight);
+							raySum += phantomData[phantomIndex] * weight;
 						}
 					}
 
 					// centre
 					else if (row >= 0 && row < FOVRowCount) {
 						phantomIndex = row * FOVColumnCount + col;
-						addWeight(rayIndex, phantomIndex, lengthPerCol);
+						raySum += phantomData[phantomIndex] * lengthPerCol;
 					}
 					isin = true;
 				}
 			}
+
+			sinoData[rayIndex] = float(raySum);
 		} // end loop detector
 	} // end loop angles
 }
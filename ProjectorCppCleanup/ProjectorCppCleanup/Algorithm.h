@@ -19,10 +19,18 @@ public:
 	void addWeight(int _rayIndex, int _phantomIndex, float _weight);
 	void runProjection();
 
+	// accumulate ray sums and step along the rays in double precision.
+	// the data stays float; slower, but the error no longer grows with the ray length.
+	void setDoublePrecision(bool _doublePrecision);
+	bool getDoublePrecision() const;
+
 protected:
+	template<typename Real> void runProjectionImpl();
+
 	Geometry* geom;
 	DataStructure* phantom;
 	DataStructure* sino;
+	bool doublePrecision;
 };
 
 #endif
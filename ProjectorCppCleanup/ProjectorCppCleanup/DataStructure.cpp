@@ -1,8 +1,35 @@
 #include <cassert>
+#include <cstring>
 #include <iostream>
+#include <stdlib.h>
+
+#ifdef _MSC_VER
+#include <malloc.h>
+#endif
 
 #include "DataStructure.h"
 
+// 16-byte aligned allocation, _aligned_malloc only exists on MSVC
+static float* alignedAllocate(size_t bytes) {
+#ifdef _MSC_VER
+	return (float*)_aligned_malloc(bytes, 16);
+#else
+	void* p = NULL;
+	if (posix_memalign(&p, 16, bytes) != 0) {
+		return NULL;
+	}
+	return (float*)p;
+#endif
+}
+
+static void alignedFree(float* p) {
+#ifdef _MSC_VER
+	_aligned_free(p);
+#else
+	free(p);
+#endif
+}
+
 DataStructure::DataStructure() {
 	width = 0;
 	height = 0;
@@ -12,30 +39,38 @@ DataStructure::DataStructure() {
 }
 
 DataStructure::~DataStructure() {
-
+	clear();
 }
 
 void DataStructure::clear() {
-	_aligned_free(data);
+	if (data) {
+		alignedFree(data);
+	}
 	width = 0;
 	height = 0;
 	size = 0;
 	data = NULL;
 }
 
-DataStructure::DataStructure(int _width, int _height, const float* _data) {
-	clear();
-
+void DataStructure::allocate(int _width, int _height) {
 	assert(_width > 0);
 	assert(_height > 0);
-	assert(_data != NULL);
+	assert(data == NULL);
 
 	width = _width;    // detector count
 	height = _height;  // angle count
 	size = (size_t)width * height;
 
-	data = 0;
-	data = (float*)_aligned_malloc(size * sizeof(float),16);
+	assert(size > 0);
+	assert((size_t)size == (size_t)width * height);
+	data = alignedAllocate(size * sizeof(float));
+}
+
+DataStructure::DataStructure(int _width, int _height, const float* _data) {
+	assert(_data != NULL);
+
+	data = NULL;
+	allocate(_width, _height);
 
 	size_t i;
 	for (i = 0; i < size; ++i) {
@@ -44,19 +79,8 @@ DataStructure::DataStructure(int _width, int _height, const float* _data) {
 }
 
 DataStructure::DataStructure(int _width, int _height, float _data) {
-	clear();
-	assert(_width > 0);
-	assert(_height > 0);
-
-	width = _width;
-	height = _height;
-	size = (size_t)width * height;
-
-	data = 0;
-	assert(size > 0);
-	assert((size_t)size == (size_t)width * height);
-	assert(data == NULL);
-	data = (float*)_aligned_malloc(size * sizeof(float), 16);
+	data = NULL;
+	allocate(_width, _height);
 
 	size_t i;
 	for (i = 0; i < size; ++i) {
@@ -64,6 +88,72 @@ DataStructure::DataStructure(int _width, int _height, float _data) {
 	}
 }
 
+DataStructure::DataStructure(const DataStructure& _other) {
+	width = 0;
+	height = 0;
+	size = 0;
+	data = NULL;
+
+	if (_other.data) {
+		allocate(_other.width, _other.height);
+		memcpy(data, _other.data, size * sizeof(float));
+	}
+}
+
+DataStructure::DataStructure(DataStructure&& _other) noexcept {
+	width = _other.width;
+	height = _other.height;
+	size = _other.size;
+	data = _other.data;
+
+	_other.width = 0;
+	_other.height = 0;
+	_other.size = 0;
+	_other.data = NULL;
+}
+
+DataStructure& DataStructure::operator=(const DataStructure& _other) {
+	if (this == &_other) return *this;
+
+	if (!_other.data) {
+		clear();
+		return *this;
+	}
+
+	reinitialize(_other.width, _other.height);
+	memcpy(data, _other.data, size * sizeof(float));
+	return *this;
+}
+
+DataStructure& DataStructure::operator=(DataStructure&& _other) noexcept {
+	if (this == &_other) return *this;
+
+	clear();
+
+	width = _other.width;
+	height = _other.height;
+	size = _other.size;
+	data = _other.data;
+
+	_other.width = 0;
+	_other.height = 0;
+	_other.size = 0;
+	_other.data = NULL;
+	return *this;
+}
+
+bool DataStructure::reinitialize(int _width, int _height) {
+	if (data && (size_t)_width * _height == (size_t)size) {
+		width = _width;
+		height = _height;
+		return true;
+	}
+
+	clear();
+	allocate(_width, _height);
+	return false;
+}
+
 void DataStructure::setData(float _data) {
 	assert(data != NULL);
 	assert(size > 0);
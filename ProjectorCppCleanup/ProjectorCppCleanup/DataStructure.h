@@ -8,8 +8,15 @@ public:
 	DataStructure();
 	DataStructure(int _width, int _height, float _data);
 	DataStructure(int _width, int _height, const float* _data);
+	DataStructure(const DataStructure& _other);
+	DataStructure(DataStructure&& _other) noexcept;
 	virtual ~DataStructure();
+	DataStructure& operator=(const DataStructure& _other);
+	DataStructure& operator=(DataStructure&& _other) noexcept;
 	void clear();
+	// Resize to _width x _height. The buffer is kept if the size does not change,
+	// the contents is undefined afterwards. Returns true if the buffer was reused.
+	bool reinitialize(int _width, int _height);
 	float* getData();
 	void setData(float _data);
 	int getWidth() const;
@@ -18,6 +25,8 @@ public:
 	float& getData(int _index);
 
 protected:
+	void allocate(int _width, int _height);
+
 	float* data;
 
 	int width;   // x